@@ -0,0 +1,2 @@
+TESTS += $(LIBRARY_DIR)/peripherals/cortex/test/interrupt_test.cpp
+PLATFORM = lpc40xx
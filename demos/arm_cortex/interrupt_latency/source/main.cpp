@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+#include "peripherals/cortex/dwt_counter.hpp"
+#include "peripherals/interrupt.hpp"
+#include "platforms/targets/lpc40xx/LPC40xx.h"
+#include "utility/log.hpp"
+
+namespace
+{
+/// Interrupt used for the measurements. It is triggered from software, so any
+/// interrupt that is not used by the application will do.
+constexpr int kIrq = sjsu::lpc40xx::IRQn::QEI_IRQn;
+
+/// Number of interrupts measured for each dispatch method.
+constexpr size_t kSamples = 64;
+
+/// Stands in for a driver, whose interrupt handler captures its address.
+struct Probe_t
+{
+  sjsu::cortex::DwtCounter & counter;
+  volatile uint32_t handled_at = 0;
+
+  void Record()
+  {
+    handled_at = counter.GetCount();
+  }
+};
+
+sjsu::cortex::DwtCounter dwt_counter;
+Probe_t probe = { .counter = dwt_counter };
+
+// Reproduces the dispatch before InterruptDelegate: the handler is copied out
+// of a table of std::function and called through it. It is reached through a
+// delegate, so the difference between the two results slightly understates
+// the saving.
+std::function<void(void)> legacy_handler;
+
+void LegacyLookupHandler()
+{
+  std::function<void(void)> handler = legacy_handler;
+  handler();
+}
+
+struct Result_t
+{
+  uint32_t minimum = UINT32_MAX;
+  uint32_t maximum = 0;
+  uint32_t total   = 0;
+};
+
+Result_t Measure(sjsu::InterruptHandler handler)
+{
+  using sjsu::cortex::NVIC_Type;
+
+  sjsu::InterruptController::GetPlatformController().Enable({
+      .interrupt_request_number = kIrq,
+      .interrupt_handler        = handler,
+  });
+
+  Result_t result;
+  for (size_t i = 0; i < kSamples; i++)
+  {
+    probe.handled_at            = 0;
+    const uint32_t kTriggeredAt = dwt_counter.GetCount();
+    NVIC->STIR                  = kIrq;
+    while (probe.handled_at == 0)
+    {
+      continue;
+    }
+
+    const uint32_t kCycles = probe.handled_at - kTriggeredAt;
+    result.minimum         = std::min(result.minimum, kCycles);
+    result.maximum         = std::max(result.maximum, kCycles);
+    result.total           = result.total + kCycles;
+  }
+
+  sjsu::InterruptController::GetPlatformController().Disable(kIrq);
+  return result;
+}
+
+void Print(const char * name, const Result_t & result)
+{
+  sjsu::LogInfo("%-17s min = %3lu  avg = %3lu  max = %3lu cycles",
+                name,
+                result.minimum,
+                result.total / kSamples,
+                result.maximum);
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("Interrupt Latency Benchmark Starting...");
+  sjsu::LogInfo("Measures the DWT cycles from triggering an interrupt to the");
+  sjsu::LogInfo("start of its handler, through the LookupHandler dispatch.");
+  dwt_counter.Initialize();
+
+  legacy_handler = [&probe = probe]() { probe.Record(); };
+
+  const Result_t kLegacy   = Measure(LegacyLookupHandler);
+  const Result_t kDelegate = Measure([&probe = probe]() { probe.Record(); });
+
+  Print("std::function", kLegacy);
+  Print("InterruptDelegate", kDelegate);
+
+  return 0;
+}
@@ -0,0 +1 @@
+TESTS += $(LIBRARY_DIR)/utility/test/lock_free_queue_test.cpp
@@ -0,0 +1,140 @@
+#include <array>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdlib>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+#include "utility/lock_free_queue.hpp"
+#include "utility/log.hpp"
+#include "utility/time/time.hpp"
+
+// Compares the cost of moving items through a FreeRTOS queue, which copies
+// each item inside a critical section, with the lock-free SpscQueue and
+// MpscQueue, one item at a time and in bulk.
+//
+// Each round pushes a burst of items and then pops them all, from a single
+// task, so only the queue operations are measured and not the scheduler.
+// Build and run on the FreeRTOS POSIX port with:
+//
+//    make application PLATFORM=linux && make flash PLATFORM=linux
+//
+// or flash it to a board, where the differences are larger, since entering
+// and leaving a critical section is not free there.
+namespace
+{
+/// Items pushed and popped each round.
+constexpr size_t kBurst = 32;
+
+/// Rounds run for each queue.
+constexpr uint32_t kRounds = 5'000;
+
+using Item_t  = uint32_t;
+using Burst_t = std::array<Item_t, kBurst>;
+
+QueueHandle_t freertos_queue;
+sjsu::SpscQueue<Item_t, kBurst> spsc_queue;
+sjsu::MpscQueue<Item_t, kBurst> mpsc_queue;
+
+/// Run `round` kRounds times and report the time taken per item.
+///
+/// @param name - name of the benchmark.
+/// @param round - pushes and pops kBurst items, returning false if any were
+///        lost.
+void Measure(const char * name, bool (*round)(Burst_t & items))
+{
+  Burst_t items;
+  for (size_t i = 0; i < kBurst; i++)
+  {
+    items[i] = static_cast<Item_t>(i);
+  }
+
+  uint32_t failures = 0;
+  const auto kStart = sjsu::Uptime();
+  for (uint32_t i = 0; i < kRounds; i++)
+  {
+    failures += round(items) ? 0 : 1;
+  }
+  const auto kElapsed = sjsu::Uptime() - kStart;
+
+  const double kItems = static_cast<double>(kRounds) * kBurst;
+  sjsu::LogInfo("%-20s: %8.1f ns per item pushed and popped",
+                name,
+                static_cast<double>(kElapsed.count()) / kItems);
+  if (failures != 0)
+  {
+    sjsu::LogError("%s lost items in %" PRIu32 " rounds", name, failures);
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+void BenchmarkTask([[maybe_unused]] void * parameters)
+{
+  Measure("xQueueSend/Receive", [](Burst_t & items) {
+    for (Item_t & item : items)
+    {
+      xQueueSend(freertos_queue, &item, 0);
+    }
+    bool received = true;
+    for (Item_t & item : items)
+    {
+      received = (xQueueReceive(freertos_queue, &item, 0) == pdTRUE) &&
+                 received;
+    }
+    return received;
+  });
+
+  Measure("SpscQueue", [](Burst_t & items) {
+    for (const Item_t & item : items)
+    {
+      spsc_queue.Push(item);
+    }
+    bool received = true;
+    for (Item_t & item : items)
+    {
+      received = spsc_queue.Pop(item) && received;
+    }
+    return received;
+  });
+
+  Measure("SpscQueue bulk", [](Burst_t & items) {
+    spsc_queue.Push(items);
+    return spsc_queue.Pop(items) == kBurst;
+  });
+
+  Measure("MpscQueue", [](Burst_t & items) {
+    for (const Item_t & item : items)
+    {
+      mpsc_queue.Push(item);
+    }
+    bool received = true;
+    for (Item_t & item : items)
+    {
+      received = mpsc_queue.Pop(item) && received;
+    }
+    return received;
+  });
+
+  Measure("MpscQueue bulk", [](Burst_t & items) {
+    mpsc_queue.Push(items);
+    return mpsc_queue.Pop(items) == kBurst;
+  });
+
+  sjsu::LogInfo("Lock-free queue benchmark finished");
+  std::exit(EXIT_SUCCESS);
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("Lock-free Queue Benchmark Starting...");
+
+  freertos_queue = xQueueCreate(kBurst, sizeof(Item_t));
+  xTaskCreate(BenchmarkTask, "Benchmark", 2048, nullptr, 1, nullptr);
+
+  vTaskStartScheduler();
+
+  return 0;
+}
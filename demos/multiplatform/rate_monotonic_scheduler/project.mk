@@ -0,0 +1 @@
+TESTS += $(LIBRARY_DIR)/utility/rtos/freertos/test/rate_monotonic_scheduler_test.cpp
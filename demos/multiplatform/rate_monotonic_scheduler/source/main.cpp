@@ -0,0 +1,121 @@
+#include <cinttypes>
+#include <cstdint>
+#include <cstdlib>
+
+#include "utility/log.hpp"
+#include "utility/rtos/freertos/rate_monotonic_scheduler.hpp"
+#include "utility/time/time.hpp"
+
+// Runs callbacks at three unrelated periods, one of which is not a multiple of
+// the RTOS tick, then checks that each ran as often as its period allows. One
+// callback deliberately overruns its deadline once, which must be detected.
+//
+// Build and run on the FreeRTOS POSIX port with:
+//
+//    make application PLATFORM=linux && make flash PLATFORM=linux
+//
+// The program exits with a non-zero status if a check fails. Threads on a
+// desktop OS are not scheduled in real time, so expect a few missed deadlines
+// at the fastest rate besides the deliberate one.
+namespace
+{
+using Scheduler_t = sjsu::rtos::RateMonotonicScheduler<3>;
+
+/// How long to let the callbacks run before checking them.
+constexpr auto kRunTime = 2s;
+
+/// Number of the run of the overrunning callback that runs too long.
+constexpr uint32_t kOverrunCount = 10;
+
+Scheduler_t scheduler;
+std::chrono::nanoseconds start_time = 0ns;
+
+/// Keep the CPU busy, as a callback doing real work would.
+void BusyWait(std::chrono::nanoseconds duration)
+{
+  const auto kEnd = sjsu::Uptime() + duration;
+  while (sjsu::Uptime() < kEnd)
+  {
+    continue;
+  }
+}
+
+Scheduler_t::Callback_t sample("Sample", [](uint32_t) { BusyWait(200us); });
+Scheduler_t::Callback_t filter(
+    "Filter", [](uint32_t) { BusyWait(300us); }, 1ms);
+Scheduler_t::Callback_t control(
+    "Control", [](uint32_t) { BusyWait(500us); });
+Scheduler_t::Callback_t overrun("Overrun", [](uint32_t count) {
+  BusyWait((count == kOverrunCount) ? 60ms : 1ms);
+});
+
+/// @return true if the callback ran or missed its deadline once per period,
+///         give or take a period.
+bool Check(const Scheduler_t::Callback_t & callback,
+           std::chrono::nanoseconds elapsed)
+{
+  const auto & statistics = callback.GetStatistics();
+  const auto kExpected =
+      static_cast<uint32_t>(elapsed / callback.GetPeriod());
+  const uint32_t kPeriods = statistics.runs + statistics.missed_deadlines;
+
+  sjsu::LogInfo("%-8s %6" PRId64 "us %3d: %4" PRIu32
+                " runs (~%" PRIu32 "), %" PRIu32
+                " missed, %" PRId64 "/%" PRId64 "/%" PRId64 "us",
+                callback.GetName(),
+                static_cast<int64_t>(callback.GetPeriod() / 1us),
+                callback.GetPriority(),
+                statistics.runs,
+                kExpected,
+                statistics.missed_deadlines,
+                static_cast<int64_t>(statistics.minimum_execution / 1us),
+                static_cast<int64_t>(statistics.AverageExecution() / 1us),
+                static_cast<int64_t>(statistics.maximum_execution / 1us));
+
+  return kPeriods + 1 >= kExpected && statistics.runs <= kExpected + 1;
+}
+
+void Finish(uint32_t)
+{
+  const auto kElapsed = sjsu::Uptime() - start_time;
+  if (kElapsed < kRunTime)
+  {
+    return;
+  }
+
+  bool passed = true;
+  for (const auto * callback : { &sample, &filter, &control, &overrun })
+  {
+    passed = Check(*callback, kElapsed) && passed;
+  }
+
+  if (overrun.GetStatistics().missed_deadlines == 0)
+  {
+    sjsu::LogError("The overrun of %s was not detected", overrun.GetName());
+    passed = false;
+  }
+
+  sjsu::LogInfo("Rate monotonic scheduler %s", passed ? "PASSED" : "FAILED");
+  std::exit(passed ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+Scheduler_t::Callback_t finish("Finish", Finish);
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("Starting RateMonotonicScheduler example...");
+
+  scheduler.Add(sample, 2500us);
+  scheduler.Add(filter, 2500us);
+  scheduler.Add(control, 10ms);
+  scheduler.Add(overrun, 50ms);
+  scheduler.Add(finish, 50ms);
+  scheduler.Start();
+
+  start_time = sjsu::Uptime();
+
+  vTaskStartScheduler();
+
+  return 0;
+}
@@ -0,0 +1,4 @@
+CFLAGS = $(SJ2_DEFAULT_CFLAGS) -D SJ2_ENABLE_RTOS_TRACE=1
+
+TESTS += $(LIBRARY_DIR)/utility/rtos/freertos/test/trace_recorder_test.cpp
+TESTS += $(LIBRARY_DIR)/utility/console/commands/test/trace_command_test.cpp
@@ -0,0 +1,155 @@
+#include <array>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+
+#include "utility/build_info.hpp"
+#include "utility/console/commands/trace_command.hpp"
+#include "utility/log.hpp"
+#include "utility/rtos/freertos/trace_recorder.hpp"
+#include "utility/time/time.hpp"
+
+// Records a classic priority inversion: a low priority task holds a mutex that
+// a high priority task needs, while a medium priority task competes with the
+// low one for the CPU. FreeRTOS lends the low task the high task's priority
+// until it gives the mutex back, which shows up in the trace.
+//
+// After a second, the CPU time and stack left of each task are printed, and
+// the recording is dumped. On linux, build and run on the FreeRTOS POSIX port
+// and convert the dump to a timeline with:
+//
+//    make application PLATFORM=linux && make flash PLATFORM=linux
+//    python3 tools/rtos_trace/trace_to_chrome.py rtos_trace.bin trace.json
+//
+// then open trace.json in chrome://tracing or https://ui.perfetto.dev. On a
+// board, the dump is written to stdout, so capture the serial output into a
+// file and convert that instead; the tool skips the text before the dump.
+namespace
+{
+/// How long to record before reporting.
+constexpr auto kRecordTime = 1s;
+
+/// File the dump is written to on linux.
+constexpr char kDumpFile[] = "rtos_trace.bin";
+
+std::array<sjsu::rtos::TraceEvent_t, 2048> events;
+std::array<sjsu::rtos::TraceTask_t, 8> tasks;
+sjsu::rtos::TraceRecorder recorder(events, tasks);
+
+SemaphoreHandle_t shared_mutex;
+FILE * dump_file = nullptr;
+
+/// Keep the CPU busy, as a task doing real work would.
+void BusyWait(std::chrono::nanoseconds duration)
+{
+  const auto kEnd = sjsu::Uptime() + duration;
+  while (sjsu::Uptime() < kEnd)
+  {
+    continue;
+  }
+}
+
+void LowTask([[maybe_unused]] void * parameters)
+{
+  while (true)
+  {
+    xSemaphoreTake(shared_mutex, portMAX_DELAY);
+    BusyWait(3ms);
+    xSemaphoreGive(shared_mutex);
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+}
+
+void MediumTask([[maybe_unused]] void * parameters)
+{
+  while (true)
+  {
+    vTaskDelay(pdMS_TO_TICKS(5));
+    BusyWait(2ms);
+  }
+}
+
+void HighTask([[maybe_unused]] void * parameters)
+{
+  while (true)
+  {
+    vTaskDelay(pdMS_TO_TICKS(7));
+    xSemaphoreTake(shared_mutex, portMAX_DELAY);
+    BusyWait(200us);
+    xSemaphoreGive(shared_mutex);
+  }
+}
+
+void WriteToFile(std::span<const uint8_t> bytes)
+{
+  fwrite(bytes.data(), 1, bytes.size(), dump_file);
+}
+
+void ReportTask([[maybe_unused]] void * parameters)
+{
+  vTaskDelay(pdMS_TO_TICKS(kRecordTime / 1ms));
+  recorder.Stop();
+
+  uint32_t inheritances = 0;
+  for (size_t i = 0; i < recorder.Size(); i++)
+  {
+    if (recorder.GetEvent(i).type == sjsu::rtos::TraceEvent::kPriorityInherit)
+    {
+      inheritances++;
+    }
+  }
+
+  const char * const kStats[] = { "trace", "stats" };
+  const char * const kDump[]  = { "trace", "dump" };
+
+  if constexpr (sjsu::build::kPlatform == sjsu::build::Platform::linux)
+  {
+    sjsu::TraceCommand command(recorder, WriteToFile);
+    command.Program(2, kStats);
+
+    dump_file = fopen(kDumpFile, "wb");
+    if (dump_file == nullptr)
+    {
+      sjsu::LogError("Could not open %s", kDumpFile);
+      std::exit(EXIT_FAILURE);
+    }
+    command.Program(2, kDump);
+    fclose(dump_file);
+    sjsu::LogInfo("Wrote %zu events to %s", recorder.Size(), kDumpFile);
+  }
+  else
+  {
+    sjsu::TraceCommand command(recorder);
+    command.Program(2, kStats);
+    command.Program(2, kDump);
+  }
+
+  sjsu::LogInfo("Priority inherited %" PRIu32 " times", inheritances);
+  std::exit((inheritances > 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("Starting RTOS trace example...");
+
+  // Set the recorder before creating anything, so it learns the names of
+  // every task, including the idle task.
+  sjsu::rtos::TraceRecorder::SetPlatformRecorder(&recorder);
+  recorder.Start();
+
+  shared_mutex = xSemaphoreCreateMutex();
+  xTaskCreate(LowTask, "Low", 1024, nullptr, 1, nullptr);
+  xTaskCreate(MediumTask, "Medium", 1024, nullptr, 2, nullptr);
+  xTaskCreate(HighTask, "High", 1024, nullptr, 3, nullptr);
+  xTaskCreate(ReportTask, "Report", 2048, nullptr, 4, nullptr);
+
+  vTaskStartScheduler();
+
+  return 0;
+}
@@ -0,0 +1 @@
+TESTS += $(LIBRARY_DIR)/utility/time/test/timer_wheel_test.cpp
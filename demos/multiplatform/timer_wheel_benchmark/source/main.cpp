@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "utility/log.hpp"
+#include "utility/time/timer_wheel.hpp"
+
+namespace
+{
+/// Number of timeouts kept active on the wheel.
+constexpr size_t kTimeouts = 10'000;
+
+/// Tick of the wheel.
+constexpr auto kResolution = 100us;
+
+/// Longest delay that a timeout is scheduled with.
+constexpr auto kMaximumDelay = 1s;
+
+/// Simulated time that the wheel is run for.
+constexpr auto kRunTime = 10s;
+
+/// Each expired timeout schedules itself again with a new random delay, so the
+/// wheel always holds kTimeouts timeouts.
+struct Benchmark_t
+{
+  sjsu::TimerWheel wheel = sjsu::TimerWheel(kResolution);
+  std::mt19937 random    = std::mt19937(1);
+  std::uniform_int_distribution<int64_t> delay_us =
+      std::uniform_int_distribution<int64_t>(0, kMaximumDelay / 1us);
+  std::chrono::nanoseconds now = 0ns;
+  uint64_t expired             = 0;
+
+  void Reschedule(sjsu::TimerWheel::Timeout_t & timeout)
+  {
+    expired++;
+    wheel.Schedule(timeout, std::chrono::microseconds(delay_us(random)));
+  }
+};
+
+/// @return nanoseconds of host time per operation.
+double NanosecondsPer(std::chrono::steady_clock::duration elapsed,
+                      uint64_t operations)
+{
+  return static_cast<double>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                 .count()) /
+         static_cast<double>(operations);
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("Timer Wheel Benchmark Starting...");
+  sjsu::LogInfo("%zu active timeouts, %" PRId64 "us ticks",
+                kTimeouts,
+                static_cast<int64_t>(kResolution / 1us));
+
+  auto benchmark = std::make_unique<Benchmark_t>();
+  auto timeouts  = std::make_unique<sjsu::TimerWheel::Timeout_t[]>(kTimeouts);
+
+  // Run the wheel on simulated time, so the benchmark measures the wheel and
+  // not the host's clock.
+  sjsu::SetUptimeFunction([&benchmark]() { return benchmark->now; });
+
+  // Schedule
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kTimeouts; i++)
+  {
+    sjsu::TimerWheel::Timeout_t & timeout = timeouts[i];
+
+    timeout.callback = [&benchmark = *benchmark, &timeout]() {
+      benchmark.Reschedule(timeout);
+    };
+    const auto kDelay = benchmark->delay_us(benchmark->random);
+    benchmark->wheel.Schedule(timeout, std::chrono::microseconds(kDelay));
+  }
+  const auto kScheduleTime = std::chrono::steady_clock::now() - start;
+
+  // Advance
+  constexpr uint64_t kTicks = kRunTime / kResolution;
+  start                     = std::chrono::steady_clock::now();
+  for (uint64_t tick = 1; tick <= kTicks; tick++)
+  {
+    benchmark->now = tick * kResolution;
+    benchmark->wheel.Advance(benchmark->now);
+  }
+  const auto kAdvanceTime = std::chrono::steady_clock::now() - start;
+
+  // Cancel
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kTimeouts; i++)
+  {
+    benchmark->wheel.Cancel(timeouts[i]);
+  }
+  const auto kCancelTime = std::chrono::steady_clock::now() - start;
+
+  sjsu::SetUptimeFunction(nullptr);
+
+  sjsu::LogInfo("Schedule : %8.1f ns per timeout",
+                NanosecondsPer(kScheduleTime, kTimeouts));
+  sjsu::LogInfo("Cancel   : %8.1f ns per timeout",
+                NanosecondsPer(kCancelTime, kTimeouts));
+  sjsu::LogInfo("Advance  : %8.1f ns per tick, %" PRIu64 " expired in %" PRIu64
+                " ticks",
+                NanosecondsPer(kAdvanceTime, kTicks),
+                benchmark->expired,
+                kTicks);
+  sjsu::LogInfo("Expire   : %8.1f ns per expired timeout, including its "
+                "reschedule",
+                NanosecondsPer(kAdvanceTime, benchmark->expired));
+
+  return 0;
+}
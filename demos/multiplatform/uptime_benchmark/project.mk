@@ -0,0 +1 @@
+TESTS += $(LIBRARY_DIR)/utility/time/test/time_test.cpp
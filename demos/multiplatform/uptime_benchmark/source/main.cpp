@@ -0,0 +1,54 @@
+#include <cinttypes>
+#include <cstdint>
+
+#include "utility/log.hpp"
+#include "utility/time/time.hpp"
+
+namespace
+{
+/// Time spent calling each clock.
+constexpr auto kRunTime = 1s;
+
+/// Count the calls to a clock that fit in kRunTime. The loop is timed with
+/// the clock under test, so every iteration pays for exactly one call.
+///
+/// @param clock - clock to call.
+/// @return uint32_t - calls per second.
+template <typename Clock>
+uint32_t CallsPerSecond(Clock clock)
+{
+  uint32_t calls  = 1;
+  const auto kEnd = clock() + kRunTime;
+  while (clock() < kEnd)
+  {
+    calls++;
+  }
+  return static_cast<uint32_t>(calls / (kRunTime / 1s));
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("Uptime Benchmark Starting...");
+
+  // The clock as Uptime() used to be: a global std::function set to the
+  // platform's clock at startup.
+  sjsu::UptimeFunction legacy_uptime = sjsu::PlatformUptime;
+
+  const uint32_t kLegacyCalls = CallsPerSecond(legacy_uptime);
+  const uint32_t kUptimeCalls =
+      CallsPerSecond([]() { return sjsu::Uptime(); });
+
+  sjsu::LogInfo("std::function clock : %" PRIu32 " calls/s", kLegacyCalls);
+  sjsu::LogInfo("sjsu::Uptime()      : %" PRIu32 " calls/s", kUptimeCalls);
+
+  // An installed override is called through a std::function again.
+  sjsu::SetUptimeFunction(sjsu::PlatformUptime);
+  const uint32_t kOverrideCalls =
+      CallsPerSecond([]() { return sjsu::Uptime(); });
+  sjsu::SetUptimeFunction(nullptr);
+
+  sjsu::LogInfo("Uptime() overridden : %" PRIu32 " calls/s", kOverrideCalls);
+
+  return 0;
+}
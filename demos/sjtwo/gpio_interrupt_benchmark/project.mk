@@ -0,0 +1,3 @@
+
+TESTS += $(LIBRARY_DIR)/peripherals/lpc40xx/test/gpio_test.cpp
+PLATFORM = lpc40xx
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+
+#include "peripherals/cortex/dwt_counter.hpp"
+#include "peripherals/lpc40xx/gpio.hpp"
+#include "utility/log.hpp"
+#include "utility/time/time.hpp"
+
+// Raises 8 interrupt pins in a single write to the port's SET register, so all
+// 8 rising edges are latched at once, and measures the cycles from the write
+// until the last pin's handler has run, along with the number of times the
+// GPIO interrupt was entered to get there.
+//
+// The pins are driven as outputs, which still latch edges, so nothing needs to
+// be connected to P2[0] to P2[7].
+namespace
+{
+/// Number of pins toggled together.
+constexpr size_t kPins = 8;
+
+/// Pins P2[0] to P2[7].
+constexpr uint32_t kPinMask = (1 << kPins) - 1;
+
+/// Number of bursts to measure.
+constexpr size_t kBursts = 1'000;
+
+std::atomic<uint32_t> serviced_pins   = 0;
+std::atomic<uint32_t> handler_entries = 0;
+volatile uint32_t last_handler_cycle  = 0;
+
+uint32_t Cycles()
+{
+  return sjsu::cortex::DwtCounter::dwt->CYCCNT;
+}
+
+/// A plain function is called straight from the GPIO handler table.
+void PinHandler()
+{
+  last_handler_cycle = Cycles();
+  serviced_pins++;
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("GPIO Interrupt Benchmark Starting...");
+
+  std::array<sjsu::lpc40xx::Gpio, kPins> pins = {
+    sjsu::lpc40xx::Gpio(2, 0), sjsu::lpc40xx::Gpio(2, 1),
+    sjsu::lpc40xx::Gpio(2, 2), sjsu::lpc40xx::Gpio(2, 3),
+    sjsu::lpc40xx::Gpio(2, 4), sjsu::lpc40xx::Gpio(2, 5),
+    sjsu::lpc40xx::Gpio(2, 6), sjsu::lpc40xx::Gpio(2, 7),
+  };
+
+  for (auto & pin : pins)
+  {
+    pin.Initialize();
+    pin.SetAsOutput();
+    pin.SetLow();
+    pin.OnRisingEdge(PinHandler);
+  }
+
+  // Count the entries of the GPIO interrupt by wrapping its handler.
+  sjsu::InterruptController::GetPlatformController().Enable({
+      .interrupt_request_number = sjsu::lpc40xx::GPIO_IRQn,
+      .interrupt_handler =
+          []() {
+            handler_entries++;
+            sjsu::lpc40xx::Gpio::InterruptHandler();
+          },
+  });
+
+  auto * port = sjsu::lpc40xx::LPC_GPIO2;
+
+  uint32_t minimum = UINT32_MAX;
+  uint32_t maximum = 0;
+  uint64_t total   = 0;
+  for (size_t burst = 0; burst < kBursts; burst++)
+  {
+    serviced_pins   = 0;
+    handler_entries = 0;
+
+    const uint32_t kStart = Cycles();
+    port->SET             = kPinMask;
+    while (serviced_pins < kPins)
+    {
+      continue;
+    }
+    const uint32_t kCycles = last_handler_cycle - kStart;
+
+    minimum = std::min(minimum, kCycles);
+    maximum = std::max(maximum, kCycles);
+    total += kCycles;
+
+    if (handler_entries != 1)
+    {
+      sjsu::LogWarning("Burst %zu took %" PRIu32 " interrupt entries",
+                       burst,
+                       handler_entries.load());
+    }
+
+    port->CLR = kPinMask;
+    sjsu::Delay(1ms);
+  }
+
+  sjsu::LogInfo("Cycles to service %zu simultaneous edges:", kPins);
+  sjsu::LogInfo("  minimum : %" PRIu32, minimum);
+  sjsu::LogInfo("  average : %" PRIu32, static_cast<uint32_t>(total / kBursts));
+  sjsu::LogInfo("  maximum : %" PRIu32, maximum);
+
+  sjsu::Halt();
+  return 0;
+}
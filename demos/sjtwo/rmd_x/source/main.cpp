@@ -11,8 +11,7 @@ int main(void)
 
   sjsu::LogInfo("Starting RMD-X demo in 5s...");
   sjsu::lpc40xx::Can & can = sjsu::lpc40xx::GetCan<2>();
-  sjsu::StaticMemoryResource<1024> memory_resource;
-  sjsu::CanNetwork can_network(can, &memory_resource);
+  sjsu::CanNetwork can_network(can);
   sjsu::RmdX rmd_x7(can_network, 0x148);
 
   sjsu::Delay(5s);
@@ -0,0 +1 @@
+PLATFORM = lpc40xx
@@ -0,0 +1,125 @@
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "utility/log.hpp"
+#include "utility/rtos/freertos/rtos.hpp"
+#include "utility/time/time.hpp"
+
+// Several tasks wait in a loop, the way drivers wait on their timeouts. The
+// monitor measures how much of the CPU is left for the idle task, first with
+// the waits spinning, as every wait did before the scheduler hooks, then with
+// sjsu::Delay(), which sleeps through the whole ticks of the wait.
+namespace
+{
+/// Number of tasks that wait in a loop.
+constexpr size_t kWaitingTasks = 3;
+
+/// Duration of each wait.
+constexpr auto kWaitTime = 5ms;
+
+/// Length of each measurement.
+constexpr auto kMeasurementTime = 2s;
+
+/// Set by the monitor to make the waiting tasks spin.
+std::atomic<bool> spin = true;
+
+void WaitingTask([[maybe_unused]] void * parameters)
+{
+  while (true)
+  {
+    if (spin)
+    {
+      sjsu::Wait(kWaitTime, []() { return false; });
+    }
+    else
+    {
+      sjsu::Delay(kWaitTime);
+    }
+  }
+}
+
+/// @return the run time counter of the idle task and the total run time.
+std::pair<uint32_t, uint32_t> IdleRunTime()
+{
+  std::array<TaskStatus_t, kWaitingTasks + 4> tasks;
+  uint32_t total_run_time = 0;
+  UBaseType_t count =
+      uxTaskGetSystemState(tasks.data(), tasks.size(), &total_run_time);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    if (strcmp(tasks[i].pcTaskName, "IDLE") == 0)
+    {
+      return { tasks[i].ulRunTimeCounter, total_run_time };
+    }
+  }
+  return { 0, total_run_time };
+}
+
+/// @return the percentage of the CPU used by the idle task over the
+///         measurement.
+uint32_t MeasureIdlePercent()
+{
+  auto [idle_start, total_start] = IdleRunTime();
+  vTaskDelay(kMeasurementTime / 1ms);
+  auto [idle_end, total_end] = IdleRunTime();
+
+  const uint64_t kIdle  = idle_end - idle_start;
+  const uint64_t kTotal = total_end - total_start;
+  return (kTotal == 0) ? 0 : static_cast<uint32_t>((kIdle * 100) / kTotal);
+}
+
+void MonitorTask([[maybe_unused]] void * parameters)
+{
+  while (true)
+  {
+    spin                         = true;
+    const uint32_t kSpinningIdle = MeasureIdlePercent();
+    spin                         = false;
+    const uint32_t kSleepingIdle = MeasureIdlePercent();
+
+    sjsu::LogInfo("Idle CPU with spinning waits : %3" PRIu32 "%%",
+                  kSpinningIdle);
+    sjsu::LogInfo("Idle CPU with sleeping waits : %3" PRIu32 "%%",
+                  kSleepingIdle);
+    sjsu::LogInfo("Recovered for other tasks    : %3" PRId32 "%%",
+                  static_cast<int32_t>(kSleepingIdle - kSpinningIdle));
+  }
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("RTOS Wait Idle Time Example Starting...");
+  sjsu::LogInfo("%zu tasks wait %" PRId64 "ms in a loop.",
+                kWaitingTasks,
+                static_cast<int64_t>(kWaitTime / 1ms));
+
+  for (size_t i = 0; i < kWaitingTasks; i++)
+  {
+    xTaskCreate(WaitingTask,
+                "Waiting",
+                sjsu::rtos::StackSize(512),
+                sjsu::rtos::kNoParameter,
+                sjsu::rtos::Priority::kLow,
+                sjsu::rtos::kNoHandle);
+  }
+
+  xTaskCreate(MonitorTask,
+              "Monitor",
+              sjsu::rtos::StackSize(1024),
+              sjsu::rtos::kNoParameter,
+              sjsu::rtos::Priority::kHigh,
+              sjsu::rtos::kNoHandle);
+
+  sjsu::LogInfo("Starting Scheduler...");
+  vTaskStartScheduler();
+  return 0;
+}
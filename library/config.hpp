@@ -165,12 +165,75 @@ SJ2_DECLARE_CONSTANT(INCLUDE_VSNPRINTF, bool, kIncludeVsnprintf);
 /// Delcare Constant BACKTRACE_ADDRESS_OFFSET
 SJ2_DECLARE_CONSTANT(BACKTRACE_ADDRESS_OFFSET, size_t, kBacktraceAddressOffset);
 
+/// Used to time every interrupt handler dispatched by the Cortex M interrupt
+/// controller, see cortex::InterruptProfiler. Costs two reads of the DWT cycle
+/// counter and a few dozen cycles per interrupt, plus 40 bytes of RAM per
+/// interrupt vector.
+#if !defined(SJ2_ENABLE_INTERRUPT_PROFILER)
+#define SJ2_ENABLE_INTERRUPT_PROFILER false
+#endif  // !defined(SJ2_ENABLE_INTERRUPT_PROFILER)
+/// Delcare Constant ENABLE_INTERRUPT_PROFILER
+SJ2_DECLARE_CONSTANT(ENABLE_INTERRUPT_PROFILER,
+                     bool,
+                     kEnableInterruptProfiler);
+
+/// Used to record FreeRTOS scheduling and queue events, along with every
+/// interrupt dispatched by the Cortex M interrupt controller, into the platform
+/// rtos::TraceRecorder. Unlike the other options, this must be defined on the
+/// compiler command line (for example `-D SJ2_ENABLE_RTOS_TRACE=1` in CFLAGS),
+/// because FreeRTOS's C sources need to see it too.
+#if !defined(SJ2_ENABLE_RTOS_TRACE)
+#define SJ2_ENABLE_RTOS_TRACE false
+#endif  // !defined(SJ2_ENABLE_RTOS_TRACE)
+/// Delcare Constant ENABLE_RTOS_TRACE
+SJ2_DECLARE_CONSTANT(ENABLE_RTOS_TRACE, bool, kEnableRtosTrace);
+
+/// Used to set the number of work items a DeferredWork queue can hold. Must be
+/// a power of two.
+#if !defined(SJ2_DEFERRED_WORK_QUEUE_SIZE)
+#define SJ2_DEFERRED_WORK_QUEUE_SIZE 32
+#endif  // !defined(SJ2_DEFERRED_WORK_QUEUE_SIZE)
+/// Delcare Constant DEFERRED_WORK_QUEUE_SIZE
+SJ2_DECLARE_CONSTANT(DEFERRED_WORK_QUEUE_SIZE, size_t, kDeferredWorkQueueSize);
+
 /// Used to set the default scheduler size for the TaskScheduler.
 #if !defined(SJ2_TASK_SCHEDULER_SIZE)
 #define SJ2_TASK_SCHEDULER_SIZE 16
 #endif  // !defined(SJ2_TASK_SCHEDULER_SIZE)
 /// Delcare Constant TASK_SCHEDULER_SIZE
-SJ2_DECLARE_CONSTANT(TASK_SCHEDULER_SIZE, uint8_t, kTaskSchedulerSize);
+SJ2_DECLARE_CONSTANT(TASK_SCHEDULER_SIZE, size_t, kTaskSchedulerSize);
+
+/// Used to set the number of message IDs that a CanNetwork can capture. Each
+/// captured ID costs roughly two slots of the network's lookup table.
+#if !defined(SJ2_CAN_NETWORK_CAPACITY)
+#define SJ2_CAN_NETWORK_CAPACITY 32
+#endif  // !defined(SJ2_CAN_NETWORK_CAPACITY)
+/// Delcare Constant CAN_NETWORK_CAPACITY
+SJ2_DECLARE_CONSTANT(CAN_NETWORK_CAPACITY, size_t, kCanNetworkCapacity);
+static_assert(1 <= kCanNetworkCapacity && kCanNetworkCapacity <= 2048,
+              "The CanNetwork capacity is limited to between 1 and 2048.");
+
+/// Used to set the number of messages each CAN peripheral can hold in its
+/// software transmit queue while its hardware transmit buffers are busy.
+#if !defined(SJ2_CAN_TRANSMIT_QUEUE_SIZE)
+#define SJ2_CAN_TRANSMIT_QUEUE_SIZE 8
+#endif  // !defined(SJ2_CAN_TRANSMIT_QUEUE_SIZE)
+/// Delcare Constant CAN_TRANSMIT_QUEUE_SIZE
+SJ2_DECLARE_CONSTANT(CAN_TRANSMIT_QUEUE_SIZE, size_t, kCanTransmitQueueSize);
+static_assert(1 <= kCanTransmitQueueSize && kCanTransmitQueueSize <= 256,
+              "The CAN transmit queue size is limited to between 1 and 256.");
+
+/// Used to set the number of received messages each CAN peripheral can hold
+/// in its receive queue before it starts dropping messages. Must be a power of
+/// two.
+#if !defined(SJ2_CAN_RECEIVE_QUEUE_SIZE)
+#define SJ2_CAN_RECEIVE_QUEUE_SIZE 16
+#endif  // !defined(SJ2_CAN_RECEIVE_QUEUE_SIZE)
+/// Delcare Constant CAN_RECEIVE_QUEUE_SIZE
+SJ2_DECLARE_CONSTANT(CAN_RECEIVE_QUEUE_SIZE, size_t, kCanReceiveQueueSize);
+static_assert((kCanReceiveQueueSize & (kCanReceiveQueueSize - 1)) == 0 &&
+                  kCanReceiveQueueSize >= 2,
+              "The CAN receive queue size must be a power of two.");
 
 /// Used to set the receiver buffer size of the ESP8266 driver
 #if !defined(SJ2_ESP8266_BUFFER_SIZE)
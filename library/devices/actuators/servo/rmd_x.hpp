@@ -43,6 +43,12 @@ struct RmdXSettings_t
 class RmdX : public sjsu::Module<RmdXSettings_t>
 {
  public:
+  /// Torque current command value that corresponds to kMaximumTorqueCurrent.
+  static constexpr int16_t kMaximumTorqueCommand = 2000;
+
+  /// Largest torque current that can be commanded.
+  static constexpr units::current::ampere_t kMaximumTorqueCurrent = 32_A;
+
   /// Defines the set of encoder bit resolutions available for the RMD-X line of
   /// smart servos.
   enum class EncoderBitWidth
@@ -102,6 +108,8 @@ class RmdX : public sjsu::Module<RmdXSettings_t>
     /// When true, indicates that an attempt to read the feedback from the motor
     /// failed.
     bool missed_feedback = true;
+    /// Time the last reply from the motor was received.
+    std::chrono::nanoseconds timestamp = 0ns;
 
     /// Print out motor feedback information
     void Print()
@@ -140,6 +148,7 @@ class RmdX : public sjsu::Module<RmdXSettings_t>
     network_.CanBus().settings.baud_rate = settings.can_baudrate;
     network_.Initialize();
     node_ = network_.CaptureMessage(device_id_);
+    last_update_count_ = node_->UpdateCount();
 
     network_.CanBus().Send(device_id_,
                            { Value(Commands::kMotorOffCommand),
@@ -176,6 +185,30 @@ class RmdX : public sjsu::Module<RmdXSettings_t>
     return *this;
   }
 
+  /// Set the torque current of the motor.
+  ///
+  /// @param current - desired current through the motor windings. Can be
+  ///        negative to change the direction of the torque.
+  /// @return RmdX& - reference to self to allow method chaining
+  RmdX & SetTorqueCurrent(units::current::ampere_t current)
+  {
+    int16_t command_current = ConvertCurrentToCommandCurrent(current);
+    network_.CanBus().Send(
+        device_id_,
+        {
+            Value(Commands::kTorqueClosedLoopCommand),
+            0x00,
+            0x00,
+            0x00,
+            static_cast<uint8_t>((command_current >> 0) & 0xFF),
+            static_cast<uint8_t>((command_current >> 8) & 0xFF),
+            0x00,
+            0x00,
+        });
+
+    return *this;
+  }
+
   /// Set the angle of the motor's output shaft.
   ///
   /// @param angle - angle to move motor output shaft to.
@@ -248,13 +281,45 @@ class RmdX : public sjsu::Module<RmdXSettings_t>
     return *this;
   }
 
+  /// Parse the latest reply captured from the motor without waiting for one.
+  /// Every command the motor acknowledges is answered with feedback, so this
+  /// can be used to gather feedback after SetSpeed(), SetAngle() or
+  /// SetTorqueCurrent() without blocking.
+  ///
+  /// @return true - if a new reply has arrived since the last call.
+  bool CollectFeedback()
+  {
+    const int kUpdateCount = node_->UpdateCount();
+    if (kUpdateCount == last_update_count_)
+    {
+      return false;
+    }
+    last_update_count_ = kUpdateCount;
+
+    if (!ResponseHandler(node_->SecureGet()))
+    {
+      return false;
+    }
+
+    feedback_.missed_feedback = false;
+    return true;
+  }
+
   /// @return Feedback_t - copy of the motor feedback.
   Feedback_t GetFeedback() const
   {
     return feedback_;
   }
 
+  /// @return uint16_t - CAN ID of the motor.
+  uint16_t DeviceId() const
+  {
+    return device_id_;
+  }
+
  private:
+  friend class RmdXGroup;
+
   bool ResponseHandler(const Can::Message_t & message)
   {
     if (!(message.length == 8 && message.id == device_id_))
@@ -323,6 +388,7 @@ class RmdX : public sjsu::Module<RmdXSettings_t>
       default: return false;
     }
 
+    feedback_.timestamp = (message.uptime != 0ns) ? message.uptime : Uptime();
     return true;
   }
 
@@ -386,6 +452,17 @@ class RmdX : public sjsu::Module<RmdXSettings_t>
     return scaled_dps.to<int32_t>();
   }
 
+  static int16_t ConvertCurrentToCommandCurrent(
+      units::current::ampere_t current)
+  {
+    constexpr float kScale =
+        kMaximumTorqueCommand / kMaximumTorqueCurrent.to<float>();
+    float command = std::clamp(current.to<float>() * kScale,
+                               -static_cast<float>(kMaximumTorqueCommand),
+                               static_cast<float>(kMaximumTorqueCommand));
+    return static_cast<int16_t>(command);
+  }
+
   int32_t ConvertAngleToCommandAngle(units::angle::degree_t angle,
                                      float degree_to_int_ratio = 0.01f)
   {
@@ -406,5 +483,6 @@ class RmdX : public sjsu::Module<RmdXSettings_t>
   const uint16_t device_id_;
   Feedback_t feedback_;
   sjsu::CanNetwork::Node_t * node_;
+  int last_update_count_ = 0;
 };
 }  // namespace sjsu
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <chrono>
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "devices/actuators/servo/rmd_x.hpp"
+#include "peripherals/can.hpp"
+#include "utility/error_handling.hpp"
+#include "utility/math/units.hpp"
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+/// Commands a group of RMD-X motors on the same CAN bus as one unit. Commands
+/// for every motor are sent back to back and the replies are gathered from the
+/// motors' CanNetwork capture nodes as they arrive, rather than waiting for
+/// each motor's reply before commanding the next one.
+///
+/// When the group holds all four of motors 0x141 to 0x144, their torque
+/// commands are combined into a single multi-motor command frame, so
+/// commanding all four costs one frame.
+class RmdXGroup
+{
+ public:
+  /// Maximum number of motors in a group.
+  static constexpr size_t kMaximumMotors = 8;
+
+  /// CAN ID of the multi-motor torque command.
+  static constexpr uint16_t kMultiMotorCommandId = 0x280;
+
+  /// ID of the motor that takes the first two bytes of the multi-motor
+  /// command. The next three IDs take the rest.
+  static constexpr uint16_t kFirstMultiMotorId = 0x141;
+
+  /// Number of motors addressed by the multi-motor command.
+  static constexpr size_t kMultiMotorSlots = 4;
+
+  /// Freshness of a motor's feedback.
+  struct Status_t
+  {
+    /// True if the motor has replied to the last command sent to the group.
+    bool fresh;
+
+    /// Time since the motor's last reply. std::chrono::nanoseconds::max() if
+    /// the motor has never replied.
+    std::chrono::nanoseconds age;
+  };
+
+  /// @param network - CAN network the motors are attached to.
+  explicit RmdXGroup(CanNetwork & network) : network_(network) {}
+
+  /// Add a motor to the group. Motors are indexed in the order they are added.
+  ///
+  /// @param motor - initialized motor on the group's network.
+  /// @return RmdXGroup& - reference to self to allow method chaining
+  /// @throw std::errc::not_enough_memory if the group already has
+  ///        kMaximumMotors motors.
+  RmdXGroup & Add(RmdX & motor)
+  {
+    if (motor_count_ >= kMaximumMotors)
+    {
+      throw Exception(std::errc::not_enough_memory,
+                      "RmdXGroup cannot hold any more motors.");
+    }
+    motors_[motor_count_++] = &motor;
+    return *this;
+  }
+
+  /// Set the torque current of every motor.
+  ///
+  /// @param currents - one current per motor, in the order they were added.
+  /// @throw std::errc::invalid_argument if there is not one current per motor.
+  void SetTorqueCurrents(std::span<const units::current::ampere_t> currents)
+  {
+    StartCycle(currents.size());
+
+    uint32_t owned_slots = 0;
+    for (auto * motor : Motors())
+    {
+      const size_t kSlot = MultiMotorSlot(*motor);
+      if (kSlot < kMultiMotorSlots)
+      {
+        owned_slots |= 1U << kSlot;
+      }
+    }
+
+    // The multi-motor command sets the current of every slot, so it would
+    // command any slot's motor outside of the group to zero current.
+    const bool kUseMultiMotorCommand =
+        owned_slots == (1U << kMultiMotorSlots) - 1;
+
+    if (kUseMultiMotorCommand)
+    {
+      std::array<uint8_t, 8> payload = {};
+      for (size_t i = 0; i < motor_count_; i++)
+      {
+        const size_t kSlot = MultiMotorSlot(*motors_[i]);
+        if (kSlot < kMultiMotorSlots)
+        {
+          int16_t command = RmdX::ConvertCurrentToCommandCurrent(currents[i]);
+          payload[kSlot * 2]     = static_cast<uint8_t>(command & 0xFF);
+          payload[kSlot * 2 + 1] = static_cast<uint8_t>((command >> 8) & 0xFF);
+        }
+      }
+      network_.CanBus().Send(kMultiMotorCommandId, payload);
+    }
+
+    for (size_t i = 0; i < motor_count_; i++)
+    {
+      if (!kUseMultiMotorCommand ||
+          MultiMotorSlot(*motors_[i]) >= kMultiMotorSlots)
+      {
+        motors_[i]->SetTorqueCurrent(currents[i]);
+      }
+    }
+  }
+
+  /// Set the rotational speed of every motor.
+  ///
+  /// @param speeds - one speed per motor, in the order they were added.
+  /// @throw std::errc::invalid_argument if there is not one speed per motor.
+  void SetSpeeds(
+      std::span<const units::angular_velocity::revolutions_per_minute_t> speeds)
+  {
+    StartCycle(speeds.size());
+    for (size_t i = 0; i < motor_count_; i++)
+    {
+      motors_[i]->SetSpeed(speeds[i]);
+    }
+  }
+
+  /// Set the angle of every motor's output shaft.
+  ///
+  /// @param angles - one angle per motor, in the order they were added.
+  /// @param rpm - speed to move each motor at.
+  /// @throw std::errc::invalid_argument if there is not one angle per motor.
+  void SetAngles(std::span<const units::angle::degree_t> angles,
+                 units::angular_velocity::revolutions_per_minute_t rpm = 10_rpm)
+  {
+    StartCycle(angles.size());
+    for (size_t i = 0; i < motor_count_; i++)
+    {
+      motors_[i]->SetAngle(angles[i], rpm);
+    }
+  }
+
+  /// Parse any replies that have arrived since the last command, without
+  /// waiting.
+  ///
+  /// @return size_t - number of motors that have replied to the last command.
+  size_t CollectFeedback()
+  {
+    size_t replies = 0;
+    for (size_t i = 0; i < motor_count_; i++)
+    {
+      if (!replied_[i])
+      {
+        replied_[i] = motors_[i]->CollectFeedback();
+      }
+      replies += replied_[i];
+    }
+    return replies;
+  }
+
+  /// Wait for every motor to reply to the last command.
+  ///
+  /// @param timeout - maximum time to wait for the replies.
+  /// @return true - if every motor replied in time.
+  bool WaitForFeedback(std::chrono::nanoseconds timeout)
+  {
+    return Wait(timeout,
+                [this]() { return CollectFeedback() == motor_count_; });
+  }
+
+  /// @param index - index of the motor in the group.
+  /// @return Status_t - freshness of the motor's feedback.
+  Status_t GetStatus(size_t index) const
+  {
+    const auto kTimestamp = motors_[index]->GetFeedback().timestamp;
+    return {
+      .fresh = replied_[index],
+      .age   = (kTimestamp == 0ns) ? std::chrono::nanoseconds::max()
+                                   : Now() - kTimestamp,
+    };
+  }
+
+  /// @param index - index of the motor in the group.
+  /// @return RmdX& - the motor.
+  RmdX & operator[](size_t index)
+  {
+    return *motors_[index];
+  }
+
+  /// @return size_t - number of motors in the group.
+  size_t Size() const
+  {
+    return motor_count_;
+  }
+
+ private:
+  std::span<RmdX * const> Motors() const
+  {
+    return std::span(motors_).first(motor_count_);
+  }
+
+  /// @return std::chrono::nanoseconds - current time on the clock the CAN
+  ///         peripheral stamps received messages with. Falls back to Uptime()
+  ///         when messages are not stamped, as RmdX does for their feedback.
+  std::chrono::nanoseconds Now() const
+  {
+    const auto kTimestamp = network_.CanBus().CurrentSettings().timestamp;
+    return (kTimestamp != nullptr) ? kTimestamp() : Uptime();
+  }
+
+  static size_t MultiMotorSlot(const RmdX & motor)
+  {
+    // IDs below the first slot wrap around to a large value.
+    return static_cast<uint16_t>(motor.DeviceId() - kFirstMultiMotorId);
+  }
+
+  void StartCycle(size_t command_count)
+  {
+    if (command_count != motor_count_)
+    {
+      throw Exception(std::errc::invalid_argument,
+                      "RmdXGroup needs exactly one command per motor.");
+    }
+
+    // Consume replies to earlier commands so they are not mistaken for
+    // replies to this one.
+    for (size_t i = 0; i < motor_count_; i++)
+    {
+      motors_[i]->CollectFeedback();
+      replied_[i] = false;
+    }
+  }
+
+  CanNetwork & network_;
+  std::array<RmdX *, kMaximumMotors> motors_ = {};
+  std::array<bool, kMaximumMotors> replied_  = {};
+  size_t motor_count_                        = 0;
+};
+}  // namespace sjsu
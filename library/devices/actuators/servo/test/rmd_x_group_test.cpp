@@ -0,0 +1,169 @@
+#include <array>
+
+#include "devices/actuators/servo/rmd_x_group.hpp"
+#include "peripherals/linux/virtual_can.hpp"
+#include "testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing RmdXGroup")
+{
+  VirtualCanBus bus(1_MHz);
+  VirtualCan controller_can(bus);
+  VirtualCan motors_can(bus);
+  SetUptimeFunction([&bus]() { return bus.Now(); });
+  static VirtualCan * timestamp_source;
+  timestamp_source                  = &controller_can;
+  controller_can.settings.timestamp = []() { return timestamp_source->Now(); };
+
+  // Simulate the motors: every torque, speed or position command is answered
+  // with feedback from the motor it addressed.
+  std::array<uint8_t, 8> multi_motor_command = {};
+  motors_can.settings.handler = [&multi_motor_command](Can & can) {
+    auto command = can.Receive();
+    auto reply   = [&can](uint32_t id, uint8_t command_byte) {
+      can.Send(id, { command_byte, 30, 0, 0, 0, 0, 0, 0 });
+    };
+
+    if (command.id == RmdXGroup::kMultiMotorCommandId)
+    {
+      multi_motor_command = command.payload;
+      for (uint32_t slot = 0; slot < RmdXGroup::kMultiMotorSlots; slot++)
+      {
+        reply(RmdXGroup::kFirstMultiMotorId + slot, 0xA1);
+      }
+    }
+    else if (command.payload[0] >= 0xA1 && command.payload[0] <= 0xA6)
+    {
+      reply(command.id, command.payload[0]);
+    }
+  };
+  motors_can.Initialize();
+
+  CanNetwork network(controller_can);
+  RmdX motor1(network, 0x141);
+  RmdX motor2(network, 0x142);
+  RmdX motor3(network, 0x145);
+  motor1.Initialize();
+  motor2.Initialize();
+  motor3.Initialize();
+  bus.RunUntilIdle();
+  bus.ResetStatistics();
+
+  RmdXGroup group(network);
+  group.Add(motor1).Add(motor2).Add(motor3);
+
+  SECTION("Torque command is sent per motor unless the group has every slot")
+  {
+    // Setup
+    std::array<units::current::ampere_t, 3> currents = { 1_A, -2_A, 3_A };
+
+    // Exercise
+    group.SetTorqueCurrents(currents);
+
+    // Verify: Nothing has replied before the bus runs
+    CHECK(0 == group.CollectFeedback());
+    CHECK(!group.GetStatus(0).fresh);
+    CHECK(std::chrono::nanoseconds::max() == group.GetStatus(0).age);
+
+    // Exercise
+    bus.RunUntilIdle();
+
+    // Verify: No multi-motor frame, as it would command motors 0x143 and
+    //         0x144 to zero current, so one command and one reply per motor
+    CHECK(3 == group.CollectFeedback());
+    CHECK(2 * 3 == bus.GetStatistics().frames);
+    CHECK(std::array<uint8_t, 8>{} == multi_motor_command);
+    CHECK(30 == doctest::Approx(motor3.GetFeedback().temperature.to<float>()));
+    CHECK(!motor3.GetFeedback().missed_feedback);
+
+    for (size_t i = 0; i < group.Size(); i++)
+    {
+      CHECK(group.GetStatus(i).fresh);
+      CHECK(0ns <= group.GetStatus(i).age);
+      CHECK(bus.Now() >= group.GetStatus(i).age);
+    }
+  }
+
+  SECTION("Torque command uses the multi-motor command for every slot")
+  {
+    // Setup
+    RmdX motor4(network, 0x143);
+    RmdX motor5(network, 0x144);
+    motor4.Initialize();
+    motor5.Initialize();
+    bus.RunUntilIdle();
+    bus.ResetStatistics();
+    group.Add(motor4).Add(motor5);
+    std::array<units::current::ampere_t, 5> currents = {
+      1_A, -2_A, 3_A, 1_A, 0_A
+    };
+
+    // Exercise
+    group.SetTorqueCurrents(currents);
+    bus.RunUntilIdle();
+
+    // Verify: One multi-motor frame, one frame for motor 3 and a reply from
+    //         every simulated motor
+    CHECK(5 == group.CollectFeedback());
+    CHECK(2 + RmdXGroup::kMultiMotorSlots + 1 == bus.GetStatistics().frames);
+    CHECK(62 == static_cast<int16_t>(multi_motor_command[0] |
+                                     multi_motor_command[1] << 8));
+    CHECK(-125 == static_cast<int16_t>(multi_motor_command[2] |
+                                       multi_motor_command[3] << 8));
+    CHECK(62 == static_cast<int16_t>(multi_motor_command[4] |
+                                     multi_motor_command[5] << 8));
+    CHECK(0 == multi_motor_command[6]);
+    CHECK(0 == multi_motor_command[7]);
+  }
+
+  SECTION("Freshness resets on the next command")
+  {
+    // Setup
+    std::array<units::angular_velocity::revolutions_per_minute_t, 3> speeds = {
+      10_rpm, 20_rpm, 30_rpm
+    };
+    group.SetSpeeds(speeds);
+    bus.RunUntilIdle();
+    CHECK(group.WaitForFeedback(1ms));
+
+    // Exercise
+    group.SetSpeeds(speeds);
+
+    // Verify
+    CHECK(!group.GetStatus(0).fresh);
+    CHECK(0ns < group.GetStatus(0).age);
+    CHECK(0 == group.CollectFeedback());
+  }
+
+  SECTION("Age is measured on the CAN peripheral's clock")
+  {
+    // Setup: Uptime() runs an hour ahead of the CAN peripheral's clock
+    std::array<units::angular_velocity::revolutions_per_minute_t, 3> speeds = {
+      10_rpm, 20_rpm, 30_rpm
+    };
+    group.SetSpeeds(speeds);
+    bus.RunUntilIdle();
+    CHECK(group.WaitForFeedback(1ms));
+    SetUptimeFunction([&bus]() { return bus.Now() + 1h; });
+
+    // Exercise
+    auto status = group.GetStatus(0);
+
+    // Verify
+    CHECK(0ns <= status.age);
+    CHECK(1ms > status.age);
+  }
+
+  SECTION("Needs one command per motor")
+  {
+    // Setup
+    std::array<units::angle::degree_t, 2> angles = { 0_deg, 0_deg };
+
+    // Exercise + Verify
+    SJ2_CHECK_EXCEPTION(group.SetAngles(angles), std::errc::invalid_argument);
+  }
+
+  SetUptimeFunction(DefaultUptime);
+}
+}  // namespace sjsu
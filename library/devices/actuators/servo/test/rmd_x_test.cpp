@@ -10,12 +10,12 @@ TEST_CASE("Testing RMD-X7")
   Mock<Can> mock_can;
 
   Fake(Method(mock_can, Can::ModuleInitialize));
+  Fake(Method(mock_can, Can::ConfigureAcceptanceFilter));
   Fake(OverloadedMethod(mock_can, Can::Send, void(const Can::Message_t &)));
-  Fake(Method(mock_can, Can::Receive));
+  Fake(OverloadedMethod(mock_can, Can::Receive, Can::Message_t()));
   Fake(Method(mock_can, Can::HasData));
 
-  StaticMemoryResource<1024> memory_resource;
-  CanNetwork network(mock_can.get(), &memory_resource);
+  CanNetwork network(mock_can.get());
 
   constexpr auto kId = 0x140;
 
@@ -0,0 +1,689 @@
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+
+#include "peripherals/can.hpp"
+#include "peripherals/storage.hpp"
+#include "utility/error_handling.hpp"
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+/// Layout of the binary CAN log written by CanRecorder and read by
+/// CanLogReader.
+///
+/// The log starts with a 16 byte header: the 8 character signature, followed
+/// by the format version and reserved space, both 32-bit little endian.
+///
+/// Every frame is then stored as a variable length record:
+///
+///     Bytes 0-3: microseconds since the previous frame (little endian)
+///     Bytes 4-7: frame ID (little endian), bit 30 is set for remote requests
+///                and bit 31 for extended IDs
+///     Byte  8  : payload length
+///     Bytes 9- : payload, only `length` bytes are stored
+///
+/// A record with a length of kEndOfLog marks the end of the log. The rest of
+/// the last sector is filled with kEndOfLog so erased flash and partial
+/// sectors are also read as the end of the log.
+struct CanLogFormat
+{
+  /// Bytes at the start of every log
+  static constexpr std::array<char, 8> kSignature = {
+    'S', 'J', '2', 'C', 'A', 'N', 'L', 'G'
+  };
+
+  /// Version of the record layout
+  static constexpr uint32_t kVersion = 1;
+
+  /// Size of the log header
+  static constexpr size_t kHeaderSize = 16;
+
+  /// Size of a record without its payload
+  static constexpr size_t kRecordHeaderSize = 9;
+
+  /// Size of a record with a full payload
+  static constexpr size_t kMaximumRecordSize = kRecordHeaderSize + 8;
+
+  /// Length value that marks the end of the log
+  static constexpr uint8_t kEndOfLog = 0xFF;
+
+  /// Size of the blocks the log is written and read in. Matches the sector
+  /// size of SD cards and FatFS.
+  static constexpr size_t kSectorSize = 512;
+
+  /// ID bit set for remote request frames
+  static constexpr uint32_t kRemoteRequestFlag = 1UL << 30;
+
+  /// ID bit set for extended frames
+  static constexpr uint32_t kExtendedFlag = 1UL << 31;
+
+  /// @param message - frame to store.
+  /// @param delta - time since the previous frame.
+  /// @param record - buffer of at least kMaximumRecordSize bytes.
+  /// @return size_t - number of bytes of the record.
+  static size_t EncodeRecord(const Can::Message_t & message,
+                             std::chrono::nanoseconds delta,
+                             std::span<uint8_t> record)
+  {
+    const auto kMicroseconds = std::clamp<int64_t>(
+        delta / 1us, 0, std::numeric_limits<uint32_t>::max());
+    const uint8_t kLength = std::min<uint8_t>(message.length, 8);
+
+    uint32_t id = message.id;
+    if (message.is_remote_request)
+    {
+      id |= kRemoteRequestFlag;
+    }
+    if (message.format == Can::Message_t::Format::kExtended)
+    {
+      id |= kExtendedFlag;
+    }
+
+    StoreWord(record.subspan(0), static_cast<uint32_t>(kMicroseconds));
+    StoreWord(record.subspan(4), id);
+    record[8] = kLength;
+    std::copy_n(message.payload.begin(), kLength, record.begin() + 9);
+
+    return kRecordHeaderSize + kLength;
+  }
+
+  /// @param destination - where to store the value, at least 4 bytes.
+  /// @param value - value to store as little endian.
+  static void StoreWord(std::span<uint8_t> destination, uint32_t value)
+  {
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+      destination[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+  }
+
+  /// @param source - little endian value, at least 4 bytes.
+  /// @return uint32_t - the value.
+  static uint32_t LoadWord(std::span<const uint8_t> source)
+  {
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+      value |= static_cast<uint32_t>(source[i]) << (i * 8);
+    }
+    return value;
+  }
+};
+
+/// Destination of a CAN log. Always written one whole sector at a time.
+class CanLogSink
+{
+ public:
+  /// @param sector - the next CanLogFormat::kSectorSize bytes of the log.
+  virtual void Write(std::span<const uint8_t> sector) = 0;
+};
+
+/// Source of a CAN log. Always read one whole sector at a time.
+class CanLogSource
+{
+ public:
+  /// @param sector - buffer for the next CanLogFormat::kSectorSize bytes of the
+  ///        log.
+  /// @return size_t - number of bytes read, less than a sector at the end of
+  ///         the log.
+  virtual size_t Read(std::span<uint8_t> sector) = 0;
+};
+
+/// Stores a CAN log in consecutive blocks of a storage device, without a
+/// file system.
+class StorageCanLogSink : public CanLogSink
+{
+ public:
+  /// @param storage - initialized storage device.
+  /// @param first_block - block address to start writing the log at.
+  /// @throw std::errc::invalid_argument if the storage's block size does not
+  ///        divide the sector size.
+  explicit StorageCanLogSink(Storage & storage, uint32_t first_block = 0)
+      : storage_(storage),
+        address_(first_block),
+        blocks_per_sector_(BlocksPerSector(storage)),
+        end_address_(EndAddress(storage))
+  {
+  }
+
+  /// @throw std::errc::no_space_on_device if the log has reached the end of
+  ///        the storage device.
+  void Write(std::span<const uint8_t> sector) override
+  {
+    if (address_ + blocks_per_sector_ > end_address_)
+    {
+      throw Exception(std::errc::no_space_on_device,
+                      "CAN log has reached the end of the storage device.");
+    }
+
+    storage_.Erase(address_, blocks_per_sector_);
+    storage_.Write(address_, sector);
+    address_ += blocks_per_sector_;
+  }
+
+  /// @param storage - storage device holding the log.
+  /// @return uint32_t - number of storage blocks in a log sector.
+  static uint32_t BlocksPerSector(Storage & storage)
+  {
+    const auto kBlockSize = storage.GetBlockSize().to<uint32_t>();
+    if (kBlockSize == 0 || CanLogFormat::kSectorSize % kBlockSize != 0)
+    {
+      throw Exception(
+          std::errc::invalid_argument,
+          "Storage block size must divide the CAN log sector size.");
+    }
+    return CanLogFormat::kSectorSize / kBlockSize;
+  }
+
+  /// @param storage - storage device holding the log.
+  /// @return uint32_t - number of blocks of the storage device.
+  static uint32_t EndAddress(Storage & storage)
+  {
+    return static_cast<uint32_t>(storage.GetCapacity().to<uint64_t>() /
+                                 storage.GetBlockSize().to<uint64_t>());
+  }
+
+ private:
+  Storage & storage_;
+  uint32_t address_;
+  uint32_t blocks_per_sector_;
+  uint32_t end_address_;
+};
+
+/// Reads a CAN log from consecutive blocks of a storage device.
+class StorageCanLogSource : public CanLogSource
+{
+ public:
+  /// @param storage - initialized storage device.
+  /// @param first_block - block address the log starts at.
+  explicit StorageCanLogSource(Storage & storage, uint32_t first_block = 0)
+      : storage_(storage),
+        address_(first_block),
+        blocks_per_sector_(StorageCanLogSink::BlocksPerSector(storage)),
+        end_address_(StorageCanLogSink::EndAddress(storage))
+  {
+  }
+
+  size_t Read(std::span<uint8_t> sector) override
+  {
+    if (address_ + blocks_per_sector_ > end_address_)
+    {
+      return 0;
+    }
+
+    storage_.Read(address_, sector);
+    address_ += blocks_per_sector_;
+    return sector.size();
+  }
+
+ private:
+  Storage & storage_;
+  uint32_t address_;
+  uint32_t blocks_per_sector_;
+  uint32_t end_address_;
+};
+
+/// Reads a CAN log from a stdio file. Used on the host to convert logs copied
+/// off of a board's SD card.
+class StdioCanLogSource : public CanLogSource
+{
+ public:
+  /// @param file - file opened for reading in binary mode.
+  explicit StdioCanLogSource(FILE * file) : file_(file) {}
+
+  size_t Read(std::span<uint8_t> sector) override
+  {
+    return fread(sector.data(), 1, sector.size(), file_);
+  }
+
+ private:
+  FILE * file_;
+};
+
+/// Records every frame received by a CAN peripheral into a binary log, see
+/// CanLogFormat.
+///
+/// Frames are packed into two sector sized buffers. Capture() fills one
+/// buffer while Service() writes the other to the sink, so a slow write does
+/// not hold up the receive path. Capture() can run in the CAN receive handler
+/// or a high priority task and Service() in a lower priority task, or both can
+/// be called from the same loop with Update().
+///
+/// Capture() takes the frames the receive interrupt placed in the CAN
+/// peripheral's receive queue, so it must be the queue's only reader: call it
+/// from the receive handler or from a task, never both, and not next to a
+/// CanNetwork or IsoTp on the same peripheral. Logs can be converted to a
+/// candump log on the host with tools/can_log/can_log_to_candump.py.
+class CanRecorder
+{
+ public:
+  /// Counters of a recording.
+  struct Statistics_t
+  {
+    /// Number of frames stored in the log
+    uint32_t recorded_frames = 0;
+
+    /// Number of frames lost because both buffers were waiting to be written
+    uint32_t dropped_frames = 0;
+
+    /// Number of sectors written to the sink
+    uint32_t written_sectors = 0;
+  };
+
+  /// Number of frames taken from the CAN peripheral at a time.
+  static constexpr size_t kReceiveBatchSize = 8;
+
+  /// @param can - initialized CAN peripheral to record.
+  /// @param sink - destination of the log.
+  CanRecorder(Can & can, CanLogSink & sink) : can_(can), sink_(sink) {}
+
+  /// Start a new log. Frames already waiting in the CAN peripheral's receive
+  /// queue are recorded as the first frames of the log.
+  void Start()
+  {
+    statistics_     = {};
+    active_         = 0;
+    position_       = 0;
+    last_timestamp_ = std::nullopt;
+    full_[0]        = false;
+    full_[1]        = false;
+
+    std::array<uint8_t, CanLogFormat::kHeaderSize> header = {};
+    std::copy(CanLogFormat::kSignature.begin(),
+              CanLogFormat::kSignature.end(),
+              header.begin());
+    CanLogFormat::StoreWord(std::span(header).subspan(8),
+                            CanLogFormat::kVersion);
+    Append(header);
+
+    recording_ = true;
+  }
+
+  /// Move every frame waiting in the CAN peripheral's receive queue into the
+  /// log buffers.
+  ///
+  /// @return size_t - number of frames taken from the CAN peripheral.
+  size_t Capture()
+  {
+    if (!recording_)
+    {
+      return 0;
+    }
+
+    std::array<Can::Message_t, kReceiveBatchSize> messages;
+    std::array<uint8_t, CanLogFormat::kMaximumRecordSize> record;
+    size_t total = 0;
+
+    while (size_t count = can_.Receive(messages))
+    {
+      for (const auto & message : std::span(messages).first(count))
+      {
+        const auto kDelta =
+            last_timestamp_ ? message.uptime - *last_timestamp_ : 0ns;
+        const size_t kSize =
+            CanLogFormat::EncodeRecord(message, kDelta, record);
+
+        if (!HasRoomFor(kSize))
+        {
+          statistics_.dropped_frames++;
+          continue;
+        }
+
+        Append(std::span(record).first(kSize));
+        last_timestamp_ = message.uptime;
+        statistics_.recorded_frames++;
+      }
+      total += count;
+    }
+
+    return total;
+  }
+
+  /// Write any full buffers to the sink.
+  void Service()
+  {
+    // The buffer after the active one is the oldest.
+    for (size_t i = 1; i <= full_.size(); i++)
+    {
+      const size_t kIndex = (active_ + i) % buffers_.size();
+      if (full_[kIndex])
+      {
+        sink_.Write(buffers_[kIndex]);
+        statistics_.written_sectors++;
+        full_[kIndex] = false;
+      }
+    }
+  }
+
+  /// Capture() and Service() in one call.
+  void Update()
+  {
+    Capture();
+    Service();
+  }
+
+  /// Record the remaining frames, mark the end of the log and write every
+  /// buffer to the sink.
+  void Stop()
+  {
+    if (!recording_)
+    {
+      return;
+    }
+
+    Capture();
+    recording_ = false;
+
+    // Write any full buffer first so the end marker has room.
+    Service();
+
+    // The reader takes the length from the last byte of a record header, so
+    // mark the end with a whole header, even if that runs into another sector.
+    // Otherwise the reader would go on into whatever the storage held before.
+    std::array<uint8_t, CanLogFormat::kRecordHeaderSize> end_of_log;
+    end_of_log.fill(CanLogFormat::kEndOfLog);
+    Append(end_of_log);
+
+    if (position_ > 0)
+    {
+      auto & buffer = buffers_[active_];
+      std::fill(
+          buffer.begin() + position_, buffer.end(), CanLogFormat::kEndOfLog);
+      full_[active_] = true;
+    }
+    Service();
+  }
+
+  /// @return true - if a log is being recorded.
+  bool IsRecording() const
+  {
+    return recording_;
+  }
+
+  /// @return Statistics_t - counters of the current or last recording.
+  Statistics_t GetStatistics() const
+  {
+    return statistics_;
+  }
+
+ private:
+  /// @param size - size of a record.
+  /// @return true - if the record fits in the active buffer, or the rest of it
+  ///         fits in the other buffer.
+  bool HasRoomFor(size_t size) const
+  {
+    // A record that fills the active buffer moves on to the other buffer, so
+    // only one that ends before the end of the active buffer can do without
+    // it. Stop() writes any full buffer before the end of log marker, so the
+    // marker needs no room to be reserved here.
+    if (position_ + size < CanLogFormat::kSectorSize)
+    {
+      return true;
+    }
+    return !full_[(active_ + 1) % buffers_.size()];
+  }
+
+  void Append(std::span<const uint8_t> data)
+  {
+    while (!data.empty())
+    {
+      auto & buffer        = buffers_[active_];
+      const size_t kLength = std::min(data.size(), buffer.size() - position_);
+
+      std::copy_n(data.begin(), kLength, buffer.begin() + position_);
+      position_ += kLength;
+      data = data.subspan(kLength);
+
+      if (position_ == buffer.size())
+      {
+        full_[active_] = true;
+        active_        = (active_ + 1) % buffers_.size();
+        position_      = 0;
+      }
+    }
+  }
+
+  Can & can_;
+  CanLogSink & sink_;
+  std::array<std::array<uint8_t, CanLogFormat::kSectorSize>, 2> buffers_;
+  std::array<std::atomic<bool>, 2> full_ = {};
+  size_t active_                         = 0;
+  size_t position_                       = 0;
+  std::optional<std::chrono::nanoseconds> last_timestamp_;
+  bool recording_ = false;
+  Statistics_t statistics_;
+};
+
+/// Reads the frames of a binary CAN log, see CanLogFormat.
+class CanLogReader
+{
+ public:
+  /// @param source - log to read.
+  explicit CanLogReader(CanLogSource & source) : source_(source) {}
+
+  /// Read and check the log header. Must be called before Next().
+  ///
+  /// @throw std::errc::invalid_argument if the source does not contain a CAN
+  ///        log of a supported version.
+  void Open()
+  {
+    position_ = 0;
+    size_     = 0;
+    time_     = 0ns;
+    ended_    = false;
+
+    std::array<uint8_t, CanLogFormat::kHeaderSize> header;
+    const bool kComplete = ReadBytes(header);
+
+    if (!kComplete ||
+        !std::equal(CanLogFormat::kSignature.begin(),
+                    CanLogFormat::kSignature.end(),
+                    header.begin()) ||
+        CanLogFormat::LoadWord(std::span(header).subspan(8)) !=
+            CanLogFormat::kVersion)
+    {
+      throw Exception(std::errc::invalid_argument,
+                      "Source does not contain a supported CAN log.");
+    }
+  }
+
+  /// @return std::optional<Can::Message_t> - the next frame of the log, with
+  ///         its uptime set to the time since the first frame, or
+  ///         std::nullopt at the end of the log.
+  std::optional<Can::Message_t> Next()
+  {
+    std::array<uint8_t, CanLogFormat::kMaximumRecordSize> record;
+    auto header = std::span(record).first(CanLogFormat::kRecordHeaderSize);
+
+    if (ended_ || !ReadBytes(header) || record[8] > 8 ||
+        !ReadBytes(std::span(record).subspan(9, record[8])))
+    {
+      ended_ = true;
+      return std::nullopt;
+    }
+
+    const uint32_t kId = CanLogFormat::LoadWord(std::span(record).subspan(4));
+    constexpr uint32_t kFlags =
+        CanLogFormat::kRemoteRequestFlag | CanLogFormat::kExtendedFlag;
+
+    Can::Message_t message    = {};
+    message.id                = kId & ~kFlags;
+    message.is_remote_request = kId & CanLogFormat::kRemoteRequestFlag;
+    message.format            = (kId & CanLogFormat::kExtendedFlag)
+                                    ? Can::Message_t::Format::kExtended
+                                    : Can::Message_t::Format::kStandard;
+    message.length            = record[8];
+    std::copy_n(record.begin() + 9, message.length, message.payload.begin());
+
+    time_ += std::chrono::microseconds(CanLogFormat::LoadWord(record));
+    message.uptime = time_;
+
+    return message;
+  }
+
+ private:
+  bool ReadBytes(std::span<uint8_t> destination)
+  {
+    while (!destination.empty())
+    {
+      if (position_ == size_)
+      {
+        size_     = source_.Read(sector_);
+        position_ = 0;
+        if (size_ == 0)
+        {
+          return false;
+        }
+      }
+
+      const size_t kLength = std::min(destination.size(), size_ - position_);
+      std::copy_n(sector_.begin() + position_, kLength, destination.begin());
+      position_ += kLength;
+      destination = destination.subspan(kLength);
+    }
+    return true;
+  }
+
+  CanLogSource & source_;
+  std::array<uint8_t, CanLogFormat::kSectorSize> sector_;
+  size_t position_               = 0;
+  size_t size_                   = 0;
+  std::chrono::nanoseconds time_ = 0ns;
+  bool ended_                    = false;
+};
+
+/// Sends the frames of a CAN log onto a bus with their original timing.
+class CanReplay
+{
+ public:
+  /// @param can - initialized CAN peripheral to send the frames on.
+  /// @param reader - opened log to replay.
+  CanReplay(Can & can, CanLogReader & reader) : can_(can), reader_(reader) {}
+
+  /// Start the replay. The log's first frame is sent on the next Update().
+  void Start()
+  {
+    start_   = Uptime();
+    pending_ = reader_.Next();
+    sent_    = 0;
+  }
+
+  /// Send every frame that is due.
+  ///
+  /// @return true - if there are frames left to send.
+  bool Update()
+  {
+    const auto kElapsed = Uptime() - start_;
+    while (pending_ && pending_->uptime <= kElapsed)
+    {
+      can_.Send(*pending_);
+      sent_++;
+      pending_ = reader_.Next();
+    }
+    return pending_.has_value();
+  }
+
+  /// Replay the whole log, returning once the last frame has been sent.
+  void Run()
+  {
+    Start();
+    while (Update())
+    {
+      continue;
+    }
+  }
+
+  /// @return size_t - number of frames sent since Start().
+  size_t SentFrames() const
+  {
+    return sent_;
+  }
+
+ private:
+  Can & can_;
+  CanLogReader & reader_;
+  std::chrono::nanoseconds start_ = 0ns;
+  std::optional<Can::Message_t> pending_;
+  size_t sent_ = 0;
+};
+
+/// Format a frame as a line of a candump log file (`candump -l`), which can be
+/// replayed with canplayer or loaded by most CAN analysis tools.
+///
+/// @param message - frame to format, its uptime is the time of the line.
+/// @param interface - name of the interface to put in the line.
+/// @param line - buffer for the line, including the null terminator.
+/// @return int - length of the line, as returned by snprintf.
+inline int FormatCandump(const Can::Message_t & message,
+                         const char * interface,
+                         std::span<char> line)
+{
+  const auto kMicroseconds = static_cast<uint64_t>(message.uptime / 1us);
+  const int kIdDigits =
+      (message.format == Can::Message_t::Format::kExtended) ? 8 : 3;
+
+  // Payload as hex digits, or R for a remote request.
+  constexpr char kHexDigits[]      = "0123456789ABCDEF";
+  std::array<char, 8 * 2 + 1> data = {};
+  if (message.is_remote_request)
+  {
+    data[0] = 'R';
+  }
+  else
+  {
+    for (size_t i = 0; i < std::min<size_t>(message.length, 8); i++)
+    {
+      data[i * 2]     = kHexDigits[message.payload[i] >> 4];
+      data[i * 2 + 1] = kHexDigits[message.payload[i] & 0xF];
+    }
+  }
+
+  return snprintf(line.data(),
+                  line.size(),
+                  "(%010" PRIu64 ".%06" PRIu64 ") %s %0*" PRIX32 "#%s",
+                  kMicroseconds / 1'000'000,
+                  kMicroseconds % 1'000'000,
+                  interface,
+                  kIdDigits,
+                  message.id,
+                  data.data());
+}
+
+/// Convert a whole CAN log into a candump log file.
+///
+/// @param reader - opened log to convert.
+/// @param output - file to write the candump lines to.
+/// @param interface - name of the interface to put in each line.
+/// @param start - time to add to every frame, such as the time the log was
+///        recorded as seconds since the epoch.
+/// @return size_t - number of frames converted.
+inline size_t ConvertToCandump(CanLogReader & reader,
+                               FILE * output,
+                               const char * interface         = "can0",
+                               std::chrono::nanoseconds start = 0ns)
+{
+  std::array<char, 64> line;
+  size_t count = 0;
+
+  while (auto message = reader.Next())
+  {
+    message->uptime += start;
+    FormatCandump(*message, interface, line);
+    fprintf(output, "%s\n", line.data());
+    count++;
+  }
+
+  return count;
+}
+}  // namespace sjsu
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <ff.h>
+
+#include <cstdint>
+#include <span>
+
+#include "devices/communication/can_log.hpp"
+#include "utility/error_handling.hpp"
+#include "utility/fatfs/fatfs.hpp"
+
+namespace sjsu
+{
+/// Stores a CAN log in a FatFS file.
+class FatFsCanLogSink : public CanLogSink
+{
+ public:
+  /// @param file - file opened for writing.
+  explicit FatFsCanLogSink(FIL & file) : file_(file) {}
+
+  /// @throw std::errc::io_error if the file could not be written.
+  void Write(std::span<const uint8_t> sector) override
+  {
+    UINT written   = 0;
+    FRESULT result = f_write(&file_, sector.data(), sector.size(), &written);
+    if (result != FR_OK || written != sector.size())
+    {
+      throw Exception(std::errc::io_error, Stringify(result));
+    }
+  }
+
+ private:
+  FIL & file_;
+};
+
+/// Reads a CAN log from a FatFS file.
+class FatFsCanLogSource : public CanLogSource
+{
+ public:
+  /// @param file - file opened for reading.
+  explicit FatFsCanLogSource(FIL & file) : file_(file) {}
+
+  /// @throw std::errc::io_error if the file could not be read.
+  size_t Read(std::span<uint8_t> sector) override
+  {
+    UINT read      = 0;
+    FRESULT result = f_read(&file_, sector.data(), sector.size(), &read);
+    if (result != FR_OK)
+    {
+      throw Exception(std::errc::io_error, Stringify(result));
+    }
+    return read;
+  }
+
+ private:
+  FIL & file_;
+};
+}  // namespace sjsu
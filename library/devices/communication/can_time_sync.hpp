@@ -0,0 +1,376 @@
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+
+#include "peripherals/can.hpp"
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+/// Frame layout of the two-step CAN time synchronisation protocol.
+///
+/// The master sends a SYNC frame, waits for its CAN peripheral to report that
+/// the frame has left the node, then sends a FOLLOW_UP frame holding the time
+/// at which it did. Slaves timestamp the SYNC frame as it arrives. Both
+/// timestamps are taken at the end of the same frame on the bus, so their
+/// difference is the offset between the two clocks, free of the queueing and
+/// arbitration delays that the SYNC frame went through.
+///
+///   SYNC      (sync_id)     : [sequence]
+///   FOLLOW_UP (sync_id + 1) : [sequence, t1 (56-bit little endian, ns)]
+struct CanTimeSyncFormat
+{
+  /// Default ID of the SYNC frame. A low ID keeps the arbitration delay of
+  /// the FOLLOW_UP frame short, the SYNC frame itself is unaffected by it.
+  static constexpr uint32_t kDefaultSyncId = 0x010;
+
+  /// Number of bytes of the master's timestamp in a FOLLOW_UP frame.
+  static constexpr size_t kTimestampBytes = 7;
+
+  /// @param sync_id - ID of the SYNC frame.
+  /// @return constexpr uint32_t - ID of the matching FOLLOW_UP frame.
+  static constexpr uint32_t FollowUpId(uint32_t sync_id)
+  {
+    return sync_id + 1;
+  }
+};
+
+/// Settings for a CanTimeSyncMaster.
+struct CanTimeSyncSettings_t
+{
+  /// ID of the SYNC frame, the FOLLOW_UP frame uses the next ID.
+  uint32_t sync_id = CanTimeSyncFormat::kDefaultSyncId;
+
+  /// Time between SYNC frames.
+  std::chrono::nanoseconds period = 100ms;
+
+  /// Maximum time to wait for a SYNC frame to be transmitted before the
+  /// exchange is abandoned. Slaves discard an unmatched SYNC frame.
+  std::chrono::nanoseconds timeout = 10ms;
+};
+
+/// Master side of the two-step CAN time synchronisation protocol. Its clock is
+/// the one that the slaves align to.
+///
+/// Transmission is detected through Can::TransmitStatistics_t::completed, so
+/// nothing else should be sent on the same Can while a SYNC frame is in
+/// flight. The master only sends a SYNC frame once the transmit queue is empty
+/// and every frame in the hardware transmit buffers has been counted as
+/// completed, so the next completion is the SYNC frame's. This relies on the
+/// CAN driver counting every completion, which the LPC40xx driver does by
+/// holding off its interrupt in the NVIC, rather than masking the transmit
+/// interrupts, while it queues a frame.
+class CanTimeSyncMaster
+{
+ public:
+  /// @param can - initialized CAN peripheral to send the frames on.
+  /// @param settings - IDs and timing of the exchanges.
+  explicit CanTimeSyncMaster(Can & can, CanTimeSyncSettings_t settings = {})
+      : can_(can), settings_(settings)
+  {
+  }
+
+  /// Send the next SYNC or FOLLOW_UP frame when it is due. Never blocks, call
+  /// this regularly from the application loop or a periodic task.
+  void Update()
+  {
+    const auto kNow = Uptime();
+
+    if (waiting_for_completion_)
+    {
+      const auto kStatistics = can_.GetTransmitStatistics();
+      if (kStatistics.completed != completed_before_sync_)
+      {
+        SendFollowUp(kStatistics.last_completion);
+        waiting_for_completion_ = false;
+        sequence_++;
+      }
+      else if (kNow - sync_sent_at_ >= settings_.timeout)
+      {
+        waiting_for_completion_ = false;
+        abandoned_++;
+        sequence_++;
+      }
+      return;
+    }
+
+    const auto kStatistics = can_.GetTransmitStatistics();
+    if (kNow >= next_sync_ && kStatistics.queue_depth == 0 &&
+        kStatistics.in_flight == 0)
+    {
+      SendSync(kNow);
+    }
+  }
+
+  /// @return uint32_t - number of completed SYNC and FOLLOW_UP exchanges.
+  uint32_t SentExchanges() const
+  {
+    return sent_;
+  }
+
+  /// @return uint32_t - number of exchanges abandoned because the SYNC frame
+  ///         was not transmitted in time.
+  uint32_t AbandonedExchanges() const
+  {
+    return abandoned_;
+  }
+
+ private:
+  void SendSync(std::chrono::nanoseconds now)
+  {
+    Can::Message_t sync = {};
+    sync.id             = settings_.sync_id;
+    sync.length         = 1;
+    sync.payload[0]     = sequence_;
+
+    completed_before_sync_  = can_.GetTransmitStatistics().completed;
+    sync_sent_at_           = now;
+    next_sync_              = now + settings_.period;
+    waiting_for_completion_ = true;
+    can_.Send(sync);
+  }
+
+  void SendFollowUp(std::chrono::nanoseconds transmitted_at)
+  {
+    Can::Message_t follow_up = {};
+    follow_up.id         = CanTimeSyncFormat::FollowUpId(settings_.sync_id);
+    follow_up.length     = 1 + CanTimeSyncFormat::kTimestampBytes;
+    follow_up.payload[0] = sequence_;
+
+    const uint64_t kTimestamp = transmitted_at.count();
+    for (size_t i = 0; i < CanTimeSyncFormat::kTimestampBytes; i++)
+    {
+      follow_up.payload[1 + i] = static_cast<uint8_t>(kTimestamp >> (i * 8));
+    }
+
+    can_.Send(follow_up);
+    sent_++;
+  }
+
+  Can & can_;
+  CanTimeSyncSettings_t settings_;
+  std::chrono::nanoseconds next_sync_    = 0ns;
+  std::chrono::nanoseconds sync_sent_at_ = 0ns;
+  uint32_t completed_before_sync_        = 0;
+  uint32_t sent_                         = 0;
+  uint32_t abandoned_                    = 0;
+  uint8_t sequence_                      = 0;
+  bool waiting_for_completion_           = false;
+};
+
+/// Slave side of the two-step CAN time synchronisation protocol.
+///
+/// Each SYNC and FOLLOW_UP pair gives one sample of the offset between the
+/// master's clock and the local one. A least-squares line through the last
+/// kWindow samples disciplines the offset and the drift of the local clock, so
+/// local timestamps can be converted to master time between exchanges.
+///
+/// Before each new sample is added, it is compared with the offset predicted
+/// by the previous samples. That residual is the error the conversion had at
+/// that moment, and is the measure of the synchronisation accuracy.
+class CanTimeSyncSlave
+{
+ public:
+  /// Number of offset samples the drift is estimated over.
+  static constexpr size_t kWindow = 8;
+
+  /// Synchronisation state and accuracy.
+  struct Statistics_t
+  {
+    /// Number of offset samples taken.
+    uint32_t samples = 0;
+    /// Number of FOLLOW_UP frames without a matching SYNC frame.
+    uint32_t unmatched_follow_ups = 0;
+    /// Master time minus local time, at the last sample.
+    std::chrono::nanoseconds offset = 0ns;
+    /// Parts per million the local clock runs faster than the master's.
+    double drift_ppm = 0;
+    /// Measured minus predicted offset of the last sample.
+    std::chrono::nanoseconds last_residual = 0ns;
+    /// Largest absolute residual since the slave was synchronized.
+    std::chrono::nanoseconds max_residual = 0ns;
+    /// Root mean square of the residuals since the slave was synchronized.
+    std::chrono::nanoseconds rms_residual = 0ns;
+  };
+
+  /// @param sync_id - ID of the master's SYNC frame.
+  explicit constexpr CanTimeSyncSlave(
+      uint32_t sync_id = CanTimeSyncFormat::kDefaultSyncId)
+      : sync_id_(sync_id)
+  {
+  }
+
+  /// Handle a received message. Messages that are not part of the protocol
+  /// are ignored.
+  ///
+  /// @param message - message received, timestamped by the local Can.
+  /// @return true - if the message was a SYNC or FOLLOW_UP frame.
+  bool Process(const Can::Message_t & message)
+  {
+    if (message.format != Can::Message_t::Format::kStandard ||
+        message.is_remote_request)
+    {
+      return false;
+    }
+
+    if (message.id == sync_id_ && message.length >= 1)
+    {
+      pending_sequence_ = message.payload[0];
+      pending_receipt_  = message.uptime;
+      has_pending_      = true;
+      return true;
+    }
+
+    if (message.id == CanTimeSyncFormat::FollowUpId(sync_id_) &&
+        message.length >= 1 + CanTimeSyncFormat::kTimestampBytes)
+    {
+      if (!has_pending_ || message.payload[0] != pending_sequence_)
+      {
+        statistics_.unmatched_follow_ups++;
+        return true;
+      }
+
+      uint64_t master_time = 0;
+      for (size_t i = 0; i < CanTimeSyncFormat::kTimestampBytes; i++)
+      {
+        master_time |= uint64_t{ message.payload[1 + i] } << (i * 8);
+      }
+
+      has_pending_ = false;
+      AddSample(pending_receipt_,
+                std::chrono::nanoseconds(master_time) - pending_receipt_);
+      return true;
+    }
+
+    return false;
+  }
+
+  /// @return true - once enough samples have been taken to estimate drift.
+  bool IsSynchronized() const
+  {
+    return statistics_.samples >= 2;
+  }
+
+  /// @param local - time from the local clock, such as a Message_t::uptime.
+  /// @return std::chrono::nanoseconds - the same moment on the master's clock.
+  std::chrono::nanoseconds ToMasterTime(std::chrono::nanoseconds local) const
+  {
+    return local + PredictOffset(local);
+  }
+
+  /// @return std::chrono::nanoseconds - Uptime() converted to master time.
+  std::chrono::nanoseconds MasterTime() const
+  {
+    return ToMasterTime(Uptime());
+  }
+
+  /// @return Statistics_t - synchronisation state and accuracy.
+  Statistics_t GetStatistics() const
+  {
+    auto statistics = statistics_;
+    if (residual_count_ > 0)
+    {
+      statistics.rms_residual = std::chrono::nanoseconds(
+          std::llround(std::sqrt(residual_square_sum_ / residual_count_)));
+    }
+    return statistics;
+  }
+
+  /// Discard every sample and start synchronizing from scratch.
+  void Reset()
+  {
+    *this = CanTimeSyncSlave(sync_id_);
+  }
+
+ private:
+  struct Sample_t
+  {
+    std::chrono::nanoseconds local;
+    std::chrono::nanoseconds offset;
+  };
+
+  std::chrono::nanoseconds PredictOffset(std::chrono::nanoseconds local) const
+  {
+    const double kElapsed = static_cast<double>((local - reference_).count());
+    return reference_offset_ +
+           std::chrono::nanoseconds(std::llround(kElapsed * slope_));
+  }
+
+  void AddSample(std::chrono::nanoseconds local,
+                 std::chrono::nanoseconds offset)
+  {
+    if (IsSynchronized())
+    {
+      const auto kResidual     = offset - PredictOffset(local);
+      const double kResidualNs = static_cast<double>(kResidual.count());
+      statistics_.last_residual = kResidual;
+      statistics_.max_residual =
+          std::max(statistics_.max_residual, std::chrono::abs(kResidual));
+      residual_square_sum_ += kResidualNs * kResidualNs;
+      residual_count_++;
+    }
+
+    samples_[statistics_.samples % kWindow] = { local, offset };
+    statistics_.samples++;
+    statistics_.offset = offset;
+    Fit(local, offset);
+  }
+
+  void Fit(std::chrono::nanoseconds latest_local,
+           std::chrono::nanoseconds latest_offset)
+  {
+    // Fit relative to the latest sample so the sums stay small enough to be
+    // exact in a double, however long the clocks have been running.
+    const size_t kCount = std::min<size_t>(statistics_.samples, kWindow);
+    double mean_x       = 0;
+    double mean_y       = 0;
+    for (const auto & sample : std::span(samples_).first(kCount))
+    {
+      mean_x += static_cast<double>((sample.local - latest_local).count());
+      mean_y += static_cast<double>((sample.offset - latest_offset).count());
+    }
+    mean_x /= static_cast<double>(kCount);
+    mean_y /= static_cast<double>(kCount);
+
+    double covariance = 0;
+    double variance   = 0;
+    for (const auto & sample : std::span(samples_).first(kCount))
+    {
+      const double kX =
+          static_cast<double>((sample.local - latest_local).count()) - mean_x;
+      const double kY =
+          static_cast<double>((sample.offset - latest_offset).count()) -
+          mean_y;
+      covariance += kX * kY;
+      variance += kX * kX;
+    }
+
+    slope_            = (variance > 0) ? covariance / variance : 0;
+    reference_        = latest_local;
+    reference_offset_ = latest_offset + std::chrono::nanoseconds(std::llround(
+                                            mean_y - slope_ * mean_x));
+
+    // Offset falls by slope per local nanosecond, so the local clock gains
+    // -slope / (1 + slope) on the master's.
+    statistics_.drift_ppm = -slope_ / (1 + slope_) * 1e6;
+  }
+
+  uint32_t sync_id_;
+  std::array<Sample_t, kWindow> samples_     = {};
+  Statistics_t statistics_                   = {};
+  std::chrono::nanoseconds reference_        = 0ns;
+  std::chrono::nanoseconds reference_offset_ = 0ns;
+  double slope_                              = 0;
+  double residual_square_sum_                = 0;
+  uint32_t residual_count_                   = 0;
+  std::chrono::nanoseconds pending_receipt_  = 0ns;
+  uint8_t pending_sequence_                  = 0;
+  bool has_pending_                          = false;
+};
+}  // namespace sjsu
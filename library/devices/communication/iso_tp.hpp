@@ -0,0 +1,696 @@
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "peripherals/can.hpp"
+#include "utility/enum.hpp"
+#include "utility/error_handling.hpp"
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+/// Settings for an ISO-TP session. The defaults favor throughput: the sender
+/// is allowed to transmit every consecutive frame of a message back to back
+/// without waiting for another flow control frame.
+struct IsoTpSettings_t
+{
+  /// Number of consecutive frames the sender may transmit before it must wait
+  /// for the next flow control frame. 0 means the whole message.
+  uint8_t block_size = 0;
+
+  /// Minimum gap between consecutive frames requested from the sender. Times
+  /// below 1ms are sent in 100us steps.
+  std::chrono::microseconds separation_time = 0us;
+
+  /// Maximum time to wait for a flow control or consecutive frame before the
+  /// transfer is abandoned.
+  std::chrono::nanoseconds timeout = 1s;
+
+  /// Frame format of the transmit and receive IDs.
+  Can::Message_t::Format format = Can::Message_t::Format::kStandard;
+
+  /// Value written to unused payload bytes. Every frame is padded to 8 bytes.
+  uint8_t padding = 0xCC;
+};
+
+/// A single ISO-TP (ISO 15765-2) connection between two CAN IDs using normal
+/// addressing. Transfers messages larger than a single CAN frame by splitting
+/// them into single, first, consecutive and flow control frames.
+///
+/// The session does not copy payloads. A transmitted payload is read directly
+/// from the caller's span, and a received payload is reassembled directly into
+/// the buffer given to SetReceiveBuffer(). Both must outlive the transfer.
+///
+/// Process() and Update() must be called from the same thread or interrupt,
+/// which is what IsoTp does for its sessions.
+class IsoTpSession
+{
+ public:
+  /// State of a transfer in either direction.
+  enum class Status : uint8_t
+  {
+    /// No transfer has been started.
+    kIdle,
+    /// A transfer is in progress.
+    kInProgress,
+    /// The last transfer completed successfully.
+    kComplete,
+    /// The other side stopped responding.
+    kTimeout,
+    /// The message did not fit in the receiver's buffer.
+    kOverflow,
+    /// A frame arrived out of sequence or had an invalid flow status.
+    kProtocolError,
+  };
+
+  /// ISO-TP frame types, stored in the upper nibble of the first byte.
+  enum class FrameType : uint8_t
+  {
+    kSingle      = 0,
+    kFirst       = 1,
+    kConsecutive = 2,
+    kFlowControl = 3,
+  };
+
+  /// Flow status of a flow control frame.
+  enum class FlowStatus : uint8_t
+  {
+    kContinue = 0,
+    kWait     = 1,
+    kOverflow = 2,
+  };
+
+  /// Maximum payload bytes in a single frame.
+  static constexpr size_t kSingleFrameCapacity = 7;
+  /// Payload bytes in a first frame with a 12-bit length.
+  static constexpr size_t kFirstFrameCapacity = 6;
+  /// Payload bytes in a first frame with the 32-bit length escape.
+  static constexpr size_t kLongFirstFrameCapacity = 2;
+  /// Maximum payload bytes in a consecutive frame.
+  static constexpr size_t kConsecutiveFrameCapacity = 7;
+  /// Largest message length that fits in the 12-bit first frame length.
+  static constexpr size_t kMaximumShortLength = 0xFFF;
+
+  /// Encode a separation time into the STmin byte of a flow control frame.
+  ///
+  /// @param time - minimum gap between consecutive frames.
+  /// @return constexpr uint8_t - STmin value, rounded down.
+  static constexpr uint8_t EncodeSeparationTime(std::chrono::microseconds time)
+  {
+    if (time >= 1ms)
+    {
+      return static_cast<uint8_t>(std::min<int64_t>(time / 1ms, 0x7F));
+    }
+    if (time >= 100us)
+    {
+      return static_cast<uint8_t>(0xF0 + time / 100us);
+    }
+    return 0;
+  }
+
+  /// Decode the STmin byte of a flow control frame. Reserved values are
+  /// treated as the longest separation time, as required by the standard.
+  ///
+  /// @param value - STmin value.
+  /// @return constexpr std::chrono::microseconds - minimum gap between frames.
+  static constexpr std::chrono::microseconds DecodeSeparationTime(
+      uint8_t value)
+  {
+    if (value <= 0x7F)
+    {
+      return std::chrono::milliseconds(value);
+    }
+    if (value >= 0xF1 && value <= 0xF9)
+    {
+      return (value - 0xF0) * 100us;
+    }
+    return 127ms;
+  }
+
+  /// @param can - CAN peripheral to transmit frames on.
+  /// @param transmit_id - ID of the frames sent by this side.
+  /// @param receive_id - ID of the frames sent by the other side.
+  /// @param settings - flow control and timing for this session.
+  IsoTpSession(Can & can,
+               uint32_t transmit_id,
+               uint32_t receive_id,
+               IsoTpSettings_t settings = {})
+      : can_(can),
+        transmit_id_(transmit_id),
+        receive_id_(receive_id),
+        settings_(settings)
+  {
+  }
+
+  /// Start sending a payload. Single frame payloads are sent immediately,
+  /// larger payloads are sent by Update() as flow control allows.
+  ///
+  /// @param payload - bytes to send. Must remain valid until TransmitStatus()
+  ///        is no longer kInProgress.
+  /// @throw std::errc::device_or_resource_busy if a transmit is in progress.
+  /// @throw std::errc::invalid_argument if the payload is empty or too large.
+  void StartTransmit(std::span<const uint8_t> payload)
+  {
+    if (transmit_status_ == Status::kInProgress)
+    {
+      throw Exception(std::errc::device_or_resource_busy,
+                      "ISO-TP session is already transmitting.");
+    }
+
+    if (payload.empty() ||
+        payload.size() > std::numeric_limits<uint32_t>::max())
+    {
+      throw Exception(std::errc::invalid_argument,
+                      "ISO-TP payload must be 1 to 2^32 - 1 bytes long.");
+    }
+
+    transmit_payload_ = payload;
+
+    if (payload.size() <= kSingleFrameCapacity)
+    {
+      auto frame = MakeFrame(FrameType::kSingle, payload.size());
+      std::copy(payload.begin(), payload.end(), &frame.payload[1]);
+      can_.Send(frame);
+      transmit_status_ = Status::kComplete;
+      return;
+    }
+
+    Can::Message_t frame;
+    size_t first_data;
+
+    if (payload.size() <= kMaximumShortLength)
+    {
+      frame            = MakeFrame(FrameType::kFirst, payload.size() >> 8);
+      frame.payload[1] = static_cast<uint8_t>(payload.size());
+      first_data       = kFirstFrameCapacity;
+    }
+    else
+    {
+      const auto kLength = static_cast<uint32_t>(payload.size());
+      frame              = MakeFrame(FrameType::kFirst, 0);
+      frame.payload[1]   = 0;
+      frame.payload[2]   = static_cast<uint8_t>(kLength >> 24);
+      frame.payload[3]   = static_cast<uint8_t>(kLength >> 16);
+      frame.payload[4]   = static_cast<uint8_t>(kLength >> 8);
+      frame.payload[5]   = static_cast<uint8_t>(kLength);
+      first_data         = kLongFirstFrameCapacity;
+    }
+
+    std::copy_n(payload.begin(), first_data, frame.payload.end() - first_data);
+
+    transmit_offset_          = first_data;
+    transmit_sequence_        = 1;
+    waiting_for_flow_control_ = true;
+    transmit_deadline_        = Uptime() + settings_.timeout;
+    transmit_status_          = Status::kInProgress;
+
+    can_.Send(frame);
+  }
+
+  /// Provide the buffer the next received message will be reassembled into.
+  /// Once a message is complete, further messages are refused until this is
+  /// called again.
+  ///
+  /// @param buffer - destination for the next received message.
+  void SetReceiveBuffer(std::span<uint8_t> buffer)
+  {
+    receive_buffer_ = buffer;
+    receive_length_ = 0;
+    receive_offset_ = 0;
+    receive_status_ = Status::kIdle;
+  }
+
+  /// Handle a received CAN frame.
+  ///
+  /// @param message - received CAN frame.
+  /// @return true - if the frame was addressed to this session.
+  bool Process(const Can::Message_t & message)
+  {
+    if (message.id != receive_id_ || message.format != settings_.format ||
+        message.length == 0)
+    {
+      return false;
+    }
+
+    switch (static_cast<FrameType>(message.payload[0] >> 4))
+    {
+      case FrameType::kSingle: ReceiveSingleFrame(message); break;
+      case FrameType::kFirst: ReceiveFirstFrame(message); break;
+      case FrameType::kConsecutive: ReceiveConsecutiveFrame(message); break;
+      case FrameType::kFlowControl: ReceiveFlowControl(message); break;
+      default: break;
+    }
+
+    return true;
+  }
+
+  /// Send any consecutive frames that flow control allows and expire stalled
+  /// transfers. Must be called periodically while a transfer is in progress.
+  void Update()
+  {
+    const auto kNow = Uptime();
+
+    if (transmit_status_ == Status::kInProgress)
+    {
+      if (!waiting_for_flow_control_)
+      {
+        SendConsecutiveFrames(kNow);
+      }
+      if (transmit_status_ == Status::kInProgress && kNow > transmit_deadline_)
+      {
+        transmit_status_ = Status::kTimeout;
+      }
+    }
+
+    if (receive_status_ == Status::kInProgress)
+    {
+      if (flow_control_pending_)
+      {
+        SendFlowControl(FlowStatus::kContinue);
+      }
+      if (kNow > receive_deadline_)
+      {
+        receive_status_ = Status::kTimeout;
+      }
+    }
+  }
+
+  /// @return Status - state of the last transmit.
+  Status TransmitStatus() const
+  {
+    return transmit_status_;
+  }
+
+  /// @return Status - state of the last receive.
+  Status ReceiveStatus() const
+  {
+    return receive_status_;
+  }
+
+  /// @return std::span<uint8_t> - the received message. Only valid once
+  ///         ReceiveStatus() returns kComplete.
+  std::span<uint8_t> ReceivedPayload() const
+  {
+    return receive_buffer_.first(receive_length_);
+  }
+
+  /// @return uint32_t - ID of the frames this session accepts.
+  uint32_t ReceiveId() const
+  {
+    return receive_id_;
+  }
+
+ private:
+  Can::Message_t MakeFrame(FrameType type, size_t low_nibble) const
+  {
+    Can::Message_t frame = {
+      .id     = transmit_id_,
+      .length = 8,
+      .format = settings_.format,
+    };
+    frame.payload.fill(settings_.padding);
+    frame.payload[0] = static_cast<uint8_t>((Value(type) << 4) |
+                                            (low_nibble & 0xF));
+    return frame;
+  }
+
+  void SendConsecutiveFrames(std::chrono::nanoseconds now)
+  {
+    while (transmit_offset_ < transmit_payload_.size())
+    {
+      if (now < next_frame_time_)
+      {
+        return;
+      }
+
+      const size_t kSize = std::min(transmit_payload_.size() - transmit_offset_,
+                                    kConsecutiveFrameCapacity);
+      auto frame = MakeFrame(FrameType::kConsecutive, transmit_sequence_);
+      auto data  = transmit_payload_.subspan(transmit_offset_, kSize);
+      std::copy(data.begin(), data.end(), &frame.payload[1]);
+
+      if (!can_.TrySend(frame))
+      {
+        return;
+      }
+
+      transmit_offset_ += kSize;
+      transmit_sequence_ = (transmit_sequence_ + 1) & 0xF;
+      next_frame_time_   = now + separation_time_;
+      transmit_deadline_ = now + settings_.timeout;
+
+      if (block_remaining_ > 0 && --block_remaining_ == 0 &&
+          transmit_offset_ < transmit_payload_.size())
+      {
+        waiting_for_flow_control_ = true;
+        transmit_deadline_        = now + settings_.timeout;
+        return;
+      }
+    }
+
+    transmit_status_ = Status::kComplete;
+  }
+
+  void SendFlowControl(FlowStatus status)
+  {
+    auto frame       = MakeFrame(FrameType::kFlowControl, Value(status));
+    frame.payload[1] = settings_.block_size;
+    frame.payload[2] = EncodeSeparationTime(settings_.separation_time);
+
+    // Flow control may be sent from an interrupt, so it must not block. If the
+    // transmit queue is full, Update() tries again.
+    flow_control_pending_ =
+        !can_.TrySend(frame) && status == FlowStatus::kContinue;
+  }
+
+  void ReceiveSingleFrame(const Can::Message_t & message)
+  {
+    const size_t kLength = message.payload[0] & 0xF;
+    if (kLength == 0 || kLength >= message.length ||
+        receive_status_ == Status::kComplete)
+    {
+      return;
+    }
+
+    if (kLength > receive_buffer_.size())
+    {
+      receive_status_ = Status::kOverflow;
+      return;
+    }
+
+    std::copy_n(&message.payload[1], kLength, receive_buffer_.begin());
+    receive_length_ = kLength;
+    receive_status_ = Status::kComplete;
+  }
+
+  void ReceiveFirstFrame(const Can::Message_t & message)
+  {
+    if (message.length < 8)
+    {
+      return;
+    }
+
+    size_t length = ((message.payload[0] & 0xF) << 8) | message.payload[1];
+    size_t first_data = kFirstFrameCapacity;
+
+    if (length == 0)
+    {
+      length = (static_cast<uint32_t>(message.payload[2]) << 24) |
+               (static_cast<uint32_t>(message.payload[3]) << 16) |
+               (static_cast<uint32_t>(message.payload[4]) << 8) |
+               static_cast<uint32_t>(message.payload[5]);
+      first_data = kLongFirstFrameCapacity;
+    }
+
+    if (length <= kSingleFrameCapacity)
+    {
+      return;
+    }
+
+    // A completed message stays in the buffer until the caller provides a new
+    // one, so refuse anything that would overwrite it.
+    if (receive_status_ == Status::kComplete ||
+        length > receive_buffer_.size())
+    {
+      SendFlowControl(FlowStatus::kOverflow);
+      if (receive_status_ != Status::kComplete)
+      {
+        receive_status_ = Status::kOverflow;
+      }
+      return;
+    }
+
+    std::copy_n(message.payload.end() - first_data,
+                first_data,
+                receive_buffer_.begin());
+
+    receive_length_    = length;
+    receive_offset_    = first_data;
+    receive_sequence_  = 1;
+    received_in_block_ = 0;
+    receive_deadline_  = Uptime() + settings_.timeout;
+    receive_status_    = Status::kInProgress;
+
+    SendFlowControl(FlowStatus::kContinue);
+  }
+
+  void ReceiveConsecutiveFrame(const Can::Message_t & message)
+  {
+    if (receive_status_ != Status::kInProgress)
+    {
+      return;
+    }
+
+    if ((message.payload[0] & 0xF) != receive_sequence_)
+    {
+      receive_status_ = Status::kProtocolError;
+      return;
+    }
+
+    const size_t kSize = std::min(receive_length_ - receive_offset_,
+                                  kConsecutiveFrameCapacity);
+    if (kSize >= message.length)
+    {
+      receive_status_ = Status::kProtocolError;
+      return;
+    }
+
+    std::copy_n(&message.payload[1], kSize, &receive_buffer_[receive_offset_]);
+    receive_offset_ += kSize;
+
+    if (receive_offset_ == receive_length_)
+    {
+      receive_status_ = Status::kComplete;
+      return;
+    }
+
+    receive_sequence_ = (receive_sequence_ + 1) & 0xF;
+    receive_deadline_ = Uptime() + settings_.timeout;
+
+    if (settings_.block_size != 0 &&
+        ++received_in_block_ == settings_.block_size)
+    {
+      received_in_block_ = 0;
+      SendFlowControl(FlowStatus::kContinue);
+    }
+  }
+
+  void ReceiveFlowControl(const Can::Message_t & message)
+  {
+    if (transmit_status_ != Status::kInProgress || !waiting_for_flow_control_ ||
+        message.length < 3)
+    {
+      return;
+    }
+
+    const auto kNow = Uptime();
+
+    switch (static_cast<FlowStatus>(message.payload[0] & 0xF))
+    {
+      case FlowStatus::kContinue:
+        block_remaining_          = message.payload[1];
+        separation_time_          = DecodeSeparationTime(message.payload[2]);
+        next_frame_time_          = kNow;
+        waiting_for_flow_control_ = false;
+        SendConsecutiveFrames(kNow);
+        break;
+      case FlowStatus::kWait:
+        transmit_deadline_ = kNow + settings_.timeout;
+        break;
+      case FlowStatus::kOverflow: transmit_status_ = Status::kOverflow; break;
+      default: transmit_status_ = Status::kProtocolError; break;
+    }
+  }
+
+  Can & can_;
+  uint32_t transmit_id_;
+  uint32_t receive_id_;
+  IsoTpSettings_t settings_;
+
+  std::span<const uint8_t> transmit_payload_;
+  size_t transmit_offset_                     = 0;
+  uint8_t transmit_sequence_                  = 0;
+  uint8_t block_remaining_                    = 0;
+  bool waiting_for_flow_control_              = false;
+  std::chrono::microseconds separation_time_  = 0us;
+  std::chrono::nanoseconds next_frame_time_   = 0ns;
+  std::chrono::nanoseconds transmit_deadline_ = 0ns;
+  Status transmit_status_                     = Status::kIdle;
+
+  std::span<uint8_t> receive_buffer_;
+  size_t receive_length_                     = 0;
+  size_t receive_offset_                     = 0;
+  uint8_t receive_sequence_                  = 0;
+  uint8_t received_in_block_                 = 0;
+  bool flow_control_pending_                 = false;
+  std::chrono::nanoseconds receive_deadline_ = 0ns;
+  Status receive_status_                     = Status::kIdle;
+};
+
+/// Routes received CAN frames to a set of concurrent ISO-TP sessions and
+/// drives their transfers.
+///
+/// Poll() takes every frame out of the CAN peripheral's receive queue and
+/// drops the frames not addressed to a session, so IsoTp must be the only
+/// reader of the peripheral. It refuses to poll a peripheral that has a
+/// receive handler, such as one managed by a CanNetwork, as both would be
+/// consuming the same queue.
+class IsoTp
+{
+ public:
+  /// Maximum number of sessions that can be attached at once.
+  static constexpr size_t kMaximumSessions = 16;
+
+  /// Number of frames read from the CAN peripheral per Receive() call.
+  static constexpr size_t kReceiveBatchSize = 8;
+
+  /// @param can - CAN peripheral the sessions communicate over.
+  explicit IsoTp(Can & can) : can_(can) {}
+
+  /// Route received frames for the session's receive ID to it.
+  ///
+  /// @param session - session to attach. Must outlive this object.
+  /// @throw std::errc::not_enough_memory if kMaximumSessions are attached.
+  void Attach(IsoTpSession & session)
+  {
+    if (session_count_ >= kMaximumSessions)
+    {
+      throw Exception(std::errc::not_enough_memory,
+                      "Too many ISO-TP sessions attached.");
+    }
+    sessions_[session_count_++] = &session;
+  }
+
+  /// Pass a frame received elsewhere, such as from a CAN receive handler, to
+  /// the session it is addressed to.
+  ///
+  /// @param message - received CAN frame.
+  /// @return true - if a session accepted the frame.
+  bool Process(const Can::Message_t & message)
+  {
+    for (auto * session : Sessions())
+    {
+      if (session->Process(message))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Read every pending frame from the CAN peripheral, route them to their
+  /// sessions, then update every session.
+  ///
+  /// @throw std::errc::device_or_resource_busy if the CAN peripheral has a
+  /// receive handler that already consumes its frames.
+  void Poll()
+  {
+    if (can_.CurrentSettings().handler)
+    {
+      throw Exception(std::errc::device_or_resource_busy,
+                      "IsoTp must be the only reader of the CAN peripheral, "
+                      "but it has a receive handler.");
+    }
+
+    std::array<Can::Message_t, kReceiveBatchSize> messages;
+    size_t count;
+
+    do
+    {
+      count = can_.Receive(messages);
+      for (const auto & message : std::span(messages).first(count))
+      {
+        Process(message);
+      }
+    } while (count == messages.size());
+
+    for (auto * session : Sessions())
+    {
+      session->Update();
+    }
+  }
+
+  /// Send a payload and poll until it has been transmitted.
+  ///
+  /// @param session - an attached session.
+  /// @param payload - bytes to send.
+  /// @throw std::errc::timed_out if the receiver stopped responding.
+  /// @throw std::errc::message_size if the receiver's buffer is too small.
+  /// @throw std::errc::protocol_error if the receiver sent invalid frames.
+  void Send(IsoTpSession & session, std::span<const uint8_t> payload)
+  {
+    session.StartTransmit(payload);
+
+    while (session.TransmitStatus() == IsoTpSession::Status::kInProgress)
+    {
+      Poll();
+    }
+
+    ThrowOnFailure(session.TransmitStatus());
+  }
+
+  /// Receive a payload into the supplied buffer, polling until it arrives.
+  ///
+  /// @param session - an attached session.
+  /// @param buffer - destination for the message.
+  /// @param timeout - maximum time to wait for the message to complete.
+  /// @return std::span<uint8_t> - the part of buffer holding the message.
+  /// @throw std::errc::timed_out if no message completed in time.
+  /// @throw std::errc::message_size if the message did not fit in buffer.
+  /// @throw std::errc::protocol_error if the sender sent invalid frames.
+  std::span<uint8_t> Receive(IsoTpSession & session,
+                             std::span<uint8_t> buffer,
+                             std::chrono::nanoseconds timeout)
+  {
+    session.SetReceiveBuffer(buffer);
+
+    Wait(timeout, [this, &session]() {
+      Poll();
+      auto status = session.ReceiveStatus();
+      return status != IsoTpSession::Status::kIdle &&
+             status != IsoTpSession::Status::kInProgress;
+    });
+
+    auto status = session.ReceiveStatus();
+    if (status == IsoTpSession::Status::kIdle ||
+        status == IsoTpSession::Status::kInProgress)
+    {
+      status = IsoTpSession::Status::kTimeout;
+    }
+
+    ThrowOnFailure(status);
+    return session.ReceivedPayload();
+  }
+
+ private:
+  std::span<IsoTpSession * const> Sessions() const
+  {
+    return std::span(sessions_).first(session_count_);
+  }
+
+  static void ThrowOnFailure(IsoTpSession::Status status)
+  {
+    switch (status)
+    {
+      case IsoTpSession::Status::kComplete: return;
+      case IsoTpSession::Status::kOverflow:
+        throw Exception(std::errc::message_size,
+                        "ISO-TP message does not fit in the receive buffer.");
+      case IsoTpSession::Status::kProtocolError:
+        throw Exception(std::errc::protocol_error,
+                        "Invalid ISO-TP frame received.");
+      default:
+        throw Exception(std::errc::timed_out, "ISO-TP transfer timed out.");
+    }
+  }
+
+  Can & can_;
+  std::array<IsoTpSession *, kMaximumSessions> sessions_ = {};
+  size_t session_count_                                 = 0;
+};
+}  // namespace sjsu
@@ -0,0 +1,313 @@
+#include <array>
+#include <vector>
+
+#include "devices/communication/can_log.hpp"
+#include "peripherals/linux/virtual_can.hpp"
+#include "testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing CAN log")
+{
+  constexpr size_t kSectors = 8;
+
+  // Storage with 512 byte blocks, backed by memory
+  std::vector<uint8_t> memory(kSectors * CanLogFormat::kSectorSize, 0xFF);
+  Mock<Storage> mock_storage;
+  When(Method(mock_storage, GetBlockSize)).AlwaysReturn(512_B);
+  When(Method(mock_storage, GetCapacity))
+      .AlwaysReturn(units::data::byte_t(memory.size()));
+  When(Method(mock_storage, Erase))
+      .AlwaysDo([&memory](uint32_t block, size_t count) {
+        std::fill_n(memory.begin() + block * 512, count * 512, 0xFF);
+      });
+  When(OverloadedMethod(
+           mock_storage, Write, void(uint32_t, std::span<const uint8_t>)))
+      .AlwaysDo([&memory](uint32_t block, std::span<const uint8_t> data) {
+        std::copy(data.begin(), data.end(), memory.begin() + block * 512);
+      });
+  When(Method(mock_storage, Read))
+      .AlwaysDo([&memory](uint32_t block, std::span<uint8_t> data) {
+        std::copy_n(memory.begin() + block * 512, data.size(), data.begin());
+      });
+
+  VirtualCanBus bus(1_MHz);
+  VirtualCan sender(bus);
+  VirtualCan recorded(bus);
+  VirtualCan monitor(bus);
+  sender.Initialize();
+  recorded.Initialize();
+  monitor.Initialize();
+  SetUptimeFunction([&bus]() { return bus.Now(); });
+
+  StorageCanLogSink sink(mock_storage.get());
+  StorageCanLogSource source(mock_storage.get());
+  CanRecorder recorder(recorded, sink);
+  CanLogReader reader(source);
+
+  auto send_frames = [&sender, &bus](size_t count, uint8_t first = 0) {
+    for (size_t i = 0; i < count; i++)
+    {
+      const uint8_t kValue = static_cast<uint8_t>(first + i);
+      sender.Send(0x100 + kValue, { kValue, 1, 2, 3, 4, 5, 6, 7 });
+    }
+    bus.RunUntilIdle();
+  };
+
+  SECTION("Record and read back")
+  {
+    // Setup
+    Can::Message_t extended = { .id = 0x1234'5678, .length = 2 };
+    extended.format         = Can::Message_t::Format::kExtended;
+    extended.payload        = { 0xAB, 0xCD };
+    Can::Message_t remote = { .id = 0x7FF, .is_remote_request = true };
+
+    recorder.Start();
+    sender.Send(0x123, { 0xDE, 0xAD, 0xBE, 0xEF });
+    sender.Send(extended);
+    bus.Run(1ms);
+    sender.Send(remote);
+    bus.RunUntilIdle();
+
+    std::array<Can::Message_t, 3> expected;
+    REQUIRE(3 == monitor.Receive(expected));
+
+    // Exercise
+    recorder.Update();
+    recorder.Stop();
+
+    // Verify
+    CHECK(!recorder.IsRecording());
+    CHECK(3 == recorder.GetStatistics().recorded_frames);
+    CHECK(1 == recorder.GetStatistics().written_sectors);
+    CHECK(0 == std::memcmp(memory.data(), "SJ2CANLG", 8));
+
+    // Exercise + Verify
+    reader.Open();
+    for (const auto & frame : expected)
+    {
+      auto message = reader.Next();
+      REQUIRE(message.has_value());
+      CHECK(frame.id == message->id);
+      CHECK(frame.format == message->format);
+      CHECK(frame.is_remote_request == message->is_remote_request);
+      CHECK(frame.length == message->length);
+      CHECK(std::equal(frame.payload.begin(),
+                       frame.payload.begin() + frame.length,
+                       message->payload.begin()));
+      CHECK(std::chrono::floor<std::chrono::microseconds>(
+                frame.uptime - expected[0].uptime) >= message->uptime);
+      CHECK(frame.uptime - expected[0].uptime - message->uptime <
+            std::chrono::microseconds(3));
+    }
+    CHECK(!reader.Next().has_value());
+  }
+
+  SECTION("Double buffered across sectors")
+  {
+    // Setup: 100 full frames take 1716 bytes, four sectors
+    recorder.Start();
+
+    // Exercise
+    for (uint8_t round = 0; round < 10; round++)
+    {
+      send_frames(10, round * 10);
+      recorder.Update();
+    }
+    recorder.Stop();
+
+    // Verify
+    CHECK(100 == recorder.GetStatistics().recorded_frames);
+    CHECK(0 == recorder.GetStatistics().dropped_frames);
+    CHECK(4 == recorder.GetStatistics().written_sectors);
+
+    reader.Open();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+      auto message = reader.Next();
+      REQUIRE(message.has_value());
+      CHECK(0x100 + i == message->id);
+      CHECK(i == message->payload[0]);
+    }
+    CHECK(!reader.Next().has_value());
+  }
+
+  SECTION("Capture() in the receive handler")
+  {
+    // Setup
+    recorded.settings.handler = [&recorder](Can &) { recorder.Capture(); };
+    recorded.Initialize();
+    recorder.Start();
+
+    // Exercise
+    send_frames(20);
+    recorder.Stop();
+
+    // Verify: Each frame was taken from the receive queue as it arrived
+    CHECK(20 == recorder.GetStatistics().recorded_frames);
+    CHECK(0 == recorded.GetReceiveStatistics().queue_depth);
+    reader.Open();
+    for (uint32_t i = 0; i < 20; i++)
+    {
+      auto message = reader.Next();
+      REQUIRE(message.has_value());
+      CHECK(0x100 + i == message->id);
+    }
+    CHECK(!reader.Next().has_value());
+  }
+
+  SECTION("Frames are dropped while both buffers wait to be written")
+  {
+    // Setup
+    recorder.Start();
+
+    // Exercise
+    for (uint8_t round = 0; round < 5; round++)
+    {
+      send_frames(16, round * 16);
+      recorder.Capture();
+    }
+
+    // Verify: Two sectors hold 59 full frames after the header
+    auto statistics = recorder.GetStatistics();
+    CHECK(59 == statistics.recorded_frames);
+    CHECK(80 - 59 == statistics.dropped_frames);
+    CHECK(0 == statistics.written_sectors);
+
+    // Exercise
+    recorder.Service();
+    recorder.Stop();
+
+    // Verify: The two full sectors, then the rest of the end of log marker,
+    //         as only 5 bytes of the second sector were left for it
+    CHECK(3 == recorder.GetStatistics().written_sectors);
+  }
+
+  SECTION("Log ending within 8 bytes of the end of a sector")
+  {
+    // Setup: The storage holds an older log past the end of this one
+    std::fill(memory.begin(), memory.end(), 0x00);
+    recorder.Start();
+
+    // Exercise: The header and 29 full frames leave 3 bytes of the sector
+    send_frames(16);
+    recorder.Update();
+    send_frames(13, 16);
+    recorder.Stop();
+
+    // Verify: The end of log marker runs into the next sector
+    CHECK(16 + 29 * 17 == CanLogFormat::kSectorSize - 3);
+    CHECK(2 == recorder.GetStatistics().written_sectors);
+    reader.Open();
+    for (uint32_t i = 0; i < 29; i++)
+    {
+      REQUIRE(reader.Next().has_value());
+    }
+    CHECK(!reader.Next().has_value());
+  }
+
+  SECTION("Replay keeps the original timing")
+  {
+    // Setup: Two frames with a 500us gap between them
+    recorder.Start();
+    send_frames(1, 0);
+    bus.Run(500us);
+    send_frames(1, 1);
+    recorder.Stop();
+    reader.Open();
+
+    std::array<Can::Message_t, 4> replayed;
+    REQUIRE(2 == monitor.Receive(replayed));
+    const auto kOriginalGap = replayed[1].uptime - replayed[0].uptime;
+
+    CanReplay replay(sender, reader);
+
+    // Exercise
+    replay.Start();
+    CHECK(replay.Update());
+
+    // Verify: Only the first frame is due
+    CHECK(1 == replay.SentFrames());
+
+    // Exercise
+    while (replay.Update())
+    {
+      bus.Run(10us);
+    }
+    bus.RunUntilIdle();
+
+    // Verify
+    REQUIRE(2 == monitor.Receive(replayed));
+    CHECK(0x100 == replayed[0].id);
+    CHECK(0x101 == replayed[1].id);
+    CHECK(replayed[1].uptime - replayed[0].uptime >= kOriginalGap - 1us);
+    CHECK(replayed[1].uptime - replayed[0].uptime <= kOriginalGap + 10us);
+  }
+
+  SECTION("Invalid log")
+  {
+    SJ2_CHECK_EXCEPTION(reader.Open(), std::errc::invalid_argument);
+  }
+
+  SECTION("Storage block size must divide the sector size")
+  {
+    When(Method(mock_storage, GetBlockSize)).AlwaysReturn(3_B);
+    SJ2_CHECK_EXCEPTION(StorageCanLogSink{ mock_storage.get() },
+                        std::errc::invalid_argument);
+  }
+
+  SECTION("Log stops at the end of the storage")
+  {
+    // Setup
+    recorder.Start();
+
+    // Exercise + Verify
+    for (uint8_t round = 0; round < 15; round++)
+    {
+      send_frames(16, round * 16);
+      recorder.Update();
+    }
+    SJ2_CHECK_EXCEPTION(recorder.Stop(), std::errc::no_space_on_device);
+  }
+
+  SECTION("Candump conversion")
+  {
+    // Setup
+    std::array<char, 64> line;
+    Can::Message_t standard = { .id = 0x12, .length = 3 };
+    standard.payload        = { 0xDE, 0xAD, 0x01 };
+    standard.uptime         = 1'500'000'123'456us;
+    Can::Message_t extended = { .id = 0x1ABC'DEF0 };
+    extended.format         = Can::Message_t::Format::kExtended;
+    Can::Message_t remote   = { .id = 0x7FF, .is_remote_request = true };
+
+    // Exercise + Verify
+    FormatCandump(standard, "can0", line);
+    CHECK(std::string_view("(0001500000.123456) can0 012#DEAD01") ==
+          line.data());
+    FormatCandump(extended, "vcan1", line);
+    CHECK(std::string_view("(0000000000.000000) vcan1 1ABCDEF0#") ==
+          line.data());
+    FormatCandump(remote, "can0", line);
+    CHECK(std::string_view("(0000000000.000000) can0 7FF#R") == line.data());
+
+    // Exercise: A whole log
+    recorder.Start();
+    send_frames(3);
+    recorder.Stop();
+    reader.Open();
+    FILE * output = tmpfile();
+    REQUIRE(output != nullptr);
+
+    // Verify
+    CHECK(3 == ConvertToCandump(reader, output, "can0", 10s));
+    rewind(output);
+    REQUIRE(fgets(line.data(), line.size(), output) != nullptr);
+    CHECK(std::string_view("(0000000010.000000) can0 100#0001020304050607"
+                           "\n") == line.data());
+    fclose(output);
+  }
+
+  SetUptimeFunction(DefaultUptime);
+}
+}  // namespace sjsu
@@ -0,0 +1,155 @@
+#include <array>
+
+#include "devices/communication/can_time_sync.hpp"
+#include "peripherals/linux/virtual_can.hpp"
+#include "testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing CAN time sync")
+{
+  VirtualCanBus bus(1_MHz);
+  VirtualCan master_can(bus);
+  VirtualCan slave_can(bus);
+  VirtualCan traffic_can(bus);
+  master_can.Initialize();
+  slave_can.Initialize();
+  traffic_can.Initialize();
+  SetUptimeFunction([&bus]() { return bus.Now(); });
+
+  // The slave's oscillator is 5ms ahead and runs 50 ppm fast.
+  slave_can.SetClock(5ms, 50);
+
+  CanTimeSyncMaster master(master_can, { .period = 10ms });
+  CanTimeSyncSlave slave;
+
+  bool send_traffic = false;
+
+  auto run = [&](std::chrono::nanoseconds duration) {
+    const auto kEnd = bus.Now() + duration;
+    for (uint32_t step = 0; bus.Now() < kEnd; step++)
+    {
+      if (send_traffic && step % 16 == 0)
+      {
+        traffic_can.TrySend({ .id = 0x001, .length = 8 });
+      }
+      master.Update();
+      bus.Run(20us);
+
+      std::array<Can::Message_t, 4> received;
+      for (size_t count = slave_can.Receive(received); count > 0;
+           count        = slave_can.Receive(received))
+      {
+        for (const auto & message : std::span(received).first(count))
+        {
+          slave.Process(message);
+        }
+      }
+    }
+  };
+
+  SECTION("Slave aligns to the master's clock")
+  {
+    // Setup: Higher priority traffic delays the SYNC frames by a varying
+    //        amount.
+    send_traffic = true;
+
+    // Exercise
+    run(1s);
+
+    // Verify
+    auto statistics = slave.GetStatistics();
+    CHECK(slave.IsSynchronized());
+    CHECK(0 == master.AbandonedExchanges());
+    CHECK(master.SentExchanges() == statistics.samples);
+    CHECK(90 < statistics.samples);
+    CHECK(0 == statistics.unmatched_follow_ups);
+    CHECK(50 == doctest::Approx(statistics.drift_ppm).epsilon(0.01));
+    CHECK(statistics.max_residual < 10us);
+    CHECK(statistics.rms_residual < 1us);
+    CHECK(std::chrono::abs(statistics.last_residual) < 100ns);
+
+    // Verify: Between exchanges, the slave's clock converts to the master's
+    for (int i = 0; i < 10; i++)
+    {
+      run(3ms);
+      CHECK(std::chrono::abs(slave.ToMasterTime(slave_can.Now()) - bus.Now()) <
+            10us);
+    }
+  }
+
+  SECTION("Not synchronized until two exchanges")
+  {
+    // Exercise
+    run(5ms);
+
+    // Verify
+    CHECK(1 == slave.GetStatistics().samples);
+    CHECK(!slave.IsSynchronized());
+    CHECK(std::chrono::abs(-5ms - slave.GetStatistics().offset) < 1us);
+  }
+
+  SECTION("FOLLOW_UP without a matching SYNC is ignored")
+  {
+    // Setup
+    constexpr uint32_t kSyncId = CanTimeSyncFormat::kDefaultSyncId;
+    Can::Message_t follow_up   = {};
+    follow_up.id               = CanTimeSyncFormat::FollowUpId(kSyncId);
+    follow_up.length           = 8;
+
+    // Exercise + Verify
+    CHECK(slave.Process(follow_up));
+    CHECK(!slave.Process({ .id = 0x123 }));
+
+    // Verify
+    CHECK(1 == slave.GetStatistics().unmatched_follow_ups);
+    CHECK(0 == slave.GetStatistics().samples);
+  }
+
+  SECTION("Exchange is abandoned if the SYNC frame is never transmitted")
+  {
+    // Setup: The stalled bus is never run, so nothing is transmitted on it
+    VirtualCanBus stalled_bus;
+    VirtualCan stalled_can(stalled_bus);
+    stalled_can.Initialize();
+    CanTimeSyncMaster stalled_master(stalled_can, { .timeout = 1ms });
+
+    // Exercise
+    stalled_master.Update();
+    bus.Run(2ms);
+    stalled_master.Update();
+
+    // Verify
+    CHECK(1 == stalled_master.AbandonedExchanges());
+    CHECK(0 == stalled_master.SentExchanges());
+  }
+
+  SECTION("SYNC waits for earlier frames to leave the transmit buffers")
+  {
+    // Setup
+    Can::TransmitStatistics_t statistics = { .in_flight = 1 };
+    Mock<Can> mock_can;
+    When(Method(mock_can, Can::GetTransmitStatistics))
+        .AlwaysDo([&statistics]() { return statistics; });
+    Fake(OverloadedMethod(mock_can, Can::Send, void(const Can::Message_t &)));
+    CanTimeSyncMaster busy_master(mock_can.get());
+
+    // Exercise
+    busy_master.Update();
+
+    // Verify: The next completion would be the earlier frame's
+    Verify(OverloadedMethod(mock_can, Can::Send, void(const Can::Message_t &)))
+        .Never();
+
+    // Exercise
+    statistics = { .completed = 1 };
+    busy_master.Update();
+
+    // Verify
+    Verify(OverloadedMethod(mock_can, Can::Send, void(const Can::Message_t &)))
+        .Once();
+  }
+
+  SetUptimeFunction(DefaultUptime);
+}
+}  // namespace sjsu
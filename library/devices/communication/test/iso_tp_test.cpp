@@ -0,0 +1,336 @@
+#include <array>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+#include "devices/communication/iso_tp.hpp"
+#include "testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing IsoTpSession")
+{
+  constexpr uint32_t kTransmitId = 0x7E0;
+  constexpr uint32_t kReceiveId  = 0x7E8;
+
+  std::chrono::nanoseconds now = 0ns;
+  SetUptimeFunction([&now]() { return now; });
+
+  std::vector<Can::Message_t> sent;
+  Mock<Can> mock_can;
+  When(OverloadedMethod(mock_can, Can::Send, void(const Can::Message_t &)))
+      .AlwaysDo([&sent](const Can::Message_t & message) {
+        sent.push_back(message);
+      });
+  When(Method(mock_can, Can::TrySend))
+      .AlwaysDo([&sent](const Can::Message_t & message) {
+        sent.push_back(message);
+        return true;
+      });
+
+  std::array<uint8_t, 27> payload;
+  std::iota(payload.begin(), payload.end(), 0);
+
+  auto make_frame = [](std::array<uint8_t, 8> data, uint8_t length = 8) {
+    Can::Message_t frame = { .id = kReceiveId, .length = length };
+    frame.payload        = data;
+    return frame;
+  };
+
+  SECTION("Single frame transmit")
+  {
+    // Setup
+    IsoTpSession session(mock_can.get(), kTransmitId, kReceiveId);
+
+    // Exercise
+    session.StartTransmit(std::span(payload).first(3));
+
+    // Verify
+    REQUIRE(1 == sent.size());
+    CHECK(kTransmitId == sent[0].id);
+    CHECK(8 == sent[0].length);
+    CHECK(std::array<uint8_t, 8>{ 0x03, 0, 1, 2, 0xCC, 0xCC, 0xCC, 0xCC } ==
+          sent[0].payload);
+    CHECK(IsoTpSession::Status::kComplete == session.TransmitStatus());
+  }
+
+  SECTION("Multi-frame transmit follows block size")
+  {
+    // Setup
+    IsoTpSession session(mock_can.get(), kTransmitId, kReceiveId);
+
+    // Exercise
+    session.StartTransmit(payload);
+    session.Update();
+
+    // Verify: Only the first frame is sent before flow control
+    REQUIRE(1 == sent.size());
+    CHECK(std::array<uint8_t, 8>{ 0x10, 27, 0, 1, 2, 3, 4, 5 } ==
+          sent[0].payload);
+
+    // Exercise: Allow two consecutive frames
+    CHECK(session.Process(make_frame({ 0x30, 2, 0 }, 3)));
+
+    // Verify
+    REQUIRE(3 == sent.size());
+    CHECK(std::array<uint8_t, 8>{ 0x21, 6, 7, 8, 9, 10, 11, 12 } ==
+          sent[1].payload);
+    CHECK(std::array<uint8_t, 8>{ 0x22, 13, 14, 15, 16, 17, 18, 19 } ==
+          sent[2].payload);
+    CHECK(IsoTpSession::Status::kInProgress == session.TransmitStatus());
+
+    // Exercise: Allow the rest
+    session.Update();
+    CHECK(3 == sent.size());
+    CHECK(session.Process(make_frame({ 0x30, 0, 0 }, 3)));
+
+    // Verify
+    REQUIRE(4 == sent.size());
+    CHECK(std::array<uint8_t, 8>{ 0x23, 20, 21, 22, 23, 24, 25, 26 } ==
+          sent[3].payload);
+    CHECK(IsoTpSession::Status::kComplete == session.TransmitStatus());
+  }
+
+  SECTION("Transmit honors separation time and times out")
+  {
+    // Setup
+    IsoTpSession session(mock_can.get(), kTransmitId, kReceiveId);
+    session.StartTransmit(payload);
+
+    // Exercise: 500us separation time
+    session.Process(make_frame({ 0x30, 0, 0xF5 }, 3));
+    session.Update();
+
+    // Verify
+    CHECK(2 == sent.size());
+    now += 500us;
+    session.Update();
+    CHECK(3 == sent.size());
+
+    // Exercise: Restart and never send flow control
+    now += 1ms;
+    session.Update();
+    sent.clear();
+    session.StartTransmit(payload);
+    now += 2s;
+    session.Update();
+
+    // Verify
+    CHECK(IsoTpSession::Status::kTimeout == session.TransmitStatus());
+    CHECK(1 == sent.size());
+  }
+
+  SECTION("Multi-frame receive into caller buffer")
+  {
+    // Setup
+    IsoTpSession session(mock_can.get(),
+                         kTransmitId,
+                         kReceiveId,
+                         { .block_size = 2, .separation_time = 2ms });
+    std::array<uint8_t, 32> buffer = {};
+    session.SetReceiveBuffer(buffer);
+
+    // Exercise
+    session.Process(make_frame({ 0x10, 27, 0, 1, 2, 3, 4, 5 }));
+
+    // Verify: Flow control with the session's block size and STmin, padded
+    //         to 8 bytes like every other frame
+    REQUIRE(1 == sent.size());
+    CHECK(8 == sent[0].length);
+    CHECK(0x30 == sent[0].payload[0]);
+    CHECK(2 == sent[0].payload[1]);
+    CHECK(2 == sent[0].payload[2]);
+    CHECK(0xCC == sent[0].payload[3]);
+    CHECK(0xCC == sent[0].payload[7]);
+
+    // Exercise
+    session.Process(make_frame({ 0x21, 6, 7, 8, 9, 10, 11, 12 }));
+    session.Process(make_frame({ 0x22, 13, 14, 15, 16, 17, 18, 19 }));
+
+    // Verify: Another flow control after the block
+    CHECK(2 == sent.size());
+    CHECK(IsoTpSession::Status::kInProgress == session.ReceiveStatus());
+
+    // Exercise
+    session.Process(make_frame({ 0x23, 20, 21, 22, 23, 24, 25, 26 }));
+
+    // Verify
+    CHECK(IsoTpSession::Status::kComplete == session.ReceiveStatus());
+    REQUIRE(27 == session.ReceivedPayload().size());
+    CHECK(buffer.data() == session.ReceivedPayload().data());
+    CHECK(std::equal(payload.begin(), payload.end(), buffer.begin()));
+
+    // Exercise: Messages are refused until the buffer is handed back
+    session.Process(make_frame({ 0x02, 0xAA, 0xBB }, 3));
+    CHECK(0 == buffer[0]);
+    session.SetReceiveBuffer(buffer);
+    session.Process(make_frame({ 0x02, 0xAA, 0xBB }, 3));
+    CHECK(2 == session.ReceivedPayload().size());
+    CHECK(0xAA == buffer[0]);
+  }
+
+  SECTION("Receive errors")
+  {
+    // Setup
+    IsoTpSession session(mock_can.get(), kTransmitId, kReceiveId);
+    std::array<uint8_t, 16> buffer;
+    session.SetReceiveBuffer(buffer);
+
+    SECTION("Overflow")
+    {
+      // Exercise
+      session.Process(make_frame({ 0x10, 27, 0, 1, 2, 3, 4, 5 }));
+
+      // Verify
+      REQUIRE(1 == sent.size());
+      CHECK(0x32 == sent[0].payload[0]);
+      CHECK(IsoTpSession::Status::kOverflow == session.ReceiveStatus());
+    }
+
+    SECTION("Sequence error")
+    {
+      // Exercise
+      session.Process(make_frame({ 0x10, 14, 0, 1, 2, 3, 4, 5 }));
+      session.Process(make_frame({ 0x22, 6, 7, 8, 9, 10, 11, 12 }));
+
+      // Verify
+      CHECK(IsoTpSession::Status::kProtocolError == session.ReceiveStatus());
+    }
+
+    SECTION("Timeout")
+    {
+      // Exercise
+      session.Process(make_frame({ 0x10, 14, 0, 1, 2, 3, 4, 5 }));
+      now += 2s;
+      session.Update();
+
+      // Verify
+      CHECK(IsoTpSession::Status::kTimeout == session.ReceiveStatus());
+    }
+
+    SECTION("Other IDs are ignored")
+    {
+      // Setup
+      auto frame = make_frame({ 0x02, 0xAA, 0xBB }, 3);
+      frame.id   = kTransmitId;
+
+      // Exercise + Verify
+      CHECK(!session.Process(frame));
+      CHECK(IsoTpSession::Status::kIdle == session.ReceiveStatus());
+    }
+  }
+
+  SECTION("Separation time encoding")
+  {
+    CHECK(0x00 == IsoTpSession::EncodeSeparationTime(50us));
+    CHECK(0xF3 == IsoTpSession::EncodeSeparationTime(300us));
+    CHECK(0x05 == IsoTpSession::EncodeSeparationTime(5ms));
+    CHECK(0x7F == IsoTpSession::EncodeSeparationTime(500ms));
+    CHECK(900us == IsoTpSession::DecodeSeparationTime(0xF9));
+    CHECK(20ms == IsoTpSession::DecodeSeparationTime(20));
+    CHECK(127ms == IsoTpSession::DecodeSeparationTime(0xFA));
+  }
+
+  SetUptimeFunction(DefaultUptime);
+}
+
+TEST_CASE("Testing IsoTp")
+{
+  // Two CAN peripherals wired to each other
+  std::deque<Can::Message_t> to_a;
+  std::deque<Can::Message_t> to_b;
+
+  auto wire = [](Mock<Can> & mock_can,
+                 std::deque<Can::Message_t> & inbox,
+                 std::deque<Can::Message_t> & outbox) {
+    When(OverloadedMethod(mock_can, Can::Send, void(const Can::Message_t &)))
+        .AlwaysDo([&outbox](const Can::Message_t & message) {
+          outbox.push_back(message);
+        });
+    When(Method(mock_can, Can::TrySend))
+        .AlwaysDo([&outbox](const Can::Message_t & message) {
+          outbox.push_back(message);
+          return true;
+        });
+    When(OverloadedMethod(
+             mock_can, Can::Receive, size_t(std::span<Can::Message_t>)))
+        .AlwaysDo([&inbox](std::span<Can::Message_t> messages) {
+          size_t count = 0;
+          while (count < messages.size() && !inbox.empty())
+          {
+            messages[count++] = inbox.front();
+            inbox.pop_front();
+          }
+          return count;
+        });
+  };
+
+  Mock<Can> mock_can_a;
+  Mock<Can> mock_can_b;
+  wire(mock_can_a, to_a, to_b);
+  wire(mock_can_b, to_b, to_a);
+
+  IsoTp network_a(mock_can_a.get());
+  IsoTp network_b(mock_can_b.get());
+
+  // Two concurrent sessions, one with flow control every 4 frames
+  IsoTpSession a1(mock_can_a.get(), 0x100, 0x101);
+  IsoTpSession a2(mock_can_a.get(), 0x200, 0x201);
+  IsoTpSession b1(mock_can_b.get(), 0x101, 0x100);
+  IsoTpSession b2(mock_can_b.get(), 0x201, 0x200, { .block_size = 4 });
+  network_a.Attach(a1);
+  network_a.Attach(a2);
+  network_b.Attach(b1);
+  network_b.Attach(b2);
+
+  std::array<uint8_t, 300> payload1;
+  std::array<uint8_t, 5000> payload2;
+  std::iota(payload1.begin(), payload1.end(), 0);
+  std::iota(payload2.begin(), payload2.end(), 7);
+
+  std::array<uint8_t, 300> buffer1;
+  std::array<uint8_t, 5000> buffer2;
+  b1.SetReceiveBuffer(buffer1);
+  b2.SetReceiveBuffer(buffer2);
+
+  // Exercise
+  a1.StartTransmit(payload1);
+  a2.StartTransmit(payload2);
+
+  while (a1.TransmitStatus() == IsoTpSession::Status::kInProgress ||
+         a2.TransmitStatus() == IsoTpSession::Status::kInProgress)
+  {
+    network_a.Poll();
+    network_b.Poll();
+  }
+  network_b.Poll();
+
+  // Verify
+  CHECK(IsoTpSession::Status::kComplete == a1.TransmitStatus());
+  CHECK(IsoTpSession::Status::kComplete == a2.TransmitStatus());
+  CHECK(IsoTpSession::Status::kComplete == b1.ReceiveStatus());
+  CHECK(IsoTpSession::Status::kComplete == b2.ReceiveStatus());
+  CHECK(payload1 == buffer1);
+  CHECK(payload2 == buffer2);
+
+  SECTION("Attach limit")
+  {
+    for (size_t i = 2; i < IsoTp::kMaximumSessions; i++)
+    {
+      network_a.Attach(a1);
+    }
+    SJ2_CHECK_EXCEPTION(network_a.Attach(a1), std::errc::not_enough_memory);
+  }
+
+  SECTION("Poll() refuses to share the CAN peripheral with a handler")
+  {
+    // Setup
+    Fake(Method(mock_can_a, Can::ModuleInitialize));
+    mock_can_a.get().settings.handler = [](Can &) {};
+    mock_can_a.get().Initialize();
+
+    // Exercise + Verify
+    SJ2_CHECK_EXCEPTION(network_a.Poll(), std::errc::device_or_resource_busy);
+  }
+}
+}  // namespace sjsu
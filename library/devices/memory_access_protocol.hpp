@@ -3,13 +3,16 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <span>
 #include <type_traits>
 #include <utility>
 
+#include "peripherals/gpio.hpp"
 #include "peripherals/i2c.hpp"
+#include "peripherals/spi.hpp"
 #include "utility/math/byte.hpp"
 #include "utility/enum.hpp"
 #include "utility/error_handling.hpp"
@@ -488,6 +491,342 @@ class I2cProtocol : public MemoryAccessProtocol
   sjsu::I2c & i2c_;
 };
 
+/// Generic MemoryAccessProtocol for register based SPI devices.
+///
+/// Most SPI sensors and memories place a read/write flag and, optionally, an
+/// auto-increment (multi-byte) flag within the first byte of the address. The
+/// Format_t passed to the constructor describes which bits to set for each
+/// type of access.
+///
+/// Each access is performed with a single Spi::Transfer() within a single
+/// chip select window, so reading or writing a burst of registers costs one
+/// transaction regardless of its length.
+///
+/// The SPI peripheral and the chip select Gpio must be initialized and the chip
+/// select must be set as an output before performing any accesses.
+///
+/// @tparam MaximumPayloadSize - the largest number of bytes that will be read
+///         or written in a single access.
+template <size_t MaximumPayloadSize = 1>
+class SpiProtocol : public MemoryAccessProtocol
+{
+ public:
+  /// Describes how a device expects the access type to be encoded within the
+  /// first byte of the address.
+  struct Format_t
+  {
+    /// Bits to set in the first address byte for read operations
+    uint8_t read_mask = 0b1000'0000;
+    /// Bits to set in the first address byte for write operations
+    uint8_t write_mask = 0b0000'0000;
+    /// Bits to set in the first address byte when more than one byte is
+    /// accessed, enabling the device's address auto-increment.
+    uint8_t auto_increment_mask = 0b0000'0000;
+  };
+
+  /// @param spi - SPI peripheral to use
+  /// @param chip_select - chip select of the device. Active low.
+  /// @param format - how reads, writes and auto-increment are encoded in the
+  ///        address.
+  constexpr SpiProtocol(sjsu::Spi & spi,
+                        sjsu::Gpio & chip_select,
+                        Format_t format = {})
+      : spi_(spi), chip_select_(chip_select), format_(format)
+  {
+  }
+
+  void Write(std::span<const uint8_t> address,
+             std::span<const uint8_t> value) override
+  {
+    auto buffer = Prepare(address, value.size(), format_.write_mask);
+    std::copy(value.begin(), value.end(), buffer.begin() + address.size());
+
+    Transfer(std::span<uint8_t>(buffer).first(address.size() + value.size()));
+  }
+
+  void Read(std::span<const uint8_t> address,
+            std::span<uint8_t> receive) override
+  {
+    auto buffer = Prepare(address, receive.size(), format_.read_mask);
+
+    Transfer(std::span<uint8_t>(buffer).first(address.size() + receive.size()));
+
+    std::copy_n(buffer.begin() + address.size(), receive.size(),
+                receive.begin());
+  }
+
+ private:
+  static constexpr auto kBufferSize =
+      MemoryAccessProtocol::kAddressSizeLimit + MaximumPayloadSize;
+
+  std::array<uint8_t, kBufferSize> Prepare(std::span<const uint8_t> address,
+                                           size_t payload_size,
+                                           uint8_t access_mask)
+  {
+    if (address.size() + payload_size > kBufferSize)
+    {
+      throw Exception(
+          std::errc::not_enough_memory,
+          "SpiProtocol Object does not have enough buffer storage to "
+          "perform this operation.");
+    }
+
+    std::array<uint8_t, kBufferSize> buffer = {};
+    std::copy(address.begin(), address.end(), buffer.begin());
+
+    buffer[0] = static_cast<uint8_t>(buffer[0] | access_mask);
+
+    if (payload_size > 1)
+    {
+      buffer[0] = static_cast<uint8_t>(buffer[0] | format_.auto_increment_mask);
+    }
+
+    return buffer;
+  }
+
+  void Transfer(std::span<uint8_t> buffer)
+  {
+    chip_select_.SetLow();
+    spi_.Transfer(buffer);
+    chip_select_.SetHigh();
+  }
+
+  sjsu::Spi & spi_;
+  sjsu::Gpio & chip_select_;
+  Format_t format_;
+};
+
+/// Write-back cache that sits in front of another MemoryAccessProtocol. Reads
+/// of registers that have already been seen are served from a local shadow
+/// copy and writes only update the shadow copy and mark the bytes as dirty.
+/// Calling Flush() will write every dirty byte back to the device, coalescing
+/// adjacent dirty registers into single auto-increment burst writes.
+///
+/// This makes read-modify-write sequences, like `memory[kReg] |= 0b100`, cost
+/// zero bus transactions after the first read of the register.
+///
+/// Registers whose contents can change without the host writing to them
+/// (status, data, interrupt flags, etc) should be marked as volatile using
+/// SetVolatile(). Volatile registers are never cached and all accesses to them
+/// go directly to the device.
+///
+/// @tparam kMapSize - number of bytes of device memory to shadow, starting at
+///         the base address passed to the constructor.
+template <size_t kMapSize = 256>
+class ShadowRegisterMap : public MemoryAccessProtocol
+{
+ public:
+  /// @param protocol - the memory access protocol used to communicate with the
+  ///        device.
+  /// @param specification - address width and endianness of the device's
+  ///        memory map.
+  /// @param base_address - first address of device memory to shadow.
+  /// @param maximum_burst - the maximum number of payload bytes the underlying
+  ///        protocol can write in a single transaction. For example, an
+  ///        I2cProtocol<N> can write at most N bytes in one transaction.
+  template <AddressWidth address_width, std::endian endianness>
+  constexpr ShadowRegisterMap(
+      MemoryAccessProtocol & protocol,
+      Specification_t<address_width, endianness> specification,
+      uint32_t base_address = 0,
+      size_t maximum_burst  = kMapSize)
+      : protocol_(protocol),
+        address_width_(Value(specification.AddressWidth())),
+        endianness_(specification.Endianness()),
+        base_address_(base_address),
+        maximum_burst_(std::max(maximum_burst, size_t{ 1 }))
+  {
+  }
+
+  /// Mark a register as volatile (or not). Volatile registers will not be
+  /// cached and every read or write to them will be passed directly to the
+  /// device.
+  ///
+  /// @param address - the register to change
+  /// @param is_volatile - true to bypass the cache for this register.
+  template <AddressWidth address_width, std::endian endianness>
+  void SetVolatile(const Address<address_width, endianness> & address,
+                   bool is_volatile = true)
+  {
+    const uint32_t kLocation = ToInteger<uint32_t>(endianness, address.address);
+
+    for (size_t i = 0; i < address.width; i++)
+    {
+      if (InWindow(kLocation + i))
+      {
+        const size_t kOffset = kLocation + i - base_address_;
+        volatile_[kOffset]   = is_volatile;
+        valid_[kOffset]      = false;
+        dirty_[kOffset]      = false;
+      }
+    }
+  }
+
+  /// Write every dirty byte in the shadow copy back to the device. Runs of
+  /// adjacent dirty bytes are written using a single transaction, up to the
+  /// maximum_burst size given in the constructor.
+  void Flush()
+  {
+    size_t offset = 0;
+
+    while (offset < kMapSize)
+    {
+      if (!dirty_[offset])
+      {
+        offset++;
+        continue;
+      }
+
+      const size_t kStart = offset;
+      while (offset < kMapSize && dirty_[offset] &&
+             (offset - kStart) < maximum_burst_)
+      {
+        offset++;
+      }
+
+      const size_t kLength = offset - kStart;
+      const auto kAddress =
+          ToByteArray<uint32_t>(endianness_, base_address_ + kStart);
+
+      const auto kPayload =
+          std::span<const uint8_t>(shadow_).subspan(kStart, kLength);
+
+      protocol_.Write(ByteArrayToSpan(endianness_, kAddress, address_width_),
+                      kPayload);
+
+      for (size_t i = kStart; i < offset; i++)
+      {
+        dirty_[i] = false;
+      }
+    }
+  }
+
+  /// Discard all cached register values that are not waiting to be written to
+  /// the device. The next read of each register will be fetched from the
+  /// device. Pending dirty bytes are kept until Flush() is called.
+  void Invalidate()
+  {
+    valid_ &= dirty_;
+  }
+
+  /// @return true - if there are writes waiting to be flushed to the device.
+  bool IsDirty() const
+  {
+    return dirty_.any();
+  }
+
+  void Write(std::span<const uint8_t> address,
+             std::span<const uint8_t> payload) override
+  {
+    const uint32_t kLocation = ToInteger<uint32_t>(endianness_, address);
+
+    if (IsCacheable(kLocation, payload.size()))
+    {
+      const size_t kOffset = kLocation - base_address_;
+      for (size_t i = 0; i < payload.size(); i++)
+      {
+        shadow_[kOffset + i] = payload[i];
+        valid_[kOffset + i]  = true;
+        dirty_[kOffset + i]  = true;
+      }
+      return;
+    }
+
+    protocol_.Write(address, payload);
+
+    // The device now holds these values, so any shadowed bytes overlapping
+    // this write are no longer dirty.
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+      if (IsShadowed(kLocation + i))
+      {
+        const size_t kOffset = kLocation + i - base_address_;
+        shadow_[kOffset]     = payload[i];
+        valid_[kOffset]      = true;
+        dirty_[kOffset]      = false;
+      }
+    }
+  }
+
+  void Read(std::span<const uint8_t> address,
+            std::span<uint8_t> payload) override
+  {
+    const uint32_t kLocation = ToInteger<uint32_t>(endianness_, address);
+
+    if (IsCacheable(kLocation, payload.size()))
+    {
+      const size_t kOffset = kLocation - base_address_;
+      bool all_valid       = true;
+
+      for (size_t i = 0; i < payload.size(); i++)
+      {
+        all_valid = all_valid && valid_[kOffset + i];
+      }
+
+      if (all_valid)
+      {
+        std::copy_n(shadow_.begin() + kOffset, payload.size(), payload.begin());
+        return;
+      }
+    }
+
+    protocol_.Read(address, payload);
+
+    // Dirty bytes have not made it to the device yet, so the shadow copy is
+    // the most up to date version of them. Every other shadowed byte is
+    // updated with the value just read from the device.
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+      if (IsShadowed(kLocation + i))
+      {
+        const size_t kOffset = kLocation + i - base_address_;
+        if (dirty_[kOffset])
+        {
+          payload[i] = shadow_[kOffset];
+        }
+        else
+        {
+          shadow_[kOffset] = payload[i];
+          valid_[kOffset]  = true;
+        }
+      }
+    }
+  }
+
+ private:
+  bool InWindow(uint32_t location) const
+  {
+    return location >= base_address_ && (location - base_address_) < kMapSize;
+  }
+
+  bool IsShadowed(uint32_t location) const
+  {
+    return InWindow(location) && !volatile_[location - base_address_];
+  }
+
+  bool IsCacheable(uint32_t location, size_t length) const
+  {
+    for (size_t i = 0; i < length; i++)
+    {
+      if (!IsShadowed(static_cast<uint32_t>(location + i)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  MemoryAccessProtocol & protocol_;
+  uint8_t address_width_;
+  std::endian endianness_;
+  uint32_t base_address_;
+  size_t maximum_burst_;
+  std::array<uint8_t, kMapSize> shadow_ = {};
+  std::bitset<kMapSize> valid_;
+  std::bitset<kMapSize> dirty_;
+  std::bitset<kMapSize> volatile_;
+};
+
 /// Used to validate at compile time a set of addresses do not overlap in
 /// memory.
 ///
@@ -515,4 +854,249 @@ constexpr bool NoRegistersOverlap(
   }
   return true;
 }
+
+/// A list of registers that are read together. At compile time, registers
+/// whose address ranges are adjacent (or overlap) are fused into a single
+/// burst read so that fetching every register in the group costs the minimum
+/// number of transactions.
+///
+/// Usage:
+///
+///   static constexpr auto kData = RegisterGroup(Map::kStatus, Map::kXYZ);
+///
+///   auto snapshot                 = kData.Read(memory);
+///   uint8_t status                = snapshot[Map::kStatus];
+///   std::array<int16_t, 3> xyz    = snapshot[Map::kXYZ];
+///
+/// @tparam address_width - number of bytes that represent the address
+/// @tparam endianness - the endianness of the memory
+/// @tparam kRegisterCount - number of registers in the group
+/// @tparam kBufferSize - number of bytes reserved to hold the contents of every
+///         register in the group. Defaults to enough space for each register to
+///         be a 64-bit integer.
+template <MemoryAccessProtocol::AddressWidth address_width,
+          std::endian endianness,
+          size_t kRegisterCount,
+          size_t kBufferSize = kRegisterCount * sizeof(uint64_t)>
+class RegisterGroup
+{
+ public:
+  /// Shorthand for the address type accepted by this group
+  using Address_t = MemoryAccessProtocol::Address<address_width, endianness>;
+
+  /// A single contiguous read operation
+  struct Burst_t
+  {
+    /// Address of the first byte to read
+    uint32_t address = 0;
+    /// Number of bytes to read
+    size_t length = 0;
+    /// Where the bytes of this burst are stored in the snapshot buffer
+    size_t offset = 0;
+  };
+
+  /// Holds the bytes of every register in the group after a Read() and decodes
+  /// them into integers or arrays using the memory's endianness.
+  class Snapshot
+  {
+   public:
+    /// View of a single register's bytes within the snapshot. Implicitly
+    /// converts to the same types an AccessHandler can be read as.
+    class Field
+    {
+     public:
+      /// @param bytes - the bytes of the register within the snapshot.
+      explicit constexpr Field(std::span<const uint8_t> bytes) : bytes_(bytes)
+      {
+      }
+
+      /// @return the contents of the register as an integer
+      template <typename Integer>
+      operator Integer() const
+      {
+        return ToInteger<Integer>(endianness, bytes_);
+      }
+
+      /// @return the contents of the register as an array of bytes
+      template <size_t N>
+      operator std::array<uint8_t, N>() const
+      {
+        std::array<uint8_t, N> result = {};
+        std::copy_n(bytes_.begin(), std::min(N, bytes_.size()), result.begin());
+        return result;
+      }
+
+      /// @return the contents of the register as an array of integers
+      template <typename T, size_t N>
+      operator std::array<T, N>() const
+      {
+        const size_t kLength = std::min(N * sizeof(T), bytes_.size());
+        return ToIntegerArray<T, N>(endianness, bytes_.first(kLength));
+      }
+
+     private:
+      std::span<const uint8_t> bytes_;
+    };
+
+    /// @param bursts - the bursts of the register group this snapshot was
+    ///        taken from. Copied, so the snapshot outlives the group.
+    explicit constexpr Snapshot(std::span<const Burst_t> bursts)
+        : burst_count_(bursts.size())
+    {
+      std::copy(bursts.begin(), bursts.end(), bursts_.begin());
+    }
+
+    /// @param device_register - register to retrieve from the snapshot. Must
+    ///        be located within one of the group's bursts.
+    /// @return Field - view of the register's bytes.
+    Field operator[](const Address_t & device_register) const
+    {
+      const auto kLocation =
+          ToInteger<uint32_t>(endianness, device_register.address);
+      const size_t kOffset = Locate(kLocation, device_register.width);
+      return Field(std::span<const uint8_t>(bytes).subspan(
+          kOffset, device_register.width));
+    }
+
+    /// Raw contents of the bursts, stored back to back.
+    std::array<uint8_t, kBufferSize> bytes = {};
+
+   private:
+    size_t Locate(uint32_t location, size_t width) const
+    {
+      for (size_t i = 0; i < burst_count_; i++)
+      {
+        const Burst_t & burst = bursts_[i];
+        if (location >= burst.address &&
+            location + width <= burst.address + burst.length)
+        {
+          return burst.offset + (location - burst.address);
+        }
+      }
+
+      throw Exception(std::errc::invalid_argument,
+                      "Register is not a part of this RegisterGroup.");
+    }
+
+    std::array<Burst_t, kRegisterCount> bursts_ = {};
+    size_t burst_count_                         = 0;
+  };
+
+  /// @param registers - list of registers to be read together. May be given in
+  ///        any order.
+  template <typename... Registers,
+            typename = std::enable_if_t<
+                (std::is_same_v<Registers, Address_t> && ...)>>
+  explicit constexpr RegisterGroup(const Registers &... registers)
+  {
+    std::array<Address_t, kRegisterCount> list = { registers... };
+    std::array<uint32_t, kRegisterCount> starts = {};
+    std::array<uint32_t, kRegisterCount> ends   = {};
+
+    for (size_t i = 0; i < kRegisterCount; i++)
+    {
+      starts[i] = ToInteger<uint32_t>(endianness, list[i].address);
+      ends[i]   = starts[i] + list[i].width;
+    }
+
+    // Insertion sort the ranges by their start address
+    for (size_t i = 1; i < kRegisterCount; i++)
+    {
+      for (size_t j = i; j > 0 && starts[j - 1] > starts[j]; j--)
+      {
+        std::swap(starts[j - 1], starts[j]);
+        std::swap(ends[j - 1], ends[j]);
+      }
+    }
+
+    // Fuse adjacent and overlapping ranges into bursts
+    uint32_t burst_start = starts[0];
+    uint32_t burst_end   = ends[0];
+
+    for (size_t i = 1; i <= kRegisterCount; i++)
+    {
+      if (i < kRegisterCount && starts[i] <= burst_end)
+      {
+        burst_end = std::max(burst_end, ends[i]);
+        continue;
+      }
+
+      bursts_[burst_count_] = {
+        .address = burst_start,
+        .length  = burst_end - burst_start,
+        .offset  = total_bytes_,
+      };
+      total_bytes_ += burst_end - burst_start;
+      burst_count_++;
+
+      if (i < kRegisterCount)
+      {
+        burst_start = starts[i];
+        burst_end   = ends[i];
+      }
+    }
+
+    if (total_bytes_ > kBufferSize)
+    {
+      throw Exception(std::errc::not_enough_memory,
+                      "RegisterGroup kBufferSize is too small to hold every "
+                      "register in the group.");
+    }
+  }
+
+  /// Read every register in the group using the minimum number of bursts.
+  ///
+  /// @param memory - memory access protocol to read the registers from.
+  /// @return Snapshot - contents of the registers.
+  Snapshot Read(MemoryAccessProtocol & memory) const
+  {
+    Snapshot snapshot(Bursts());
+
+    for (size_t i = 0; i < burst_count_; i++)
+    {
+      constexpr size_t kAddressWidth = Value(address_width);
+
+      const auto & burst  = bursts_[i];
+      const auto kAddress = ToByteArray<uint32_t, kAddressWidth>(endianness,
+                                                                 burst.address);
+      const auto kPayload = std::span<uint8_t>(snapshot.bytes)
+                                .subspan(burst.offset, burst.length);
+
+      memory.Read(kAddress, kPayload);
+    }
+
+    return snapshot;
+  }
+
+  /// @return the number of read transactions needed to read the group.
+  constexpr size_t BurstCount() const
+  {
+    return burst_count_;
+  }
+
+  /// @return the bursts performed by Read()
+  constexpr std::span<const Burst_t> Bursts() const
+  {
+    return std::span<const Burst_t>(bursts_.data(), burst_count_);
+  }
+
+  /// @return the total number of bytes read by Read()
+  constexpr size_t TotalBytes() const
+  {
+    return total_bytes_;
+  }
+
+ private:
+  std::array<Burst_t, kRegisterCount> bursts_ = {};
+  size_t burst_count_                         = 0;
+  size_t total_bytes_                         = 0;
+};
+
+/// Deduction guide to allow `RegisterGroup(kRegisterA, kRegisterB, ...)`
+template <MemoryAccessProtocol::AddressWidth address_width,
+          std::endian endianness,
+          typename... Rest>
+RegisterGroup(const MemoryAccessProtocol::Address<address_width, endianness> &,
+              const Rest &...)
+    -> RegisterGroup<address_width, endianness, 1 + sizeof...(Rest)>;
 }  // namespace sjsu
@@ -1,5 +1,6 @@
 #include <numeric>
 #include <string>
+#include <vector>
 
 #include "devices/memory_access_protocol.hpp"
 #include "testing/testing_frameworks.hpp"
@@ -697,6 +698,432 @@ TEST_CASE_TEMPLATE("Testing MemoryAccessProtocol",
     }
   }
 }
+
+TEST_CASE("Testing ShadowRegisterMap")
+{
+  // Setup
+  // Setup: Wrap the mock protocol in order to count how many transactions make
+  //        it to the bus.
+  class CountingProtocol : public MemoryAccessProtocol
+  {
+   public:
+    void Write(std::span<const uint8_t> address,
+               std::span<const uint8_t> payload) override
+    {
+      writes++;
+      last_write_size = payload.size();
+      device.Write(address, payload);
+    }
+
+    void Read(std::span<const uint8_t> address,
+              std::span<uint8_t> payload) override
+    {
+      reads++;
+      device.Read(address, payload);
+    }
+
+    MockProtocol<MemoryAccessProtocol::AddressWidth::kByte1> device;
+    size_t writes          = 0;
+    size_t reads           = 0;
+    size_t last_write_size = 0;
+  };
+
+  constexpr auto kControl1 =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x20, .width = 1 });
+  constexpr auto kControl2 =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x21, .width = 1 });
+  constexpr auto kControl3 =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x22, .width = 2 });
+  constexpr auto kStatus =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x24, .width = 1 });
+  constexpr auto kThreshold =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x30, .width = 1 });
+
+  CountingProtocol bus;
+  bus.device.memory_map.fill(0);
+
+  ShadowRegisterMap<64> shadow(bus, kSpec1, 0x00);
+
+  // Setup: Sequence of bit field changes a driver would perform when
+  //        configuring a device.
+  auto configure = [&](MemoryAccessProtocol & memory) {
+    memory[kControl1] |= uint8_t{ 0b0000'0001 };
+    memory[kControl1] |= uint8_t{ 0b0000'0100 };
+    memory[kControl1] &= uint8_t{ 0b1111'1110 };
+    memory[kControl2] |= uint8_t{ 0b1000'0000 };
+    memory[kControl2] |= uint8_t{ 0b0000'0010 };
+    memory[kControl2] ^= uint8_t{ 0b0000'0011 };
+    memory[kControl3] |= uint16_t{ 0x1200 };
+    memory[kControl3] |= uint16_t{ 0x0034 };
+    memory[kControl3] &= uint16_t{ 0xFF0F };
+    memory[kThreshold] |= uint8_t{ 0x0F };
+    memory[kThreshold] &= uint8_t{ 0x0C };
+    memory[kThreshold] |= uint8_t{ 0x30 };
+  };
+
+  SECTION("Read-modify-write sequence uses fewer bus transactions")
+  {
+    // Setup: Run the sequence directly on the bus to get the baseline.
+    configure(bus);
+    const size_t kDirectTransactions = bus.reads + bus.writes;
+    const auto kExpectedMemory       = bus.device.memory_map;
+
+    bus.device.memory_map.fill(0);
+    bus.reads  = 0;
+    bus.writes = 0;
+
+    // Exercise
+    configure(shadow);
+    const size_t kBeforeFlushWrites = bus.writes;
+    shadow.Flush();
+
+    // Verify
+    // Verify: 12 reads + 12 writes without the shadow map.
+    CHECK(24 == kDirectTransactions);
+    // Verify: One read per register touched and no writes until Flush().
+    CHECK(4 == bus.reads);
+    CHECK(0 == kBeforeFlushWrites);
+    // Verify: kControl1, kControl2 and kControl3 are adjacent and are written
+    //         using a single burst. kThreshold is written on its own.
+    CHECK(2 == bus.writes);
+    CHECK(kExpectedMemory == bus.device.memory_map);
+    CHECK(!shadow.IsDirty());
+  }
+
+  SECTION("Adjacent dirty registers are coalesced into one burst write")
+  {
+    // Exercise
+    shadow[kControl1] = uint8_t{ 0xAA };
+    shadow[kControl2] = uint8_t{ 0xBB };
+    shadow[kControl3] = uint16_t{ 0xCCDD };
+    CHECK(shadow.IsDirty());
+    shadow.Flush();
+
+    // Verify
+    CHECK(0 == bus.reads);
+    CHECK(1 == bus.writes);
+    CHECK(4 == bus.last_write_size);
+    CHECK(0xAA == bus.device.memory_map[0x20]);
+    CHECK(0xBB == bus.device.memory_map[0x21]);
+    CHECK(0xCC == bus.device.memory_map[0x22]);
+    CHECK(0xDD == bus.device.memory_map[0x23]);
+  }
+
+  SECTION("Bursts are limited to the maximum burst size")
+  {
+    // Setup
+    ShadowRegisterMap<64> limited_shadow(bus, kSpec1, 0x00, 2);
+
+    // Exercise
+    limited_shadow[kControl1] = uint8_t{ 0xAA };
+    limited_shadow[kControl2] = uint8_t{ 0xBB };
+    limited_shadow[kControl3] = uint16_t{ 0xCCDD };
+    limited_shadow.Flush();
+
+    // Verify
+    CHECK(2 == bus.writes);
+    CHECK(2 == bus.last_write_size);
+    CHECK(0xDD == bus.device.memory_map[0x23]);
+  }
+
+  SECTION("Volatile registers bypass the cache")
+  {
+    // Setup
+    shadow.SetVolatile(kStatus);
+    bus.device.memory_map[0x24] = 0x11;
+
+    // Exercise
+    uint8_t first_read          = shadow[kStatus];
+    bus.device.memory_map[0x24] = 0x22;
+    uint8_t second_read         = shadow[kStatus];
+    shadow[kStatus]             = uint8_t{ 0x33 };
+
+    // Verify
+    CHECK(0x11 == first_read);
+    CHECK(0x22 == second_read);
+    CHECK(2 == bus.reads);
+    CHECK(1 == bus.writes);
+    CHECK(0x33 == bus.device.memory_map[0x24]);
+    CHECK(!shadow.IsDirty());
+  }
+
+  SECTION("Cached reads do not touch the bus")
+  {
+    // Setup
+    bus.device.memory_map[0x30] = 0x5A;
+
+    // Exercise
+    uint8_t first_read          = shadow[kThreshold];
+    bus.device.memory_map[0x30] = 0x00;
+    uint8_t second_read         = shadow[kThreshold];
+
+    // Verify
+    CHECK(0x5A == first_read);
+    CHECK(0x5A == second_read);
+    CHECK(1 == bus.reads);
+  }
+
+  SECTION("Invalidate() keeps pending writes")
+  {
+    // Setup
+    bus.device.memory_map[0x20] = 0x01;
+    bus.device.memory_map[0x21] = 0x02;
+    uint8_t unused              = shadow[kControl1];
+    static_cast<void>(unused);
+    shadow[kControl2] = uint8_t{ 0x55 };
+
+    // Exercise
+    shadow.Invalidate();
+    bus.device.memory_map[0x20] = 0x0F;
+    std::array<uint8_t, 2> both = shadow[MemoryAccessProtocol::Address(
+        kSpec1, { .address = 0x20, .width = 2 })];
+
+    // Verify
+    // Verify: kControl1 is fetched again from the device, while kControl2
+    //         still reflects the value waiting to be flushed.
+    CHECK(0x0F == both[0]);
+    CHECK(0x55 == both[1]);
+    CHECK(2 == bus.reads);
+  }
+}
+
+TEST_CASE("Testing RegisterGroup")
+{
+  // Setup
+  constexpr auto kStatus =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x00, .width = 1 });
+  constexpr auto kXYZ =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x01, .width = 6 });
+  constexpr auto kWhoAmI =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x0D, .width = 1 });
+  constexpr auto kConfig =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x0E, .width = 1 });
+  constexpr auto kLittleEndianWord =
+      MemoryAccessProtocol::Address(kSpec5, { .address = 0x10, .width = 2 });
+
+  class CountingProtocol
+      : public MockProtocol<MemoryAccessProtocol::AddressWidth::kByte1>
+  {
+   public:
+    void Read(std::span<const uint8_t> address,
+              std::span<uint8_t> payload) override
+    {
+      reads++;
+      MockProtocol::Read(address, payload);
+    }
+
+    size_t reads = 0;
+  };
+
+  CountingProtocol memory;
+  memory.memory_map.fill(0);
+  std::array<uint8_t, 8> device_data = { 0x05, 0x12, 0x30, 0xFE,
+                                         0xD0, 0x01, 0x00 };
+  std::copy(device_data.begin(), device_data.end(), memory.memory_map.begin());
+  memory.memory_map[0x0D] = 0x2A;
+  memory.memory_map[0x0E] = 0x01;
+  memory.memory_map[0x10] = 0x34;
+  memory.memory_map[0x11] = 0x12;
+
+  SECTION("Adjacent registers are fused at compile time")
+  {
+    // Setup
+    static constexpr auto kGroup =
+        RegisterGroup(kConfig, kXYZ, kWhoAmI, kStatus);
+
+    // Verify
+    static_assert(kGroup.BurstCount() == 2);
+    static_assert(kGroup.TotalBytes() == 9);
+    static_assert(kGroup.Bursts()[0].address == 0x00);
+    static_assert(kGroup.Bursts()[0].length == 7);
+    static_assert(kGroup.Bursts()[1].address == 0x0D);
+    static_assert(kGroup.Bursts()[1].length == 2);
+    static_assert(kGroup.Bursts()[1].offset == 7);
+  }
+
+  SECTION("Read decodes registers into a typed structure")
+  {
+    // Setup
+    struct AccelerometerData_t
+    {
+      uint8_t status;
+      std::array<int16_t, 3> xyz;
+      uint8_t who_am_i;
+    };
+
+    static constexpr auto kGroup =
+        RegisterGroup(kStatus, kXYZ, kWhoAmI, kConfig);
+
+    // Exercise
+    auto snapshot = kGroup.Read(memory);
+    AccelerometerData_t data{
+      .status   = snapshot[kStatus],
+      .xyz      = snapshot[kXYZ],
+      .who_am_i = snapshot[kWhoAmI],
+    };
+    uint8_t config = snapshot[kConfig];
+
+    // Verify
+    CHECK(2 == memory.reads);
+    CHECK(0x05 == data.status);
+    CHECK(0x1230 == data.xyz[0]);
+    CHECK(static_cast<int16_t>(0xFED0) == data.xyz[1]);
+    CHECK(0x0100 == data.xyz[2]);
+    CHECK(0x2A == data.who_am_i);
+    CHECK(0x01 == config);
+  }
+
+  SECTION("Registers within a burst can be read individually")
+  {
+    // Setup
+    static constexpr auto kGroup = RegisterGroup(kStatus, kXYZ);
+    constexpr auto kYAxis =
+        MemoryAccessProtocol::Address(kSpec1, { .address = 0x03, .width = 2 });
+
+    // Exercise
+    auto snapshot                  = kGroup.Read(memory);
+    uint16_t y                     = snapshot[kYAxis];
+    std::array<uint8_t, 2> y_bytes = snapshot[kYAxis];
+
+    // Verify
+    CHECK(1 == memory.reads);
+    CHECK(0xFED0 == y);
+    CHECK(std::array<uint8_t, 2>{ 0xFE, 0xD0 } == y_bytes);
+    SJ2_CHECK_EXCEPTION(static_cast<uint8_t>(snapshot[kWhoAmI]),
+                        std::errc::invalid_argument);
+  }
+
+  SECTION("Endianness of the group is respected")
+  {
+    // Setup
+    static constexpr auto kGroup = RegisterGroup(kLittleEndianWord);
+
+    // Exercise
+    uint16_t value = kGroup.Read(memory)[kLittleEndianWord];
+
+    // Verify
+    CHECK(0x1234 == value);
+  }
+
+  SECTION("A snapshot outlives the group it was read from")
+  {
+    // Exercise
+    auto snapshot = RegisterGroup(kStatus, kWhoAmI).Read(memory);
+
+    // Verify
+    CHECK(0x05 == static_cast<uint8_t>(snapshot[kStatus]));
+    CHECK(0x2A == static_cast<uint8_t>(snapshot[kWhoAmI]));
+  }
+}
+
+TEST_CASE("Testing SpiProtocol")
+{
+  // Setup
+  constexpr auto kConfig =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x20, .width = 1 });
+  constexpr auto kData =
+      MemoryAccessProtocol::Address(kSpec1, { .address = 0x28, .width = 6 });
+
+  Mock<sjsu::Spi> mock_spi;
+  Mock<sjsu::Gpio> mock_chip_select;
+
+  std::vector<uint8_t> sent;
+  std::vector<sjsu::Gpio::State> chip_select_states;
+  size_t transfers = 0;
+
+  When(OverloadedMethod(mock_spi, Transfer, void(std::span<uint8_t>)))
+      .AlwaysDo([&](std::span<uint8_t> buffer) {
+        transfers++;
+        // Chip select must be active during the transfer
+        CHECK(sjsu::Gpio::State::kLow == chip_select_states.back());
+        sent.assign(buffer.begin(), buffer.end());
+        // Respond with an incrementing pattern after the address byte
+        for (size_t i = 1; i < buffer.size(); i++)
+        {
+          buffer[i] = static_cast<uint8_t>(0x10 + i);
+        }
+      });
+  When(Method(mock_chip_select, Set))
+      .AlwaysDo([&](sjsu::Gpio::State state) {
+        chip_select_states.push_back(state);
+      });
+
+  SECTION("Write sets the write flag")
+  {
+    // Setup
+    SpiProtocol<8> protocol(mock_spi.get(), mock_chip_select.get());
+
+    // Exercise
+    protocol[kConfig] = uint8_t{ 0x47 };
+
+    // Verify
+    CHECK(1 == transfers);
+    CHECK(std::vector<uint8_t>{ 0x20, 0x47 } == sent);
+    CHECK(std::vector<sjsu::Gpio::State>{ sjsu::Gpio::State::kLow,
+                                          sjsu::Gpio::State::kHigh } ==
+          chip_select_states);
+  }
+
+  SECTION("Read sets the read flag")
+  {
+    // Setup
+    SpiProtocol<8> protocol(mock_spi.get(), mock_chip_select.get());
+
+    // Exercise
+    uint8_t config = protocol[kConfig];
+
+    // Verify
+    CHECK(1 == transfers);
+    CHECK(std::vector<uint8_t>{ 0xA0, 0x00 } == sent);
+    CHECK(0x11 == config);
+  }
+
+  SECTION("Burst read uses auto-increment within one chip select window")
+  {
+    // Setup
+    SpiProtocol<8> protocol(mock_spi.get(), mock_chip_select.get(),
+                            { .read_mask           = 0b1000'0000,
+                              .write_mask          = 0b0000'0000,
+                              .auto_increment_mask = 0b0100'0000 });
+
+    // Exercise
+    std::array<uint8_t, 6> data = protocol[kData];
+
+    // Verify
+    CHECK(1 == transfers);
+    CHECK(2 == chip_select_states.size());
+    CHECK(7 == sent.size());
+    CHECK(0xE8 == sent[0]);
+    CHECK(std::array<uint8_t, 6>{ 0x11, 0x12, 0x13, 0x14, 0x15, 0x16 } ==
+          data);
+  }
+
+  SECTION("Burst write uses auto-increment")
+  {
+    // Setup
+    SpiProtocol<8> protocol(
+        mock_spi.get(), mock_chip_select.get(),
+        { .read_mask = 0x00, .write_mask = 0x80, .auto_increment_mask = 0x40 });
+
+    // Exercise
+    protocol[kData] = std::array<uint8_t, 6>{ 1, 2, 3, 4, 5, 6 };
+
+    // Verify
+    CHECK(1 == transfers);
+    CHECK(std::vector<uint8_t>{ 0xE8, 1, 2, 3, 4, 5, 6 } == sent);
+  }
+
+  SECTION("Payload larger than the buffer throws")
+  {
+    // Setup
+    SpiProtocol<2> protocol(mock_spi.get(), mock_chip_select.get());
+
+    // Exercise + Verify
+    SJ2_CHECK_EXCEPTION((protocol[kData] = std::array<uint8_t, 6>{}),
+                        std::errc::not_enough_memory);
+    CHECK(0 == transfers);
+  }
+}
 }  // namespace sjsu
 
 TYPE_TO_STRING(decltype(sjsu::MemoryAccessProtocol::Address(sjsu::kSpec1, {})));
@@ -12,7 +12,10 @@
 // =============================================================================
 // Communication
 // =============================================================================
-#include "devices/communication/test/tsop752_test.cpp"  // NOLINT
+#include "devices/communication/test/can_log_test.cpp"        // NOLINT
+#include "devices/communication/test/can_time_sync_test.cpp"  // NOLINT
+#include "devices/communication/test/iso_tp_test.cpp"         // NOLINT
+#include "devices/communication/test/tsop752_test.cpp"        // NOLINT
 
 // =============================================================================
 // Displays
@@ -70,8 +73,9 @@
 // =============================================================================
 // Actuators
 // =============================================================================
-#include "devices/actuators/servo/test/servo_test.cpp"  // NOLINT
-#include "devices/actuators/servo/test/rmd_x_test.cpp"  // NOLINT
+#include "devices/actuators/servo/test/servo_test.cpp"        // NOLINT
+#include "devices/actuators/servo/test/rmd_x_group_test.cpp"  // NOLINT
+#include "devices/actuators/servo/test/rmd_x_test.cpp"        // NOLINT
 
 // =============================================================================
 // Battery
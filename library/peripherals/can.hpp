@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <algorithm>
 #include <array>
 #include <atomic>
@@ -9,13 +10,17 @@
 #include <initializer_list>
 #include <optional>
 #include <span>
-#include <unordered_map>
 #include <utility>
 
+#include "config.hpp"
 #include "peripherals/inactive.hpp"
 #include "module.hpp"
-#include "utility/memory_resource.hpp"
+#include "utility/enum.hpp"
+#include "utility/error_handling.hpp"
+#include "utility/lock_free_queue.hpp"
 #include "utility/log.hpp"
+#include "utility/math/units.hpp"
+#include "utility/time/time.hpp"
 
 namespace sjsu
 {
@@ -28,6 +33,18 @@ struct CanSettings_t
   /// Can message receive handler definition
   using ReceiveHandler = std::function<void(sjsu::Can &)>;
 
+  /// Function used to timestamp received messages. A plain function pointer is
+  /// used as it is called from the receive interrupt.
+  using TimestampFunction = std::chrono::nanoseconds (*)();
+
+  /// Timestamp received messages with the system Uptime().
+  ///
+  /// @return std::chrono::nanoseconds - current system uptime
+  static std::chrono::nanoseconds UptimeTimestamp()
+  {
+    return Uptime();
+  }
+
   /// Standard baud rate for most CANBUS networks
   static constexpr auto kStandardBaudRate = 100_kHz;
 
@@ -39,6 +56,11 @@ struct CanSettings_t
 
   /// When a message is received this handler is executed.
   ReceiveHandler handler = nullptr;
+
+  /// Source of the timestamp stored in each received message. Set this to a
+  /// platform clock, like cortex::SystemTimer::GetCount, to avoid the extra
+  /// indirection of Uptime(). Set to nullptr to leave the timestamps at zero.
+  TimestampFunction timestamp = UptimeTimestamp;
 };
 
 /// The common interface for the CANBUS peripherals.
@@ -78,9 +100,9 @@ class Can : public Module<CanSettings_t>
     /// ID format
     Format format = Format::kStandard;
 
-    /// Set the time in which this message was received. This value is default
-    /// constructed and should not be changed.
-    std::chrono::nanoseconds uptime = Uptime();
+    /// The time at which this message was received. Set by the peripheral
+    /// when the message is taken out of the hardware.
+    std::chrono::nanoseconds uptime = 0ns;
 
     /// Container of the payload contents
     std::array<uint8_t, 8> payload;
@@ -96,17 +118,150 @@ class Can : public Module<CanSettings_t>
     }
   };
 
-  /// Send a message via CANBUS to the designated device with the supplied ID
+  /// Describes a set of message IDs that should pass through the peripheral's
+  /// hardware acceptance filter. A filter matches a single ID when `id_low`
+  /// and `id_high` are equal, otherwise it matches the inclusive range of IDs
+  /// between them.
+  struct AcceptanceFilter_t
+  {
+    /// Lowest ID accepted by this filter
+    uint32_t id_low = 0;
+
+    /// Highest ID accepted by this filter
+    uint32_t id_high = 0;
+
+    /// ID format accepted by this filter
+    Message_t::Format format = Message_t::Format::kStandard;
+
+    /// @param id - the only ID to accept
+    /// @param format - ID format to accept
+    /// @return AcceptanceFilter_t - filter matching a single ID
+    static constexpr AcceptanceFilter_t Id(
+        uint32_t id, Message_t::Format format = Message_t::Format::kStandard)
+    {
+      return { .id_low = id, .id_high = id, .format = format };
+    }
+
+    /// @param low - lowest ID to accept
+    /// @param high - highest ID to accept
+    /// @param format - ID format to accept
+    /// @return AcceptanceFilter_t - filter matching an inclusive range of IDs
+    static constexpr AcceptanceFilter_t Range(
+        uint32_t low,
+        uint32_t high,
+        Message_t::Format format = Message_t::Format::kStandard)
+    {
+      return { .id_low = low, .id_high = high, .format = format };
+    }
+
+    /// @return true - if this filter matches more than one ID
+    constexpr bool IsRange() const
+    {
+      return id_low != id_high;
+    }
+
+    /// @param id - message ID to check
+    /// @param message_format - format of the message ID
+    /// @return true - if the message would pass through this filter
+    constexpr bool Matches(uint32_t id, Message_t::Format message_format) const
+    {
+      return message_format == format && id_low <= id && id <= id_high;
+    }
+  };
+
+  /// The number of AcceptanceFilter_t entries every CAN peripheral
+  /// implementation is capable of holding.
+  static constexpr size_t kMaximumAcceptanceFilters = 32;
+
+  /// Statistics about the software transmit queue of a CAN peripheral
+  struct TransmitStatistics_t
+  {
+    /// Number of messages currently waiting in the transmit queue
+    size_t queue_depth = 0;
+
+    /// Largest number of messages that have waited in the transmit queue
+    size_t peak_queue_depth = 0;
+
+    /// Number of messages rejected by TrySend() because the queue was full
+    uint32_t dropped = 0;
+
+    /// Number of messages the hardware has finished transmitting
+    uint32_t completed = 0;
+
+    /// Number of messages written into the hardware transmit buffers that are
+    /// not yet counted in `completed`
+    size_t in_flight = 0;
+
+    /// Time, from CanSettings_t::timestamp, at which the hardware reported the
+    /// last completed transmission. Used to timestamp a frame as it leaves
+    /// the node, as protocols such as time synchronisation need.
+    std::chrono::nanoseconds last_completion = 0ns;
+  };
+
+  /// Send a message via CANBUS to the designated device with the supplied ID.
+  /// The message is placed into the peripheral's transmit queue, which is
+  /// drained into the hardware by the transmit complete interrupt, in order of
+  /// CAN ID like bus arbitration. Only blocks if the transmit queue is full.
   ///
   /// @param message - Message containing the CANBUS contents.
   virtual void Send(const Message_t & message) = 0;
 
-  /// Receive a CANBUS message from the queue.
+  /// Same as Send() but never blocks.
+  ///
+  /// @param message - Message containing the CANBUS contents.
+  /// @return true - if the message was queued for transmission.
+  /// @return false - if the transmit queue was full and the message was
+  ///         dropped.
+  virtual bool TrySend(const Message_t & message) = 0;
+
+  /// @return statistics about the peripheral's transmit queue.
+  virtual TransmitStatistics_t GetTransmitStatistics() = 0;
+
+  /// Replace the set of messages the peripheral's hardware acceptance filter
+  /// lets through. Messages that do not match any of the filters are dropped
+  /// by hardware and will not trigger the receive handler. An empty list
+  /// accepts every message, which is the default.
   ///
-  /// @return Message_t - messages
+  /// If the list is longer than kMaximumAcceptanceFilters or does not fit into
+  /// the hardware's filter memory, the peripheral will fall back to accepting
+  /// every message.
+  ///
+  /// Can be called before or after Initialize().
+  ///
+  /// @param filters - list of IDs and ID ranges to accept.
+  virtual void ConfigureAcceptanceFilter(
+      std::span<const AcceptanceFilter_t> filters) = 0;
+
+  /// Statistics about the receive queue of a CAN peripheral
+  struct ReceiveStatistics_t
+  {
+    /// Number of messages currently waiting in the receive queue
+    size_t queue_depth = 0;
+
+    /// Number of messages lost because the receive queue or the hardware
+    /// receive buffer was full
+    uint32_t overruns = 0;
+  };
+
+  /// Receive a CANBUS message from the queue. Only messages already moved into
+  /// the queue by the receive interrupt are returned, so check HasData()
+  /// first.
+  ///
+  /// @return Message_t - oldest message in the queue, or a default constructed
+  ///         message if the queue is empty.
   virtual Message_t Receive() = 0;
 
-  /// Checks if there is a message available for this channel.
+  /// Receive as many CANBUS messages as are queued, up to the size of
+  /// `messages`, in the order they were received.
+  ///
+  /// @param messages - destination for the received messages.
+  /// @return size_t - number of messages written to `messages`.
+  virtual size_t Receive(std::span<Message_t> messages) = 0;
+
+  /// @return statistics about the peripheral's receive queue.
+  virtual ReceiveStatistics_t GetReceiveStatistics() = 0;
+
+  /// Checks if there is a message in the receive queue of this channel.
   ///
   /// @returns true a message was received.
   virtual bool HasData() = 0;
@@ -123,6 +278,164 @@ class Can : public Module<CanSettings_t>
   /// @return false - if the device is NOT "bus off"
   virtual bool IsBusOff() = 0;
 
+  /// Kinds of bus errors reported by CAN controllers
+  enum class BusError : uint8_t
+  {
+    kBit,
+    kStuff,
+    kForm,
+    kCrc,
+    kAcknowledge,
+    kOther,
+    kNumberOfErrors,
+  };
+
+  /// Traffic and error counters of a CAN peripheral, used to measure bus
+  /// utilisation and health.
+  struct BusStatistics_t
+  {
+    /// Number of buckets in the transmit latency histogram
+    static constexpr size_t kLatencyBuckets = 16;
+
+    /// Estimate the number of bits a frame takes on the bus. Uses the nominal
+    /// frame length plus half of the worst case number of stuff bits, which is
+    /// cheap enough to run for every frame in an interrupt.
+    ///
+    /// @param message - frame to measure.
+    /// @return constexpr uint32_t - estimated length of the frame in bits.
+    static constexpr uint32_t EstimateFrameBits(const Message_t & message)
+    {
+      // Start of frame through CRC, the part of the frame that is stuffed.
+      uint32_t stuffed_bits =
+          (message.format == Message_t::Format::kExtended) ? 54 : 34;
+      if (!message.is_remote_request)
+      {
+        stuffed_bits += std::min<uint32_t>(message.length, 8) * 8;
+      }
+      // CRC delimiter, acknowledge, end of frame and interframe space.
+      constexpr uint32_t kTrailerBits = 13;
+      const uint32_t kWorstCaseStuffBits = (stuffed_bits - 1) / 4;
+      return stuffed_bits + kWorstCaseStuffBits / 2 + kTrailerBits;
+    }
+
+    /// @param latency - time a message waited in the transmit queue.
+    /// @return constexpr size_t - histogram bucket for the latency. Bucket 0
+    ///         holds latencies under 1us, bucket N holds latencies from
+    ///         2^(N-1)us up to 2^N us and the last bucket holds the rest.
+    static constexpr size_t LatencyBucket(std::chrono::nanoseconds latency)
+    {
+      auto microseconds = static_cast<uint64_t>(latency / 1us);
+      size_t bucket     = 0;
+      while (microseconds != 0 && bucket < kLatencyBuckets - 1)
+      {
+        microseconds >>= 1;
+        bucket++;
+      }
+      return bucket;
+    }
+
+    /// Count a frame written to the hardware for transmission.
+    ///
+    /// @param message - transmitted frame.
+    /// @param latency - time the frame waited in the transmit queue.
+    void RecordTransmit(const Message_t & message,
+                        std::chrono::nanoseconds latency)
+    {
+      transmitted_frames++;
+      transmitted_bits += EstimateFrameBits(message);
+      transmit_latency[LatencyBucket(latency)]++;
+    }
+
+    /// Count a frame read from the hardware.
+    ///
+    /// @param message - received frame.
+    void RecordReceive(const Message_t & message)
+    {
+      received_frames++;
+      received_bits += EstimateFrameBits(message);
+    }
+
+    /// Count a bus error.
+    ///
+    /// @param error - kind of error reported by the controller.
+    void RecordError(BusError error)
+    {
+      bus_errors[Value(error)]++;
+    }
+
+    /// @param count - number of events over the elapsed time.
+    /// @return float - events per second.
+    float PerSecond(uint64_t count) const
+    {
+      if (elapsed_time <= 0ns)
+      {
+        return 0.0f;
+      }
+      return static_cast<float>(count) /
+             std::chrono::duration<float>(elapsed_time).count();
+    }
+
+    /// @param bit_rate - bit rate of the bus.
+    /// @return float - estimated percentage of the bus' capacity used by the
+    ///         frames seen by this peripheral.
+    float BusLoad(units::frequency::hertz_t bit_rate) const
+    {
+      if (bit_rate <= 0_Hz)
+      {
+        return 0.0f;
+      }
+      return 100.0f * PerSecond(transmitted_bits + received_bits) /
+             bit_rate.to<float>();
+    }
+
+    /// Number of frames written to the hardware for transmission
+    uint32_t transmitted_frames = 0;
+
+    /// Estimated number of bits of the transmitted frames
+    uint64_t transmitted_bits = 0;
+
+    /// Number of frames read from the hardware
+    uint32_t received_frames = 0;
+
+    /// Estimated number of bits of the received frames
+    uint64_t received_bits = 0;
+
+    /// Histogram of the time frames waited in the transmit queue, see
+    /// LatencyBucket().
+    std::array<uint32_t, kLatencyBuckets> transmit_latency = {};
+
+    /// Number of bus errors of each kind, indexed by BusError
+    std::array<uint32_t, Value(BusError::kNumberOfErrors)> bus_errors = {};
+
+    /// Number of received messages lost to a full queue or hardware buffer
+    uint32_t receive_overruns = 0;
+
+    /// Controller's transmit error counter
+    uint8_t transmit_error_count = 0;
+
+    /// Controller's receive error counter
+    uint8_t receive_error_count = 0;
+
+    /// True if an error counter has passed the error warning limit
+    bool error_warning = false;
+
+    /// True if an error counter has passed 127 and the controller can only
+    /// send passive error flags
+    bool error_passive = false;
+
+    /// True if the controller is bus off
+    bool bus_off = false;
+
+    /// Time since the statistics were last reset
+    std::chrono::nanoseconds elapsed_time = 0ns;
+  };
+
+  /// @return traffic and error counters since the last reset.
+  virtual BusStatistics_t GetBusStatistics() = 0;
+
+  /// Clear the traffic and error counters and restart the elapsed time.
+  virtual void ResetBusStatistics() = 0;
+
   // ===========================================================================
   // Helper Functions
   // ===========================================================================
@@ -169,10 +482,29 @@ inline sjsu::Can & GetInactive<sjsu::Can>()
    public:
     void ModuleInitialize() override {}
     void Send(const Message_t &) override {}
+    bool TrySend(const Message_t &) override
+    {
+      return true;
+    }
+    TransmitStatistics_t GetTransmitStatistics() override
+    {
+      return {};
+    }
+    void ConfigureAcceptanceFilter(std::span<const AcceptanceFilter_t>) override
+    {
+    }
     Message_t Receive() override
     {
       return {};
     }
+    size_t Receive(std::span<Message_t>) override
+    {
+      return 0;
+    }
+    ReceiveStatistics_t GetReceiveStatistics() override
+    {
+      return {};
+    }
     bool HasData() override
     {
       return false;
@@ -185,12 +517,107 @@ inline sjsu::Can & GetInactive<sjsu::Can>()
     {
       return false;
     }
+    BusStatistics_t GetBusStatistics() override
+    {
+      return {};
+    }
+    void ResetBusStatistics() override {}
   };
 
   static InactiveCan inactive_can;
   return inactive_can;
 }
 
+/// Fixed capacity software transmit queue for CAN peripherals. Messages come
+/// out in the order they would win bus arbitration, lowest ID first, and in
+/// the order they were pushed for messages with the same ID.
+///
+/// The queue itself is not thread safe. Peripherals must mask their transmit
+/// interrupt while pushing to it from a thread.
+///
+/// @tparam kCapacity - maximum number of messages held by the queue.
+template <size_t kCapacity>
+class CanTransmitQueue
+{
+ public:
+  /// @param message - message to get the arbitration priority of.
+  /// @return uint32_t - priority of the message on the bus, lower values win
+  ///         arbitration. A standard frame wins over an extended frame with
+  ///         the same 11-bit base ID.
+  static constexpr uint32_t ArbitrationKey(const Can::Message_t & message)
+  {
+    if (message.format == Can::Message_t::Format::kStandard)
+    {
+      return (message.id & 0x7FF) << 19;
+    }
+    const uint32_t kBaseId  = (message.id >> 18) & 0x7FF;
+    const uint32_t kExtraId = message.id & 0x3'FFFF;
+    return (kBaseId << 19) | (1 << 18) | kExtraId;
+  }
+
+  /// @param message - message to insert into the queue.
+  /// @return false - if the queue is full.
+  bool Push(const Can::Message_t & message)
+  {
+    if (count_ >= kCapacity)
+    {
+      return false;
+    }
+
+    // Messages are stored from lowest to highest priority such that popping
+    // the highest priority message is just a decrement. Shift higher priority
+    // messages, and older messages with the same priority, back to make room.
+    const uint32_t kKey = ArbitrationKey(message);
+    size_t index        = count_;
+    while (index > 0 && ArbitrationKey(messages_[index - 1]) <= kKey)
+    {
+      messages_[index] = messages_[index - 1];
+      index--;
+    }
+    messages_[index] = message;
+    count_++;
+
+    return true;
+  }
+
+  /// @return the message with the highest priority. Must not be called on an
+  ///         empty queue.
+  const Can::Message_t & Top() const
+  {
+    return messages_[count_ - 1];
+  }
+
+  /// Remove the message with the highest priority.
+  void Pop()
+  {
+    count_--;
+  }
+
+  /// @return true - if there are no messages in the queue.
+  bool IsEmpty() const
+  {
+    return count_ == 0;
+  }
+
+  /// @return the number of messages in the queue.
+  size_t Size() const
+  {
+    return count_;
+  }
+
+ private:
+  std::array<Can::Message_t, kCapacity> messages_;
+  size_t count_ = 0;
+};
+
+/// Fixed capacity receive queue for CAN peripherals. Lock free for a single
+/// producer, the receive interrupt, and a single consumer.
+///
+/// @tparam kCapacity - maximum number of messages held by the queue. Must be a
+///         power of two.
+template <size_t kCapacity>
+using CanReceiveQueue = SpscQueue<Can::Message_t, kCapacity>;
+
 /// CanNetwork is a canbus message receiver handler and
 class CanNetwork : public sjsu::Module<>
 {
@@ -259,6 +686,13 @@ class CanNetwork : public sjsu::Module<>
       return {};
     };
 
+    /// @return int - number of messages stored in this node so far. Compare
+    ///         it between calls to tell if a new message has arrived.
+    int UpdateCount() const
+    {
+      return access_counter.load() / 2;
+    }
+
    private:
     friend CanNetwork;
 
@@ -292,12 +726,35 @@ class CanNetwork : public sjsu::Module<>
     std::atomic<int> access_counter = 0;
   };
 
-  /// @param can - CAN peripheral to manage the network of.
-  /// @param memory_resource - pointer to a memory resource.
-  CanNetwork(Can & can, std::pmr::memory_resource * memory_resource) noexcept
-      : can_(can), messages_(memory_resource)
+  /// Statistics about the lookups performed by the receive handler. Useful for
+  /// checking that the lookup table is not too full and for measuring the
+  /// time spent in interrupt context per received message.
+  struct LookupStatistics_t
   {
-  }
+    /// Number of received messages looked up in the table
+    uint32_t lookups = 0;
+
+    /// Number of received messages whose ID was not captured
+    uint32_t misses = 0;
+
+    /// Sum of the number of slots inspected over every lookup
+    uint32_t total_probes = 0;
+
+    /// Largest number of slots inspected by a single lookup
+    uint32_t longest_probe = 0;
+
+    /// Sum of the time spent performing every profiled lookup
+    std::chrono::nanoseconds total_lookup_time = 0ns;
+
+    /// Longest time spent performing a single profiled lookup
+    std::chrono::nanoseconds longest_lookup_time = 0ns;
+  };
+
+  /// Maximum number of IDs that can be captured by a CanNetwork
+  static constexpr size_t kCapacity = config::kCanNetworkCapacity;
+
+  /// @param can - CAN peripheral to manage the network of.
+  explicit CanNetwork(Can & can) noexcept : can_(can) {}
 
   void ModuleInitialize() override
   {
@@ -316,36 +773,104 @@ class CanNetwork : public sjsu::Module<>
   ///    Node_t * temperature_node = can_network.CaptureMessage(0x7AA);
   /// ```
   ///
+  /// Extended IDs must be captured with their format, so that the hardware
+  /// acceptance filter lets them through:
+  ///
+  /// ```
+  ///    Node_t * bms_node = can_network.CaptureMessage(
+  ///        0x18FF'50E5, Can::Message_t::Format::kExtended);
+  /// ```
+  ///
+  /// Capturing an ID does not allocate and can be done while the receive
+  /// handler is running. Capturing the same ID twice returns the same node.
+  /// A standard and an extended ID with the same value are different messages,
+  /// so each is given its own node.
+  ///
   /// @param id - Associated ID of messages to be stored.
-  /// @throw std::bad_alloc if this static storage allocated for this object is
-  /// not enough to hold
+  /// @param format - format of the ID, which selects the acceptance filter the
+  ///        ID is added to.
+  /// @throw std::errc::invalid_argument if a standard ID does not fit in 11
+  /// bits.
+  /// @throw std::errc::not_enough_memory if kCapacity IDs have already been
+  /// captured.
   /// @return Node_t* - reference to the CANBUS network Node_t which can be used
   /// at anytime to retreive the latest received message from the CANBUS that is
   /// associated with the set ID.
-  [[nodiscard]] Node_t * CaptureMessage(uint32_t id)
+  [[nodiscard]] Node_t * CaptureMessage(
+      uint32_t id,
+      Can::Message_t::Format format = Can::Message_t::Format::kStandard)
   {
-    try
+    constexpr uint32_t kMaximumStandardId = 0x7FF;
+    if (format == Can::Message_t::Format::kStandard && id > kMaximumStandardId)
     {
-      Node_t empty_node;
+      throw Exception(std::errc::invalid_argument,
+                      "Standard CAN IDs must fit in 11 bits, capture IDs "
+                      "above 0x7FF with Format::kExtended.");
+    }
 
-      // Insert an empty Node_t into the map with the following ID as
-      // the key. This is how each ID is remembered when calls to
-      // ReceiveHandler() and GetMessage() are performed. ReceiveHandler() will
-      // ignore messages with IDs that are not already keys within the map.
-      // GetMessage() will throw an exception.
-      messages_.emplace(std::make_pair(id, empty_node));
+    const uint32_t kKey = Key(id, format);
+    size_t index        = Hash(kKey);
 
-      // Return reference to the newly made Node_t.
-      return &messages_[id];
-    }
-    // will be thrown if memory resource is exhausted.
-    catch (std::bad_alloc & e)
+    for (size_t probe = 0; probe < kTableSize; probe++)
     {
-      LogDebug("Could not add ID 0x%" PRIX32
-               ", memory resource has been exhausted!",
-               id);
-      throw;
+      auto & slot       = table_[index];
+      uint32_t slot_key = slot.key.load(std::memory_order_acquire);
+
+      if (slot_key == kEmptySlot)
+      {
+        // Reserve room for the ID before claiming the slot, so the table never
+        // holds more than kCapacity IDs.
+        if (id_count_.fetch_add(1) >= kCapacity)
+        {
+          id_count_--;
+          break;
+        }
+
+        // Claim the empty slot. The node is already in its default state, so
+        // publishing the ID is all it takes for the receive handler to start
+        // using it.
+        if (slot.key.compare_exchange_strong(slot_key, kKey))
+        {
+          // Let the ID through the hardware acceptance filter so that only
+          // captured messages ever reach the ReceiveHandler().
+          AddToAcceptanceFilter(id, format);
+          return &slot.node;
+        }
+
+        // Another thread claimed the slot first; slot_key now holds its key.
+        id_count_--;
+      }
+
+      if (slot_key == kKey)
+      {
+        AddToAcceptanceFilter(id, format);
+        return &slot.node;
+      }
+
+      index = (index + 1) & (kTableSize - 1);
     }
+
+    LogDebug("Could not add ID 0x%" PRIX32 ", CanNetwork is full!", id);
+    throw Exception(std::errc::not_enough_memory,
+                    "CanNetwork cannot capture more than kCapacity IDs. "
+                    "Increase SJ2_CAN_NETWORK_CAPACITY.");
+  }
+
+  /// @param id - message ID to look for
+  /// @param format - format of the message ID
+  /// @return Node_t* - the node associated with the ID or nullptr if the ID
+  /// was never captured in this format.
+  Node_t * Find(
+      uint32_t id,
+      Can::Message_t::Format format = Can::Message_t::Format::kStandard)
+  {
+    return Lookup(Key(id, format)).node;
+  }
+
+  /// @return the number of IDs that have been captured
+  size_t Size() const
+  {
+    return id_count_;
   }
 
   /// Manually call the receive handler. This is useful for unit testing and for
@@ -366,14 +891,124 @@ class CanNetwork : public sjsu::Module<>
     return can_;
   }
 
-  /// Meant for testing purposes or when direct inspection of the map is useful
-  /// in userspace. Should not be used in SJSU-Dev2 libraries.
-  const auto & GetInternalMap()
+  /// @return statistics about the lookups made by the receive handler.
+  LookupStatistics_t GetLookupStatistics() const
+  {
+    return statistics_;
+  }
+
+  /// Clear the lookup statistics
+  void ResetLookupStatistics()
   {
-    return messages_;
+    statistics_ = {};
+  }
+
+  /// Measure the time taken by each lookup in the receive handler using
+  /// Uptime(). Disabled by default, as reading the clock can cost more than
+  /// the lookup itself.
+  ///
+  /// @param enable - true to time each lookup
+  void ProfileLookups(bool enable)
+  {
+    profile_lookups_ = enable;
+  }
+
+  /// @return the acceptance filters currently given to the CAN peripheral. An
+  /// empty list means that the peripheral accepts every message, which is the
+  /// case when no messages have been captured or when the captured IDs could
+  /// not be described by kMaximumAcceptanceFilters filters.
+  std::span<const Can::AcceptanceFilter_t> GetAcceptanceFilters() const
+  {
+    if (filter_overflow_)
+    {
+      return {};
+    }
+    return std::span(filters_.data(), filter_count_);
   }
 
  private:
+  /// Add the ID to the acceptance filter list, merging it with neighbouring
+  /// IDs of the same format to form ranges, then hand the updated list to the
+  /// CAN peripheral. Does nothing if the ID is already accepted.
+  ///
+  /// @param id - captured message ID
+  /// @param format - format of the captured message ID
+  void AddToAcceptanceFilter(uint32_t id, Can::Message_t::Format format)
+  {
+    FilterLock_t lock(*this);
+
+    if (filter_overflow_)
+    {
+      return;
+    }
+
+    for (size_t i = 0; i < filter_count_; i++)
+    {
+      if (filters_[i].Matches(id, format))
+      {
+        return;
+      }
+    }
+
+    // Grow an existing filter if the ID sits right next to it, otherwise add a
+    // new filter for it.
+    auto * filter = std::find_if(
+        filters_.begin(), filters_.begin() + filter_count_, [=](auto & entry) {
+          return entry.format == format &&
+                 (entry.id_high + 1 == id || id + 1 == entry.id_low);
+        });
+
+    if (filter != filters_.begin() + filter_count_)
+    {
+      filter->id_low  = std::min(filter->id_low, id);
+      filter->id_high = std::max(filter->id_high, id);
+      MergeAdjacentFilter(filter);
+    }
+    else if (filter_count_ < filters_.size())
+    {
+      filters_[filter_count_++] = Can::AcceptanceFilter_t::Id(id, format);
+    }
+    else
+    {
+      LogDebug("Too many CAN IDs to filter in hardware, accepting all.");
+      filter_overflow_ = true;
+    }
+
+    can_.ConfigureAcceptanceFilter(GetAcceptanceFilters());
+  }
+
+  /// If growing `filter` made it touch another filter, fold both into one
+  /// filter and remove the other from the list.
+  ///
+  /// @param filter - filter that was just grown
+  void MergeAdjacentFilter(Can::AcceptanceFilter_t * filter)
+  {
+    const size_t kGrown = filter - filters_.data();
+
+    for (size_t i = 0; i < filter_count_; i++)
+    {
+      auto & other = filters_[i];
+      if (i == kGrown || other.format != filter->format)
+      {
+        continue;
+      }
+
+      if (other.id_high + 1 == filter->id_low ||
+          filter->id_high + 1 == other.id_low)
+      {
+        const size_t kKeep   = std::min(i, kGrown);
+        const size_t kRemove = std::max(i, kGrown);
+
+        filters_[kKeep] = Can::AcceptanceFilter_t::Range(
+            std::min(filter->id_low, other.id_low),
+            std::max(filter->id_high, other.id_high),
+            filter->format);
+        filters_[kRemove] = filters_[--filter_count_];
+        return;
+      }
+    }
+  }
+
   void ReceiveHandler(sjsu::Can & can)
   {
     // If there isn't any data available, return early.
@@ -385,26 +1020,163 @@ class CanNetwork : public sjsu::Module<>
     // Pop the latest can message off the queue.
     const auto kMessage = can.Receive();
 
-    // Check if the map already has a value for this ID. This acts as the last
-    // stage of the CAN filter for the CANBUS Network module. If the key
-    // does NOT exist in the map, then this message will not be saved.
-    // Typically, this only happens when the hardware filter has not been setup
-    // properly to eliminate can messages that should be ignored.
-    //
-    // Map lookups can be costly, especially in a interrupt context, so only
-    // needing to hash/lookup the ID once is preferred. To prevent multiple
-    // lookups, an iterator is stored into the message_node variable.
-    auto message_node = messages_.find(kMessage.id);
+    std::chrono::nanoseconds start_time = 0ns;
+    if (profile_lookups_)
+    {
+      start_time = Uptime();
+    }
+
+    // Find the node for this ID. This acts as the last stage of the CAN filter
+    // for the CANBUS Network module. If the ID was never captured, then this
+    // message will not be saved. Typically, this only happens when the
+    // hardware filter could not hold every captured ID.
+    const auto kResult = Lookup(Key(kMessage.id, kMessage.format));
 
-    // If the ID has an associated value in the map, then the node std::pair<>
-    // is returned, otherwise, the ::end() node is returned.
-    if (message_node != messages_.end())
+    if (kResult.node != nullptr)
     {
-      message_node->second.Update(kMessage);
+      kResult.node->Update(kMessage);
+    }
+    else
+    {
+      statistics_.misses++;
+    }
+
+    statistics_.lookups++;
+    statistics_.total_probes += kResult.probes;
+    statistics_.longest_probe =
+        std::max(statistics_.longest_probe, kResult.probes);
+
+    if (profile_lookups_)
+    {
+      const auto kLookupTime = Uptime() - start_time;
+      statistics_.total_lookup_time += kLookupTime;
+      statistics_.longest_lookup_time =
+          std::max(statistics_.longest_lookup_time, kLookupTime);
     }
   }
 
+  /// Result of searching the lookup table for an ID.
+  struct LookupResult_t
+  {
+    /// Node associated with the ID or nullptr if the ID was not found
+    Node_t * node;
+    /// Number of slots inspected
+    uint32_t probes;
+  };
+
+  /// Holds the acceptance filter list for a thread, waiting for any other
+  /// thread capturing a message to finish updating it.
+  class FilterLock_t
+  {
+   public:
+    explicit FilterLock_t(CanNetwork & network) : network_(network)
+    {
+      // Sleep a tick at a time rather than spin, as the holder may be a lower
+      // priority thread that this one preempted.
+      while (network_.filter_busy_.exchange(true, std::memory_order_acquire))
+      {
+        SleepThread(1ms, false);
+      }
+    }
+
+    ~FilterLock_t()
+    {
+      network_.filter_busy_.store(false, std::memory_order_release);
+    }
+
+   private:
+    CanNetwork & network_;
+  };
+
+  /// Search the table using linear probing, starting from the slot the key
+  /// hashes to. Keys are never removed, so reaching an empty slot means the
+  /// key was not captured. Safe to call from an ISR while CaptureMessage() runs
+  /// in another thread, as a slot's key is only published once.
+  ///
+  /// @param key - key of the message ID to look for, made with Key()
+  LookupResult_t Lookup(uint32_t key)
+  {
+    size_t index = Hash(key);
+
+    for (uint32_t probe = 1; probe <= kTableSize; probe++)
+    {
+      auto & slot = table_[index];
+      const uint32_t kSlotKey = slot.key.load(std::memory_order_acquire);
+
+      if (kSlotKey == key)
+      {
+        return { .node = &slot.node, .probes = probe };
+      }
+
+      if (kSlotKey == kEmptySlot)
+      {
+        return { .node = nullptr, .probes = probe };
+      }
+
+      index = (index + 1) & (kTableSize - 1);
+    }
+
+    return { .node = nullptr, .probes = kTableSize };
+  }
+
+  /// @param id - message ID
+  /// @param format - format of the message ID
+  /// @return uint32_t - the ID with its format in the bit above the widest
+  ///         CAN ID, so the same ID in either format has its own slot.
+  static constexpr uint32_t Key(uint32_t id, Can::Message_t::Format format)
+  {
+    constexpr uint32_t kExtendedKey = 1U << 29;
+    return (format == Can::Message_t::Format::kExtended) ? (id | kExtendedKey)
+                                                         : id;
+  }
+
+  /// Fibonacci hash of the key into the lookup table. CAN IDs tend to be
+  /// clustered together, which this spreads evenly over the table.
+  ///
+  /// @param key - key of the message ID to hash
+  /// @return size_t - index of the first slot to probe
+  static constexpr size_t Hash(uint32_t key)
+  {
+    constexpr uint32_t kGoldenRatio = 0x9E37'79B9;
+    return static_cast<uint32_t>(key * kGoldenRatio) >> (32 - kTableBits);
+  }
+
+  /// Marks a slot that holds no key. Keys are at most 30 bits wide, so this
+  /// value never collides with a real key.
+  static constexpr uint32_t kEmptySlot = 0xFFFF'FFFF;
+
+  /// Number of bits used to index the lookup table. The table has at least
+  /// twice as many slots as kCapacity, keeping the load factor at or below 50%
+  /// so probe sequences stay short.
+  static constexpr uint32_t kTableBits = []() {
+    uint32_t bits = 1;
+    while ((size_t{ 1 } << bits) < kCapacity * 2)
+    {
+      bits++;
+    }
+    return bits;
+  }();
+
+  /// Number of slots in the lookup table
+  static constexpr size_t kTableSize = size_t{ 1 } << kTableBits;
+
+  /// Slot of the lookup table
+  struct Slot_t
+  {
+    /// Key of the ID held by this slot or kEmptySlot
+    std::atomic<uint32_t> key = kEmptySlot;
+    /// Latest message received with this ID
+    Node_t node;
+  };
+
   Can & can_;
-  std::pmr::unordered_map<uint32_t, Node_t> messages_;
+  std::array<Slot_t, kTableSize> table_;
+  std::atomic<size_t> id_count_ = 0;
+  LookupStatistics_t statistics_;
+  bool profile_lookups_ = false;
+  std::array<Can::AcceptanceFilter_t, Can::kMaximumAcceptanceFilters> filters_;
+  size_t filter_count_           = 0;
+  bool filter_overflow_          = false;
+  std::atomic<bool> filter_busy_ = false;
 };
 }  // namespace sjsu
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
 #include "platforms/targets/lpc40xx/LPC40xx.h"
 #include "module.hpp"
+#include "utility/math/units.hpp"
 
 namespace sjsu
 {
@@ -17,12 +22,56 @@ class DwtCounter : public sjsu::Module<>
   /// Address of the Cortex M CoreDebug module
   static inline CoreDebug_Type * core = CoreDebug;
 
+  /// Upper bits of the extended count. Bit 31 holds bit 31 of CYCCNT when it
+  /// was last seen, and bits 0 to 30 hold bits 32 to 62 of the count. Shared by
+  /// every DwtCounter, as they all read the same hardware counter.
+  static inline std::atomic<uint32_t> upper_count = 0;
+
+  /// Convert a number of cycles into a duration.
+  ///
+  /// @param cycles - number of cycles.
+  /// @param cycles_per_second - rate at which the cycles are counted.
+  /// @return constexpr std::chrono::nanoseconds - duration of the cycles,
+  ///         rounded down.
+  static constexpr std::chrono::nanoseconds CyclesToDuration(
+      uint64_t cycles, uint32_t cycles_per_second)
+  {
+    // Split off whole seconds so the multiplication cannot overflow.
+    const uint64_t kSeconds   = cycles / cycles_per_second;
+    const uint64_t kRemainder = cycles % cycles_per_second;
+    return std::chrono::seconds(kSeconds) +
+           std::chrono::nanoseconds(kRemainder * 1'000'000'000 /
+                                    cycles_per_second);
+  }
+
+  /// Convert a duration into a number of cycles.
+  ///
+  /// @param duration - duration to convert, must not be negative.
+  /// @param cycles_per_second - rate at which the cycles are counted.
+  /// @return constexpr uint64_t - number of cycles in duration, rounded down.
+  static constexpr uint64_t DurationToCycles(std::chrono::nanoseconds duration,
+                                             uint32_t cycles_per_second)
+  {
+    const uint64_t kSeconds   = duration / 1s;
+    const uint64_t kRemainder = (duration % 1s).count();
+    return kSeconds * cycles_per_second +
+           kRemainder * cycles_per_second / 1'000'000'000;
+  }
+
   /// Initialize the debug core to enable counting and then being counting on
   /// the DWT.
+  ///
+  /// The count only starts from zero if the trace was not already enabled.
+  /// Uptime() can be read from this counter, so initializing another
+  /// DwtCounter, or this one again, must not move it backwards.
   void ModuleInitialize() override
   {
-    core->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
-    dwt->CYCCNT = 0;
+    if (!(core->DEMCR & CoreDebug_DEMCR_TRCENA_Msk))
+    {
+      core->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+      dwt->CYCCNT = 0;
+      upper_count.store(0, std::memory_order_relaxed);
+    }
     dwt->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
   }
 
@@ -32,6 +81,37 @@ class DwtCounter : public sjsu::Module<>
   {
     return dwt->CYCCNT;
   }
+
+  /// Return the number of ticks extended to 63 bits, which does not wrap for
+  /// hundreds of years. Lock-free, so it can be called from any thread or
+  /// interrupt, and never goes backwards.
+  ///
+  /// The upper bits are only advanced when this is called, so it must be
+  /// called at least once every 2^31 ticks, which SystemTimer's tick interrupt
+  /// does.
+  uint64_t GetCount64()
+  {
+    // Reading the upper bits first means CYCCNT is never older than them.
+    uint32_t upper        = upper_count.load(std::memory_order_acquire);
+    const uint32_t kLower = dwt->CYCCNT;
+
+    // If bit 31 of CYCCNT no longer matches, the count has crossed into its
+    // other half since the upper bits were stored. Going from the upper half
+    // to the lower half means CYCCNT has wrapped, so carry into the upper
+    // bits. Only store them if no other caller has stored newer ones since
+    // they were read, so a preempted caller cannot move the count backwards.
+    if (((upper ^ kLower) & (1U << 31)) != 0)
+    {
+      uint32_t expected = upper;
+      upper             = (upper ^ (1U << 31)) + (upper >> 31);
+      upper_count.compare_exchange_strong(expected,
+                                          upper,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed);
+    }
+
+    return (uint64_t{ upper & ~(1U << 31) } << 32) | kLower;
+  }
 };
 }  // namespace cortex
 }  // namespace sjsu
@@ -4,9 +4,12 @@
 #include <array>
 #include <cstddef>
 
+#include "config.hpp"
 #include "platforms/processors/arm_cortex/m4/core_cm4.h"
+#include "peripherals/cortex/interrupt_profiler.hpp"
 #include "peripherals/interrupt.hpp"
 #include "utility/log.hpp"
+#include "utility/rtos/freertos/trace_recorder.hpp"
 
 namespace sjsu
 {
@@ -29,6 +32,9 @@ class InterruptController final : public sjsu::InterruptController
   inline static NVIC_Type * nvic = NVIC;
   /// Holds the current_vector that is running
   inline static int current_vector = cortex::Reset_IRQn;
+  /// Number of entries in the interrupt vector table
+  static constexpr size_t kTableSize =
+      kNumberOfInterrupts + kArmExceptionOffset;
 
   /// @param irq - irq number to convert
   /// @return A convert an irq number into lookup table index
@@ -50,15 +56,35 @@ class InterruptController final : public sjsu::InterruptController
   /// application.
   static void LookupHandler()
   {
-    int active_interrupt     = (scb->ICSR & 0xFF);
-    current_vector           = IndexToIRQ(active_interrupt);
-    InterruptHandler handler = table[active_interrupt];
-    handler();
+    int active_interrupt = (scb->ICSR & 0xFF);
+    current_vector       = IndexToIRQ(active_interrupt);
+    if constexpr (config::kEnableRtosTrace)
+    {
+      RecordTrace(rtos::TraceEvent::kIsrEnter, active_interrupt);
+    }
+    if constexpr (config::kEnableInterruptProfiler)
+    {
+      auto frame = profiler.Enter(active_interrupt);
+      table[active_interrupt]();
+      profiler.Exit(active_interrupt, frame);
+    }
+    else
+    {
+      table[active_interrupt]();
+    }
+    if constexpr (config::kEnableRtosTrace)
+    {
+      RecordTrace(rtos::TraceEvent::kIsrExit, active_interrupt);
+    }
   }
 
   InterruptController()
   {
     std::fill(table.begin(), table.end(), nullptr);
+    if constexpr (config::kEnableInterruptProfiler)
+    {
+      InterruptProfiler::SetPlatformProfiler(&profiler);
+    }
   }
 
   void ModuleInitialize() override {}
@@ -87,10 +113,28 @@ class InterruptController final : public sjsu::InterruptController
     table[IRQToIndex(interrupt_request_number)] = UnregisteredHandler;
   }
 
+  /// Only device interrupts, numbered from 0, can be triggered. The system
+  /// exceptions are owned by the RTOS and the fault handlers.
+  void Trigger(int interrupt_request_number) override
+  {
+    if (interrupt_request_number < 0)
+    {
+      throw Exception(std::errc::invalid_argument,
+                      "Only device interrupts can be triggered in software.");
+    }
+    nvic->ISPR[(interrupt_request_number >> 5)] =
+        (1 << (interrupt_request_number & 0x1F));
+  }
+
  private:
-  static inline std::array<InterruptHandler,
-                           kNumberOfInterrupts + kArmExceptionOffset>
-      table;
+  static inline std::array<InterruptHandler, kTableSize> table;
+  static inline std::array<InterruptStatistics_t,
+                           config::kEnableInterruptProfiler ? kTableSize : 0>
+      statistics;
+  /// Times each handler dispatched by LookupHandler(), if
+  /// SJ2_ENABLE_INTERRUPT_PROFILER is true.
+  static inline InterruptProfiler profiler =
+      InterruptProfiler(statistics, -kArmExceptionOffset);
   /// Enable External Interrupt
   /// Enables a device-specific interrupt in the NVIC interrupt controller.
   ///
@@ -127,6 +171,19 @@ class InterruptController final : public sjsu::InterruptController
     }
   }
 
+  /// Record an interrupt event into the platform's trace recorder, if it has
+  /// one, when SJ2_ENABLE_RTOS_TRACE is true.
+  ///
+  /// @param type - kIsrEnter or kIsrExit.
+  /// @param index - interrupt vector table index of the handler.
+  static void RecordTrace(rtos::TraceEvent type, int index)
+  {
+    if (auto * recorder = rtos::TraceRecorder::GetPlatformRecorder())
+    {
+      recorder->Record(type, index);
+    }
+  }
+
   /// Program will call this if an unexpected interrupt occurs or a specific
   /// handler is not present in the application code.
   static void UnregisteredHandler()
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "platforms/targets/lpc40xx/LPC40xx.h"
+#include "utility/math/byte.hpp"
+
+namespace sjsu
+{
+namespace cortex
+{
+/// Time spent in, and between entries of, one interrupt's handler, in DWT
+/// cycles.
+struct InterruptStatistics_t
+{
+  /// Number of times the handler ran.
+  uint32_t count = 0;
+  /// Number of times the handler ran nested inside another handler.
+  uint32_t preemptions = 0;
+  /// Fewest cycles spent in the handler, not counting nested handlers.
+  uint32_t minimum_cycles = UINT32_MAX;
+  /// Most cycles spent in the handler, not counting nested handlers.
+  uint32_t maximum_cycles = 0;
+  /// Sum of the cycles spent in the handler, not counting nested handlers.
+  uint64_t total_cycles = 0;
+  /// Fewest cycles between two entries of the handler.
+  uint32_t minimum_period = UINT32_MAX;
+  /// Most cycles between two entries of the handler. For a periodic interrupt,
+  /// the difference from minimum_period is its jitter.
+  uint32_t maximum_period = 0;
+  /// Cycle count of the last entry.
+  uint32_t last_entry = 0;
+
+  /// @return average number of cycles spent in the handler.
+  uint32_t AverageCycles() const
+  {
+    return (count == 0) ? 0 : static_cast<uint32_t>(total_cycles / count);
+  }
+};
+
+/// Records InterruptStatistics_t for each interrupt dispatched by
+/// cortex::InterruptController, timed with the DWT cycle counter. The counter
+/// must be running, see DwtCounter.
+///
+/// Profiling is enabled with SJ2_ENABLE_INTERRUPT_PROFILER. When it is
+/// disabled, the interrupt controller keeps no statistics and its dispatch
+/// does not reference the profiler at all.
+class InterruptProfiler
+{
+ public:
+  /// Address of the hardware DWT registers
+  static inline DWT_Type * dwt = DWT;
+
+  /// Identifies the start of a binary dump.
+  static constexpr uint32_t kDumpMagic = 0x5051'5249;  // "IRQP"
+  /// Version of the binary dump format.
+  static constexpr uint16_t kDumpVersion = 1;
+  /// Size of the dump header: magic (u32), version (u16), number of records
+  /// (u16), deepest nesting (u32).
+  static constexpr size_t kDumpHeaderSize = 12;
+  /// Size of each record: irq (i16), reserved (u16), count, preemptions,
+  /// minimum_cycles, maximum_cycles (u32), total_cycles (u64),
+  /// minimum_period, maximum_period (u32). Little-endian.
+  static constexpr size_t kDumpRecordSize = 36;
+
+  /// State of a handler between Enter() and Exit().
+  struct Frame_t
+  {
+    /// Cycle count when the handler was entered.
+    uint32_t start;
+    /// Value of the nested cycle count when the handler was entered.
+    uint32_t nested;
+  };
+
+  /// @return the profiler of the platform's interrupt controller, or nullptr
+  ///         if profiling is disabled.
+  static InterruptProfiler * GetPlatformProfiler()
+  {
+    return platform_profiler;
+  }
+
+  /// @param profiler - profiler to return from GetPlatformProfiler().
+  static void SetPlatformProfiler(InterruptProfiler * profiler)
+  {
+    platform_profiler = profiler;
+  }
+
+  /// @param statistics - a record for each entry of the interrupt vector
+  ///        table.
+  /// @param first_irq - irq number of the first entry of the table.
+  constexpr InterruptProfiler(std::span<InterruptStatistics_t> statistics,
+                              int first_irq)
+      : statistics_(statistics), first_irq_(first_irq)
+  {
+  }
+
+  /// Record the entry of a handler. Call as the first thing in the dispatch.
+  ///
+  /// @param index - interrupt vector table index of the handler.
+  /// @return Frame_t - pass to Exit() once the handler returns.
+  Frame_t Enter(size_t index)
+  {
+    const uint32_t kNow = dwt->CYCCNT;
+    // Read after the cycle count, so a handler that nests in between is
+    // counted towards this one rather than subtracted twice.
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    const Frame_t kFrame = { .start = kNow, .nested = nested_cycles_ };
+
+    InterruptStatistics_t & statistics = statistics_[index];
+    if (statistics.count > 0)
+    {
+      const uint32_t kPeriod = kNow - statistics.last_entry;
+      statistics.minimum_period = std::min(statistics.minimum_period, kPeriod);
+      statistics.maximum_period = std::max(statistics.maximum_period, kPeriod);
+    }
+    statistics.last_entry = kNow;
+    statistics.count++;
+
+    if (depth_ > 0)
+    {
+      statistics.preemptions++;
+    }
+    depth_++;
+    maximum_depth_ = std::max(maximum_depth_, depth_);
+
+    return kFrame;
+  }
+
+  /// Record the exit of a handler.
+  ///
+  /// @param index - interrupt vector table index of the handler.
+  /// @param frame - value returned by Enter().
+  void Exit(size_t index, Frame_t frame)
+  {
+    const uint32_t kNested = nested_cycles_ - frame.nested;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    const uint32_t kElapsed = dwt->CYCCNT - frame.start;
+    const uint32_t kCycles  = kElapsed - kNested;
+
+    InterruptStatistics_t & statistics = statistics_[index];
+    statistics.minimum_cycles = std::min(statistics.minimum_cycles, kCycles);
+    statistics.maximum_cycles = std::max(statistics.maximum_cycles, kCycles);
+    statistics.total_cycles += kCycles;
+
+    // The handler this one preempted subtracts all of its time.
+    nested_cycles_ = frame.nested + kElapsed;
+    depth_--;
+  }
+
+  /// @return the statistics of each entry of the interrupt vector table.
+  std::span<const InterruptStatistics_t> GetStatistics() const
+  {
+    return statistics_;
+  }
+
+  /// @param index - interrupt vector table index.
+  /// @return irq number of the table entry.
+  int IndexToIrq(size_t index) const
+  {
+    return static_cast<int>(index) + first_irq_;
+  }
+
+  /// @return most handlers that were running at once.
+  uint32_t GetMaximumDepth() const
+  {
+    return maximum_depth_;
+  }
+
+  /// Clear the statistics of every interrupt.
+  void Reset()
+  {
+    std::fill(statistics_.begin(), statistics_.end(), InterruptStatistics_t{});
+    maximum_depth_ = 0;
+  }
+
+  /// Write the statistics of every interrupt that ran in a binary format, see
+  /// kDumpHeaderSize and kDumpRecordSize.
+  ///
+  /// @param write - called with the header and then with each record.
+  void Dump(const std::function<void(std::span<const uint8_t>)> & write) const
+  {
+    const auto kRecords = std::count_if(
+        statistics_.begin(), statistics_.end(), [](const auto & statistics) {
+          return statistics.count > 0;
+        });
+
+    std::array<uint8_t, kDumpHeaderSize> header;
+    size_t position = 0;
+    PutLittleEndian(header, position, kDumpMagic);
+    PutLittleEndian(header, position, kDumpVersion);
+    PutLittleEndian(header, position, static_cast<uint16_t>(kRecords));
+    PutLittleEndian(header, position, maximum_depth_);
+    write(header);
+
+    for (size_t index = 0; index < statistics_.size(); index++)
+    {
+      const InterruptStatistics_t & statistics = statistics_[index];
+      if (statistics.count == 0)
+      {
+        continue;
+      }
+
+      std::array<uint8_t, kDumpRecordSize> record;
+      position = 0;
+      PutLittleEndian(
+          record, position, static_cast<uint16_t>(IndexToIrq(index)));
+      PutLittleEndian(record, position, uint16_t{ 0 });
+      PutLittleEndian(record, position, statistics.count);
+      PutLittleEndian(record, position, statistics.preemptions);
+      PutLittleEndian(record, position, statistics.minimum_cycles);
+      PutLittleEndian(record, position, statistics.maximum_cycles);
+      PutLittleEndian(record, position, statistics.total_cycles);
+      PutLittleEndian(record, position, statistics.minimum_period);
+      PutLittleEndian(record, position, statistics.maximum_period);
+      write(record);
+    }
+  }
+
+ private:
+  static inline InterruptProfiler * platform_profiler = nullptr;
+
+  std::span<InterruptStatistics_t> statistics_;
+  int first_irq_;
+  uint32_t nested_cycles_ = 0;
+  uint32_t depth_         = 0;
+  uint32_t maximum_depth_ = 0;
+};
+}  // namespace cortex
+}  // namespace sjsu
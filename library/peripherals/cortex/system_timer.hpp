@@ -49,15 +49,8 @@ class SystemTimer final : public sjsu::SystemTimer
   /// Higher precision counter that counts on every system clock cycle
   inline static DwtCounter dwt_counter;
 
-  /// Holds the converstion from ticks to nanoseconds
-  inline static std::chrono::nanoseconds nanoseconds_per_tick = 1us;
-
-  /// Holds the conversion from ticks to milliseconds
-  inline static uint32_t ticks_per_millisecond = 1;
-
-  /// Fixed point scale in order to boost the precision of GetCount() method
-  /// while also keeping most of the arithmetic as integer math.
-  static constexpr uint32_t kFixedPointScaling = 1'000'000;
+  /// Rate of the DWT counter, which counts system clock cycles
+  inline static uint32_t cycles_per_second = 1;
 
   /// System timer interrupt handler.
   static void SystemTimerHandler()
@@ -65,6 +58,11 @@ class SystemTimer final : public sjsu::SystemTimer
     // This assumes that SysTickHandler is called every millisecond.
     // Changing that frequency will distort the milliseconds time.
     millisecond_count += 1ms;
+
+    // Keeps the upper bits of the extended DWT count up to date, which must
+    // happen at least once per 2^31 cycles.
+    dwt_counter.GetCount64();
+
     if (callback)
     {
       callback();
@@ -74,26 +72,10 @@ class SystemTimer final : public sjsu::SystemTimer
   /// @return returns the current system_timer counter value.
   static std::chrono::nanoseconds GetCount()
   {
-    // Capture all count variables at this instant.
-    uint32_t high_speed_ticks = dwt_counter.GetCount();
-    auto current_millis_count = millisecond_count;
-
-    // Get rid of the portion of the dwt tick count that is above 1ms.
-    // We only want the information about the ticks that is below 1ms, since we
-    // get the 1ms count from the SysTick timer interrupt.
-    uint32_t sub_millis_ticks = (high_speed_ticks % ticks_per_millisecond);
-
-    // Perform the conversion from ticks to nanoseconds
-    auto nanoseconds_unscaled = (sub_millis_ticks * nanoseconds_per_tick);
-
-    // Nanoseconds per tick is actually scaled up by the kFixedPointScaling
-    // factor, meaning it needs to be divided by that value to get the correct
-    // nanosecond_uptime.
-    auto nanoseconds_uptime_scaled = nanoseconds_unscaled / kFixedPointScaling;
-
-    // Result is simply the uptime milliseconds (represented in nanoseconds) +
-    // the added nanoseconds
-    return current_millis_count + nanoseconds_uptime_scaled;
+    // The whole uptime comes from one read of the extended cycle count, so it
+    // never goes backwards, unlike combining it with the tick count.
+    return DwtCounter::CyclesToDuration(dwt_counter.GetCount64(),
+                                        cycles_per_second);
   }
 
   /// Constructor for ARM Cortex M system timer.
@@ -160,10 +142,7 @@ class SystemTimer final : public sjsu::SystemTimer
     const auto kSystemFrequency =
         sjsu::SystemController::GetPlatformController().GetClockRate(id_);
 
-    ticks_per_millisecond = kSystemFrequency.to<uint32_t>() / 1000;
-
-    nanoseconds_per_tick = (kFixedPointScaling * 1'000'000'000ns) /
-                           kSystemFrequency.to<uint32_t>();
+    cycles_per_second = kSystemFrequency.to<uint32_t>();
 
     uint32_t reload_value = (kSystemFrequency / settings.frequency) - 1;
 
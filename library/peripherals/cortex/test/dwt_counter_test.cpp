@@ -41,6 +41,60 @@ TEST_CASE("Testing ARM Cortex Data Watchdog Trace Counter")
     CHECK(1024 == test_subject.GetCount());
   }
 
+  SECTION("GetCount64() extends the count past the counter wrapping")
+  {
+    // Setup
+    test_subject.Initialize();
+
+    // Exercise + Verify: Each half of the counter is seen at least once per
+    //                    wrap.
+    for (uint64_t wrap = 0; wrap < 3; wrap++)
+    {
+      local_dwt.CYCCNT = 0x1234;
+      CHECK((wrap << 32) + 0x1234 == test_subject.GetCount64());
+      CHECK((wrap << 32) + 0x1234 == test_subject.GetCount64());
+      local_dwt.CYCCNT = 0x8000'0000;
+      CHECK((wrap << 32) + 0x8000'0000 == test_subject.GetCount64());
+      local_dwt.CYCCNT = 0xFFFF'FFFF;
+      CHECK((wrap << 32) + 0xFFFF'FFFF == test_subject.GetCount64());
+    }
+  }
+
+  SECTION("Initializing again keeps counting from where the count is")
+  {
+    // Setup
+    test_subject.Initialize();
+    local_dwt.CYCCNT = 0x8000'0000;
+    CHECK(0x8000'0000 == test_subject.GetCount64());
+    local_dwt.CYCCNT = 0x1234;
+    CHECK(0x1'0000'1234 == test_subject.GetCount64());
+
+    // Exercise
+    DwtCounter another;
+    another.Initialize();
+    test_subject.Initialize();
+
+    // Verify
+    CHECK(0x1234 == local_dwt.CYCCNT);
+    CHECK(0x1'0000'1234 == test_subject.GetCount64());
+    CHECK(0x1'0000'1234 == another.GetCount64());
+  }
+
+  SECTION("Cycle conversions")
+  {
+    constexpr uint32_t kFrequency = 120'000'000;
+    constexpr uint64_t kTenHours  = uint64_t{ 36'000 } * kFrequency;
+
+    CHECK(0ns == DwtCounter::CyclesToDuration(0, kFrequency));
+    CHECK(25ns == DwtCounter::CyclesToDuration(3, kFrequency));
+    CHECK(1s == DwtCounter::CyclesToDuration(kFrequency, kFrequency));
+    CHECK(10h + 25ns ==
+          DwtCounter::CyclesToDuration(kTenHours + 3, kFrequency));
+    CHECK(3 == DwtCounter::DurationToCycles(25ns, kFrequency));
+    CHECK(kTenHours + 3 ==
+          DwtCounter::DurationToCycles(10h + 25ns, kFrequency));
+  }
+
   DwtCounter::dwt  = DWT;
   DwtCounter::core = CoreDebug;
 }
@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <vector>
+
+#include "peripherals/cortex/interrupt_profiler.hpp"
+#include "testing/testing_frameworks.hpp"
+
+namespace sjsu::cortex
+{
+TEST_CASE("Testing cortex InterruptProfiler")
+{
+  DWT_Type local_dwt = {
+    // This field must be defined otherwise compiler will complain
+    .PCSR = 0,
+  };
+  testing::ClearStructure(&local_dwt);
+  InterruptProfiler::dwt = &local_dwt;
+
+  constexpr int kFirstIrq = -16;
+  std::array<InterruptStatistics_t, 32> statistics;
+  InterruptProfiler test_subject(statistics, kFirstIrq);
+
+  auto run_handler = [&](size_t index, uint32_t entry, uint32_t exit) {
+    local_dwt.CYCCNT = entry;
+    auto frame       = test_subject.Enter(index);
+    local_dwt.CYCCNT = exit;
+    test_subject.Exit(index, frame);
+  };
+
+  SECTION("Cycles in the handler and period between entries")
+  {
+    // Exercise: A periodic handler that arrives late on its third entry
+    run_handler(20, 1000, 1100);
+    run_handler(20, 2000, 2300);
+    run_handler(20, 3500, 3700);
+
+    // Verify
+    const auto & result = test_subject.GetStatistics()[20];
+    CHECK(3 == result.count);
+    CHECK(0 == result.preemptions);
+    CHECK(100 == result.minimum_cycles);
+    CHECK(300 == result.maximum_cycles);
+    CHECK(600 == result.total_cycles);
+    CHECK(200 == result.AverageCycles());
+    CHECK(1000 == result.minimum_period);
+    CHECK(1500 == result.maximum_period);
+    CHECK(4 == test_subject.IndexToIrq(20));
+    CHECK(1 == test_subject.GetMaximumDepth());
+  }
+
+  SECTION("Nested handlers are not counted towards the one they preempt")
+  {
+    // Exercise
+    local_dwt.CYCCNT = 0;
+    auto outer       = test_subject.Enter(17);
+    run_handler(18, 100, 400);
+    run_handler(19, 500, 550);
+    local_dwt.CYCCNT = 1000;
+    test_subject.Exit(17, outer);
+
+    // Verify
+    CHECK(650 == statistics[17].maximum_cycles);
+    CHECK(0 == statistics[17].preemptions);
+    CHECK(300 == statistics[18].maximum_cycles);
+    CHECK(1 == statistics[18].preemptions);
+    CHECK(50 == statistics[19].maximum_cycles);
+    CHECK(2 == test_subject.GetMaximumDepth());
+  }
+
+  SECTION("Cycle counter wraps during a handler")
+  {
+    // Exercise
+    run_handler(20, UINT32_MAX - 49, 50);
+
+    // Verify
+    CHECK(100 == statistics[20].maximum_cycles);
+  }
+
+  SECTION("Reset")
+  {
+    // Setup
+    run_handler(20, 0, 100);
+
+    // Exercise
+    test_subject.Reset();
+
+    // Verify
+    CHECK(0 == statistics[20].count);
+    CHECK(UINT32_MAX == statistics[20].minimum_cycles);
+    CHECK(0 == test_subject.GetMaximumDepth());
+  }
+
+  SECTION("Dump")
+  {
+    // Setup
+    run_handler(3, 0, 10);
+    run_handler(20, 100, 130);
+    run_handler(20, 1100, 1120);
+
+    // Exercise
+    std::vector<uint8_t> dump;
+    test_subject.Dump([&dump](std::span<const uint8_t> bytes) {
+      dump.insert(dump.end(), bytes.begin(), bytes.end());
+    });
+
+    // Verify
+    constexpr size_t kHeader = InterruptProfiler::kDumpHeaderSize;
+    constexpr size_t kRecord = InterruptProfiler::kDumpRecordSize;
+    REQUIRE(kHeader + 2 * kRecord == dump.size());
+
+    const std::vector<uint8_t> kExpectedHeader = {
+      'I', 'R', 'Q', 'P', 1, 0, 2, 0, 1, 0, 0, 0,
+    };
+    CHECK(kExpectedHeader ==
+          std::vector<uint8_t>(dump.begin(), dump.begin() + kHeader));
+
+    // Verify: Second record, for irq 4
+    const std::vector<uint8_t> kExpectedRecord = {
+      4,    0, 0, 0,              // irq, reserved
+      2,    0, 0, 0,              // count
+      0,    0, 0, 0,              // preemptions
+      20,   0, 0, 0,              // minimum_cycles
+      30,   0, 0, 0,              // maximum_cycles
+      50,   0, 0, 0, 0, 0, 0, 0,  // total_cycles
+      0xE8, 3, 0, 0,              // minimum_period
+      0xE8, 3, 0, 0,              // maximum_period
+    };
+    CHECK(kExpectedRecord ==
+          std::vector<uint8_t>(dump.begin() + kHeader + kRecord, dump.end()));
+    CHECK(0xF3 == dump[kHeader]);  // irq -13
+    CHECK(0xFF == dump[kHeader + 1]);
+  }
+
+  InterruptProfiler::dwt = DWT;
+}
+}  // namespace sjsu::cortex
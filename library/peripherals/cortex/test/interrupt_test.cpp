@@ -70,5 +70,11 @@ TEST_CASE("Testing cortex interrupt")
     test_subject.Disable(kIRQ);
     CHECK(local_nvic.ICER[(kIRQ >> 5)] == (1 << (kIRQ & 0x1F)));
   }
+  SECTION("Trigger")
+  {
+    test_subject.Trigger(kIRQ);
+    CHECK(local_nvic.ISPR[(kIRQ >> 5)] == (1 << (kIRQ & 0x1F)));
+    CHECK_THROWS(test_subject.Trigger(cortex::PendSV_IRQn));
+  }
 }
 }  // namespace sjsu::cortex
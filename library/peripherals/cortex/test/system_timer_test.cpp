@@ -60,11 +60,6 @@ TEST_CASE("Testing ARM Cortex SystemTimer")
     constexpr auto kFrequency         = 1_kHz;
     constexpr auto kExpectedLoadValue = (kClockFrequency / kFrequency) - 1;
     constexpr auto kClockFrequencyInt = kClockFrequency.to<uint32_t>();
-    constexpr auto kExpectedTicksPerMillisecond =
-        kClockFrequencyInt / 1000 /* ms/s */;
-    constexpr auto kExpectedNanosecondsPerTick =
-        (SystemTimer::kFixedPointScaling * 1'000'000'000ns) /
-        kClockFrequencyInt;
 
     // Setup: Set LOAD to zero
     local_systick.LOAD = 0;
@@ -82,8 +77,7 @@ TEST_CASE("Testing ARM Cortex SystemTimer")
     CHECK(0 == local_dwt.CYCCNT);
     CHECK(DWT_CTRL_CYCCNTENA_Msk == local_dwt.CTRL);
 
-    CHECK(kExpectedTicksPerMillisecond == SystemTimer::ticks_per_millisecond);
-    CHECK(kExpectedNanosecondsPerTick == SystemTimer::nanoseconds_per_tick);
+    CHECK(kClockFrequencyInt == SystemTimer::cycles_per_second);
     CHECK(kExpectedLoadValue.to<uint32_t>() == local_systick.LOAD);
 
     CHECK(kMask == local_systick.CTRL);
@@ -156,9 +150,7 @@ TEST_CASE("Testing ARM Cortex SystemTimer")
   {
     // Setup
     constexpr uint32_t kDebugCountTicks = 128;
-    constexpr auto kMilliseconds        = 1ms;
-    SystemTimer::millisecond_count      = kMilliseconds;
-    constexpr auto kExpectedUptime = kMilliseconds + (kDebugCountTicks * 100ns);
+    constexpr auto kExpectedUptime      = kDebugCountTicks * 100ns;
 
     // Exercise
     test_subject.Initialize();
@@ -169,6 +161,22 @@ TEST_CASE("Testing ARM Cortex SystemTimer")
     CHECK(kExpectedUptime == uptime);
   }
 
+  SECTION("GetCount() continues past the DWT counter wrapping")
+  {
+    // Setup
+    test_subject.Initialize();
+
+    // Exercise: The tick interrupt sees the counter in its upper half, then it
+    //           wraps.
+    local_dwt.CYCCNT = 0xC000'0000;
+    test_subject.SystemTimerHandler();
+    local_dwt.CYCCNT = 0x10;
+    auto uptime      = test_subject.GetCount();
+
+    // Verify
+    CHECK((0x1'0000'0010 * 100ns) == uptime);
+  }
+
   // Cleanup
   SystemTimer::sys_tick = SysTick;
   DwtCounter::dwt       = DWT;
@@ -1,18 +1,102 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include "peripherals/inactive.hpp"
 #include "module.hpp"
+#include "utility/error_handling.hpp"
 
 namespace sjsu
 {
 /// Used specifically for defining an interrupt vector table of addresses.
 using InterruptVectorAddress = void (*)(void);
 
+/// Callable object for interrupt service routines that never allocates.
+///
+/// The callable is stored in place, so a copy is a plain copy of a few words
+/// and a call is a single indirect call through a function pointer. Any
+/// callable that is trivially copyable and no larger than kStorageSize can be
+/// stored, which covers free functions, static member functions and lambdas
+/// capturing up to two pointers or references, such as [this]. Anything
+/// larger, such as a std::function, must be kept alive elsewhere and called
+/// from a lambda capturing a reference to it.
+///
+/// @tparam Args - arguments the callable is called with. Interrupt handlers
+///         take none, see InterruptDelegate.
+template <typename... Args>
+class BasicInterruptDelegate
+{
+ public:
+  /// Number of bytes available to store the callable.
+  static constexpr size_t kStorageSize = 2 * sizeof(void *);
+
+  /// Construct an empty delegate. Calling it throws std::bad_function_call,
+  /// like an empty std::function.
+  constexpr BasicInterruptDelegate() = default;
+
+  /// Construct an empty delegate.
+  constexpr BasicInterruptDelegate(std::nullptr_t) {}  // NOLINT
+
+  /// @param callable - function or lambda to call when the interrupt fires.
+  template <typename Callable,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<Callable>,
+                                BasicInterruptDelegate> &&
+                std::is_invocable_v<std::decay_t<Callable> &, Args...>>>
+  BasicInterruptDelegate(Callable && callable)  // NOLINT
+  {
+    using Stored_t = std::decay_t<Callable>;
+    static_assert(sizeof(Stored_t) <= kStorageSize &&
+                      alignof(Stored_t) <= alignof(void *),
+                  "Interrupt handlers can capture at most two pointers or "
+                  "references.");
+    static_assert(std::is_trivially_copyable_v<Stored_t> &&
+                      std::is_trivially_destructible_v<Stored_t>,
+                  "Interrupt handlers must be trivially copyable, capture "
+                  "objects such as std::function by reference instead.");
+
+    new (storage_) Stored_t(std::forward<Callable>(callable));
+    invoker_ = [](const void * storage, Args... args) {
+      (*static_cast<Stored_t *>(const_cast<void *>(storage)))(args...);
+    };
+  }
+
+  /// Call the stored callable.
+  ///
+  /// @param args - arguments passed to the callable.
+  void operator()(Args... args) const
+  {
+    invoker_(storage_, args...);
+  }
+
+  /// @return true - if a callable is stored.
+  explicit operator bool() const
+  {
+    return invoker_ != InvokeEmpty;
+  }
+
+ private:
+  using Invoker_t = void (*)(const void * storage, Args... args);
+
+  static void InvokeEmpty(const void *, Args...)
+  {
+    throw std::bad_function_call();
+  }
+
+  alignas(void *) std::byte storage_[kStorageSize] = {};
+  Invoker_t invoker_                                = InvokeEmpty;
+};
+
+/// Callable object for interrupt service routines, see BasicInterruptDelegate.
+using InterruptDelegate = BasicInterruptDelegate<>;
+
 /// Define an alias for an interrupt service routine callable object.
-using InterruptHandler = std::function<void(void)>;
+using InterruptHandler = InterruptDelegate;
 
 /// Standard callback that should be executed when interrupts fire.
 using InterruptCallback = std::function<void(void)>;
@@ -78,6 +162,20 @@ class InterruptController : public Module<>
   /// @param interrupt_request_number - the interrupt request number to be
   ///        disabled.
   virtual void Disable(int interrupt_request_number) = 0;
+
+  /// Set an interrupt pending from software, so its handler runs as if the
+  /// peripheral had requested it. Lets software hand work to a lower priority
+  /// interrupt, see DeferredWork.
+  ///
+  /// @param interrupt_request_number - the interrupt request number to
+  ///        trigger.
+  /// @throw std::errc::operation_not_supported if the platform cannot trigger
+  ///        interrupts from software.
+  virtual void Trigger([[maybe_unused]] int interrupt_request_number)
+  {
+    throw Exception(std::errc::operation_not_supported,
+                    "This interrupt controller cannot trigger interrupts.");
+  }
 };
 
 /// Compare operator between two InterruptController::RegistrationInfo_t
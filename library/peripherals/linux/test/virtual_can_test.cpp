@@ -0,0 +1,186 @@
+#include <array>
+
+#include "peripherals/linux/virtual_can.hpp"
+#include "testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing VirtualCan")
+{
+  VirtualCanBus bus(500_kHz);
+  VirtualCan node_a(bus);
+  VirtualCan node_b(bus);
+  VirtualCan node_c(bus);
+  node_a.Initialize();
+  node_b.Initialize();
+  node_c.Initialize();
+
+  std::array<Can::Message_t, 8> received;
+
+  SECTION("FrameBits()")
+  {
+    // Setup: An all zero frame needs a stuff bit after every five zeros
+    Can::Message_t zeros = { .id = 0 };
+    Can::Message_t full  = { .id = 0x555, .length = 8 };
+    full.payload         = { 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55 };
+    Can::Message_t extended = {
+      .id = 0x1555'5555, .format = Can::Message_t::Format::kExtended
+    };
+
+    // Exercise + Verify
+    CHECK(47 + 6 == VirtualCanBus::FrameBits(zeros));
+    CHECK(111 <= VirtualCanBus::FrameBits(full));
+    CHECK(111 + 24 >= VirtualCanBus::FrameBits(full));
+    CHECK(67 <= VirtualCanBus::FrameBits(extended));
+    CHECK(VirtualCanBus::FrameBits(zeros) * 2us == bus.FrameTime(zeros));
+  }
+
+  SECTION("Frames are sent in arbitration order")
+  {
+    // Setup
+    node_a.Send(0x300, { 3 });
+    node_a.Send(0x100, { 1 });
+    node_b.Send(0x200, { 2 });
+
+    // Exercise
+    bus.RunUntilIdle();
+
+    // Verify
+    REQUIRE(3 == node_c.Receive(received));
+    CHECK(0x100 == received[0].id);
+    CHECK(0x200 == received[1].id);
+    CHECK(0x300 == received[2].id);
+    CHECK(bus.FrameTime(received[0]) == received[0].uptime);
+    CHECK(received[0].uptime + bus.FrameTime(received[1]) ==
+          received[1].uptime);
+    CHECK(bus.Now() == received[2].uptime);
+
+    // Verify: Senders do not receive their own frames
+    CHECK(1 == node_a.Receive(received));
+    CHECK(0x200 == received[0].id);
+    CHECK(2 == node_b.Receive(received));
+  }
+
+  SECTION("Bus load")
+  {
+    // Setup
+    Can::Message_t first  = { .id = 0x100, .length = 4 };
+    Can::Message_t second = { .id = 0x200, .length = 4 };
+    first.payload         = { 1, 2, 3, 4 };
+    second.payload        = { 1, 2, 3, 4 };
+    node_a.Send(first);
+    node_b.Send(second);
+    auto busy_time = bus.FrameTime(first) + bus.FrameTime(second);
+
+    // Exercise
+    bus.Run(1ms);
+
+    // Verify
+    auto statistics = bus.GetStatistics();
+    CHECK(2 == statistics.frames);
+    CHECK(1ms == bus.Now());
+    CHECK(1ms == statistics.elapsed_time);
+    CHECK(busy_time == statistics.busy_time);
+    CHECK(statistics.Load() == doctest::Approx(busy_time / 1.0ms));
+  }
+
+  SECTION("Injected errors cause retransmission")
+  {
+    // Setup
+    node_a.Send(0x100, { 1 });
+    bus.InjectErrors(1);
+
+    // Exercise
+    bus.RunUntilIdle();
+
+    // Verify
+    CHECK(1 == bus.GetStatistics().errors);
+    CHECK(1 == bus.GetStatistics().frames);
+    CHECK(1 == node_b.Receive(received));
+    CHECK(7 == node_a.TransmitErrorCount());
+    CHECK(1 == node_a.GetBusStatistics().transmitted_frames);
+    CHECK(1 == node_a.GetBusStatistics()
+                   .bus_errors[Value(Can::BusError::kOther)]);
+    CHECK(1 == node_b.GetBusStatistics().received_frames);
+
+    // Exercise: Enough errors to go bus off
+    node_a.Send(0x100, { 1 });
+    bus.InjectErrors(VirtualCan::kBusOffErrorCount / 8);
+    bus.RunUntilIdle();
+
+    // Verify
+    CHECK(node_a.IsBusOff());
+    CHECK(!node_a.TrySend({ .id = 0x100 }));
+    CHECK(!node_b.HasData());
+  }
+
+  SECTION("Acceptance filter and receive handler")
+  {
+    // Setup: Node B answers every request from node A
+    std::array filters = { Can::AcceptanceFilter_t::Id(0x100) };
+    node_b.ConfigureAcceptanceFilter(filters);
+    node_b.settings.handler = [](Can & can) {
+      auto request = can.Receive();
+      can.Send(request.id + 1, { request.payload[0] });
+    };
+    node_b.Initialize();
+
+    // Exercise
+    node_a.Send(0x100, { 0x42 });
+    node_a.Send(0x300, { 0x43 });
+    bus.RunUntilIdle();
+
+    // Verify
+    CHECK(3 == bus.GetStatistics().frames);
+    REQUIRE(1 == node_a.Receive(received));
+    CHECK(0x101 == received[0].id);
+    CHECK(0x42 == received[0].payload[0]);
+    CHECK(!node_b.HasData());
+  }
+
+  SECTION("Send() waits for room, only TrySend() drops")
+  {
+    // Setup
+    constexpr size_t kFrames = config::kCanTransmitQueueSize + 4;
+
+    // Exercise: Send() runs the bus to make room in the full queue
+    for (size_t i = 0; i < kFrames; i++)
+    {
+      node_a.Send(0x100, { static_cast<uint8_t>(i) });
+    }
+
+    // Verify
+    CHECK(0 == node_a.GetTransmitStatistics().dropped);
+
+    // Exercise
+    for (size_t i = 0; i < config::kCanTransmitQueueSize; i++)
+    {
+      node_a.TrySend({ .id = 0x100 });
+    }
+    bus.RunUntilIdle();
+
+    // Verify: Every frame sent with Send() made it onto the bus
+    CHECK(0 < node_a.GetTransmitStatistics().dropped);
+    CHECK(kFrames + config::kCanTransmitQueueSize -
+              node_a.GetTransmitStatistics().dropped ==
+          node_a.GetTransmitStatistics().completed);
+  }
+
+  SECTION("Receive queue overrun")
+  {
+    // Setup
+    for (size_t i = 0; i < config::kCanReceiveQueueSize + 2; i++)
+    {
+      node_a.Send(0x100, { static_cast<uint8_t>(i) });
+    }
+
+    // Exercise
+    bus.RunUntilIdle();
+
+    // Verify
+    CHECK(2 == node_b.GetReceiveStatistics().overruns);
+    CHECK(config::kCanReceiveQueueSize ==
+          node_b.GetReceiveStatistics().queue_depth);
+  }
+}
+}  // namespace sjsu
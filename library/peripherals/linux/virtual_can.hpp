@@ -0,0 +1,576 @@
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "config.hpp"
+#include "peripherals/can.hpp"
+#include "utility/error_handling.hpp"
+#include "utility/math/units.hpp"
+
+namespace sjsu
+{
+class VirtualCan;
+
+/// Simulated CAN bus for running several CAN nodes in one process, such as
+/// whole multi-node control loops in a host test or on a Linux machine.
+///
+/// The bus keeps its own simulated clock. Every frame takes the time it would
+/// take on a real bus at the configured bit rate, including stuff bits, and
+/// pending frames are sent in the order they would win arbitration. Nothing
+/// happens on the bus until Step(), Run() or RunUntilIdle() is called, so the
+/// bus and every VirtualCan attached to it must be used from one thread.
+class VirtualCanBus
+{
+ public:
+  /// Maximum number of VirtualCan nodes attached to one bus.
+  static constexpr size_t kMaximumNodes = 16;
+
+  /// Bits that follow the CRC of every frame and are never stuffed: CRC
+  /// delimiter, ACK slot, ACK delimiter, end of frame and interframe space.
+  static constexpr size_t kFrameTrailerBits = 1 + 1 + 1 + 7 + 3;
+
+  /// Bits taken by an error frame: error flag, error delimiter and
+  /// interframe space.
+  static constexpr size_t kErrorFrameBits = 6 + 8 + 3;
+
+  /// Bus activity counters.
+  struct Statistics_t
+  {
+    /// Number of frames transmitted successfully.
+    size_t frames = 0;
+    /// Number of frames destroyed by an injected error.
+    size_t errors = 0;
+    /// Total time the bus was busy sending frames and error frames.
+    std::chrono::nanoseconds busy_time = 0ns;
+    /// Total simulated time since the statistics were reset.
+    std::chrono::nanoseconds elapsed_time = 0ns;
+
+    /// @return float - fraction of the elapsed time the bus was busy.
+    float Load() const
+    {
+      if (elapsed_time == 0ns)
+      {
+        return 0.0f;
+      }
+      return static_cast<float>(busy_time.count()) /
+             static_cast<float>(elapsed_time.count());
+    }
+  };
+
+  /// Calculate the number of bits a frame takes on the bus, including the
+  /// stuff bits that would be inserted into it.
+  ///
+  /// @param message - frame to measure.
+  /// @return size_t - length of the frame in bits.
+  static constexpr size_t FrameBits(const Can::Message_t & message)
+  {
+    // Only the frame up to the end of the CRC is stuffed, so build that part
+    // bit by bit. The longest is an extended frame with 39 bits of header and
+    // control field, 8 bytes of data and a 15-bit CRC.
+    std::array<bool, 39 + 64 + 15> bits = {};
+    size_t count = 0;
+
+    auto append = [&bits, &count](uint32_t value, size_t width) {
+      for (size_t i = width; i > 0; i--)
+      {
+        bits[count++] = (value >> (i - 1)) & 1;
+      }
+    };
+
+    const bool kExtended =
+        message.format == Can::Message_t::Format::kExtended;
+    const uint32_t kLength = std::min<uint32_t>(message.length, 8);
+
+    append(0, 1);  // Start of frame
+    if (kExtended)
+    {
+      append(message.id >> 18, 11);
+      append(1, 1);  // Substitute remote request
+      append(1, 1);  // Identifier extension
+      append(message.id, 18);
+      append(message.is_remote_request, 1);
+      append(0, 2);  // Reserved bits
+    }
+    else
+    {
+      append(message.id, 11);
+      append(message.is_remote_request, 1);
+      append(0, 1);  // Identifier extension
+      append(0, 1);  // Reserved bit
+    }
+    append(kLength, 4);
+
+    if (!message.is_remote_request)
+    {
+      for (size_t i = 0; i < kLength; i++)
+      {
+        append(message.payload[i], 8);
+      }
+    }
+
+    uint32_t crc = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      const bool kNext = bits[i] ^ ((crc >> 14) & 1);
+      crc              = (crc << 1) & 0x7FFF;
+      if (kNext)
+      {
+        crc ^= 0x4599;
+      }
+    }
+    append(crc, 15);
+
+    // A stuff bit of the opposite value is inserted after every five bits of
+    // the same value, and counts towards the next run.
+    size_t stuff_bits = 0;
+    size_t run        = 1;
+    bool previous     = bits[0];
+    for (size_t i = 1; i < count; i++)
+    {
+      if (bits[i] == previous)
+      {
+        run++;
+      }
+      else
+      {
+        previous = bits[i];
+        run      = 1;
+      }
+
+      if (run == 5)
+      {
+        stuff_bits++;
+        previous = !previous;
+        run      = 1;
+      }
+    }
+
+    return count + stuff_bits + kFrameTrailerBits;
+  }
+
+  /// @param bit_rate - bit rate of the simulated bus.
+  explicit VirtualCanBus(units::frequency::hertz_t bit_rate = 1_MHz)
+      : bit_time_(std::chrono::nanoseconds(
+            1'000'000'000 / bit_rate.to<int64_t>()))
+  {
+  }
+
+  /// @param message - frame to measure.
+  /// @return std::chrono::nanoseconds - time the frame takes on this bus.
+  std::chrono::nanoseconds FrameTime(const Can::Message_t & message) const
+  {
+    return FrameBits(message) * bit_time_;
+  }
+
+  /// Send the pending frame that wins arbitration and deliver it to every
+  /// other node.
+  ///
+  /// @return true - if a frame was on the bus, false if the bus is idle.
+  inline bool Step();
+
+  /// Send frames for a duration of simulated time. The bus is idle for the
+  /// rest of the time.
+  ///
+  /// @param duration - amount of simulated time to advance.
+  void Run(std::chrono::nanoseconds duration)
+  {
+    const auto kEnd = now_ + duration;
+    while (now_ < kEnd && Step())
+    {
+      continue;
+    }
+    if (now_ < kEnd)
+    {
+      statistics_.elapsed_time += kEnd - now_;
+      now_ = kEnd;
+    }
+  }
+
+  /// Send frames until no node has anything left to send.
+  void RunUntilIdle()
+  {
+    while (Step())
+    {
+      continue;
+    }
+  }
+
+  /// Corrupt the next frames sent on the bus. Each corrupted frame is followed
+  /// by an error frame and is retransmitted by its sender.
+  ///
+  /// @param count - number of frames to corrupt.
+  void InjectErrors(size_t count)
+  {
+    pending_errors_ += count;
+  }
+
+  /// @return std::chrono::nanoseconds - current simulated time. Can be passed
+  ///         to SetUptimeFunction() to run application code on bus time.
+  std::chrono::nanoseconds Now() const
+  {
+    return now_;
+  }
+
+  /// @return Statistics_t - bus activity since the last reset.
+  Statistics_t GetStatistics() const
+  {
+    return statistics_;
+  }
+
+  /// Clear the bus activity counters.
+  void ResetStatistics()
+  {
+    statistics_ = {};
+  }
+
+ private:
+  friend class VirtualCan;
+
+  void Attach(VirtualCan & node)
+  {
+    if (node_count_ >= kMaximumNodes)
+    {
+      throw Exception(std::errc::not_enough_memory,
+                      "Too many nodes attached to the virtual CAN bus.");
+    }
+    nodes_[node_count_++] = &node;
+  }
+
+  void Detach(VirtualCan & node)
+  {
+    auto end = nodes_.begin() + node_count_;
+    if (std::remove(nodes_.begin(), end, &node) != end)
+    {
+      node_count_--;
+    }
+  }
+
+  void Advance(std::chrono::nanoseconds time)
+  {
+    now_ += time;
+    statistics_.busy_time += time;
+    statistics_.elapsed_time += time;
+  }
+
+  std::chrono::nanoseconds bit_time_;
+  std::chrono::nanoseconds now_ = 0ns;
+  std::array<VirtualCan *, kMaximumNodes> nodes_ = {};
+  size_t node_count_                               = 0;
+  size_t pending_errors_                           = 0;
+  Statistics_t statistics_;
+};
+
+/// sjsu::Can implementation attached to a VirtualCanBus. The baud rate setting
+/// is ignored, every node runs at the bus's bit rate. Received messages and
+/// completed transmissions are timestamped at the end of the frame with the
+/// node's local clock, which is the bus's simulated time unless SetClock()
+/// gives the node an offset and drift.
+class VirtualCan final : public sjsu::Can
+{
+ public:
+  /// Adding this so Send() with the std::initializer_list is within the scope
+  /// of this class.
+  using sjsu::Can::Send;
+
+  /// Number of transmit errors after which a node goes bus off.
+  static constexpr uint32_t kBusOffErrorCount = 256;
+
+  /// @param bus - bus to attach to.
+  /// @throw std::errc::not_enough_memory if the bus has no room for the node.
+  explicit VirtualCan(VirtualCanBus & bus) : bus_(bus)
+  {
+    bus_.Attach(*this);
+  }
+
+  ~VirtualCan()
+  {
+    bus_.Detach(*this);
+  }
+
+  void ModuleInitialize() override
+  {
+    transmit_error_count_ = 0;
+    ResetBusStatistics();
+  }
+
+  void Send(const Message_t & message) override
+  {
+    // Without a real bus running in the background, a full queue is drained
+    // by running the simulated bus. The message is only lost if the
+    // controller goes bus off before there is room for it.
+    while (!Enqueue(message))
+    {
+      if (IsBusOff())
+      {
+        transmit_statistics_.dropped++;
+        return;
+      }
+      bus_.Step();
+    }
+  }
+
+  bool TrySend(const Message_t & message) override
+  {
+    if (!Enqueue(message))
+    {
+      transmit_statistics_.dropped++;
+      return false;
+    }
+    return true;
+  }
+
+  TransmitStatistics_t GetTransmitStatistics() override
+  {
+    auto statistics        = transmit_statistics_;
+    statistics.queue_depth = transmit_queue_.Size();
+    return statistics;
+  }
+
+  void ConfigureAcceptanceFilter(
+      std::span<const AcceptanceFilter_t> filters) override
+  {
+    filter_count_ = std::min(filters.size(), filters_.size());
+    std::copy_n(filters.begin(), filter_count_, filters_.begin());
+  }
+
+  Message_t Receive() override
+  {
+    Message_t message;
+    receive_queue_.Pop(std::span(&message, 1));
+    return message;
+  }
+
+  size_t Receive(std::span<Message_t> messages) override
+  {
+    return receive_queue_.Pop(messages);
+  }
+
+  ReceiveStatistics_t GetReceiveStatistics() override
+  {
+    auto statistics        = receive_statistics_;
+    statistics.queue_depth = receive_queue_.Size();
+    return statistics;
+  }
+
+  bool HasData() override
+  {
+    return !receive_queue_.IsEmpty();
+  }
+
+  bool SelfTest(uint32_t) override
+  {
+    return !IsBusOff();
+  }
+
+  bool IsBusOff() override
+  {
+    return transmit_error_count_ >= kBusOffErrorCount;
+  }
+
+  BusStatistics_t GetBusStatistics() override
+  {
+    constexpr uint32_t kErrorWarningLimit = 96;
+    constexpr uint32_t kErrorPassiveLimit = 128;
+
+    auto statistics                 = bus_statistics_;
+    statistics.transmit_error_count = static_cast<uint8_t>(
+        std::min<uint32_t>(transmit_error_count_, UINT8_MAX));
+    statistics.error_warning = transmit_error_count_ >= kErrorWarningLimit;
+    statistics.error_passive = transmit_error_count_ >= kErrorPassiveLimit;
+    statistics.bus_off       = IsBusOff();
+    statistics.elapsed_time  = Now() - bus_statistics_start_;
+    return statistics;
+  }
+
+  void ResetBusStatistics() override
+  {
+    bus_statistics_       = {};
+    bus_statistics_start_ = Now();
+  }
+
+  /// Model the node's local clock, as if it ran from its own oscillator.
+  ///
+  /// @param offset - local time when the bus's simulated time is zero.
+  /// @param drift_ppm - parts per million the local clock runs faster than
+  ///        the bus's simulated time. Negative values run slower.
+  void SetClock(std::chrono::nanoseconds offset, double drift_ppm)
+  {
+    clock_offset_    = offset;
+    clock_drift_ppm_ = drift_ppm;
+  }
+
+  /// @param bus_time - simulated time of the bus.
+  /// @return std::chrono::nanoseconds - the node's local time at bus_time.
+  std::chrono::nanoseconds LocalTime(std::chrono::nanoseconds bus_time) const
+  {
+    const auto kDrift = std::chrono::nanoseconds(static_cast<int64_t>(
+        static_cast<double>(bus_time.count()) * clock_drift_ppm_ / 1e6));
+    return bus_time + clock_offset_ + kDrift;
+  }
+
+  /// @return std::chrono::nanoseconds - the node's local time now. Can be
+  ///         passed to SetUptimeFunction() to run code on the node's clock.
+  std::chrono::nanoseconds Now() const
+  {
+    return LocalTime(bus_.Now());
+  }
+
+  /// @return uint32_t - transmit error counter, incremented by 8 for every
+  ///         frame destroyed by an error and decremented for every success.
+  uint32_t TransmitErrorCount() const
+  {
+    return transmit_error_count_;
+  }
+
+ private:
+  friend class VirtualCanBus;
+
+  using TransmitQueue_t = CanTransmitQueue<config::kCanTransmitQueueSize>;
+
+  /// Place a message into the transmit queue.
+  ///
+  /// @param message - message to transmit.
+  /// @return false - if the queue was full or the controller is bus off.
+  bool Enqueue(const Message_t & message)
+  {
+    // Record when the message was queued to measure its queueing latency.
+    Message_t queued_message = message;
+    queued_message.uptime    = Now();
+
+    if (IsBusOff() || !transmit_queue_.Push(queued_message))
+    {
+      return false;
+    }
+    transmit_statistics_.peak_queue_depth = std::max(
+        transmit_statistics_.peak_queue_depth, transmit_queue_.Size());
+    return true;
+  }
+
+  bool HasPending()
+  {
+    return !transmit_queue_.IsEmpty() && !IsBusOff();
+  }
+
+  void TransmitSucceeded()
+  {
+    const Message_t & message = transmit_queue_.Top();
+    const auto kNow           = Now();
+    bus_statistics_.RecordTransmit(message, kNow - message.uptime);
+    transmit_queue_.Pop();
+    transmit_statistics_.completed++;
+    transmit_statistics_.last_completion = kNow;
+    if (transmit_error_count_ > 0)
+    {
+      transmit_error_count_--;
+    }
+  }
+
+  void TransmitFailed()
+  {
+    bus_statistics_.RecordError(BusError::kOther);
+    transmit_error_count_ += 8;
+  }
+
+  void Deliver(Message_t message, std::chrono::nanoseconds timestamp)
+  {
+    if (GetState() != State::kInitialized || !Accepts(message))
+    {
+      return;
+    }
+
+    message.uptime = LocalTime(timestamp);
+    bus_statistics_.RecordReceive(message);
+    if (!receive_queue_.Push(message))
+    {
+      receive_statistics_.overruns++;
+      bus_statistics_.receive_overruns++;
+      return;
+    }
+
+    if (CurrentSettings().handler)
+    {
+      CurrentSettings().handler(*this);
+    }
+  }
+
+  bool Accepts(const Message_t & message) const
+  {
+    if (filter_count_ == 0)
+    {
+      return true;
+    }
+    return std::any_of(filters_.begin(),
+                       filters_.begin() + filter_count_,
+                       [&message](const AcceptanceFilter_t & filter) {
+                         return filter.Matches(message.id, message.format);
+                       });
+  }
+
+  VirtualCanBus & bus_;
+  TransmitQueue_t transmit_queue_;
+  TransmitStatistics_t transmit_statistics_;
+  CanReceiveQueue<config::kCanReceiveQueueSize> receive_queue_;
+  ReceiveStatistics_t receive_statistics_;
+  BusStatistics_t bus_statistics_;
+  std::chrono::nanoseconds bus_statistics_start_ = 0ns;
+  std::array<AcceptanceFilter_t, kMaximumAcceptanceFilters> filters_ = {};
+  size_t filter_count_                   = 0;
+  uint32_t transmit_error_count_         = 0;
+  std::chrono::nanoseconds clock_offset_ = 0ns;
+  double clock_drift_ppm_                = 0;
+};
+
+inline bool VirtualCanBus::Step()
+{
+  // Arbitration: the pending frame with the lowest key wins. Ties go to the
+  // node that was attached first.
+  VirtualCan * winner = nullptr;
+  for (auto * node : std::span(nodes_).first(node_count_))
+  {
+    if (node->HasPending() &&
+        (winner == nullptr ||
+         VirtualCan::TransmitQueue_t::ArbitrationKey(
+             node->transmit_queue_.Top()) <
+             VirtualCan::TransmitQueue_t::ArbitrationKey(
+                 winner->transmit_queue_.Top())))
+    {
+      winner = node;
+    }
+  }
+
+  if (winner == nullptr)
+  {
+    return false;
+  }
+
+  const Can::Message_t kMessage = winner->transmit_queue_.Top();
+  Advance(FrameTime(kMessage));
+
+  if (pending_errors_ > 0)
+  {
+    pending_errors_--;
+    statistics_.errors++;
+    Advance(kErrorFrameBits * bit_time_);
+    winner->TransmitFailed();
+    return true;
+  }
+
+  statistics_.frames++;
+  winner->TransmitSucceeded();
+
+  for (auto * node : std::span(nodes_).first(node_count_))
+  {
+    if (node != winner)
+    {
+      node->Deliver(kMessage, now_);
+    }
+  }
+
+  return true;
+}
+}  // namespace sjsu
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <initializer_list>
+#include <span>
 #include <scope>
 #include <string_view>
 
@@ -12,6 +15,7 @@
 #include "peripherals/lpc40xx/system_controller.hpp"
 #include "utility/enum.hpp"
 #include "utility/error_handling.hpp"
+#include "utility/log.hpp"
 #include "utility/macros.hpp"
 
 namespace sjsu
@@ -26,6 +30,10 @@ class Can final : public sjsu::Can
   /// of this class.
   using sjsu::Can::Send;
 
+  /// The controller has a double receive buffer, so at most this many messages
+  /// can be waiting in hardware when the receive interrupt is serviced.
+  static constexpr size_t kHardwareReceiveDepth = 2;
+
   /// This struct holds bit timing values. It is used to configure the CAN bus
   /// clock. It is HW mapped to a 32-bit register: BTR (pg. 562)
   struct BusTiming  // NOLINT
@@ -124,9 +132,33 @@ class Can final : public sjsu::Can
     /// If 1, receive buffer has at least 1 complete message stored
     static constexpr bit::Mask kReceiveBuffer = bit::MaskFromRange(0);
 
+    /// If 1, a message was lost because the receive buffer was full
+    static constexpr bit::Mask kDataOverrun = bit::MaskFromRange(1);
+
+    /// If 1, one or both of the error counters has reached the error warning
+    /// limit.
+    static constexpr bit::Mask kErrorStatus = bit::MaskFromRange(6);
+
     /// Bus status bit. If this is '1' then the bus is active, otherwise the bus
     /// is bus off.
     static constexpr bit::Mask kBusError = bit::MaskFromRange(7);
+
+    /// The controller's receive error counter
+    static constexpr bit::Mask kReceiveErrorCounter =
+        bit::MaskFromRange(16, 23);
+
+    /// The controller's transmit error counter
+    static constexpr bit::Mask kTransmitErrorCounter =
+        bit::MaskFromRange(24, 31);
+  };
+
+  /// Values of the error code type field of ICR (pg. 560)
+  enum ErrorCodeTypes : uint8_t
+  {
+    kBitError   = 0b00,
+    kFormError  = 0b01,
+    kStuffError = 0b10,
+    kOtherError = 0b11,
   };
 
   /// This struct holds CAN controller status information. It is HW mapped to a
@@ -190,13 +222,36 @@ class Can final : public sjsu::Can
   enum class Commands : uint32_t
   {
     kReleaseRxBuffer            = 0x04,
+    kClearDataOverrun           = 0x08,
     kSendTxBuffer1              = 0x21,
     kSendTxBuffer2              = 0x41,
     kSendTxBuffer3              = 0x81,
     kSelfReceptionSendTxBuffer1 = 0x30,
     kAcceptAllMessages          = 0x02,
+    kAcceptanceFilterOff        = 0x01,
+    kAcceptanceFilterOn         = 0x00,
   };
 
+  /// Bit layout of the entries within the acceptance filter RAM lookup tables.
+  /// https://www.nxp.com/docs/en/user-guide/UM10562.pdf (pg. 571)
+  struct AcceptanceFilterEntry  // NOLINT
+  {
+    /// Standard ID within a 16-bit standard frame entry
+    static constexpr bit::Mask kStandardId = bit::MaskFromRange(0, 10);
+
+    /// Controller number of a 16-bit standard frame entry
+    static constexpr bit::Mask kStandardController = bit::MaskFromRange(13, 15);
+
+    /// Extended ID within a 32-bit extended frame entry
+    static constexpr bit::Mask kExtendedId = bit::MaskFromRange(0, 28);
+
+    /// Controller number of a 32-bit extended frame entry
+    static constexpr bit::Mask kExtendedController = bit::MaskFromRange(29, 31);
+  };
+
+  /// Number of 32-bit words in the acceptance filter RAM
+  static constexpr size_t kAcceptanceFilterRamSize = 512;
+
   /// https://www.nxp.com/docs/en/user-guide/UM10562.pdf (pg. 560)
   /// CAN frame format: https://goo.gl/images/XLjzn5
   enum FrameErrorCodes : uint8_t
@@ -293,6 +348,29 @@ class Can final : public sjsu::Can
   /// Pointer to the LPC CANBUS acceptance filter peripheral in memory
   inline static LPC_CANAF_TypeDef * can_acceptance_filter_register = LPC_CANAF;
 
+  /// Pointer to the LPC CANBUS acceptance filter lookup table RAM
+  inline static LPC_CANAF_RAM_TypeDef * can_acceptance_filter_ram =
+      LPC_CANAF_RAM;
+
+  /// The acceptance filter is shared by both CAN controllers, so the filters
+  /// for each controller are held here and merged together every time the
+  /// lookup tables are rebuilt. A filter count of zero means that the
+  /// controller accepts all messages.
+  struct AcceptanceFilterList_t
+  {
+    /// Filters assigned to the controller
+    std::array<AcceptanceFilter_t, kMaximumAcceptanceFilters> filters;
+    /// Number of valid entries in filters
+    size_t count;
+  };
+
+  /// Filter lists for CAN1 and CAN2
+  inline static std::array<AcceptanceFilterList_t, 2> acceptance_filters = {};
+
+  /// Controllers that have been initialized, indexed by controller number.
+  /// Used by the interrupt handler shared by CAN1 and CAN2.
+  inline static std::array<Can *, 2> controllers = {};
+
   /// @param channel - Which CANBUS channel to use
   explicit constexpr Can(const Port_t & channel) : channel_(channel) {}
 
@@ -313,103 +391,92 @@ class Can final : public sjsu::Can
     SetMode(Mode::kReset, true);
 
     ConfigureBaudRate();
-    ConfigureReceiveHandler();
+    ConfigureInterrupts();
     EnableAcceptanceFilter();
 
+    // CurrentSettings() is only updated once initialization has finished.
+    bus_statistics_       = {};
+    bus_statistics_start_ =
+        (settings.timestamp != nullptr) ? settings.timestamp() : 0ns;
+
     // Flip logic of enable such that, if enable = true, set reset mode to false
     SetMode(Mode::kReset, false);
   }
 
   void Send(const Message_t & message) override
   {
-    LpcRegisters_t registers = ConvertMessageToRegisters(message);
-
-    // Wait for one of the buffers to be free so we can transmit a message
-    // through it.
-    bool sent = false;
-    while (!sent)
+    // Only wait if the transmit queue is full. Each attempt gives any free
+    // hardware buffers a chance to take messages from the queue.
+    while (!Enqueue(message))
     {
-      uint32_t status_register = channel_.registers->SR;
-      // Check if any buffer is available.
-      if (bit::Read(status_register, BufferStatus::kTx1Released))
-      {
-        channel_.registers->TFI1 = registers.frame;
-        channel_.registers->TID1 = registers.id;
-        channel_.registers->TDA1 = registers.data_a;
-        channel_.registers->TDB1 = registers.data_b;
-        channel_.registers->CMR  = Value(Commands::kSendTxBuffer1);
-        sent                     = true;
-      }
-      else if (bit::Read(status_register, BufferStatus::kTx2Released))
-      {
-        channel_.registers->TFI2 = registers.frame;
-        channel_.registers->TID2 = registers.id;
-        channel_.registers->TDA2 = registers.data_a;
-        channel_.registers->TDB2 = registers.data_b;
-        channel_.registers->CMR  = Value(Commands::kSendTxBuffer2);
-        sent                     = true;
-      }
-      else if (bit::Read(status_register, BufferStatus::kTx3Released))
-      {
-        channel_.registers->TFI3 = registers.frame;
-        channel_.registers->TID3 = registers.id;
-        channel_.registers->TDA3 = registers.data_a;
-        channel_.registers->TDB3 = registers.data_b;
-        channel_.registers->CMR  = Value(Commands::kSendTxBuffer3);
-        sent                     = true;
-      }
+      continue;
     }
   }
 
-  bool HasData() override
+  bool TrySend(const Message_t & message) override
   {
-    return bit::Read(channel_.registers->GSR, GlobalStatus::kReceiveBuffer);
+    if (!Enqueue(message))
+    {
+      transmit_statistics_.dropped++;
+      return false;
+    }
+    return true;
   }
 
-  Message_t Receive() override
+  TransmitStatistics_t GetTransmitStatistics() override
   {
-    Message_t message;
-
-    uint32_t frame = channel_.registers->RFS;
-
-    // Extract all of the information from the message frame
-    bool is_remote_request = bit::Extract(frame, FrameInfo::kRemoteRequest);
-    uint32_t length        = bit::Extract(frame, FrameInfo::kLength);
-    uint32_t format        = bit::Extract(frame, FrameInfo::kFormat);
+    auto statistics        = transmit_statistics_;
+    statistics.queue_depth = transmit_queue_.Size();
+    statistics.in_flight   = written_ - statistics.completed;
+    return statistics;
+  }
 
-    message.is_remote_request = is_remote_request;
-    message.length            = static_cast<uint8_t>(length);
-    message.format            = static_cast<Message_t::Format>(format);
+  void ConfigureAcceptanceFilter(
+      std::span<const AcceptanceFilter_t> filters) override
+  {
+    auto & list = acceptance_filters[ControllerNumber()];
 
-    // Get the frame ID
-    const uint32_t kRID = channel_.registers->RID;
-    if (message.format == Message_t::Format::kExtended)
+    if (filters.size() > list.filters.size())
     {
-      message.id = bit::Extract(kRID, bit::MaskFromRange(0, 10));
+      LogWarning("Too many CAN acceptance filters, accepting all messages.");
+      list.count = 0;
     }
     else
     {
-      message.id = bit::Extract(kRID, bit::MaskFromRange(0, 28));
+      std::copy(filters.begin(), filters.end(), list.filters.begin());
+      list.count = filters.size();
     }
 
-    // Pull the bytes from RDA into the payload array
-    message.payload[0] = (channel_.registers->RDA >> (0 * 8)) & 0xFF;
-    message.payload[1] = (channel_.registers->RDA >> (1 * 8)) & 0xFF;
-    message.payload[2] = (channel_.registers->RDA >> (2 * 8)) & 0xFF;
-    message.payload[3] = (channel_.registers->RDA >> (3 * 8)) & 0xFF;
-
-    // Pull the bytes from RDB into the payload array
-    message.payload[4] = (channel_.registers->RDB >> (0 * 8)) & 0xFF;
-    message.payload[5] = (channel_.registers->RDB >> (1 * 8)) & 0xFF;
-    message.payload[6] = (channel_.registers->RDB >> (2 * 8)) & 0xFF;
-    message.payload[7] = (channel_.registers->RDB >> (3 * 8)) & 0xFF;
+    if (GetState() == State::kInitialized)
+    {
+      EnableAcceptanceFilter();
+    }
+  }
 
-    // Release the RX buffer and allow another buffer to be read.
-    channel_.registers->CMR = Value(Commands::kReleaseRxBuffer);
+  bool HasData() override
+  {
+    return !receive_queue_.IsEmpty();
+  }
 
+  Message_t Receive() override
+  {
+    Message_t message;
+    receive_queue_.Pop(std::span(&message, 1));
     return message;
   }
 
+  size_t Receive(std::span<Message_t> messages) override
+  {
+    return receive_queue_.Pop(messages);
+  }
+
+  ReceiveStatistics_t GetReceiveStatistics() override
+  {
+    auto statistics        = receive_statistics_;
+    statistics.queue_depth = receive_queue_.Size();
+    return statistics;
+  }
+
   bool SelfTest(uint32_t id) override
   {
     Message_t test_message;
@@ -422,6 +489,12 @@ class Can final : public sjsu::Can
     // Disable reset mode
     SetMode(Mode::kReset, false);
 
+    // Mask the receive interrupt, so the test message stays in the receive
+    // buffer and can be read from here without racing the interrupt.
+    bit::Register(&channel_.registers->IER)
+        .Clear(Interrupts::kReceivedMessage)
+        .Save();
+
     // Write test message to tx buffer 1
     LpcRegisters_t registers = ConvertMessageToRegisters(test_message);
 
@@ -437,15 +510,19 @@ class Can final : public sjsu::Can
         channel_.registers->TDA1 = 0;
         channel_.registers->TDB1 = 0;
         channel_.registers->CMR  = Value(Commands::kSelfReceptionSendTxBuffer1);
+        written_++;
         break;
       }
     }
 
     // Allow time for RX to fire
-    Wait(100ms, [this]() { return HasData(); });
+    Wait(100ms, [this]() { return HardwareHasData(); });
+    auto received_message = ReadReceiveBuffer(Timestamp());
 
-    // Read the message from the rx buffer and enqueue it into the rx queue.
-    auto received_message = Receive();
+    // Let the receive interrupt fill the receive queue again
+    bit::Register(&channel_.registers->IER)
+        .Set(Interrupts::kReceivedMessage)
+        .Save();
 
     // Check if the received message matches the one we sent
     if (received_message.id != test_message.id)
@@ -466,15 +543,111 @@ class Can final : public sjsu::Can
     return bit::Read(channel_.registers->GSR, GlobalStatus::kBusError);
   }
 
+  BusStatistics_t GetBusStatistics() override
+  {
+    const uint32_t kStatus = channel_.registers->GSR;
+    auto statistics        = bus_statistics_;
+
+    statistics.transmit_error_count = static_cast<uint8_t>(
+        bit::Extract(kStatus, GlobalStatus::kTransmitErrorCounter));
+    statistics.receive_error_count = static_cast<uint8_t>(
+        bit::Extract(kStatus, GlobalStatus::kReceiveErrorCounter));
+    statistics.error_warning = bit::Read(kStatus, GlobalStatus::kErrorStatus);
+    statistics.error_passive = statistics.transmit_error_count > 127 ||
+                               statistics.receive_error_count > 127;
+    statistics.bus_off      = bit::Read(kStatus, GlobalStatus::kBusError);
+    statistics.elapsed_time = Timestamp() - bus_statistics_start_;
+
+    return statistics;
+  }
+
+  void ResetBusStatistics() override
+  {
+    bus_statistics_       = {};
+    bus_statistics_start_ = Timestamp();
+  }
+
   ~Can()
   {
     // Canbus interrupts must be disabled
     bit::Register(&channel_.registers->IER)
         .Clear(Interrupts::kReceivedMessage)
+        .Clear(Interrupts::kTx1Ready)
+        .Clear(Interrupts::kTx2Ready)
+        .Clear(Interrupts::kTx3Ready)
+        .Clear(Interrupts::kBusError)
         .Save();
+
+    if (controllers[ControllerNumber()] == this)
+    {
+      controllers[ControllerNumber()] = nullptr;
+    }
   }
 
  private:
+  /// Take the message out of the hardware receive buffer and release the
+  /// buffer for the next message.
+  ///
+  /// @param timestamp - time to record as the message's reception time.
+  /// @return Message_t - the received message.
+  Message_t ReadReceiveBuffer(std::chrono::nanoseconds timestamp)
+  {
+    Message_t message;
+    message.uptime = timestamp;
+
+    uint32_t frame = channel_.registers->RFS;
+
+    // Extract all of the information from the message frame
+    bool is_remote_request = bit::Extract(frame, FrameInfo::kRemoteRequest);
+    uint32_t length        = bit::Extract(frame, FrameInfo::kLength);
+    uint32_t format        = bit::Extract(frame, FrameInfo::kFormat);
+
+    message.is_remote_request = is_remote_request;
+    message.length            = static_cast<uint8_t>(length);
+    message.format            = static_cast<Message_t::Format>(format);
+
+    // Get the frame ID
+    const uint32_t kRID = channel_.registers->RID;
+    if (message.format == Message_t::Format::kExtended)
+    {
+      message.id = bit::Extract(kRID, bit::MaskFromRange(0, 28));
+    }
+    else
+    {
+      message.id = bit::Extract(kRID, bit::MaskFromRange(0, 10));
+    }
+
+    // Pull the bytes from RDA into the payload array
+    message.payload[0] = (channel_.registers->RDA >> (0 * 8)) & 0xFF;
+    message.payload[1] = (channel_.registers->RDA >> (1 * 8)) & 0xFF;
+    message.payload[2] = (channel_.registers->RDA >> (2 * 8)) & 0xFF;
+    message.payload[3] = (channel_.registers->RDA >> (3 * 8)) & 0xFF;
+
+    // Pull the bytes from RDB into the payload array
+    message.payload[4] = (channel_.registers->RDB >> (0 * 8)) & 0xFF;
+    message.payload[5] = (channel_.registers->RDB >> (1 * 8)) & 0xFF;
+    message.payload[6] = (channel_.registers->RDB >> (2 * 8)) & 0xFF;
+    message.payload[7] = (channel_.registers->RDB >> (3 * 8)) & 0xFF;
+
+    // Release the RX buffer and allow another buffer to be read.
+    channel_.registers->CMR = Value(Commands::kReleaseRxBuffer);
+
+    bus_statistics_.RecordReceive(message);
+
+    return message;
+  }
+
+  bool HardwareHasData()
+  {
+    return bit::Read(channel_.registers->GSR, GlobalStatus::kReceiveBuffer);
+  }
+
+  std::chrono::nanoseconds Timestamp() const
+  {
+    auto timestamp = CurrentSettings().timestamp;
+    return (timestamp != nullptr) ? timestamp() : 0ns;
+  }
+
   void ConfigureBaudRate()
   {
     // According to the BOSCH CAN spec, the nominal bit time is divided into 4
@@ -536,24 +709,227 @@ class Can final : public sjsu::Can
     channel_.registers->BTR = bus_timing;
   }
 
-  void ConfigureReceiveHandler()
+  void ConfigureInterrupts()
+  {
+    controllers[ControllerNumber()] = this;
+
+    // The receive interrupt fills the receive queue, the transmit buffer
+    // interrupts drain the transmit queue and the bus error interrupt counts
+    // errors.
+    bit::Register(&channel_.registers->IER)
+        .Set(Interrupts::kReceivedMessage)
+        .Set(Interrupts::kTx1Ready)
+        .Set(Interrupts::kTx2Ready)
+        .Set(Interrupts::kTx3Ready)
+        .Set(Interrupts::kBusError)
+        .Save();
+
+    SetCanInterrupt(true);
+  }
+
+  /// CAN1 and CAN2 share a single interrupt, so service both controllers.
+  static void InterruptHandler()
+  {
+    for (auto * controller : controllers)
+    {
+      if (controller != nullptr)
+      {
+        controller->ServiceInterrupt();
+      }
+    }
+  }
+
+  void ServiceInterrupt()
+  {
+    // Reading ICR acknowledges the transmit buffer interrupts and releases
+    // the error code capture bits.
+    const uint32_t kFlags = channel_.registers->ICR;
+
+    if (bit::Read(kFlags, Interrupts::kBusError))
+    {
+      bus_statistics_.RecordError(DecodeBusError(kFlags));
+    }
+
+    const uint32_t kCompleted = bit::Read(kFlags, Interrupts::kTx1Ready) +
+                                bit::Read(kFlags, Interrupts::kTx2Ready) +
+                                bit::Read(kFlags, Interrupts::kTx3Ready);
+    if (kCompleted > 0)
+    {
+      transmit_statistics_.completed += kCompleted;
+      transmit_statistics_.last_completion = Timestamp();
+    }
+
+    TransmitQueuedMessages();
+
+    ReceiveIntoQueue();
+
+    // Call the handler once per queued message, like it would be if each
+    // message caused its own interrupt, but stop once the queue is drained.
+    if (CurrentSettings().handler)
+    {
+      for (size_t i = receive_queue_.Size(); i > 0 && HasData(); i--)
+      {
+        CurrentSettings().handler(*this);
+      }
+    }
+  }
+
+  /// Move every message in the hardware receive buffer into the receive
+  /// queue. The timestamp is taken once for the whole batch.
+  void ReceiveIntoQueue()
   {
-    if (settings.handler)
+    if (!HardwareHasData())
     {
-      bit::Register(&channel_.registers->IER)
-          .Set(Interrupts::kReceivedMessage)
-          .Save();
+      return;
+    }
+
+    const auto kTimestamp = Timestamp();
+
+    for (size_t i = 0; i < kHardwareReceiveDepth && HardwareHasData(); i++)
+    {
+      if (!receive_queue_.Push(ReadReceiveBuffer(kTimestamp)))
+      {
+        receive_statistics_.overruns++;
+        bus_statistics_.receive_overruns++;
+      }
+    }
+
+    if (bit::Read(channel_.registers->GSR, GlobalStatus::kDataOverrun))
+    {
+      receive_statistics_.overruns++;
+      bus_statistics_.receive_overruns++;
+      channel_.registers->CMR = Value(Commands::kClearDataOverrun);
+    }
+  }
+
+  /// @param flags - contents of ICR captured during a bus error interrupt.
+  /// @return BusError - kind of error described by the error code capture
+  ///         bits.
+  static BusError DecodeBusError(uint32_t flags)
+  {
+    const auto kLocation = bit::Extract(flags, Interrupts::kErrorCodeLocation);
+
+    switch (bit::Extract(flags, Interrupts::kErrorCodeType))
+    {
+      case kBitError: return BusError::kBit;
+      case kFormError: return BusError::kForm;
+      case kStuffError: return BusError::kStuff;
+      default: break;
+    }
+
+    // Other errors are identified by where in the frame they happened.
+    switch (kLocation)
+    {
+      case kCrcSequence: return BusError::kCrc;
+      case kAcknowledgeSlot: return BusError::kAcknowledge;
+      default: return BusError::kOther;
+    }
+  }
+
+  /// Place a message into the transmit queue and move as many messages as
+  /// possible from the queue into free hardware buffers.
+  ///
+  /// @param message - message to transmit.
+  /// @return false - if the queue was full.
+  bool Enqueue(const Message_t & message)
+  {
+    // Record when the message was queued to measure its queueing latency.
+    Message_t queued_message = message;
+    queued_message.uptime    = Timestamp();
+
+    // Keep the interrupt from draining the queue while it is being modified.
+    // The interrupt is held off in the NVIC rather than masked in IER, as the
+    // transmit buffer flags only latch while they are enabled in IER. Any
+    // completion in the meantime is served once the interrupt is enabled.
+    SetCanInterrupt(false);
 
-      InterruptController::GetPlatformController().Enable({
+    bool queued = transmit_queue_.Push(queued_message);
+    TransmitQueuedMessages();
+
+    if (!queued)
+    {
+      queued = transmit_queue_.Push(queued_message);
+      TransmitQueuedMessages();
+    }
+
+    transmit_statistics_.peak_queue_depth = std::max(
+        transmit_statistics_.peak_queue_depth, transmit_queue_.Size());
+
+    SetCanInterrupt(true);
+
+    return queued;
+  }
+
+  /// Move messages from the transmit queue, highest priority first, into the
+  /// hardware buffers until the buffers are full or the queue is empty.
+  void TransmitQueuedMessages()
+  {
+    while (!transmit_queue_.IsEmpty())
+    {
+      const Message_t & message = transmit_queue_.Top();
+      if (!WriteToFreeBuffer(message))
+      {
+        return;
+      }
+      bus_statistics_.RecordTransmit(message, Timestamp() - message.uptime);
+      transmit_queue_.Pop();
+      written_++;
+    }
+  }
+
+  /// @param message - message to write into a free transmit buffer.
+  /// @return false - if none of the transmit buffers were free.
+  bool WriteToFreeBuffer(const Message_t & message)
+  {
+    LpcRegisters_t registers = ConvertMessageToRegisters(message);
+
+    uint32_t status_register = channel_.registers->SR;
+    // Check if any buffer is available.
+    if (bit::Read(status_register, BufferStatus::kTx1Released))
+    {
+      channel_.registers->TFI1 = registers.frame;
+      channel_.registers->TID1 = registers.id;
+      channel_.registers->TDA1 = registers.data_a;
+      channel_.registers->TDB1 = registers.data_b;
+      channel_.registers->CMR  = Value(Commands::kSendTxBuffer1);
+      return true;
+    }
+    else if (bit::Read(status_register, BufferStatus::kTx2Released))
+    {
+      channel_.registers->TFI2 = registers.frame;
+      channel_.registers->TID2 = registers.id;
+      channel_.registers->TDA2 = registers.data_a;
+      channel_.registers->TDB2 = registers.data_b;
+      channel_.registers->CMR  = Value(Commands::kSendTxBuffer2);
+      return true;
+    }
+    else if (bit::Read(status_register, BufferStatus::kTx3Released))
+    {
+      channel_.registers->TFI3 = registers.frame;
+      channel_.registers->TID3 = registers.id;
+      channel_.registers->TDA3 = registers.data_a;
+      channel_.registers->TDB3 = registers.data_b;
+      channel_.registers->CMR  = Value(Commands::kSendTxBuffer3);
+      return true;
+    }
+
+    return false;
+  }
+
+  /// @param enable - true to enable the interrupt shared by CAN1 and CAN2
+  static void SetCanInterrupt(bool enable)
+  {
+    auto & interrupt_controller = InterruptController::GetPlatformController();
+    if (enable)
+    {
+      interrupt_controller.Enable({
           .interrupt_request_number = lpc40xx::CAN_IRQn,
-          .interrupt_handler = [this]() { CurrentSettings().handler(*this); },
+          .interrupt_handler        = InterruptHandler,
       });
     }
     else
     {
-      bit::Register(&channel_.registers->IER)
-          .Clear(Interrupts::kReceivedMessage)
-          .Save();
+      interrupt_controller.Disable(lpc40xx::CAN_IRQn);
     }
   }
 
@@ -600,12 +976,185 @@ class Can final : public sjsu::Can
         bit::Insert(channel_.registers->MOD, enable_mode, mode);
   }
 
+  size_t ControllerNumber() const
+  {
+    constexpr auto kCan2 = sjsu::lpc40xx::SystemController::Peripherals::kCan2;
+    return (channel_.id.device_id == kCan2.device_id) ? 1 : 0;
+  }
+
+  /// Rebuild the acceptance filter lookup tables from the filter lists of both
+  /// controllers. If neither controller has filters, or the tables do not fit
+  /// within the acceptance filter RAM, the acceptance filter is bypassed and
+  /// every message is accepted.
   static void EnableAcceptanceFilter()
   {
-    can_acceptance_filter_register->AFMR = Value(Commands::kAcceptAllMessages);
+    // Every filter of both controllers could land in the same table, plus
+    // the padding entry of the standard ID table.
+    constexpr size_t kMaximumFilters =
+        acceptance_filters.size() * kMaximumAcceptanceFilters;
+    constexpr uint32_t kMaximumStandardId = 0x7FF;
+    constexpr uint32_t kMaximumExtendedId = 0x1FFF'FFFF;
+    // An extended range, the largest entry, takes two words of the RAM.
+    static_assert(2 * kMaximumFilters <= kAcceptanceFilterRamSize,
+                  "Every acceptance filter must fit in acceptance filter RAM");
+
+    std::array<uint32_t, kMaximumFilters + 1> standard_ids;
+    std::array<uint32_t, kMaximumFilters> standard_ranges;
+    std::array<uint32_t, kMaximumFilters> extended_ids;
+    // Extended ranges are pairs of words, held as 64-bit values to sort them
+    std::array<uint64_t, kMaximumFilters> extended_pairs;
+    size_t standard_id_count    = 0;
+    size_t standard_range_count = 0;
+    size_t extended_id_count    = 0;
+    size_t extended_pair_count  = 0;
+
+    if (acceptance_filters[0].count == 0 && acceptance_filters[1].count == 0)
+    {
+      can_acceptance_filter_register->AFMR =
+          Value(Commands::kAcceptAllMessages);
+      return;
+    }
+
+    auto standard_entry = [](uint32_t controller, uint32_t id) {
+      return bit::Value()
+          .Insert(id, AcceptanceFilterEntry::kStandardId)
+          .Insert(controller, AcceptanceFilterEntry::kStandardController)
+          .To<uint32_t>();
+    };
+
+    auto extended_entry = [](uint32_t controller, uint32_t id) {
+      return bit::Value()
+          .Insert(id, AcceptanceFilterEntry::kExtendedId)
+          .Insert(controller, AcceptanceFilterEntry::kExtendedController)
+          .To<uint32_t>();
+    };
+
+    for (uint32_t controller = 0; controller < acceptance_filters.size();
+         controller++)
+    {
+      const auto & list = acceptance_filters[controller];
+      std::span<const AcceptanceFilter_t> filters(list.filters.data(),
+                                                  list.count);
+
+      // A controller without filters accepts every standard and extended ID.
+      std::array<AcceptanceFilter_t, 2> accept_all = {
+        AcceptanceFilter_t::Range(0, kMaximumStandardId),
+        AcceptanceFilter_t::Range(
+            0, kMaximumExtendedId, Message_t::Format::kExtended),
+      };
+
+      if (list.count == 0)
+      {
+        filters = accept_all;
+      }
+
+      for (const auto & filter : filters)
+      {
+        if (filter.format == Message_t::Format::kStandard)
+        {
+          const uint32_t kLow = standard_entry(controller, filter.id_low);
+          if (filter.IsRange())
+          {
+            const uint32_t kHigh = standard_entry(controller, filter.id_high);
+            standard_ranges[standard_range_count++] = (kLow << 16) | kHigh;
+          }
+          else
+          {
+            standard_ids[standard_id_count++] = kLow;
+          }
+        }
+        else
+        {
+          const uint32_t kLow = extended_entry(controller, filter.id_low);
+          if (filter.IsRange())
+          {
+            const uint64_t kHigh = extended_entry(controller, filter.id_high);
+            extended_pairs[extended_pair_count++] = (uint64_t{ kLow } << 32) |
+                                                    kHigh;
+          }
+          else
+          {
+            extended_ids[extended_id_count++] = kLow;
+          }
+        }
+      }
+    }
+
+    // The acceptance filter performs a binary search through each table, so
+    // each table must be sorted by controller number then by ID.
+    std::sort(standard_ids.begin(), standard_ids.begin() + standard_id_count);
+    std::sort(standard_ranges.begin(),
+              standard_ranges.begin() + standard_range_count);
+    std::sort(extended_ids.begin(), extended_ids.begin() + extended_id_count);
+    std::sort(extended_pairs.begin(),
+              extended_pairs.begin() + extended_pair_count);
+
+    // Two standard IDs are packed into each word of the table. If there is an
+    // odd number of them, pad the table with a disabled entry. Setting every
+    // bit of the entry sets the disable bit and ensures it sorts last.
+    if (standard_id_count % 2 != 0)
+    {
+      standard_ids[standard_id_count++] = 0xFFFF;
+    }
+
+    const size_t kStandardIdWords = standard_id_count / 2;
+    const size_t kTotalWords = kStandardIdWords + standard_range_count +
+                               extended_id_count + 2 * extended_pair_count;
+
+    if (kTotalWords > kAcceptanceFilterRamSize)
+    {
+      LogWarning("CAN acceptance filter tables do not fit, accepting all.");
+      can_acceptance_filter_register->AFMR =
+          Value(Commands::kAcceptAllMessages);
+      return;
+    }
+
+    // Acceptance filter RAM can only be written while the filter is off.
+    can_acceptance_filter_register->AFMR =
+        Value(Commands::kAcceptanceFilterOff);
+
+    auto & ram   = can_acceptance_filter_ram->mask;
+    size_t index = 0;
+
+    // No FullCAN entries are used, so the standard table starts at zero.
+    can_acceptance_filter_register->SFF_sa = 0;
+    for (size_t i = 0; i < kStandardIdWords; i++)
+    {
+      ram[index++] = (standard_ids[2 * i] << 16) | standard_ids[2 * i + 1];
+    }
+
+    can_acceptance_filter_register->SFF_GRP_sa = index * sizeof(uint32_t);
+    for (size_t i = 0; i < standard_range_count; i++)
+    {
+      ram[index++] = standard_ranges[i];
+    }
+
+    can_acceptance_filter_register->EFF_sa = index * sizeof(uint32_t);
+    for (size_t i = 0; i < extended_id_count; i++)
+    {
+      ram[index++] = extended_ids[i];
+    }
+
+    can_acceptance_filter_register->EFF_GRP_sa = index * sizeof(uint32_t);
+    for (size_t i = 0; i < extended_pair_count; i++)
+    {
+      ram[index++] = static_cast<uint32_t>(extended_pairs[i] >> 32);
+      ram[index++] = static_cast<uint32_t>(extended_pairs[i]);
+    }
+
+    can_acceptance_filter_register->ENDofTable = index * sizeof(uint32_t);
+
+    can_acceptance_filter_register->AFMR = Value(Commands::kAcceptanceFilterOn);
   }
 
   const Port_t & channel_;
+  CanTransmitQueue<config::kCanTransmitQueueSize> transmit_queue_;
+  TransmitStatistics_t transmit_statistics_;
+  uint32_t written_ = 0;
+  CanReceiveQueue<config::kCanReceiveQueueSize> receive_queue_;
+  ReceiveStatistics_t receive_statistics_;
+  BusStatistics_t bus_statistics_;
+  std::chrono::nanoseconds bus_statistics_start_ = 0ns;
 };
 
 template <int port>
@@ -28,7 +28,12 @@ class Gpio final : public sjsu::Gpio
   static constexpr uint8_t kInterruptPorts = 2;
 
   /// Lookup table that holds developer gpio interrupt handlers.
-  inline static InterruptCallback handlers[kInterruptPorts][kPinCount];
+  inline static InterruptDelegate handlers[kInterruptPorts][kPinCount];
+
+  /// Copies of the attached callbacks that are too large for an
+  /// InterruptDelegate, such as lambdas capturing by value, which the
+  /// handlers table calls through.
+  inline static InterruptCallback callbacks[kInterruptPorts][kPinCount];
 
   /// This structure makes the access of gpio interrupt registers more
   /// accessible and efficient
@@ -159,24 +164,36 @@ class Gpio final : public sjsu::Gpio
   }
 
   /// The gpio interrupt handler that calls the attached interrupt callbacks.
+  /// Every pin with a pending edge, on both ports, is cleared and serviced in
+  /// a single entry, so a burst of edges does not re-enter the handler once
+  /// per pin.
   static void InterruptHandler()
   {
-    int triggered_port;
-    if constexpr (IsPlatform(sjsu::build::Platform::lpc40xx))
-    {
-      triggered_port = *InterruptStatus() >> 2;
-    }
-    else
+    for (uint8_t port = 0; port < kInterruptPorts; port++)
     {
-      triggered_port = *InterruptStatus() >> 2;
-    }
+      auto * interrupt = InterruptRegister(port);
+      uint32_t status  = *interrupt->rising_status | *interrupt->falling_status;
+      if (status == 0)
+      {
+        continue;
+      }
 
-    auto * interrupt  = InterruptRegister(triggered_port);
-    int status        = *interrupt->rising_status | *interrupt->falling_status;
-    int triggered_pin = __builtin_ctz(status);
+      // Clear before calling the handlers, so that an edge arriving while
+      // they run is latched and serviced on the next entry.
+      *interrupt->clear = status;
+
+      while (status != 0)
+      {
+        const uint32_t kPin = 31 - __builtin_clz(status);
+        status &= ~(1U << kPin);
 
-    handlers[triggered_port][triggered_pin]();
-    *interrupt->clear |= (1 << triggered_pin);
+        // An edge latched just before DetachInterrupt() has no handler.
+        if (handlers[port][kPin])
+        {
+          handlers[port][kPin]();
+        }
+      }
+    }
   }
 
   /// For port 0-4, pins 0-31 are available. Port 5 only has pins 0-4 available.
@@ -300,7 +317,25 @@ class Gpio final : public sjsu::Gpio
       });
     }
 
-    handlers[interrupt_index_][pin_] = callback;
+    // Plain functions and InterruptDelegates are called straight from the
+    // handler table. Anything else is copied into the callbacks table, so
+    // neither it nor this object has to outlive the attachment.
+    if (auto * function = callback.target<void (*)()>();
+        function != nullptr && *function != nullptr)
+    {
+      handlers[interrupt_index_][pin_] = *function;
+    }
+    else if (auto * handler = callback.target<InterruptDelegate>();
+             handler != nullptr)
+    {
+      handlers[interrupt_index_][pin_] = *handler;
+    }
+    else
+    {
+      InterruptCallback & stored       = callbacks[interrupt_index_][pin_];
+      stored                           = callback;
+      handlers[interrupt_index_][pin_] = [&stored]() { stored(); };
+    }
 
     auto * interrupt = LocalInterruptRegister();
     if (edge == Edge::kBoth || edge == Edge::kRising)
@@ -319,7 +354,8 @@ class Gpio final : public sjsu::Gpio
   {
     if (IsInterruptPort())
     {
-      handlers[interrupt_index_][pin_] = nullptr;
+      handlers[interrupt_index_][pin_]  = nullptr;
+      callbacks[interrupt_index_][pin_] = nullptr;
 
       auto * interrupt           = LocalInterruptRegister();
       *interrupt->rising_enable  = bit::Clear(*interrupt->rising_enable, pin_);
@@ -15,6 +15,7 @@
 #include "utility/error_handling.hpp"
 #include "utility/log.hpp"
 #include "utility/time/time.hpp"
+#include "utility/time/wait_signal.hpp"
 
 namespace sjsu
 {
@@ -280,7 +281,13 @@ class I2c final : public sjsu::I2c
     // Enable interrupt service routine.
     sjsu::InterruptController::GetPlatformController().Enable({
         .interrupt_request_number = i2c_.irq_number,
-        .interrupt_handler        = [this]() { I2cHandler(i2c_); },
+        .interrupt_handler        = [this]() {
+          I2cHandler(i2c_);
+          if (!i2c_.transaction.busy)
+          {
+            transaction_finished_.Notify();
+          }
+        },
     });
   }
 
@@ -357,7 +364,8 @@ class I2c final : public sjsu::I2c
       return !i2c_.transaction.busy;
     };
 
-    auto wait_status = Wait(i2c_.transaction.timeout, wait_for_i2c_transaction);
+    auto wait_status = transaction_finished_.Wait(i2c_.transaction.timeout,
+                                                  wait_for_i2c_transaction);
 
     if (i2c_.transaction.status == CommonErrors::kBusError)
     {
@@ -384,6 +392,8 @@ class I2c final : public sjsu::I2c
   }
 
   const Port_t & i2c_;
+  /// Wakes the thread in BlockUntilFinished() when the transaction ends.
+  mutable WaitSignal transaction_finished_;
 };
 
 template <int port>
@@ -1,6 +1,7 @@
 #include "peripherals/lpc40xx/can.hpp"
 
 #include <chrono>
+#include <array>
 
 #include "testing/testing_frameworks.hpp"
 
@@ -15,8 +16,12 @@ TEST_CASE("Testing lpc40xx Can")
   LPC_CANAF_TypeDef local_can_acceptance;
   testing::ClearStructure(&local_can_acceptance);
 
+  LPC_CANAF_RAM_TypeDef local_can_acceptance_ram;
+  testing::ClearStructure(&local_can_acceptance_ram);
+
   // Set acceptance filter to the local acceptance filter
   Can::can_acceptance_filter_register = &local_can_acceptance;
+  Can::can_acceptance_filter_ram      = &local_can_acceptance_ram;
 
   // Set mock for sjsu::SystemController
   constexpr units::frequency::hertz_t kDummySystemControllerClockFrequency =
@@ -28,8 +33,14 @@ TEST_CASE("Testing lpc40xx Can")
 
   sjsu::SystemController::SetPlatformController(&mock_system_controller.get());
 
+  sjsu::InterruptHandler can_interrupt_handler;
   Mock<sjsu::InterruptController> mock_interrupt_controller;
-  Fake(Method(mock_interrupt_controller, InterruptController::Enable));
+  When(Method(mock_interrupt_controller, InterruptController::Enable))
+      .AlwaysDo([&can_interrupt_handler](
+                    sjsu::InterruptController::RegistrationInfo_t info) {
+        can_interrupt_handler = info.interrupt_handler;
+      });
+  Fake(Method(mock_interrupt_controller, InterruptController::Disable));
   sjsu::InterruptController::SetPlatformController(
       &mock_interrupt_controller.get());
 
@@ -137,21 +148,20 @@ TEST_CASE("Testing lpc40xx Can")
 
   SECTION("HasData()")
   {
+    // Setup
+    test_can.Initialize();
+    local_can.GSR = bit::Set(local_can.GSR, Can::GlobalStatus::kReceiveBuffer);
+
     SECTION("CANBUS has data")
     {
       // Setup
-      local_can.GSR =
-          bit::Set(local_can.GSR, Can::GlobalStatus::kReceiveBuffer);
+      can_interrupt_handler();
 
       // Exercise + Verify
       CHECK(test_can.HasData());
     }
-    SECTION("CANBUS does NOT have data")
+    SECTION("CANBUS does NOT have data until the interrupt queues it")
     {
-      // Setup
-      local_can.GSR =
-          bit::Clear(local_can.GSR, Can::GlobalStatus::kReceiveBuffer);
-
       // Exercise + Verify
       CHECK(!test_can.HasData());
     }
@@ -246,17 +256,21 @@ TEST_CASE("Testing lpc40xx Can")
       CHECK(Value(Can::Commands::kSendTxBuffer3) == local_can.CMR);
     }
 
-    SECTION("All buffers full, release TX3 after ")
+    SECTION("All buffers and transmit queue full, release TX3 after ")
     {
       testing::PollingVerification({
           .locking_function =
-              [&local_can]() {
+              [&local_can, &test_can, &message]() {
                 local_can.SR =
                     bit::Clear(local_can.SR, Can::BufferStatus::kTx1Released);
                 local_can.SR =
                     bit::Clear(local_can.SR, Can::BufferStatus::kTx2Released);
                 local_can.SR =
                     bit::Clear(local_can.SR, Can::BufferStatus::kTx3Released);
+                for (size_t i = 0; i < config::kCanTransmitQueueSize; i++)
+                {
+                  test_can.TrySend(message);
+                }
               },
           .polling_function = [&test_can,
                                &message]() { test_can.Send(message); },
@@ -270,6 +284,76 @@ TEST_CASE("Testing lpc40xx Can")
     }
   }
 
+  SECTION("TrySend()")
+  {
+    // Setup
+    Can::Message_t message;
+    message.length  = 1;
+    message.payload = { 0xAA };
+
+    SECTION("Queue drains in ID order from the interrupt")
+    {
+      // Setup: Occupy every transmit buffer
+      test_can.Initialize();
+      local_can.SR = 0;
+
+      // Exercise
+      message.id = 0x300;
+      CHECK(test_can.TrySend(message));
+      message.id = 0x100;
+      CHECK(test_can.TrySend(message));
+      message.id     = 0x10'0000;
+      message.format = Can::Message_t::Format::kExtended;
+      CHECK(test_can.TrySend(message));
+
+      // Verify: Nothing has been written to the hardware
+      CHECK(0 == local_can.CMR);
+      CHECK(3 == test_can.GetTransmitStatistics().queue_depth);
+      CHECK(3 == test_can.GetTransmitStatistics().peak_queue_depth);
+
+      // Verify: The interrupt was held off in the NVIC, leaving the transmit
+      //         buffer interrupts enabled so their flags still latch.
+      CHECK(bit::Read(local_can.IER, Can::Interrupts::kTx1Ready));
+      Verify(Method(mock_interrupt_controller, InterruptController::Disable)
+                 .Using(lpc40xx::CAN_IRQn),
+             Method(mock_interrupt_controller, InterruptController::Enable))
+          .Exactly(3);
+
+      // Exercise: Free buffer 1, the extended ID has a base ID of 0x004 and
+      //           wins arbitration.
+      local_can.SR  = bit::Set(0, Can::BufferStatus::kTx1Released);
+      local_can.ICR = bit::Set(0, Can::Interrupts::kTx1Ready);
+      can_interrupt_handler();
+      local_can.ICR = 0;
+
+      // Verify: Every message is written as buffer 1 is never marked as busy
+      //         by the fake registers, the last one is the lowest priority.
+      CHECK(0x300 == local_can.TID1);
+      CHECK(0 == test_can.GetTransmitStatistics().queue_depth);
+      CHECK(3 == test_can.GetTransmitStatistics().peak_queue_depth);
+      CHECK(1 == test_can.GetTransmitStatistics().completed);
+    }
+
+    SECTION("Full queue drops messages")
+    {
+      // Setup
+      local_can.SR = 0;
+      for (size_t i = 0; i < config::kCanTransmitQueueSize; i++)
+      {
+        CHECK(test_can.TrySend(message));
+      }
+
+      // Exercise + Verify
+      CHECK(!test_can.TrySend(message));
+      CHECK(!test_can.TrySend(message));
+
+      // Verify
+      auto statistics = test_can.GetTransmitStatistics();
+      CHECK(2 == statistics.dropped);
+      CHECK(config::kCanTransmitQueueSize == statistics.queue_depth);
+    }
+  }
+
   SECTION("Receive()")
   {
     // Setup
@@ -294,6 +378,9 @@ TEST_CASE("Testing lpc40xx Can")
     local_can.RDA = message.payload[0] | message.payload[1] << 8 |
                     message.payload[2] << 16 | message.payload[3] << 24;
     local_can.RDB = message.payload[4];
+    test_can.Initialize();
+    local_can.GSR = bit::Set(local_can.GSR, Can::GlobalStatus::kReceiveBuffer);
+    can_interrupt_handler();
 
     // Exercise
     Can::Message_t actual_message = test_can.Receive();
@@ -306,6 +393,233 @@ TEST_CASE("Testing lpc40xx Can")
     CHECK(message.payload == actual_message.payload);
   }
 
+  SECTION("Receive() extended ID")
+  {
+    // Setup
+    local_can.RFS = bit::Value()
+                        .Insert(8, Can::FrameInfo::kLength)
+                        .Insert(Value(Can::Message_t::Format::kExtended),
+                                Can::FrameInfo::kFormat);
+    local_can.RID = 0x1AB'CDEF;
+    test_can.Initialize();
+    local_can.GSR = bit::Set(local_can.GSR, Can::GlobalStatus::kReceiveBuffer);
+    can_interrupt_handler();
+
+    // Exercise
+    Can::Message_t actual_message = test_can.Receive();
+
+    // Verify
+    CHECK(0x1AB'CDEF == actual_message.id);
+    CHECK(Can::Message_t::Format::kExtended == actual_message.format);
+  }
+
+  SECTION("Receive() batch from interrupt")
+  {
+    // Setup
+    test_can.settings.timestamp = []() -> std::chrono::nanoseconds {
+      return 5ms;
+    };
+    test_can.Initialize();
+    local_can.GSR = bit::Set(0, Can::GlobalStatus::kReceiveBuffer);
+    local_can.RID = 0x25;
+    local_can.RFS = bit::Value().Insert(2, Can::FrameInfo::kLength);
+    std::array<Can::Message_t, config::kCanReceiveQueueSize + 1> messages;
+
+    // Exercise: Messages still waiting in hardware are left for the next
+    // interrupt, only the queued messages are returned.
+    can_interrupt_handler();
+    size_t count = test_can.Receive(messages);
+
+    // Verify
+    CHECK(bit::Read(local_can.IER, Can::Interrupts::kReceivedMessage));
+    CHECK(Can::kHardwareReceiveDepth == count);
+    CHECK(0x25 == messages[0].id);
+    CHECK(2 == messages[0].length);
+    CHECK(5ms == messages[0].uptime);
+    CHECK(5ms == messages[1].uptime);
+    CHECK(!test_can.HasData());
+    CHECK(0 == test_can.GetReceiveStatistics().overruns);
+  }
+
+  SECTION("Receive() queue overrun")
+  {
+    // Setup
+    test_can.Initialize();
+    local_can.GSR = bit::Set(0, Can::GlobalStatus::kReceiveBuffer);
+    constexpr size_t kInterrupts =
+        config::kCanReceiveQueueSize / Can::kHardwareReceiveDepth + 1;
+
+    // Exercise
+    for (size_t i = 0; i < kInterrupts; i++)
+    {
+      can_interrupt_handler();
+    }
+    local_can.GSR = bit::Set(local_can.GSR, Can::GlobalStatus::kDataOverrun);
+    can_interrupt_handler();
+
+    // Verify
+    auto statistics = test_can.GetReceiveStatistics();
+    CHECK(config::kCanReceiveQueueSize == statistics.queue_depth);
+    CHECK(Can::kHardwareReceiveDepth * 2 + 1 == statistics.overruns);
+    CHECK(Value(Can::Commands::kClearDataOverrun) == local_can.CMR);
+  }
+
+  SECTION("GetBusStatistics()")
+  {
+    // Setup
+    static std::chrono::nanoseconds now;
+    now                         = 0ns;
+    test_can.settings.timestamp = []() { return now; };
+    test_can.Initialize();
+    local_can.SR = 0;
+
+    Can::Message_t message = { .id = 0x100, .length = 8 };
+    CHECK(test_can.TrySend(message));
+
+    // Exercise: The message waits 40us for a free buffer
+    now          = 40us;
+    local_can.SR = bit::Set(0, Can::BufferStatus::kTx1Released);
+    can_interrupt_handler();
+
+    // Exercise: Bus errors are decoded from the error code capture bits
+    constexpr auto kType     = Can::Interrupts::kErrorCodeType;
+    constexpr auto kLocation = Can::Interrupts::kErrorCodeLocation;
+
+    local_can.ICR = bit::Value()
+                        .Set(Can::Interrupts::kBusError)
+                        .Insert(uint32_t{ Can::kOtherError }, kType)
+                        .Insert(uint32_t{ Can::kAcknowledgeSlot }, kLocation);
+    can_interrupt_handler();
+    local_can.ICR = bit::Value()
+                        .Set(Can::Interrupts::kBusError)
+                        .Insert(uint32_t{ Can::kStuffError }, kType);
+    can_interrupt_handler();
+    local_can.ICR = 0;
+
+    local_can.GSR = bit::Value()
+                        .Set(Can::GlobalStatus::kErrorStatus)
+                        .Insert(136, Can::GlobalStatus::kTransmitErrorCounter)
+                        .Insert(5, Can::GlobalStatus::kReceiveErrorCounter);
+    auto statistics = test_can.GetBusStatistics();
+
+    // Verify
+    CHECK(bit::Read(local_can.IER, Can::Interrupts::kBusError));
+    CHECK(1 == statistics.transmitted_frames);
+    CHECK(1 == statistics.transmit_latency[6]);
+    CHECK(40us == statistics.elapsed_time);
+    CHECK(1 == statistics.bus_errors[Value(Can::BusError::kAcknowledge)]);
+    CHECK(1 == statistics.bus_errors[Value(Can::BusError::kStuff)]);
+    CHECK(0 == statistics.bus_errors[Value(Can::BusError::kBit)]);
+    CHECK(136 == statistics.transmit_error_count);
+    CHECK(5 == statistics.receive_error_count);
+    CHECK(statistics.error_warning);
+    CHECK(statistics.error_passive);
+    CHECK(!statistics.bus_off);
+
+    // Exercise + Verify
+    test_can.ResetBusStatistics();
+    CHECK(0 == test_can.GetBusStatistics().transmitted_frames);
+    CHECK(0ns == test_can.GetBusStatistics().elapsed_time);
+  }
+
+  SECTION("ConfigureAcceptanceFilter()")
+  {
+    SECTION("Filters are written to acceptance filter RAM")
+    {
+      // Setup
+      const std::array kFilters = {
+        Can::AcceptanceFilter_t::Id(0x140),
+        Can::AcceptanceFilter_t::Range(0x200, 0x20F),
+        Can::AcceptanceFilter_t::Id(0x100),
+        Can::AcceptanceFilter_t::Id(0x1AB'CDEF,
+                                    Can::Message_t::Format::kExtended),
+      };
+
+      // Exercise
+      test_can.ConfigureAcceptanceFilter(kFilters);
+      test_can.Initialize();
+
+      // Verify: CAN1 filters are in the tables, while CAN2, which has no
+      //         filters, is given the full standard and extended ID ranges.
+      CHECK(Value(Can::Commands::kAcceptanceFilterOn) ==
+            local_can_acceptance.AFMR);
+      CHECK(0 == local_can_acceptance.SFF_sa);
+      CHECK(1 * 4 == local_can_acceptance.SFF_GRP_sa);
+      CHECK(3 * 4 == local_can_acceptance.EFF_sa);
+      CHECK(4 * 4 == local_can_acceptance.EFF_GRP_sa);
+      CHECK(6 * 4 == local_can_acceptance.ENDofTable);
+
+      CHECK(0x0100'0140 == local_can_acceptance_ram.mask[0]);
+      CHECK(0x0200'020F == local_can_acceptance_ram.mask[1]);
+      CHECK(0x2000'27FF == local_can_acceptance_ram.mask[2]);
+      CHECK(0x01AB'CDEF == local_can_acceptance_ram.mask[3]);
+      CHECK(0x2000'0000 == local_can_acceptance_ram.mask[4]);
+      CHECK(0x3FFF'FFFF == local_can_acceptance_ram.mask[5]);
+    }
+
+    SECTION("Odd number of standard IDs is padded")
+    {
+      // Setup
+      const std::array kFilters = {
+        Can::AcceptanceFilter_t::Id(0x140),
+      };
+
+      // Exercise
+      test_can.Initialize();
+      test_can.ConfigureAcceptanceFilter(kFilters);
+
+      // Verify
+      CHECK(0x0140'FFFF == local_can_acceptance_ram.mask[0]);
+      CHECK(1 * 4 == local_can_acceptance.SFF_GRP_sa);
+    }
+
+    SECTION("Extended ranges filling both controllers fit")
+    {
+      // Setup: Extended ranges take the most RAM, two words each
+      std::array<Can::AcceptanceFilter_t, Can::kMaximumAcceptanceFilters>
+          filters;
+      for (uint32_t i = 0; i < filters.size(); i++)
+      {
+        filters[i] = Can::AcceptanceFilter_t::Range(
+            i * 0x100, i * 0x100 + 0xFF, Can::Message_t::Format::kExtended);
+      }
+      Can::acceptance_filters[1].filters = filters;
+      Can::acceptance_filters[1].count   = filters.size();
+
+      // Exercise
+      test_can.ConfigureAcceptanceFilter(filters);
+      test_can.Initialize();
+
+      // Verify
+      constexpr uint32_t kWords = 2 * 2 * Can::kMaximumAcceptanceFilters;
+      CHECK(Value(Can::Commands::kAcceptanceFilterOn) ==
+            local_can_acceptance.AFMR);
+      CHECK(0 == local_can_acceptance.EFF_GRP_sa);
+      CHECK(kWords * 4 == local_can_acceptance.ENDofTable);
+      CHECK(0x0000'0000 == local_can_acceptance_ram.mask[0]);
+      CHECK(0x0000'00FF == local_can_acceptance_ram.mask[1]);
+      CHECK(0x2000'1F00 == local_can_acceptance_ram.mask[kWords - 2]);
+      CHECK(0x2000'1FFF == local_can_acceptance_ram.mask[kWords - 1]);
+    }
+
+    SECTION("Empty list accepts all messages")
+    {
+      // Setup
+      test_can.ConfigureAcceptanceFilter(
+          std::array{ Can::AcceptanceFilter_t::Id(0x140) });
+
+      // Exercise
+      test_can.ConfigureAcceptanceFilter({});
+      test_can.Initialize();
+
+      // Verify
+      CHECK(Value(Can::Commands::kAcceptAllMessages) ==
+            local_can_acceptance.AFMR);
+    }
+
+    Can::acceptance_filters = {};
+  }
+
   SECTION("SelfTest() Polling Test")
   {
     testing::PollingVerification({
@@ -426,5 +740,6 @@ TEST_CASE("Testing lpc40xx Can")
   }
 
   Can::can_acceptance_filter_register = LPC_CANAF;
+  Can::can_acceptance_filter_ram      = LPC_CANAF_RAM;
 }
 }  // namespace sjsu::lpc40xx
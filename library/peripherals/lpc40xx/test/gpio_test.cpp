@@ -1,5 +1,6 @@
 #include "peripherals/lpc40xx/gpio.hpp"
 
+#include <array>
 #include <cstdint>
 
 #include "platforms/targets/lpc40xx/LPC40xx.h"
@@ -210,14 +211,15 @@ TEST_CASE("Testing lpc40xx Gpio External Interrupts")
     CHECK(!bit::Read(local_eint.IO2IntEnF, kPin7));
 
     // Verify: Check Developer's ISR is attached
-    auto * save_callback0 =
-        p0_15.handlers[kPort0][kPin15].target<void (*)(void)>();
-    auto * save_callback1 =
-        p2_7.handlers[kPort2][kPin7].target<void (*)(void)>();
-    REQUIRE(save_callback0 != nullptr);
-    REQUIRE(save_callback1 != nullptr);
-    CHECK(&InterruptCallback0 == *save_callback0);
-    CHECK(&InterruptCallback1 == *save_callback1);
+    RESET_FAKE(InterruptCallback0);
+    RESET_FAKE(InterruptCallback1);
+    local_eint.IO0IntStatF = (1 << kPin15);
+    local_eint.IO2IntStatR = (1 << kPin7);
+    Gpio::InterruptHandler();
+    CHECK(1 == InterruptCallback0_fake.call_count);
+    CHECK(1 == InterruptCallback1_fake.call_count);
+    local_eint.IO0IntStatF = 0;
+    local_eint.IO2IntStatR = 0;
 
     // Setup & Execute
     p0_15.DetachInterrupt();
@@ -228,8 +230,8 @@ TEST_CASE("Testing lpc40xx Gpio External Interrupts")
     CHECK(!bit::Read(local_eint.IO0IntEnF, kPin15));
     CHECK(!bit::Read(local_eint.IO2IntEnR, kPin7));
     CHECK(!bit::Read(local_eint.IO2IntEnF, kPin7));
-    CHECK(p0_15.handlers[kPort0][kPin15] == nullptr);
-    CHECK(p2_7.handlers[kPort2][kPin7] == nullptr);
+    CHECK(!p0_15.handlers[kPort0][kPin15]);
+    CHECK(!p2_7.handlers[kPort2][kPin7]);
   }
 
   SECTION("Call the Interrupt handler to service the pin.")
@@ -249,5 +251,66 @@ TEST_CASE("Testing lpc40xx Gpio External Interrupts")
     CHECK(bit::Read(local_eint.IO0IntClr, kPin15));
     CHECK(was_called);
   }
+
+  SECTION("Service every pending pin of both ports in one call")
+  {
+    // Setup
+    std::array<Gpio, 3> port0 = { Gpio(0, 0, &mock_pin.get()),
+                                  Gpio(0, 9, &mock_pin.get()),
+                                  Gpio(0, 31, &mock_pin.get()) };
+    std::array<int, 3> port0_calls = {};
+    for (size_t i = 0; i < port0.size(); i++)
+    {
+      int * calls = &port0_calls[i];
+      port0[i].OnChange([calls]() { (*calls)++; });
+    }
+    int port2_calls = 0;
+    p2_7.OnChange([&port2_calls]() { port2_calls++; });
+    RESET_FAKE(InterruptCallback0);
+    p0_15.OnChange(&InterruptCallback0);
+
+    local_eint.IO0IntStatR = (1 << 0) | (1 << 31);
+    local_eint.IO0IntStatF = (1 << 9) | (1 << 15);
+    local_eint.IO2IntStatF = (1 << kPin7);
+
+    // Execute
+    Gpio::InterruptHandler();
+
+    // Verify
+    CHECK(std::array<int, 3>{ 1, 1, 1 } == port0_calls);
+    CHECK(1 == InterruptCallback0_fake.call_count);
+    CHECK(1 == port2_calls);
+    CHECK(((1U << 0) | (1U << 9) | (1U << 15) | (1U << 31)) ==
+          local_eint.IO0IntClr);
+    CHECK((1U << kPin7) == local_eint.IO2IntClr);
+
+    // Cleanup: Leave no handler capturing this section's locals
+    for (Gpio & gpio : port0)
+    {
+      gpio.DetachInterrupt();
+    }
+    p2_7.DetachInterrupt();
+    p0_15.DetachInterrupt();
+  }
+
+  SECTION("Callables too large for the handlers table are copied")
+  {
+    // Setup
+    int calls = 0;
+    {
+      InterruptCallback callback = [&calls]() { calls++; };
+      p0_15.AttachInterrupt(callback, sjsu::Gpio::Edge::kBoth);
+    }
+    local_eint.IO0IntStatR = (1 << kPin15);
+
+    // Execute
+    Gpio::InterruptHandler();
+    p0_15.DetachInterrupt();
+
+    // Verify
+    CHECK(1 == calls);
+    CHECK(!Gpio::handlers[kPort0][kPin15]);
+    CHECK(!Gpio::callbacks[kPort0][kPin15]);
+  }
 }
 }  // namespace sjsu::lpc40xx
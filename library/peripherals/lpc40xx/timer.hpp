@@ -81,7 +81,7 @@ class Timer final : public sjsu::Timer
   ///
   /// @param timer - a timer peripheral descriptor that, which is the the timer
   /// peripheral to be used with this object
-  explicit constexpr Timer(const Peripheral_t & timer) : timer_(timer) {}
+  explicit Timer(const Peripheral_t & timer) : timer_(timer) {}
 
   void Initialize(units::frequency::hertz_t frequency,
                   InterruptCallback callback = nullptr,
@@ -99,12 +99,13 @@ class Timer final : public sjsu::Timer
     uint32_t prescaler        = peripheral_frequency / frequency;
     timer_.peripheral->PR     = prescaler;
 
-    // Take the class's address and a copy of the callback for use in the
-    // interrupt handler.
-    auto interrupt_handler = [this, callback]() {
-      if (callback != nullptr)
+    // Keep a copy of the callback in the object, so the interrupt handler
+    // only has to capture the class's address.
+    callback_              = callback;
+    auto interrupt_handler = [this]() {
+      if (callback_ != nullptr)
       {
-        callback();
+        callback_();
       }
       // Clear interrupts for all 4 match register interrupt flag
       timer_.peripheral->IR |= 0b1111;
@@ -174,6 +175,7 @@ class Timer final : public sjsu::Timer
 
  private:
   const Peripheral_t & timer_;
+  mutable InterruptCallback callback_;
 };
 }  // namespace lpc40xx
 }  // namespace sjsu
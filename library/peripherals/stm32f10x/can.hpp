@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <initializer_list>
+#include <span>
 #include <scope>
 #include <string_view>
 
@@ -28,6 +31,10 @@ class Can final : public sjsu::Can
   /// of this class.
   using sjsu::Can::Send;
 
+  /// Each of the two receive FIFOs holds up to three messages, so at most this
+  /// many messages can be waiting in hardware when an interrupt is serviced.
+  static constexpr size_t kHardwareReceiveDepth = 6;
+
   /// This struct holds bit timing values.
   /// It is HW mapped to a 32-bit register: BTR (pg. 683).
   struct BusTiming  // NOLINT
@@ -190,6 +197,37 @@ class Can final : public sjsu::Can
     static constexpr auto kSleep = bit::MaskFromRange(17);
   };
 
+  /// This struct holds the bitmap for the error status register.
+  /// It is HW mapped to a 32-bit register: ESR (pg. 681).
+  struct ErrorStatus  // NOLINT
+  {
+    /// Set by hardware when an error counter reaches the warning limit
+    static constexpr auto kErrorWarning = bit::MaskFromRange(0);
+    /// Set by hardware when an error counter passes the error passive limit
+    static constexpr auto kErrorPassive = bit::MaskFromRange(1);
+    /// Set by hardware when the controller enters the bus off state
+    static constexpr auto kBusOff = bit::MaskFromRange(2);
+    /// Kind of the last error detected on the bus, see LastErrorCodes
+    static constexpr auto kLastErrorCode = bit::MaskFromRange(4, 6);
+    /// The controller's transmit error counter
+    static constexpr auto kTransmitErrorCounter = bit::MaskFromRange(16, 23);
+    /// The controller's receive error counter
+    static constexpr auto kReceiveErrorCounter = bit::MaskFromRange(24, 31);
+  };
+
+  /// Values of the last error code field of ESR
+  enum LastErrorCodes : uint8_t
+  {
+    kNoError          = 0,
+    kStuffError       = 1,
+    kFormError        = 2,
+    kAcknowledgeError = 3,
+    kBitRecessive     = 4,
+    kBitDominant      = 5,
+    kCrcError         = 6,
+    kSetBySoftware    = 7,
+  };
+
   /// This struct holds the bitmap for the mailbox identifier.
   /// It is represents 32-bit register: CAN_TIxR(0 - 2) (pg. 685).
   /// It is represents 32-bit register: CAN_RIxR(0 - 1) (pg. 688).
@@ -299,6 +337,20 @@ class Can final : public sjsu::Can
     kActive = 1
   };
 
+  /// This struct holds the bitmap of a 16-bit filter entry, used in the dual
+  /// 16-bit scale configuration of a filter bank (pg. 666).
+  struct FilterEntry16  // NOLINT
+  {
+    /// Identifier extension bit
+    static constexpr auto kIdentifierType = bit::MaskFromRange(3);
+    /// Standard identifier
+    static constexpr auto kStandardIdentifier = bit::MaskFromRange(5, 15);
+  };
+
+  /// Number of filter banks available to the CAN1 peripheral on the
+  /// connectivity line-less STM32F10x devices.
+  static constexpr size_t kFilterBankCount = 14;
+
   /// Contains all of the information for to control and configure a CANBUS bus
   /// on the STM32F10x platform.
   struct Port_t  // NOLINT
@@ -373,6 +425,8 @@ class Can final : public sjsu::Can
 
     ConfigureBaudRate();
     ConfigureReceiveHandler();
+    ConfigureTransmitInterrupt();
+    ConfigureErrorInterrupt();
 
     EnableAcceptanceFilter();
 
@@ -442,62 +496,195 @@ class Can final : public sjsu::Can
 
   void Send(const Message_t & message) override
   {
-    StmDataRegisters_t registers = ConvertMessageToRegisters(message);
-    bool sent                    = false;
-    while (!sent)
+    // Only wait if the transmit queue is full. Each attempt gives any empty
+    // mailboxes a chance to take messages from the queue.
+    while (!Enqueue(message))
     {
-      uint32_t status_register = channel_.can->TSR;
-      // Check if any buffer is available.
-      if (bit::Read(status_register, TransmitStatus::kTransmitMailbox0Empty))
-      {
-        channel_.can->sTxMailBox[0].TDTR &= ~(0xF);
-        channel_.can->sTxMailBox[0].TDTR |= message.length & 0xF;
-        channel_.can->sTxMailBox[0].TDLR = registers.data_a;
-        channel_.can->sTxMailBox[0].TDHR = registers.data_b;
-        channel_.can->sTxMailBox[0].TIR  = registers.id;
-        sent                             = true;
-      }
-      else if (bit::Read(status_register,
-                         TransmitStatus::kTransmitMailbox1Empty))
-      {
-        channel_.can->sTxMailBox[1].TDTR &= ~(0xF);
-        channel_.can->sTxMailBox[1].TDTR |= message.length & 0xF;
-        channel_.can->sTxMailBox[1].TDLR = registers.data_a;
-        channel_.can->sTxMailBox[1].TDHR = registers.data_b;
-        channel_.can->sTxMailBox[1].TIR  = registers.id;
-        sent                             = true;
-      }
-      else if (bit::Read(status_register,
-                         TransmitStatus::kTransmitMailbox2Empty))
-      {
-        channel_.can->sTxMailBox[2].TDTR &= ~(0xF);
-        channel_.can->sTxMailBox[2].TDTR |= message.length & 0xF;
-        channel_.can->sTxMailBox[2].TDLR = registers.data_a;
-        channel_.can->sTxMailBox[2].TDHR = registers.data_b;
-        channel_.can->sTxMailBox[2].TIR  = registers.id;
-        sent                             = true;
-      }
+      continue;
     }
   }
 
-  bool HasData() override
+  bool TrySend(const Message_t & message) override
   {
-    uint32_t fifo0_status = channel_.can->RF0R;
-    uint32_t fifo1_status = channel_.can->RF1R;
-    if (bit::Read(fifo0_status, FIFOStatus::kMessagesPending))
+    if (!Enqueue(message))
     {
-      return true;
+      transmit_statistics_.dropped++;
+      return false;
     }
-    if (bit::Read(fifo1_status, FIFOStatus::kMessagesPending))
+    return true;
+  }
+
+  TransmitStatistics_t GetTransmitStatistics() override
+  {
+    auto statistics        = transmit_statistics_;
+    statistics.queue_depth = transmit_queue_.Size();
+    statistics.in_flight   = written_ - statistics.completed;
+    return statistics;
+  }
+
+  void ConfigureAcceptanceFilter(
+      std::span<const AcceptanceFilter_t> filters) override
+  {
+    if (filters.size() > filters_.size())
     {
-      return true;
+      LogWarning("Too many CAN acceptance filters, accepting all messages.");
+      filter_count_ = 0;
+    }
+    else
+    {
+      std::copy(filters.begin(), filters.end(), filters_.begin());
+      filter_count_ = filters.size();
+    }
+
+    if (GetState() == State::kInitialized)
+    {
+      EnableAcceptanceFilter();
     }
-    return false;
+  }
+
+  bool HasData() override
+  {
+    return !receive_queue_.IsEmpty();
   }
 
   Message_t Receive() override
   {
     Message_t message;
+    receive_queue_.Pop(std::span(&message, 1));
+    return message;
+  }
+
+  size_t Receive(std::span<Message_t> messages) override
+  {
+    return receive_queue_.Pop(messages);
+  }
+
+  ReceiveStatistics_t GetReceiveStatistics() override
+  {
+    auto statistics        = receive_statistics_;
+    statistics.queue_depth = receive_queue_.Size();
+    return statistics;
+  }
+
+  bool SelfTest(uint32_t id) override
+  {
+    Message_t test_message;
+    test_message.id = id;
+
+    // Enable self-test mode
+    DisableInterrupts();
+    SetLoopback();
+
+    Send(test_message);
+
+    // Allow time for RX to fire. The receive interrupts are disabled, so the
+    // message stays in the hardware FIFO and can be read from here.
+    Wait(100ms, [this]() { return HardwareHasData(); });
+
+    auto received_message = ReadFifo(Timestamp());
+
+    // Check if the received message matches the one we sent
+    if (received_message.id != test_message.id)
+    {
+      return false;
+    }
+
+    // Disable self-test mode
+    ClearLoopback();
+    EnableInterrupts();
+
+    return true;
+  }
+
+  bool IsBusOff() override
+  {
+    // True = Bus is in sleep mode
+    // False = Bus has left sleep mode.
+    return bit::Read(channel_.can->MCR, MasterStatus::kSleepAcknowledge);
+  }
+
+  BusStatistics_t GetBusStatistics() override
+  {
+    const uint32_t kStatus = channel_.can->ESR;
+    auto statistics        = bus_statistics_;
+
+    statistics.transmit_error_count = static_cast<uint8_t>(
+        bit::Extract(kStatus, ErrorStatus::kTransmitErrorCounter));
+    statistics.receive_error_count = static_cast<uint8_t>(
+        bit::Extract(kStatus, ErrorStatus::kReceiveErrorCounter));
+    statistics.error_warning = bit::Read(kStatus, ErrorStatus::kErrorWarning);
+    statistics.error_passive = bit::Read(kStatus, ErrorStatus::kErrorPassive);
+    statistics.bus_off       = bit::Read(kStatus, ErrorStatus::kBusOff);
+    statistics.elapsed_time  = Timestamp() - bus_statistics_start_;
+
+    return statistics;
+  }
+
+  void ResetBusStatistics() override
+  {
+    bus_statistics_       = {};
+    bus_statistics_start_ = Timestamp();
+  }
+
+  /// Sets CANx to receive what it transmits
+  void SetLoopback()
+  {
+    SetMasterMode(MasterControl::kInitializationRequest, true);
+    channel_.can->BTR = bit::Set(channel_.can->BTR, BusTiming::kLoopBackMode);
+    SetMasterMode(MasterControl::kInitializationRequest, false);
+  }
+
+  /// Disabled CANx from receiving what it transmits
+  void ClearLoopback()
+  {
+    SetMasterMode(MasterControl::kInitializationRequest, true);
+    channel_.can->BTR = bit::Clear(channel_.can->BTR, BusTiming::kLoopBackMode);
+    SetMasterMode(MasterControl::kInitializationRequest, false);
+  }
+
+  /// Enable/Disable controller modes
+  ///
+  /// @param mode - which mode to enable/disable
+  /// @param enable_mode - true if you want to enable the mode. False otherwise.
+  void SetMasterMode(bit::Mask mode, bool enable_mode)
+  {
+    channel_.can->MCR = bit::Insert(channel_.can->MCR, enable_mode, mode);
+  }
+
+ private:
+  void ConfigureBaudRate()
+  {
+    constexpr int tseg1     = 4;
+    constexpr int tseg2     = 1;
+    constexpr int sync_jump = 0;
+
+    constexpr uint32_t clocks_per_bit = tseg1 + tseg2 + sync_jump + 3;
+
+    auto & system         = sjsu::SystemController::GetPlatformController();
+    const auto frequency  = system.GetClockRate(channel_.id);
+    const auto clock_rate = settings.baud_rate * clocks_per_bit;
+    uint32_t prescaler =
+        (frequency.to<uint32_t>() / (clock_rate.to<uint32_t>()) - 1);
+
+    channel_.can->BTR =
+        bit::Insert(channel_.can->BTR, prescaler, BusTiming::kPrescalar);
+    channel_.can->BTR =
+        bit::Insert(channel_.can->BTR, tseg1, BusTiming::kTimeSegment1);
+    channel_.can->BTR =
+        bit::Insert(channel_.can->BTR, tseg2, BusTiming::kTimeSegment2);
+    channel_.can->BTR =
+        bit::Insert(channel_.can->BTR, sync_jump, BusTiming::kSyncJumpWidth);
+  }
+
+  /// Take the oldest message out of the receive FIFOs and release its output
+  /// mailbox.
+  ///
+  /// @param timestamp - time to record as the message's reception time.
+  /// @return Message_t - the received message.
+  Message_t ReadFifo(std::chrono::nanoseconds timestamp)
+  {
+    Message_t message;
+    message.uptime = timestamp;
 
     uint32_t fifo0_status      = channel_.can->RF0R;
     uint32_t fifo1_status      = channel_.can->RF1R;
@@ -560,6 +747,8 @@ class Can final : public sjsu::Can
     message.payload[7] =
         (channel_.can->sFIFOMailBox[Value(fifo_select)].RDHR >> (3 * 8)) & 0xFF;
 
+    bus_statistics_.RecordReceive(message);
+
     // Release the RX buffer and allow another buffer to be read.
     if (fifo_select == FIFOAssignment::kFIFO1)
     {
@@ -575,118 +764,255 @@ class Can final : public sjsu::Can
     return message;
   }
 
-  bool SelfTest(uint32_t id) override
+  bool HardwareHasData()
   {
-    Message_t test_message;
-    test_message.id = id;
+    uint32_t fifo0_status = channel_.can->RF0R;
+    uint32_t fifo1_status = channel_.can->RF1R;
+    if (bit::Read(fifo0_status, FIFOStatus::kMessagesPending))
+    {
+      return true;
+    }
+    if (bit::Read(fifo1_status, FIFOStatus::kMessagesPending))
+    {
+      return true;
+    }
+    return false;
+  }
 
-    // Enable self-test mode
-    DisableInterrupts();
-    SetLoopback();
+  std::chrono::nanoseconds Timestamp() const
+  {
+    auto timestamp = settings.timestamp;
+    return (timestamp != nullptr) ? timestamp() : 0ns;
+  }
 
-    Send(test_message);
+  void ConfigureReceiveHandler()
+  {
+    // Both FIFOs always feed the receive queue, even without a handler, so
+    // messages are not lost while the application is busy.
+    for (auto irq : { stm32f10x::CAN1_RX0_IRQn, stm32f10x::CAN1_RX1_IRQn })
+    {
+      InterruptController::GetPlatformController().Enable({
+          .interrupt_request_number = irq,
+          .interrupt_handler        = [this]() { ReceiveInterruptHandler(); },
+      });
+    }
 
-    // Allow time for RX to fire
-    Wait(100ms, [this]() { return HasData(); });
+    EnableInterrupts();
+  }
 
-    // Read the message from the rx buffer and enqueue it into the rx queue.
-    auto received_message = Receive();
+  void ReceiveInterruptHandler()
+  {
+    ReceiveIntoQueue();
 
-    // Check if the received message matches the one we sent
-    if (received_message.id != test_message.id)
+    // Call the handler once per queued message, like it would be if each
+    // message caused its own interrupt, but stop once the queue is drained.
+    if (settings.handler)
     {
-      return false;
+      for (size_t i = receive_queue_.Size(); i > 0 && HasData(); i--)
+      {
+        settings.handler(*this);
+      }
     }
+  }
 
-    // Disable self-test mode
-    ClearLoopback();
-    EnableInterrupts();
+  /// Move every message in the receive FIFOs into the receive queue. The
+  /// timestamp is taken once for the whole batch.
+  void ReceiveIntoQueue()
+  {
+    if (!HardwareHasData())
+    {
+      return;
+    }
 
-    return true;
+    const auto kTimestamp = Timestamp();
+
+    for (size_t i = 0; i < kHardwareReceiveDepth && HardwareHasData(); i++)
+    {
+      if (!receive_queue_.Push(ReadFifo(kTimestamp)))
+      {
+        receive_statistics_.overruns++;
+        bus_statistics_.receive_overruns++;
+      }
+    }
+
+    // The overrun flags are cleared by writing a 1 to them.
+    for (auto * fifo_status : { &channel_.can->RF0R, &channel_.can->RF1R })
+    {
+      if (bit::Read(*fifo_status, FIFOStatus::kIsFIFOOverrun))
+      {
+        receive_statistics_.overruns++;
+        bus_statistics_.receive_overruns++;
+        *fifo_status = bit::Set(uint32_t{ 0 }, FIFOStatus::kIsFIFOOverrun);
+      }
+    }
   }
 
-  bool IsBusOff() override
+  void ConfigureErrorInterrupt()
   {
-    // True = Bus is in sleep mode
-    // False = Bus has left sleep mode.
-    return bit::Read(channel_.can->MCR, MasterStatus::kSleepAcknowledge);
+    InterruptController::GetPlatformController().Enable({
+        .interrupt_request_number = stm32f10x::CAN1_SCE_IRQn,
+        .interrupt_handler        = [this]() { ErrorInterruptHandler(); },
+    });
+
+    ResetBusStatistics();
+
+    bit::Register(&channel_.can->IER)
+        .Set(InterruptEnableRegister::kLastErrorCode)
+        .Set(InterruptEnableRegister::kErrorInterrupt)
+        .Save();
   }
 
-  /// Sets CANx to receive what it transmits
-  void SetLoopback()
+  void ErrorInterruptHandler()
   {
-    SetMasterMode(MasterControl::kInitializationRequest, true);
-    channel_.can->BTR = bit::Set(channel_.can->BTR, BusTiming::kLoopBackMode);
-    SetMasterMode(MasterControl::kInitializationRequest, false);
+    const auto kLastError =
+        bit::Extract(channel_.can->ESR, ErrorStatus::kLastErrorCode);
+
+    switch (kLastError)
+    {
+      case kNoError: break;
+      case kSetBySoftware: break;
+      case kStuffError: bus_statistics_.RecordError(BusError::kStuff); break;
+      case kFormError: bus_statistics_.RecordError(BusError::kForm); break;
+      case kAcknowledgeError:
+        bus_statistics_.RecordError(BusError::kAcknowledge);
+        break;
+      case kBitRecessive: [[fallthrough]];
+      case kBitDominant: bus_statistics_.RecordError(BusError::kBit); break;
+      case kCrcError: bus_statistics_.RecordError(BusError::kCrc); break;
+    }
+
+    // Mark the error as counted, as the hardware only updates the code when
+    // the next error happens.
+    channel_.can->ESR = bit::Insert(uint32_t{ 0 },
+                                    uint32_t{ kSetBySoftware },
+                                    ErrorStatus::kLastErrorCode);
+
+    // The error interrupt flag is cleared by writing a 1 to it.
+    channel_.can->MSR = bit::Set(uint32_t{ 0 }, MasterStatus::kErrorInterrupt);
   }
 
-  /// Disabled CANx from receiving what it transmits
-  void ClearLoopback()
+  void ConfigureTransmitInterrupt()
   {
-    SetMasterMode(MasterControl::kInitializationRequest, true);
-    channel_.can->BTR = bit::Clear(channel_.can->BTR, BusTiming::kLoopBackMode);
-    SetMasterMode(MasterControl::kInitializationRequest, false);
+    InterruptController::GetPlatformController().Enable({
+        .interrupt_request_number = stm32f10x::CAN1_TX_IRQn,
+        .interrupt_handler        = [this]() { TransmitInterruptHandler(); },
+    });
+
+    SetTransmitInterrupt(true);
   }
 
-  /// Enable/Disable controller modes
-  ///
-  /// @param mode - which mode to enable/disable
-  /// @param enable_mode - true if you want to enable the mode. False otherwise.
-  void SetMasterMode(bit::Mask mode, bool enable_mode)
+  void TransmitInterruptHandler()
   {
-    channel_.can->MCR = bit::Insert(channel_.can->MCR, enable_mode, mode);
+    const uint32_t kStatus    = channel_.can->TSR;
+    const uint32_t kCompleted =
+        bit::Read(kStatus, TransmitStatus::kRequestCompletedMailbox0) +
+        bit::Read(kStatus, TransmitStatus::kRequestCompletedMailbox1) +
+        bit::Read(kStatus, TransmitStatus::kRequestCompletedMailbox2);
+    if (kCompleted > 0)
+    {
+      transmit_statistics_.completed += kCompleted;
+      transmit_statistics_.last_completion = Timestamp();
+    }
+
+    // Writing 1 to the request completed flags acknowledges the interrupt.
+    channel_.can->TSR = bit::Value()
+                            .Set(TransmitStatus::kRequestCompletedMailbox0)
+                            .Set(TransmitStatus::kRequestCompletedMailbox1)
+                            .Set(TransmitStatus::kRequestCompletedMailbox2);
+
+    // The transmit interrupt is masked while a thread is modifying the queue.
+    if (bit::Read(channel_.can->IER,
+                  InterruptEnableRegister::kTransmitMailboxEmpty))
+    {
+      TransmitQueuedMessages();
+    }
   }
 
- private:
-  void ConfigureBaudRate()
+  /// Place a message into the transmit queue and move as many messages as
+  /// possible from the queue into empty mailboxes.
+  ///
+  /// @param message - message to transmit.
+  /// @return false - if the queue was full.
+  bool Enqueue(const Message_t & message)
   {
-    constexpr int tseg1     = 4;
-    constexpr int tseg2     = 1;
-    constexpr int sync_jump = 0;
+    // Record when the message was queued to measure its queueing latency.
+    Message_t queued_message = message;
+    queued_message.uptime    = Timestamp();
 
-    constexpr uint32_t clocks_per_bit = tseg1 + tseg2 + sync_jump + 3;
+    // Keep the transmit interrupt from draining the queue while it is being
+    // modified.
+    SetTransmitInterrupt(false);
 
-    auto & system         = sjsu::SystemController::GetPlatformController();
-    const auto frequency  = system.GetClockRate(channel_.id);
-    const auto clock_rate = settings.baud_rate * clocks_per_bit;
-    uint32_t prescaler =
-        (frequency.to<uint32_t>() / (clock_rate.to<uint32_t>()) - 1);
+    bool queued = transmit_queue_.Push(queued_message);
+    TransmitQueuedMessages();
 
-    channel_.can->BTR =
-        bit::Insert(channel_.can->BTR, prescaler, BusTiming::kPrescalar);
-    channel_.can->BTR =
-        bit::Insert(channel_.can->BTR, tseg1, BusTiming::kTimeSegment1);
-    channel_.can->BTR =
-        bit::Insert(channel_.can->BTR, tseg2, BusTiming::kTimeSegment2);
-    channel_.can->BTR =
-        bit::Insert(channel_.can->BTR, sync_jump, BusTiming::kSyncJumpWidth);
+    if (!queued)
+    {
+      queued = transmit_queue_.Push(queued_message);
+      TransmitQueuedMessages();
+    }
+
+    transmit_statistics_.peak_queue_depth = std::max(
+        transmit_statistics_.peak_queue_depth, transmit_queue_.Size());
+
+    SetTransmitInterrupt(true);
+
+    return queued;
   }
 
-  void ConfigureReceiveHandler()
+  /// Move messages from the transmit queue, highest priority first, into the
+  /// mailboxes until the mailboxes are full or the queue is empty.
+  void TransmitQueuedMessages()
   {
-    if (settings.handler)
+    while (!transmit_queue_.IsEmpty())
     {
-      InterruptController::GetPlatformController().Enable({
-          .interrupt_request_number = stm32f10x::CAN1_RX0_IRQn,
-          .interrupt_handler        = [this]() { settings.handler(*this); },
-      });
-
-      bit::Register(&channel_.can->IER)
-          .Set(InterruptEnableRegister::kFIFO0MessagePending)
-          .Save();
-      bit::Register(&channel_.can->IER)
-          .Set(InterruptEnableRegister::kFIFO1MessagePending)
-          .Save();
+      const Message_t & message = transmit_queue_.Top();
+      if (!WriteToEmptyMailbox(message))
+      {
+        return;
+      }
+      bus_statistics_.RecordTransmit(message, Timestamp() - message.uptime);
+      transmit_queue_.Pop();
+      written_++;
     }
-    else
+  }
+
+  /// @param message - message to write into an empty transmit mailbox.
+  /// @return false - if none of the transmit mailboxes were empty.
+  bool WriteToEmptyMailbox(const Message_t & message)
+  {
+    constexpr std::array kMailboxEmpty = {
+      TransmitStatus::kTransmitMailbox0Empty,
+      TransmitStatus::kTransmitMailbox1Empty,
+      TransmitStatus::kTransmitMailbox2Empty,
+    };
+
+    StmDataRegisters_t registers   = ConvertMessageToRegisters(message);
+    const uint32_t status_register = channel_.can->TSR;
+
+    for (size_t i = 0; i < kMailboxEmpty.size(); i++)
     {
-      bit::Register(&channel_.can->IER)
-          .Clear(InterruptEnableRegister::kFIFO0MessagePending)
-          .Save();
-      bit::Register(&channel_.can->IER)
-          .Clear(InterruptEnableRegister::kFIFO1MessagePending)
-          .Save();
+      if (bit::Read(status_register, kMailboxEmpty[i]))
+      {
+        auto & mailbox = channel_.can->sTxMailBox[i];
+        mailbox.TDTR &= ~(0xF);
+        mailbox.TDTR |= message.length & 0xF;
+        mailbox.TDLR = registers.data_a;
+        mailbox.TDHR = registers.data_b;
+        mailbox.TIR  = registers.id;
+        return true;
+      }
     }
+
+    return false;
+  }
+
+  /// @param enable - true to unmask the transmit mailbox empty interrupt
+  void SetTransmitInterrupt(bool enable)
+  {
+    bit::Register(&channel_.can->IER)
+        .Insert(enable, InterruptEnableRegister::kTransmitMailboxEmpty)
+        .Save();
   }
 
   void EnableInterrupts()
@@ -715,32 +1041,206 @@ class Can final : public sjsu::Can
     return false;
   }
 
+  /// Fixed capacity list of filter bank slots of a single filter bank
+  /// configuration. A bank holds four 16-bit slots or two 32-bit slots.
+  struct FilterSlots_t
+  {
+    /// Slot contents
+    std::array<uint32_t, kFilterBankCount * 4> slots = {};
+    /// Number of used slots
+    size_t count = 0;
+
+    /// @param value - slot contents to append
+    /// @return false if the list is full
+    bool Push(uint32_t value)
+    {
+      if (count >= slots.size())
+      {
+        return false;
+      }
+      slots[count++] = value;
+      return true;
+    }
+  };
+
+  /// Program the filter banks with the acceptance filters. Individual IDs are
+  /// placed in list mode banks, ranges are split into power of two aligned
+  /// blocks and placed in mask mode banks. If no filters are configured, or
+  /// they do not fit in the available filter banks, every message is
+  /// accepted.
   void EnableAcceptanceFilter()
   {
     // Activate filter initialization mode (Set bit)
     SetFilterBankMode(FilterBankMasterControl::kInitialization);
 
-    // Deactivate filter 0 (Clear bit)
-    SetFilterActivationState<0>(FilterActivation::kNotActive);
+    // Deactivate every filter bank before reconfiguring them
+    channel_.can->FA1R = 0;
 
+    if (filter_count_ == 0 || !ProgramFilterBanks())
+    {
+      channel_.can->FA1R = 0;
+      AcceptAllMessages();
+    }
+
+    // Deactivate filter initialization mode (clear bit)
+    SetFilterBankMode(FilterBankMasterControl::kActive);
+  }
+
+  void AcceptAllMessages()
+  {
     // Configure filter 0 to single 32-bit scale configuration (Set bit)
-    SetFilterScale<0>(FilterScale::kSingle32BitScale);
+    SetFilterScale(0, FilterScale::kSingle32BitScale);
 
     // Clear filter 0 registers to accept all messages.
     channel_.can->sFilterRegister[0].FR1 = 0;
     channel_.can->sFilterRegister[0].FR2 = 0;
 
     // Set filter to mask mode
-    SetFilterType<0>(FilterType::kMask);
+    SetFilterType(0, FilterType::kMask);
 
     // Assign filter 0 to FIFO 0 (Clear bit)
-    SetFilterFIFOAssignment<0>(FIFOAssignment::kFIFO1);
+    SetFilterFIFOAssignment(0, FIFOAssignment::kFIFO1);
 
     // Activate filter 0 (Set bit)
-    SetFilterActivationState<0>(FilterActivation::kActive);
+    SetFilterActivationState(0, FilterActivation::kActive);
+  }
 
-    // Deactivate filter initialization mode (clear bit)
-    SetFilterBankMode(FilterBankMasterControl::kActive);
+  bool ProgramFilterBanks()
+  {
+    FilterSlots_t standard_ids;
+    FilterSlots_t standard_masks;
+    FilterSlots_t extended_ids;
+    FilterSlots_t extended_masks;
+
+    auto standard_entry = [](uint32_t id) -> uint32_t {
+      return bit::Value().Insert(id, FilterEntry16::kStandardIdentifier);
+    };
+
+    auto extended_entry = [](uint32_t id) -> uint32_t {
+      return bit::Value()
+          .Insert(id, MailboxIdentifier::kExtendedIdentifier)
+          .Set(MailboxIdentifier::kIdentifierType);
+    };
+
+    for (const auto & filter : std::span(filters_.data(), filter_count_))
+    {
+      const bool kIsStandard = filter.format == Message_t::Format::kStandard;
+
+      if (!filter.IsRange())
+      {
+        bool pushed = kIsStandard
+                          ? standard_ids.Push(standard_entry(filter.id_low))
+                          : extended_ids.Push(extended_entry(filter.id_low));
+        if (!pushed)
+        {
+          return false;
+        }
+        continue;
+      }
+
+      // Split the range into blocks whose size is a power of two and whose
+      // base is aligned to its size, such that each block is one mask.
+      uint64_t low        = filter.id_low;
+      const uint64_t kEnd = uint64_t{ filter.id_high } + 1;
+      while (low < kEnd)
+      {
+        uint64_t size = (low == 0) ? (uint64_t{ 1 } << 29) : (low & -low);
+        while (low + size > kEnd)
+        {
+          size >>= 1;
+        }
+
+        const uint32_t kBase = static_cast<uint32_t>(low);
+        const uint32_t kMask = static_cast<uint32_t>(~(size - 1));
+        bool pushed          = false;
+        if (kIsStandard)
+        {
+          // Match the IDE bit as well so extended frames are rejected.
+          uint32_t mask = bit::Value()
+                              .Insert(kMask, FilterEntry16::kStandardIdentifier)
+                              .Set(FilterEntry16::kIdentifierType);
+          pushed = standard_masks.Push(standard_entry(kBase)) &&
+                   standard_masks.Push(mask);
+        }
+        else
+        {
+          pushed = extended_masks.Push(extended_entry(kBase)) &&
+                   extended_masks.Push(extended_entry(kMask));
+        }
+
+        if (!pushed)
+        {
+          return false;
+        }
+        low += size;
+      }
+    }
+
+    uint32_t bank = 0;
+    return WriteFilterBanks(standard_ids,
+                            FilterType::kList,
+                            FilterScale::kDual16BitScale,
+                            &bank) &&
+           WriteFilterBanks(standard_masks,
+                            FilterType::kMask,
+                            FilterScale::kDual16BitScale,
+                            &bank) &&
+           WriteFilterBanks(extended_ids,
+                            FilterType::kList,
+                            FilterScale::kSingle32BitScale,
+                            &bank) &&
+           WriteFilterBanks(extended_masks,
+                            FilterType::kMask,
+                            FilterScale::kSingle32BitScale,
+                            &bank);
+  }
+
+  /// Write the slots into consecutive filter banks starting at `bank`. The
+  /// last bank is padded by repeating the slots at the start of that bank.
+  ///
+  /// @return false if the filter banks run out
+  bool WriteFilterBanks(const FilterSlots_t & list,
+                        FilterType type,
+                        FilterScale scale,
+                        uint32_t * bank)
+  {
+    const size_t kSlotsPerBank =
+        (scale == FilterScale::kDual16BitScale) ? 4 : 2;
+
+    for (size_t start = 0; start < list.count; start += kSlotsPerBank)
+    {
+      if (*bank >= kFilterBankCount)
+      {
+        return false;
+      }
+
+      const size_t kFilled = std::min(kSlotsPerBank, list.count - start);
+      std::array<uint32_t, 4> slot;
+      for (size_t i = 0; i < kSlotsPerBank; i++)
+      {
+        slot[i] = list.slots[start + (i % kFilled)];
+      }
+
+      auto & registers = channel_.can->sFilterRegister[*bank];
+      if (scale == FilterScale::kDual16BitScale)
+      {
+        registers.FR1 = slot[0] | (slot[1] << 16);
+        registers.FR2 = slot[2] | (slot[3] << 16);
+      }
+      else
+      {
+        registers.FR1 = slot[0];
+        registers.FR2 = slot[1];
+      }
+
+      SetFilterScale(*bank, scale);
+      SetFilterType(*bank, type);
+      SetFilterFIFOAssignment(*bank, FIFOAssignment::kFIFO1);
+      SetFilterActivationState(*bank, FilterActivation::kActive);
+      (*bank)++;
+    }
+
+    return true;
   }
 
   void SetFilterBankMode(FilterBankMasterControl mode)
@@ -750,41 +1250,29 @@ class Can final : public sjsu::Can
         .Save();
   }
 
-  template <uint32_t filter>
-  void SetFilterType(FilterType filtertype)
+  void SetFilterType(uint32_t filter, FilterType filtertype)
   {
-    static_assert((filter >= 0 && filter <= 27),
-                  "There are only 28 filters available 0 - 27");
     bit::Register(&channel_.can->FM1R)
         .Insert(Value(filtertype), bit::MaskFromRange(filter))
         .Save();
   }
 
-  template <uint32_t filter>
-  void SetFilterScale(FilterScale scale)
+  void SetFilterScale(uint32_t filter, FilterScale scale)
   {
-    static_assert((filter >= 0 && filter <= 27),
-                  "There are only 28 filters available 0 - 27");
     bit::Register(&channel_.can->FS1R)
         .Insert(Value(scale), bit::MaskFromRange(filter))
         .Save();
   }
 
-  template <uint32_t filter>
-  void SetFilterFIFOAssignment(FIFOAssignment fifo)
+  void SetFilterFIFOAssignment(uint32_t filter, FIFOAssignment fifo)
   {
-    static_assert((filter >= 0 && filter <= 27),
-                  "There are only 28 filters available 0 - 27");
     bit::Register(&channel_.can->FFA1R)
         .Insert(Value(fifo), bit::MaskFromRange(filter))
         .Save();
   }
 
-  template <uint32_t filter>
-  void SetFilterActivationState(FilterActivation state)
+  void SetFilterActivationState(uint32_t filter, FilterActivation state)
   {
-    static_assert((filter >= 0 && filter <= 27),
-                  "There are only 28 filters available 0 - 27");
     bit::Register(&channel_.can->FA1R)
         .Insert(Value(state), bit::MaskFromRange(filter))
         .Save();
@@ -796,6 +1284,15 @@ class Can final : public sjsu::Can
   }
 
   const Port_t & channel_;
+  CanTransmitQueue<config::kCanTransmitQueueSize> transmit_queue_;
+  TransmitStatistics_t transmit_statistics_;
+  uint32_t written_ = 0;
+  CanReceiveQueue<config::kCanReceiveQueueSize> receive_queue_;
+  ReceiveStatistics_t receive_statistics_;
+  BusStatistics_t bus_statistics_;
+  std::chrono::nanoseconds bus_statistics_start_ = 0ns;
+  std::array<AcceptanceFilter_t, kMaximumAcceptanceFilters> filters_ = {};
+  size_t filter_count_ = 0;
 };
 
 inline Can & GetCan()
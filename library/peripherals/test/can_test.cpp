@@ -195,35 +195,175 @@ TEST_CASE("Testing GetInactive<Can>()")
 
 CanSettings_t::ReceiveHandler receive_handler;
 
+TEST_CASE("Testing CanTransmitQueue")
+{
+  CanTransmitQueue<4> queue;
+
+  auto make_message = [](uint32_t id, Can::Message_t::Format format,
+                         uint8_t tag) {
+    Can::Message_t message = { .id = id, .format = format };
+    message.payload[0]     = tag;
+    return message;
+  };
+
+  constexpr auto kStandard = Can::Message_t::Format::kStandard;
+  constexpr auto kExtended = Can::Message_t::Format::kExtended;
+
+  SECTION("Pops in arbitration order")
+  {
+    // Setup
+    CHECK(queue.IsEmpty());
+    CHECK(queue.Push(make_message(0x200, kStandard, 0)));
+    CHECK(queue.Push(make_message(0x100 << 18, kExtended, 1)));
+    CHECK(queue.Push(make_message(0x100, kStandard, 2)));
+    CHECK(queue.Push(make_message(0x200, kStandard, 3)));
+
+    // Exercise + Verify: Full
+    CHECK(!queue.Push(make_message(0x000, kStandard, 4)));
+    CHECK(4 == queue.Size());
+
+    // Verify: Standard ID wins over an extended ID with the same base ID and
+    //         messages with the same ID come out in the order they were pushed
+    CHECK(2 == queue.Top().payload[0]);
+    queue.Pop();
+    CHECK(1 == queue.Top().payload[0]);
+    queue.Pop();
+    CHECK(0 == queue.Top().payload[0]);
+    queue.Pop();
+    CHECK(3 == queue.Top().payload[0]);
+    queue.Pop();
+    CHECK(queue.IsEmpty());
+  }
+}
+
+TEST_CASE("Testing CanReceiveQueue")
+{
+  CanReceiveQueue<4> queue;
+  std::array<Can::Message_t, 3> messages;
+
+  SECTION("Pops in the order pushed")
+  {
+    // Setup
+    for (uint32_t id = 1; id <= 4; id++)
+    {
+      CHECK(queue.Push({ .id = id }));
+    }
+
+    // Exercise + Verify: Full
+    CHECK(!queue.Push({ .id = 5 }));
+    CHECK(4 == queue.Size());
+
+    // Exercise + Verify: Batch pop is limited by the span size
+    CHECK(3 == queue.Pop(messages));
+    CHECK(1 == messages[0].id);
+    CHECK(2 == messages[1].id);
+    CHECK(3 == messages[2].id);
+
+    // Exercise + Verify: Wraps around the end of the buffer
+    CHECK(queue.Push({ .id = 6 }));
+    CHECK(2 == queue.Pop(messages));
+    CHECK(4 == messages[0].id);
+    CHECK(6 == messages[1].id);
+    CHECK(queue.IsEmpty());
+    CHECK(0 == queue.Pop(messages));
+  }
+}
+
+TEST_CASE("Testing Can::BusStatistics_t")
+{
+  using BusStatistics_t = Can::BusStatistics_t;
+  BusStatistics_t statistics;
+
+  SECTION("EstimateFrameBits()")
+  {
+    // Setup
+    Can::Message_t empty    = { .id = 0x100 };
+    Can::Message_t full     = { .id = 0x100, .length = 8 };
+    Can::Message_t extended = {
+      .id = 0x100, .format = Can::Message_t::Format::kExtended
+    };
+    Can::Message_t remote = {
+      .id = 0x100, .is_remote_request = true, .length = 8
+    };
+
+    // Exercise + Verify
+    CHECK(51 == BusStatistics_t::EstimateFrameBits(empty));
+    CHECK(123 == BusStatistics_t::EstimateFrameBits(full));
+    CHECK(73 == BusStatistics_t::EstimateFrameBits(extended));
+    CHECK(51 == BusStatistics_t::EstimateFrameBits(remote));
+  }
+
+  SECTION("LatencyBucket()")
+  {
+    CHECK(0 == BusStatistics_t::LatencyBucket(0ns));
+    CHECK(0 == BusStatistics_t::LatencyBucket(999ns));
+    CHECK(1 == BusStatistics_t::LatencyBucket(1us));
+    CHECK(2 == BusStatistics_t::LatencyBucket(3us));
+    CHECK(10 == BusStatistics_t::LatencyBucket(1ms));
+    CHECK(BusStatistics_t::kLatencyBuckets - 1 ==
+          BusStatistics_t::LatencyBucket(10s));
+  }
+
+  SECTION("Rates and bus load")
+  {
+    // Setup
+    Can::Message_t message = { .id = 0x100, .length = 8 };
+
+    // Exercise
+    statistics.RecordTransmit(message, 5us);
+    statistics.RecordTransmit(message, 0ns);
+    statistics.RecordReceive(message);
+    statistics.RecordError(Can::BusError::kCrc);
+
+    // Verify: Nothing is divided by a zero elapsed time
+    CHECK(0.0f ==
+          doctest::Approx(statistics.PerSecond(statistics.transmitted_frames)));
+    CHECK(0.0f == doctest::Approx(statistics.BusLoad(1_MHz)));
+
+    // Exercise
+    statistics.elapsed_time = 10ms;
+
+    // Verify
+    CHECK(2 == statistics.transmitted_frames);
+    CHECK(1 == statistics.received_frames);
+    CHECK(1 == statistics.transmit_latency[0]);
+    CHECK(1 == statistics.transmit_latency[3]);
+    CHECK(1 == statistics.bus_errors[Value(Can::BusError::kCrc)]);
+    CHECK(200.0f == doctest::Approx(
+                        statistics.PerSecond(statistics.transmitted_frames)));
+    CHECK(3.69f == doctest::Approx(statistics.BusLoad(1_MHz)));
+  }
+}
+
 TEST_CASE("Testing CanNetwork")
 {
   Mock<Can> mock_can;
   Fake(Method(mock_can, Can::ModuleInitialize));
+  Fake(Method(mock_can, Can::ConfigureAcceptanceFilter));
 
   Can & can = mock_can.get();
-  StaticMemoryResource<1024> memory_resource;
-  CanNetwork network(can, &memory_resource);
+  CanNetwork network(can);
 
   SECTION("Initialize()")
   {
     // Setup
     When(Method(mock_can, Can::HasData)).Return(true);
-    When(Method(mock_can, Can::Receive)).Return({});
+    When(OverloadedMethod(mock_can, Can::Receive, Can::Message_t()))
+        .Return({});
 
     // Exercise
     network.Initialize();
     network.ManuallyCallReceiveHandler();
 
     // Verify
-    Verify(Method(mock_can, Can::HasData), Method(mock_can, Can::Receive))
+    Verify(Method(mock_can, Can::HasData),
+           OverloadedMethod(mock_can, Can::Receive, Can::Message_t()))
         .Once();
   }
 
   SECTION("Node_t* CaptureMessage(id)")
   {
     // Setup
-    size_t initial_memory_usage = memory_resource.MemoryAvailable();
-
     const std::array<Can::Message_t, 6> kExpectedMessages = {
       Can::Message_t{
           .id      = 0x111,
@@ -258,7 +398,7 @@ TEST_CASE("Testing CanNetwork")
     };
 
     When(Method(mock_can, Can::HasData)).AlwaysReturn(true);
-    When(Method(mock_can, Can::Receive))
+    When(OverloadedMethod(mock_can, Can::Receive, Can::Message_t()))
         .Return(kExpectedMessages[0])
         .Return(kExpectedMessages[1])
         .Return(kExpectedMessages[2])
@@ -353,41 +493,201 @@ TEST_CASE("Testing CanNetwork")
       CHECK(kExpectedMessages[5] == message4->SecureGet());
     }
 
-    // Verify: That memory was utilized from the memory resource
-    CHECK(initial_memory_usage > memory_resource.MemoryAvailable());
+    // Verify: That the lookup table contains each of these IDs
+    CHECK(message0 == network.Find(0x111));
+    CHECK(message1 == network.Find(0x222));
+    CHECK(message2 == network.Find(0x333));
+    CHECK(message3 == network.Find(0x444));
+    CHECK(message4 == network.Find(0x555));
+    CHECK(nullptr == network.Find(0x666));
+    CHECK(5 == network.Size());
+
+    // Verify: Each received message was looked up
+    auto statistics = network.GetLookupStatistics();
+    CHECK(6 == statistics.lookups);
+    CHECK(0 == statistics.misses);
+    CHECK(6 <= statistics.total_probes);
+    CHECK(1 <= statistics.longest_probe);
+  }
 
-    // Verify: That the internal map contains each of these keys
-    CHECK(network.GetInternalMap().contains(0x111));
-    CHECK(network.GetInternalMap().contains(0x222));
-    CHECK(network.GetInternalMap().contains(0x333));
-    CHECK(network.GetInternalMap().contains(0x444));
-    CHECK(network.GetInternalMap().contains(0x555));
+  SECTION("CaptureMessage(id) same ID returns same node")
+  {
+    // Exercise
+    auto * node0 = network.CaptureMessage(0x140);
+    auto * node1 = network.CaptureMessage(0x140);
+
+    // Verify
+    CHECK(node0 == node1);
+    CHECK(1 == network.Size());
   }
 
-  SECTION("CaptureMessage(id) std::bad_alloc")
+  SECTION("CaptureMessage(id) more than capacity")
   {
     // Setup
-    size_t initial_memory_usage = memory_resource.MemoryAvailable();
+    for (uint32_t i = 0; i < CanNetwork::kCapacity; i++)
+    {
+      [[maybe_unused]] auto * message = network.CaptureMessage(i);
+    }
 
     // Exercise + Verify
-    CHECK_THROWS_AS(([&network]() {
-                      for (int i = 0; i < 1000; i++)
-                      {
-                        [[maybe_unused]] auto * message =
-                            network.CaptureMessage(i);
-                      }
-                    })(),
-                    std::bad_alloc);
-
-    // Verify: That memory was utilized from the memory resource
-    CHECK(initial_memory_usage > memory_resource.MemoryAvailable());
+    SJ2_CHECK_EXCEPTION(static_cast<void>(network.CaptureMessage(0x7FF)),
+                        std::errc::not_enough_memory);
+
+    // Verify: Already captured IDs can still be retrieved
+    CHECK(nullptr != network.CaptureMessage(0));
+    CHECK(CanNetwork::kCapacity == network.Size());
+    for (uint32_t i = 0; i < CanNetwork::kCapacity; i++)
+    {
+      CHECK(nullptr != network.Find(i));
+    }
+  }
+
+  SECTION("Lookup statistics")
+  {
+    // Setup
+    Can::Message_t unknown_message = { .id = 0x321 };
+    When(Method(mock_can, Can::HasData)).AlwaysReturn(true);
+    When(OverloadedMethod(mock_can, Can::Receive, Can::Message_t()))
+        .AlwaysReturn(unknown_message);
+    [[maybe_unused]] auto * node = network.CaptureMessage(0x123);
+    network.ProfileLookups(true);
+
+    // Exercise
+    network.ManuallyCallReceiveHandler();
+    network.ManuallyCallReceiveHandler();
+
+    // Verify
+    auto statistics = network.GetLookupStatistics();
+    CHECK(2 == statistics.lookups);
+    CHECK(2 == statistics.misses);
+    CHECK(0ns < statistics.total_lookup_time);
+    CHECK(statistics.longest_lookup_time <= statistics.total_lookup_time);
+
+    // Exercise
+    network.ResetLookupStatistics();
+
+    // Verify
+    CHECK(0 == network.GetLookupStatistics().lookups);
+  }
+
+  SECTION("CaptureMessage() updates acceptance filter")
+  {
+    // Setup
+    std::vector<Can::AcceptanceFilter_t> last_filters;
+    When(Method(mock_can, Can::ConfigureAcceptanceFilter))
+        .AlwaysDo([&last_filters](auto filters) {
+          last_filters.assign(filters.begin(), filters.end());
+        });
+
+    // Exercise
+    [[maybe_unused]] auto * node0 = network.CaptureMessage(0x140);
+    [[maybe_unused]] auto * node1 = network.CaptureMessage(0x142);
+    [[maybe_unused]] auto * node2 = network.CaptureMessage(
+        0x1AB'CDEF, Can::Message_t::Format::kExtended);
+    [[maybe_unused]] auto * node3 = network.CaptureMessage(0x141);
+    [[maybe_unused]] auto * node4 = network.CaptureMessage(0x141);
+
+    // Verify
+    Verify(Method(mock_can, Can::ConfigureAcceptanceFilter)).Exactly(4);
+    auto filters = network.GetAcceptanceFilters();
+    REQUIRE(filters.size() == 2);
+    REQUIRE(last_filters.size() == 2);
+    for (size_t i = 0; i < filters.size(); i++)
+    {
+      CHECK(last_filters[i].id_low == filters[i].id_low);
+      CHECK(last_filters[i].id_high == filters[i].id_high);
+      CHECK(last_filters[i].format == filters[i].format);
+    }
+
+    CHECK(filters[0].id_low == 0x140);
+    CHECK(filters[0].id_high == 0x142);
+    CHECK(filters[0].format == Can::Message_t::Format::kStandard);
+    CHECK(filters[1].id_low == 0x1AB'CDEF);
+    CHECK(filters[1].id_high == 0x1AB'CDEF);
+    CHECK(filters[1].format == Can::Message_t::Format::kExtended);
+  }
+
+  SECTION("CaptureMessage() filters low extended IDs as extended")
+  {
+    // Exercise
+    [[maybe_unused]] auto * node0 =
+        network.CaptureMessage(0x123, Can::Message_t::Format::kExtended);
+    [[maybe_unused]] auto * node1 = network.CaptureMessage(0x123);
+
+    // Verify: The ID is accepted in both formats, each with its own node
+    auto filters = network.GetAcceptanceFilters();
+    REQUIRE(filters.size() == 2);
+    CHECK(filters[0].Matches(0x123, Can::Message_t::Format::kExtended));
+    CHECK(!filters[0].Matches(0x123, Can::Message_t::Format::kStandard));
+    CHECK(filters[1].Matches(0x123, Can::Message_t::Format::kStandard));
+    CHECK(node0 != node1);
+    CHECK(2 == network.Size());
+    CHECK(node0 == network.Find(0x123, Can::Message_t::Format::kExtended));
+    CHECK(node1 == network.Find(0x123));
+  }
+
+  SECTION("Received messages are stored by ID and format")
+  {
+    // Setup
+    const Can::Message_t kStandardMessage = {
+      .id = 0x123, .length = 1, .payload = { 0xAA }
+    };
+    const Can::Message_t kExtendedMessage = {
+      .id      = 0x123,
+      .length  = 1,
+      .format  = Can::Message_t::Format::kExtended,
+      .payload = { 0xBB },
+    };
+    When(Method(mock_can, Can::HasData)).AlwaysReturn(true);
+    When(OverloadedMethod(mock_can, Can::Receive, Can::Message_t()))
+        .Return(kExtendedMessage)
+        .Return(kStandardMessage);
+    auto * standard_node = network.CaptureMessage(0x123);
+
+    // Exercise
+    network.ManuallyCallReceiveHandler();
+
+    // Verify: The extended message is not mistaken for the standard one
+    CHECK(0 == standard_node->SecureGet().length);
+    CHECK(1 == network.GetLookupStatistics().misses);
+
+    // Exercise
+    network.ManuallyCallReceiveHandler();
+
+    // Verify
+    CHECK(0xAA == standard_node->SecureGet().payload[0]);
+    CHECK(1 == network.GetLookupStatistics().misses);
+  }
+
+  SECTION("CaptureMessage() rejects standard IDs above 11 bits")
+  {
+    // Exercise + Verify
+    SJ2_CHECK_EXCEPTION(static_cast<void>(network.CaptureMessage(0x800)),
+                        std::errc::invalid_argument);
+    CHECK(0 == network.Size());
+  }
+
+  SECTION("CaptureMessage() too many filters accepts all")
+  {
+    // Setup
+    static_assert(CanNetwork::kCapacity > Can::kMaximumAcceptanceFilters);
+
+    // Exercise
+    for (uint32_t i = 0; i <= Can::kMaximumAcceptanceFilters; i++)
+    {
+      [[maybe_unused]] auto * node = network.CaptureMessage(i * 2);
+    }
+
+    // Verify
+    CHECK(network.GetAcceptanceFilters().empty());
   }
 
   SECTION("ManuallyCallReceiveHandler()")
   {
     // Setup
     When(Method(mock_can, Can::HasData)).Return(true).Return(false);
-    When(Method(mock_can, Can::Receive)).Return({});
+    When(OverloadedMethod(mock_can, Can::Receive, Can::Message_t()))
+        .Return({});
 
     // Exercise
     network.ManuallyCallReceiveHandler();
@@ -399,7 +699,7 @@ TEST_CASE("Testing CanNetwork")
     Verify(Method(mock_can, Can::HasData)).Twice();
     // Verify: but... the Receive() call should only happen once since HasData()
     //         only return true once in a subcase such as this.
-    Verify(Method(mock_can, Can::Receive)).Once();
+    Verify(OverloadedMethod(mock_can, Can::Receive, Can::Message_t())).Once();
   }
 
   SECTION("CanBus()")
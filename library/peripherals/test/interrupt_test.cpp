@@ -19,4 +19,89 @@ TEST_CASE("Testing interrupt interface")
     CHECK(&mock_controller.get() == &should_be_the_mock_controller);
   }
 }
+
+namespace
+{
+int free_function_calls = 0;
+
+void FreeFunction()
+{
+  free_function_calls++;
+}
+}  // namespace
+
+TEST_CASE("Testing InterruptDelegate")
+{
+  SECTION("Empty delegate throws like an empty std::function")
+  {
+    // Setup
+    InterruptDelegate empty;
+    InterruptDelegate null = nullptr;
+
+    // Exercise + Verify
+    CHECK(!empty);
+    CHECK(!null);
+    CHECK_THROWS_AS(empty(), std::bad_function_call);
+    CHECK_THROWS_AS(null(), std::bad_function_call);
+  }
+
+  SECTION("Free function")
+  {
+    // Setup
+    free_function_calls = 0;
+    InterruptDelegate delegate(FreeFunction);
+
+    // Exercise
+    delegate();
+    delegate();
+
+    // Verify
+    CHECK(delegate);
+    CHECK(2 == free_function_calls);
+  }
+
+  SECTION("Lambda capturing two references, called through a copy")
+  {
+    // Setup
+    int first  = 0;
+    int second = 0;
+
+    InterruptDelegate delegate = [&first, &second]() {
+      first++;
+      second += 2;
+    };
+    InterruptDelegate copy;
+
+    // Exercise
+    copy = delegate;
+    copy();
+    delegate();
+
+    // Verify
+    CHECK(2 == first);
+    CHECK(4 == second);
+  }
+
+  SECTION("Arguments are passed to the callable")
+  {
+    // Setup
+    uint32_t sum = 0;
+    BasicInterruptDelegate<uint32_t> delegate = [&sum](uint32_t value) {
+      sum += value;
+    };
+
+    // Exercise
+    delegate(3);
+    delegate(4);
+
+    // Verify
+    CHECK(7 == sum);
+  }
+
+  SECTION("Fits in a handler table entry without allocating")
+  {
+    CHECK(sizeof(InterruptDelegate) == 3 * sizeof(void *));
+    CHECK(std::is_trivially_copyable_v<InterruptDelegate>);
+  }
+}
 }  // namespace sjsu
@@ -74,6 +74,13 @@
 // cortex implemenation test
 // =============================================================================
 
-#include "peripherals/cortex/test/dwt_counter_test.cpp"   // NOLINT
-#include "peripherals/cortex/test/interrupt_test.cpp"     // NOLINT
-#include "peripherals/cortex/test/system_timer_test.cpp"  // NOLINT
+#include "peripherals/cortex/test/dwt_counter_test.cpp"         // NOLINT
+#include "peripherals/cortex/test/interrupt_profiler_test.cpp"  // NOLINT
+#include "peripherals/cortex/test/interrupt_test.cpp"           // NOLINT
+#include "peripherals/cortex/test/system_timer_test.cpp"        // NOLINT
+
+// =============================================================================
+// linux implemenation test
+// =============================================================================
+
+#include "peripherals/linux/test/virtual_can_test.cpp"  // NOLINT
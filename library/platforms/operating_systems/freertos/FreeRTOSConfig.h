@@ -78,6 +78,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay 1
 #define INCLUDE_uxTaskGetStackHighWaterMark 1
 #define INCLUDE_xTaskGetSchedulerState 1
+#define INCLUDE_xTaskGetCurrentTaskHandle 1
 
 /* FreeRTOS Timer or daemon task configuration */
 #define configUSE_TIMERS 1
@@ -128,4 +129,10 @@ extern void vConfigureTimerForRunTimeStats(void);
 #define portGET_RUN_TIME_COUNTER_VALUE() TIM0->TC
 #endif
 
+/* SJSU-Dev: Record kernel events into sjsu::rtos::TraceRecorder. Must be
+defined on the compiler command line, so the kernel's C sources see it too. */
+#if defined(SJ2_ENABLE_RTOS_TRACE) && SJ2_ENABLE_RTOS_TRACE
+#include "trace_hooks.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
@@ -1,6 +1,13 @@
 #include <FreeRTOS.h>
 #include <task.h>
+#include <chrono>
+#include <atomic>
 #include <iterator>
+
+#include "trace_hooks.h"
+#include "utility/rtos/freertos/trace_recorder.hpp"
+#include "utility/time/time.hpp"
+
 // Implementation of vApplicationGetIdleTaskMemory required when
 // The function is called to statically create the idle task when
 // vTaskStartScheduler is invoked.
@@ -31,3 +38,126 @@ extern "C" void vApplicationGetTimerTaskMemory( // NOLINT
     *ppx_timer_task_stack_buffer = timer_task_stack;
     *pul_timer_task_stack_size = std::size(timer_task_stack);
 }
+
+// Scheduler hooks used by sjsu::Wait(), sjsu::Delay() and sjsu::WaitSignal to
+// sleep instead of spinning, see utility/time/time.hpp.
+namespace
+{
+/// @return true if called from an interrupt handler. Only Cortex-M ports can
+///         tell, other ports never run FreeRTOS calls from interrupts.
+bool IsInsideInterrupt()
+{
+#if defined(__arm__)
+  return xPortIsInsideInterrupt() == pdTRUE;
+#else
+  return false;
+#endif
+}
+}  // namespace
+
+void * sjsu::SystemThread()
+{
+  if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING || IsInsideInterrupt())
+  {
+    return nullptr;
+  }
+  return xTaskGetCurrentTaskHandle();
+}
+
+void sjsu::SystemSleep(std::chrono::nanoseconds duration, bool wake_on_signal)
+{
+  constexpr std::chrono::nanoseconds kTickPeriod =
+      std::chrono::nanoseconds(1s) / configTICK_RATE_HZ;
+
+  // A sleep of n ticks ends on the nth tick interrupt, which is at most n tick
+  // periods away, so it never overshoots the duration.
+  const auto kTicks = static_cast<TickType_t>(duration / kTickPeriod);
+  if (kTicks == 0)
+  {
+    return;
+  }
+
+  if (wake_on_signal)
+  {
+    ulTaskNotifyTake(pdTRUE, kTicks);
+  }
+  else
+  {
+    vTaskDelay(kTicks);
+  }
+}
+
+void sjsu::SystemSignal(void * thread)
+{
+  auto task = static_cast<TaskHandle_t>(thread);
+  if (IsInsideInterrupt())
+  {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(task, &higher_priority_task_woken);
+    portEND_SWITCHING_ISR(higher_priority_task_woken);
+  }
+  else
+  {
+    xTaskNotifyGive(task);
+  }
+}
+
+// Trace hooks called by the kernel when SJ2_ENABLE_RTOS_TRACE is defined, see
+// trace_hooks.h.
+namespace
+{
+using sjsu::rtos::TraceEvent;
+using sjsu::rtos::TraceRecorder;
+
+constexpr bool HooksMatch(int hook, TraceEvent event)
+{
+  return hook == static_cast<int>(event);
+}
+
+static_assert(HooksMatch(SJ2_TRACE_TASK_SWITCH_IN, TraceEvent::kTaskSwitchIn));
+static_assert(
+    HooksMatch(SJ2_TRACE_TASK_SWITCH_OUT, TraceEvent::kTaskSwitchOut));
+static_assert(HooksMatch(SJ2_TRACE_TASK_DELETE, TraceEvent::kTaskDelete));
+static_assert(
+    HooksMatch(SJ2_TRACE_PRIORITY_INHERIT, TraceEvent::kPriorityInherit));
+static_assert(
+    HooksMatch(SJ2_TRACE_PRIORITY_DISINHERIT, TraceEvent::kPriorityDisinherit));
+static_assert(HooksMatch(SJ2_TRACE_QUEUE_SEND, TraceEvent::kQueueSend));
+static_assert(
+    HooksMatch(SJ2_TRACE_QUEUE_SEND_FAILED, TraceEvent::kQueueSendFailed));
+static_assert(HooksMatch(SJ2_TRACE_QUEUE_RECEIVE, TraceEvent::kQueueReceive));
+static_assert(HooksMatch(SJ2_TRACE_QUEUE_RECEIVE_FAILED,
+                         TraceEvent::kQueueReceiveFailed));
+static_assert(
+    HooksMatch(SJ2_TRACE_QUEUE_BLOCK_ON_SEND, TraceEvent::kQueueBlockOnSend));
+static_assert(HooksMatch(SJ2_TRACE_QUEUE_BLOCK_ON_RECEIVE,
+                         TraceEvent::kQueueBlockOnReceive));
+
+/// Number given to the last queue created.
+std::atomic<uint32_t> queue_count = 0;
+}  // namespace
+
+extern "C" void RtosTraceEvent(uint8_t type, uint32_t id, uint32_t argument)
+{
+  if (auto * recorder = TraceRecorder::GetPlatformRecorder())
+  {
+    recorder->Record(static_cast<TraceEvent>(type), id, argument);
+  }
+}
+
+extern "C" void RtosTraceTaskCreate(uint32_t number,
+                                    uint32_t priority,
+                                    const char * name)
+{
+  if (auto * recorder = TraceRecorder::GetPlatformRecorder())
+  {
+    recorder->RegisterTask(number, priority, name);
+  }
+}
+
+extern "C" uint32_t RtosTraceQueueCreate(uint8_t type)
+{
+  const uint32_t kNumber = ++queue_count;
+  RtosTraceEvent(static_cast<uint8_t>(TraceEvent::kQueueCreate), kNumber, type);
+  return kNumber;
+}
@@ -0,0 +1,93 @@
+// FreeRTOS trace hook macros that report kernel events to the
+// sjsu::rtos::TraceRecorder, see utility/rtos/freertos/trace_recorder.hpp.
+//
+// Included by FreeRTOSConfig.h when SJ2_ENABLE_RTOS_TRACE is defined to 1 on
+// the compiler command line, which the kernel's C sources also see. The
+// macros expand inside tasks.c and queue.c, where the TCB_t and Queue_t fields
+// they read are visible.
+#pragma once
+
+#include <stdint.h>
+
+// Must match sjsu::rtos::TraceEvent, which freertos_common.cpp checks.
+#define SJ2_TRACE_TASK_SWITCH_IN 1
+#define SJ2_TRACE_TASK_SWITCH_OUT 2
+#define SJ2_TRACE_TASK_DELETE 4
+#define SJ2_TRACE_PRIORITY_INHERIT 5
+#define SJ2_TRACE_PRIORITY_DISINHERIT 6
+#define SJ2_TRACE_QUEUE_SEND 8
+#define SJ2_TRACE_QUEUE_SEND_FAILED 9
+#define SJ2_TRACE_QUEUE_RECEIVE 10
+#define SJ2_TRACE_QUEUE_RECEIVE_FAILED 11
+#define SJ2_TRACE_QUEUE_BLOCK_ON_SEND 12
+#define SJ2_TRACE_QUEUE_BLOCK_ON_RECEIVE 13
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+  /// Record an event in the platform's TraceRecorder, if it has one.
+  void RtosTraceEvent(uint8_t type, uint32_t id, uint32_t argument);
+  /// Remember a new task's name and record its creation.
+  void RtosTraceTaskCreate(uint32_t number,
+                           uint32_t priority,
+                           const char * name);
+  /// Record the creation of a queue.
+  ///
+  /// @return the number given to the queue, to identify it in later events.
+  uint32_t RtosTraceQueueCreate(uint8_t type);
+#ifdef __cplusplus
+}
+#endif
+
+// Switched out is reported after the context has been saved, so pxTopOfStack
+// gives the stack the task has left.
+#define traceTASK_SWITCHED_OUT()            \
+  RtosTraceEvent(SJ2_TRACE_TASK_SWITCH_OUT, \
+                 pxCurrentTCB->uxTCBNumber, \
+                 (uint32_t)(pxCurrentTCB->pxTopOfStack - pxCurrentTCB->pxStack))
+#define traceTASK_SWITCHED_IN()             \
+  RtosTraceEvent(SJ2_TRACE_TASK_SWITCH_IN,  \
+                 pxCurrentTCB->uxTCBNumber, \
+                 pxCurrentTCB->uxPriority)
+// Ports that need these two hooks themselves, such as the linux one, call the
+// SJ2_ versions from their own.
+#define SJ2_TRACE_TASK_CREATE_HOOK(pxNewTCB)   \
+  RtosTraceTaskCreate((pxNewTCB)->uxTCBNumber, \
+                      (pxNewTCB)->uxPriority,  \
+                      (pxNewTCB)->pcTaskName)
+#define SJ2_TRACE_TASK_DELETE_HOOK(pxTCB) \
+  RtosTraceEvent(SJ2_TRACE_TASK_DELETE, (pxTCB)->uxTCBNumber, 0)
+#define traceTASK_CREATE(pxNewTCB) SJ2_TRACE_TASK_CREATE_HOOK(pxNewTCB)
+#define traceTASK_DELETE(pxTCB) SJ2_TRACE_TASK_DELETE_HOOK(pxTCB)
+#define traceTASK_PRIORITY_INHERIT(pxTCB, uxPriority) \
+  RtosTraceEvent(SJ2_TRACE_PRIORITY_INHERIT, (pxTCB)->uxTCBNumber, (uxPriority))
+#define traceTASK_PRIORITY_DISINHERIT(pxTCB, uxPriority) \
+  RtosTraceEvent(                                        \
+      SJ2_TRACE_PRIORITY_DISINHERIT, (pxTCB)->uxTCBNumber, (uxPriority))
+
+// Queues are numbered as they are created, as FreeRTOS leaves that to tracers.
+#define traceQUEUE_CREATE(pxNewQueue) \
+  (pxNewQueue)->uxQueueNumber = RtosTraceQueueCreate((pxNewQueue)->ucQueueType)
+#define SJ2_TRACE_QUEUE(type, pxQueue) \
+  RtosTraceEvent(                      \
+      (type), (pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND(pxQueue) SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_SEND, pxQueue)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_SEND, pxQueue)
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_SEND_FAILED, pxQueue)
+#define traceQUEUE_SEND_FROM_ISR_FAILED(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_SEND_FAILED, pxQueue)
+#define traceQUEUE_RECEIVE(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_RECEIVE, pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_RECEIVE, pxQueue)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_RECEIVE_FAILED, pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_RECEIVE_FAILED, pxQueue)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_BLOCK_ON_SEND, pxQueue)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+  SJ2_TRACE_QUEUE(SJ2_TRACE_QUEUE_BLOCK_ON_RECEIVE, pxQueue)
@@ -161,10 +161,18 @@ extern void vPortExitCritical( void );
 #define portOUTPUT_BYTE( a, b )
 
 extern void vPortForciblyEndThread( void *pxTaskToDelete );
-#define traceTASK_DELETE( pxTaskToDelete )		vPortForciblyEndThread( pxTaskToDelete )
-
 extern void vPortAddTaskHandle( void *pxTaskHandle );
+
+#ifdef SJ2_TRACE_TASK_CREATE_HOOK
+/* Keep the RTOS trace hooks from trace_hooks.h as well as the port's own. */
+#undef traceTASK_DELETE
+#undef traceTASK_CREATE
+#define traceTASK_DELETE( pxTaskToDelete )		do { SJ2_TRACE_TASK_DELETE_HOOK( pxTaskToDelete ); vPortForciblyEndThread( pxTaskToDelete ); } while( 0 )
+#define traceTASK_CREATE( pxNewTCB )			do { SJ2_TRACE_TASK_CREATE_HOOK( pxNewTCB ); vPortAddTaskHandle( pxNewTCB ); } while( 0 )
+#else
+#define traceTASK_DELETE( pxTaskToDelete )		vPortForciblyEndThread( pxTaskToDelete )
 #define traceTASK_CREATE( pxNewTCB )			vPortAddTaskHandle( pxNewTCB )
+#endif
 
 /* Posix Signal definitions that can be changed or read as appropriate. */
 #define SIG_SUSPEND					SIGUSR1
@@ -26,12 +26,6 @@ extern "C" int _write(int, const char * ptr, int length)  // NOLINT
 {
   return LinuxStdOut(std::span<const char>(ptr, length));
 }
-
-std::chrono::nanoseconds LinuxUptime()
-{
-  return std::chrono::duration_cast<std::chrono::nanoseconds>(
-      std::chrono::steady_clock::now().time_since_epoch());
-}
 }  // namespace
 
 extern "C"
@@ -40,8 +34,10 @@ extern "C"
   int StackTop;  // NOLINT
   uint32_t ThreadRuntimeCounter()
   {
+    // FreeRTOS keeps run time in 32 bits, which wraps after 71 minutes of
+    // microseconds rather than 4.3 seconds of nanoseconds.
     return static_cast<uint32_t>(
-        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
             std::chrono::steady_clock::now().time_since_epoch())
             .count());
   }
@@ -61,7 +57,6 @@ class InitializePlatformLinux
     sjsu::SystemController::SetPlatformController(&system_controller);
     sjsu::newlib::SetStdout(LinuxStdOut);
     sjsu::newlib::SetStdin(LinuxStdIn);
-    sjsu::SetUptimeFunction(LinuxUptime);
   }
 };
 
@@ -71,7 +71,9 @@ int Lpc17xxStdIn(std::span<char> data)
 
 extern "C" uint32_t ThreadRuntimeCounter()
 {
-  return arm_dwt_counter.GetCount();
+  // FreeRTOS keeps run time in 32 bits. Counting every 64th cycle of the
+  // extended count makes it wrap after tens of minutes instead of seconds.
+  return static_cast<uint32_t>(arm_dwt_counter.GetCount64() >> 6);
 }
 
 // The entry point for the C++ library startup
@@ -166,6 +168,11 @@ const sjsu::InterruptVectorAddress kInterruptVectorTable[] = {
 
 namespace sjsu
 {
+std::chrono::nanoseconds SystemUptime()
+{
+  return sjsu::cortex::SystemTimer::GetCount();
+}
+
 SJ2_WEAK(void InitializePlatform());
 void InitializePlatform()
 {
@@ -187,6 +194,5 @@ void InitializePlatform()
   system_timer.Initialize();
 
   arm_dwt_counter.Initialize();
-  sjsu::SetUptimeFunction(sjsu::cortex::SystemTimer::GetCount);
 }
 }  // namespace sjsu
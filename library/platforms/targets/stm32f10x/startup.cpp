@@ -47,7 +47,9 @@ sjsu::cortex::InterruptController<sjsu::lpc40xx::kNumberOfIrqs,
 
 extern "C" uint32_t ThreadRuntimeCounter()
 {
-  return arm_dwt_counter.GetCount();
+  // FreeRTOS keeps run time in 32 bits. Counting every 64th cycle of the
+  // extended count makes it wrap after tens of minutes instead of seconds.
+  return static_cast<uint32_t>(arm_dwt_counter.GetCount64() >> 6);
 }
 
 // The entry point for the C++ library startup
@@ -175,6 +177,11 @@ const sjsu::InterruptVectorAddress kInterruptVectorTable[] = {
 
 namespace sjsu
 {
+std::chrono::nanoseconds SystemUptime()
+{
+  return sjsu::cortex::SystemTimer::GetCount();
+}
+
 SJ2_WEAK(void InitializePlatform());
 void InitializePlatform()
 {
@@ -193,7 +200,6 @@ void InitializePlatform()
   system_timer.Initialize();
 
   arm_dwt_counter.Initialize();
-  sjsu::SetUptimeFunction(sjsu::cortex::SystemTimer::GetCount);
 
   // The GPIO pins PB3, PB4, and PA15 are default initalized to be used for
   // JTAG purposes. They are not needed for SWD and are commonly used for other
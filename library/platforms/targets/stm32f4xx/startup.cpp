@@ -39,7 +39,9 @@ sjsu::cortex::InterruptController<sjsu::lpc40xx::kNumberOfIrqs,
 
 extern "C" uint32_t ThreadRuntimeCounter()
 {
-  return arm_dwt_counter.GetCount();
+  // FreeRTOS keeps run time in 32 bits. Counting every 64th cycle of the
+  // extended count makes it wrap after tens of minutes instead of seconds.
+  return static_cast<uint32_t>(arm_dwt_counter.GetCount64() >> 6);
 }
 
 // The entry point for the C++ library startup
@@ -186,6 +188,11 @@ const sjsu::InterruptVectorAddress kInterruptVectorTable[] = {
 
 namespace sjsu
 {
+std::chrono::nanoseconds SystemUptime()
+{
+  return sjsu::cortex::SystemTimer::GetCount();
+}
+
 SJ2_WEAK(void InitializePlatform());
 void InitializePlatform()
 {
@@ -204,6 +211,5 @@ void InitializePlatform()
   system_timer.Initialize();
 
   arm_dwt_counter.Initialize();
-  sjsu::SetUptimeFunction(sjsu::cortex::SystemTimer::GetCount);
 }
 }  // namespace sjsu
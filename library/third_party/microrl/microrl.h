@@ -5,8 +5,10 @@
 
 #pragma GCC system_header
 
+#ifndef __cplusplus
 #define true  1
 #define false 0
+#endif
 
  /* define the Key codes */
 #define KEY_NUL 0 /**< ^@ Null character */
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include "peripherals/can.hpp"
+#include "utility/console/console.hpp"
+#include "utility/enum.hpp"
+#include "utility/log.hpp"
+
+namespace sjsu
+{
+/// Displays the traffic, queueing latency and error statistics of a CAN
+/// peripheral.
+class CanCommand final : public Command
+{
+ public:
+  /// An enumeration that specifies the locations of each command argument in
+  /// the command line.
+  enum Args
+  {
+    kName      = 0,
+    kOperation = 1,
+  };
+
+  /// CAN usage description and details.
+  static constexpr char kDescription[] = R"(Display CAN bus statistics.
+                can stats
+                can reset
+  )";
+
+  /// Set of CAN command operations
+  static inline const char * const kCanOperations[] = { "stats",
+                                                        "reset",
+                                                        nullptr };
+
+  /// Names of each Can::BusError, in the order of the enumeration
+  static constexpr const char * kBusErrorNames[] = {
+    "bit", "stuff", "form", "crc", "acknowledge", "other",
+  };
+
+  static_assert(std::size(kBusErrorNames) ==
+                    Value(Can::BusError::kNumberOfErrors),
+                "Every bus error needs a name.");
+
+  /// @param can - CAN peripheral to report on.
+  explicit constexpr CanCommand(Can & can)
+      : Command("can", kDescription), can_(can)
+  {
+  }
+
+  int AutoComplete(int argc,
+                   const char * const argv[],
+                   const char * completion[],
+                   size_t completion_length) override
+  {
+    size_t position = 0;
+    if (argc - 1 == Args::kOperation)
+    {
+      for (const char * operation : kCanOperations)
+      {
+        if (operation != nullptr && position < completion_length &&
+            std::strstr(operation, argv[Args::kOperation]) == operation)
+        {
+          completion[position++] = operation;
+        }
+      }
+    }
+    return static_cast<int>(position);
+  }
+
+  int Program(int argc, const char * const argv[]) override
+  {
+    if (argc - 1 < Args::kOperation ||
+        strcmp(argv[Args::kOperation], kCanOperations[0]) == 0)
+    {
+      PrintStatistics();
+      return 0;
+    }
+
+    if (strcmp(argv[Args::kOperation], kCanOperations[1]) == 0)
+    {
+      can_.ResetBusStatistics();
+      return 0;
+    }
+
+    sjsu::LogError("Invalid operation %s", argv[Args::kOperation]);
+    return 1;
+  }
+
+ private:
+  void PrintStatistics()
+  {
+    using BusStatistics_t = Can::BusStatistics_t;
+
+    const auto kStatistics = can_.GetBusStatistics();
+
+    printf("Elapsed: %" PRIu32 " ms\n",
+           static_cast<uint32_t>(kStatistics.elapsed_time / 1ms));
+    printf("TX: %" PRIu32 " frames, %.1f frames/s, %.0f bits/s\n",
+           kStatistics.transmitted_frames,
+           static_cast<double>(
+               kStatistics.PerSecond(kStatistics.transmitted_frames)),
+           static_cast<double>(
+               kStatistics.PerSecond(kStatistics.transmitted_bits)));
+    printf("RX: %" PRIu32 " frames, %.1f frames/s, %.0f bits/s\n",
+           kStatistics.received_frames,
+           static_cast<double>(
+               kStatistics.PerSecond(kStatistics.received_frames)),
+           static_cast<double>(
+               kStatistics.PerSecond(kStatistics.received_bits)));
+    printf("Bus load: %.1f%%\n",
+           static_cast<double>(
+               kStatistics.BusLoad(can_.CurrentSettings().baud_rate)));
+    printf("RX overruns: %" PRIu32 "\n", kStatistics.receive_overruns);
+
+    puts("TX queue latency:");
+    constexpr size_t kLastBucket = BusStatistics_t::kLatencyBuckets - 1;
+    for (size_t i = 0; i < kLastBucket; i++)
+    {
+      printf("  < %5" PRIu32 " us : %" PRIu32 "\n",
+             uint32_t{ 1 } << i,
+             kStatistics.transmit_latency[i]);
+    }
+    printf(" >= %5" PRIu32 " us : %" PRIu32 "\n",
+           uint32_t{ 1 } << (kLastBucket - 1),
+           kStatistics.transmit_latency[kLastBucket]);
+
+    puts("Bus errors:");
+    for (size_t i = 0; i < std::size(kBusErrorNames); i++)
+    {
+      printf("  %-11s : %" PRIu32 "\n",
+             kBusErrorNames[i],
+             kStatistics.bus_errors[i]);
+    }
+    printf("TEC: %u  REC: %u  %s\n",
+           kStatistics.transmit_error_count,
+           kStatistics.receive_error_count,
+           ErrorStateToString(kStatistics));
+  }
+
+  static const char * ErrorStateToString(
+      const Can::BusStatistics_t & statistics)
+  {
+    if (statistics.bus_off)
+    {
+      return "BUS OFF";
+    }
+    if (statistics.error_passive)
+    {
+      return "ERROR PASSIVE";
+    }
+    if (statistics.error_warning)
+    {
+      return "ERROR WARNING";
+    }
+    return "ERROR ACTIVE";
+  }
+
+  Can & can_;
+};
+}  // namespace sjsu
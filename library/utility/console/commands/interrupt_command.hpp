@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <span>
+
+#include "peripherals/cortex/interrupt_profiler.hpp"
+#include "utility/console/console.hpp"
+#include "utility/log.hpp"
+
+namespace sjsu
+{
+/// Displays the time spent in each interrupt handler and the period between
+/// its entries, as recorded by a cortex::InterruptProfiler.
+class InterruptCommand final : public Command
+{
+ public:
+  /// An enumeration that specifies the locations of each command argument in
+  /// the command line.
+  enum Args
+  {
+    kName      = 0,
+    kOperation = 1,
+  };
+
+  /// Interrupt command usage description and details.
+  static constexpr char kDescription[] = R"(Display interrupt handler timing.
+                irq stats
+                irq reset
+                irq dump - write the statistics to stdout in binary
+  )";
+
+  /// Set of interrupt command operations
+  static inline const char * const kIrqOperations[] = { "stats",
+                                                        "reset",
+                                                        "dump",
+                                                        nullptr };
+
+  /// @param profiler - profiler to report on, usually
+  ///        cortex::InterruptProfiler::GetPlatformProfiler().
+  /// @param cycles_per_second - rate of the DWT cycle counter, which is the
+  ///        CPU clock rate.
+  constexpr InterruptCommand(cortex::InterruptProfiler & profiler,
+                             uint32_t cycles_per_second)
+      : Command("irq", kDescription),
+        profiler_(profiler),
+        cycles_per_second_(cycles_per_second)
+  {
+  }
+
+  int AutoComplete(int argc,
+                   const char * const argv[],
+                   const char * completion[],
+                   size_t completion_length) override
+  {
+    size_t position = 0;
+    if (argc - 1 == Args::kOperation)
+    {
+      for (const char * operation : kIrqOperations)
+      {
+        if (operation != nullptr && position < completion_length &&
+            std::strstr(operation, argv[Args::kOperation]) == operation)
+        {
+          completion[position++] = operation;
+        }
+      }
+    }
+    return static_cast<int>(position);
+  }
+
+  int Program(int argc, const char * const argv[]) override
+  {
+    if (argc - 1 < Args::kOperation ||
+        strcmp(argv[Args::kOperation], kIrqOperations[0]) == 0)
+    {
+      PrintStatistics();
+      return 0;
+    }
+
+    if (strcmp(argv[Args::kOperation], kIrqOperations[1]) == 0)
+    {
+      profiler_.Reset();
+      return 0;
+    }
+
+    if (strcmp(argv[Args::kOperation], kIrqOperations[2]) == 0)
+    {
+      profiler_.Dump([](std::span<const uint8_t> bytes) {
+        fwrite(bytes.data(), 1, bytes.size(), stdout);
+      });
+      fflush(stdout);
+      return 0;
+    }
+
+    sjsu::LogError("Invalid operation %s", argv[Args::kOperation]);
+    return 1;
+  }
+
+ private:
+  void PrintStatistics()
+  {
+    puts(" IRQ |  count | nested |  min us |  avg us |  max us | period us");
+    const auto kStatistics = profiler_.GetStatistics();
+    for (size_t index = 0; index < kStatistics.size(); index++)
+    {
+      const cortex::InterruptStatistics_t & statistics = kStatistics[index];
+      if (statistics.count == 0)
+      {
+        continue;
+      }
+
+      printf("%4d | %6" PRIu32 " | %6" PRIu32
+             " | %7.2f | %7.2f | %7.2f | ",
+             profiler_.IndexToIrq(index),
+             statistics.count,
+             statistics.preemptions,
+             Microseconds(statistics.minimum_cycles),
+             Microseconds(statistics.AverageCycles()),
+             Microseconds(statistics.maximum_cycles));
+
+      if (statistics.count > 1)
+      {
+        printf("%.1f - %.1f\n",
+               Microseconds(statistics.minimum_period),
+               Microseconds(statistics.maximum_period));
+      }
+      else
+      {
+        puts("-");
+      }
+    }
+    printf("Deepest nesting: %" PRIu32 "\n", profiler_.GetMaximumDepth());
+  }
+
+  double Microseconds(uint32_t cycles) const
+  {
+    return static_cast<double>(cycles) * 1e6 /
+           static_cast<double>(cycles_per_second_);
+  }
+
+  cortex::InterruptProfiler & profiler_;
+  uint32_t cycles_per_second_;
+};
+}  // namespace sjsu
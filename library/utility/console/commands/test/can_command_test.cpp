@@ -0,0 +1,65 @@
+#include "peripherals/linux/virtual_can.hpp"
+#include "testing/testing_frameworks.hpp"
+#include "utility/console/commands/can_command.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing CAN Command")
+{
+  VirtualCanBus bus(500_kHz);
+  VirtualCan node_a(bus);
+  VirtualCan node_b(bus);
+  node_a.Initialize();
+  node_b.Initialize();
+
+  node_a.Send(0x100, { 1, 2, 3 });
+  node_b.Send(0x200, { 4 });
+  bus.Run(1ms);
+
+  CanCommand command(node_a);
+
+  SECTION("Statistics")
+  {
+    // Setup
+    const char * const kArguments[] = { "can", "stats" };
+
+    // Exercise + Verify
+    CHECK(0 == command.Program(1, kArguments));
+    CHECK(0 == command.Program(2, kArguments));
+    CHECK(1 == node_a.GetBusStatistics().transmitted_frames);
+    CHECK(1 == node_a.GetBusStatistics().received_frames);
+  }
+
+  SECTION("Reset")
+  {
+    // Setup
+    const char * const kArguments[] = { "can", "reset" };
+
+    // Exercise
+    CHECK(0 == command.Program(2, kArguments));
+
+    // Verify
+    auto statistics = node_a.GetBusStatistics();
+    CHECK(0 == statistics.transmitted_frames);
+    CHECK(0 == statistics.received_frames);
+    CHECK(0ns == statistics.elapsed_time);
+  }
+
+  SECTION("Invalid operation")
+  {
+    const char * const kArguments[] = { "can", "explode" };
+    CHECK(1 == command.Program(2, kArguments));
+  }
+
+  SECTION("AutoComplete()")
+  {
+    // Setup
+    const char * const kArguments[] = { "can", "re" };
+    const char * completion[4]      = {};
+
+    // Exercise + Verify
+    CHECK(1 == command.AutoComplete(2, kArguments, completion, 4));
+    CHECK(std::string_view("reset") == completion[0]);
+  }
+}
+}  // namespace sjsu
@@ -0,0 +1,67 @@
+#include "testing/testing_frameworks.hpp"
+#include "utility/console/commands/interrupt_command.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing Interrupt Command")
+{
+  cortex::DWT_Type * const kOriginalDwt = cortex::InterruptProfiler::dwt;
+  cortex::DWT_Type local_dwt{};
+  cortex::InterruptProfiler::dwt = &local_dwt;
+
+  std::array<cortex::InterruptStatistics_t, 8> statistics;
+  cortex::InterruptProfiler profiler(statistics, -2);
+
+  for (uint32_t entry : { 0, 1000, 2100 })
+  {
+    local_dwt.CYCCNT = entry;
+    auto frame       = profiler.Enter(5);
+    local_dwt.CYCCNT = entry + 48;
+    profiler.Exit(5, frame);
+  }
+
+  InterruptCommand command(profiler, 48'000'000);
+
+  SECTION("Statistics")
+  {
+    // Setup
+    const char * const kArguments[] = { "irq", "stats" };
+
+    // Exercise + Verify
+    CHECK(0 == command.Program(1, kArguments));
+    CHECK(0 == command.Program(2, kArguments));
+    CHECK(3 == statistics[5].count);
+  }
+
+  SECTION("Reset")
+  {
+    // Setup
+    const char * const kArguments[] = { "irq", "reset" };
+
+    // Exercise
+    CHECK(0 == command.Program(2, kArguments));
+
+    // Verify
+    CHECK(0 == statistics[5].count);
+  }
+
+  SECTION("Invalid operation")
+  {
+    const char * const kArguments[] = { "irq", "explode" };
+    CHECK(1 == command.Program(2, kArguments));
+  }
+
+  SECTION("AutoComplete()")
+  {
+    // Setup
+    const char * const kArguments[] = { "irq", "d" };
+    const char * completion[4]      = {};
+
+    // Exercise + Verify
+    CHECK(1 == command.AutoComplete(2, kArguments, completion, 4));
+    CHECK(std::string("dump") == completion[0]);
+  }
+
+  cortex::InterruptProfiler::dwt = kOriginalDwt;
+}
+}  // namespace sjsu
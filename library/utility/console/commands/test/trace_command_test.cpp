@@ -0,0 +1,95 @@
+#include <vector>
+
+#include "testing/testing_frameworks.hpp"
+#include "utility/console/commands/trace_command.hpp"
+
+namespace sjsu
+{
+namespace
+{
+std::vector<uint8_t> dumped;  // NOLINT
+}  // namespace
+
+TEST_CASE("Testing Trace Command")
+{
+  std::chrono::nanoseconds now = 0ns;
+  SetUptimeFunction([&now]() { return now; });
+
+  std::array<rtos::TraceEvent_t, 16> events;
+  std::array<rtos::TraceTask_t, 4> tasks;
+  rtos::TraceRecorder recorder(events, tasks);
+  recorder.RegisterTask(1, 1, "Worker");
+  recorder.RegisterTask(2, 0, "Idle");
+
+  dumped.clear();
+  TraceCommand command(recorder, [](std::span<const uint8_t> bytes) {
+    dumped.insert(dumped.end(), bytes.begin(), bytes.end());
+  });
+
+  SECTION("Start and stop")
+  {
+    // Setup
+    const char * const kStart[] = { "trace", "start" };
+    const char * const kStop[]  = { "trace", "stop" };
+
+    // Exercise + Verify
+    CHECK(0 == command.Program(2, kStart));
+    CHECK(recorder.IsRecording());
+    CHECK(0 == command.Program(2, kStop));
+    CHECK(!recorder.IsRecording());
+  }
+
+  SECTION("Statistics")
+  {
+    // Setup
+    const char * const kArguments[] = { "trace", "stats" };
+    recorder.Start();
+    for (uint32_t task : { 1, 2, 1, 2 })
+    {
+      recorder.Record(rtos::TraceEvent::kTaskSwitchIn, task, 1);
+      now += 100us;
+      recorder.Record(rtos::TraceEvent::kTaskSwitchOut, task, 60 + task);
+    }
+
+    // Exercise + Verify
+    CHECK(0 == command.Program(1, kArguments));
+    CHECK(0 == command.Program(2, kArguments));
+  }
+
+  SECTION("Dump stops recording")
+  {
+    // Setup
+    const char * const kArguments[] = { "trace", "dump" };
+    recorder.Start();
+
+    // Exercise + Verify
+    CHECK(0 == command.Program(2, kArguments));
+    CHECK(!recorder.IsRecording());
+    CHECK(rtos::TraceRecorder::kDumpHeaderSize +
+              2 * rtos::TraceRecorder::kDumpTaskSize ==
+          dumped.size());
+    CHECK('R' == dumped[0]);
+  }
+
+  SECTION("Invalid operation")
+  {
+    const char * const kArguments[] = { "trace", "explode" };
+    CHECK(1 == command.Program(2, kArguments));
+  }
+
+  SECTION("AutoComplete()")
+  {
+    // Setup
+    const char * const kArguments[] = { "trace", "st" };
+    const char * completion[4]      = {};
+
+    // Exercise + Verify
+    CHECK(3 == command.AutoComplete(2, kArguments, completion, 4));
+    CHECK(std::string("start") == completion[0]);
+    CHECK(std::string("stop") == completion[1]);
+    CHECK(std::string("stats") == completion[2]);
+  }
+
+  SetUptimeFunction(nullptr);
+}
+}  // namespace sjsu
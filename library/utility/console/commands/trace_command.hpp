@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <span>
+
+#include "utility/console/console.hpp"
+#include "utility/log.hpp"
+#include "utility/rtos/freertos/trace_recorder.hpp"
+
+namespace sjsu
+{
+/// Controls an rtos::TraceRecorder and exports what it recorded.
+class TraceCommand final : public Command
+{
+ public:
+  /// An enumeration that specifies the locations of each command argument in
+  /// the command line.
+  enum Args
+  {
+    kName      = 0,
+    kOperation = 1,
+  };
+
+  /// Trace command usage description and details.
+  static constexpr char kDescription[] = R"(Record RTOS and interrupt events.
+                trace start - clear the buffer and start recording
+                trace stop
+                trace stats - CPU time and stack left of each task
+                trace dump - stop and write the recording out in binary
+  )";
+
+  /// Set of trace command operations
+  static inline const char * const kTraceOperations[] = {
+    "start", "stop", "stats", "dump", nullptr
+  };
+
+  /// Receives the bytes of a dump.
+  using DumpWriter = void (*)(std::span<const uint8_t> bytes);
+
+  /// Writes a dump to stdout.
+  static void WriteToStdout(std::span<const uint8_t> bytes)
+  {
+    fwrite(bytes.data(), 1, bytes.size(), stdout);
+  }
+
+  /// @param recorder - recorder to control, usually
+  ///        rtos::TraceRecorder::GetPlatformRecorder().
+  /// @param writer - where `trace dump` writes the recording, such as a file.
+  explicit constexpr TraceCommand(rtos::TraceRecorder & recorder,
+                                  DumpWriter writer = WriteToStdout)
+      : Command("trace", kDescription), recorder_(recorder), writer_(writer)
+  {
+  }
+
+  int AutoComplete(int argc,
+                   const char * const argv[],
+                   const char * completion[],
+                   size_t completion_length) override
+  {
+    size_t position = 0;
+    if (argc - 1 == Args::kOperation)
+    {
+      for (const char * operation : kTraceOperations)
+      {
+        if (operation != nullptr && position < completion_length &&
+            std::strstr(operation, argv[Args::kOperation]) == operation)
+        {
+          completion[position++] = operation;
+        }
+      }
+    }
+    return static_cast<int>(position);
+  }
+
+  int Program(int argc, const char * const argv[]) override
+  {
+    if (argc - 1 < Args::kOperation ||
+        strcmp(argv[Args::kOperation], kTraceOperations[2]) == 0)
+    {
+      PrintStatistics();
+      return 0;
+    }
+
+    if (strcmp(argv[Args::kOperation], kTraceOperations[0]) == 0)
+    {
+      recorder_.Start();
+      return 0;
+    }
+
+    if (strcmp(argv[Args::kOperation], kTraceOperations[1]) == 0)
+    {
+      recorder_.Stop();
+      return 0;
+    }
+
+    if (strcmp(argv[Args::kOperation], kTraceOperations[3]) == 0)
+    {
+      // Recording while dumping would overwrite the events being written with
+      // the dump's own.
+      recorder_.Stop();
+      recorder_.Dump(writer_);
+      fflush(stdout);
+      return 0;
+    }
+
+    sjsu::LogError("Invalid operation %s", argv[Args::kOperation]);
+    return 1;
+  }
+
+ private:
+  void PrintStatistics()
+  {
+    const size_t kSize = recorder_.Size();
+    printf("%s, %zu of %zu events, %" PRIu32 " overwritten\n",
+           recorder_.IsRecording() ? "Recording" : "Stopped",
+           kSize,
+           recorder_.GetCapacity(),
+           recorder_.GetOverwritten());
+    if (recorder_.GetTruncated() != 0)
+    {
+      printf("%" PRIu32 " events had an id above 255, which aliases a lower "
+             "one in the dump\n",
+             recorder_.GetTruncated());
+    }
+    if (kSize < 2)
+    {
+      return;
+    }
+
+    const uint32_t kSpan = recorder_.GetEvent(kSize - 1).timestamp -
+                           recorder_.GetEvent(0).timestamp;
+
+    puts("      Task       | Prio | Runs |  CPU us | CPU% | Min Stack Left");
+    for (const rtos::TraceTask_t & task : recorder_.GetTasks())
+    {
+      if (task.number == 0)
+      {
+        continue;
+      }
+
+      uint32_t runs        = 0;
+      uint32_t cpu_time    = 0;
+      uint32_t stack_left  = UINT32_MAX;
+      uint32_t switched_in = 0;
+      bool running         = false;
+      for (size_t i = 0; i < kSize; i++)
+      {
+        const rtos::TraceEvent_t & event = recorder_.GetEvent(i);
+        if (event.id != task.number)
+        {
+          continue;
+        }
+        if (event.type == rtos::TraceEvent::kTaskSwitchIn)
+        {
+          runs++;
+          switched_in = event.timestamp;
+          running     = true;
+        }
+        else if (event.type == rtos::TraceEvent::kTaskSwitchOut)
+        {
+          if (running)
+          {
+            cpu_time += event.timestamp - switched_in;
+          }
+          stack_left = std::min<uint32_t>(stack_left, event.argument);
+          running    = false;
+        }
+      }
+
+      const uint64_t kPercent = (kSpan == 0) ? 0 : cpu_time * 100ULL / kSpan;
+      printf("%-16s | %4u | %4" PRIu32 " | %7" PRIu32 " | %3" PRIu32 "%% | ",
+             task.name.data(),
+             task.priority,
+             runs,
+             cpu_time,
+             static_cast<uint32_t>(kPercent));
+      if (stack_left == UINT32_MAX)
+      {
+        puts("-");
+      }
+      else
+      {
+        printf("%" PRIu32 " words\n", stack_left);
+      }
+    }
+  }
+
+  rtos::TraceRecorder & recorder_;
+  DumpWriter writer_;
+};
+}  // namespace sjsu
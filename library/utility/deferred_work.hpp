@@ -0,0 +1,345 @@
+// Usage:
+//
+//    sjsu::DeferredWork deferred_work;
+//
+//    // The handler runs in the thread or interrupt that serves the queue.
+//    sjsu::DeferredWork::Source_t button(
+//        deferred_work, "button", [](uint32_t) { LogInfo("Pressed!"); });
+//    gpio.AttachInterrupt(button.ToInterruptHandler(), Gpio::Edge::kRising);
+//
+//    // With FreeRTOS, serve the queue from a high priority task
+//    xTaskCreate(sjsu::DeferredWork::Task,
+//                "Deferred",
+//                sjsu::rtos::StackSize(512),
+//                &deferred_work,
+//                sjsu::rtos::Priority::kCritical,
+//                sjsu::rtos::kNoHandle);
+//
+//    // Or, on bare metal, from a low priority interrupt that nothing else uses
+//    deferred_work.AttachInterrupt(sjsu::lpc40xx::EEPROM_IRQn, 7);
+//
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "config.hpp"
+#include "peripherals/interrupt.hpp"
+#include "utility/lock_free_queue.hpp"
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+/// Moves work out of interrupt handlers. A handler posts a small work item, a
+/// source and a 32-bit payload, to a MpscQueue and returns. The queue is
+/// drained in batches by a thread, see Serve(), or by a low priority interrupt
+/// triggered in software, see AttachInterrupt(), where the source's handler
+/// runs without delaying other interrupts.
+///
+/// Post() never blocks and can be called from any interrupt, at any priority,
+/// and from threads. The queue holds config::kDeferredWorkQueueSize items;
+/// posting to a full queue drops the item and counts it in the source's
+/// statistics.
+class DeferredWork
+{
+ public:
+  /// Number of items the queue holds.
+  static constexpr size_t kCapacity = config::kDeferredWorkQueueSize;
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                "SJ2_DEFERRED_WORK_QUEUE_SIZE must be a power of two.");
+
+  /// Number of items drained before the serving thread or interrupt checks
+  /// for anything of higher priority.
+  static constexpr size_t kDefaultBatchSize = 8;
+
+  /// Counters for the items of one source.
+  struct Statistics_t
+  {
+    /// Number of items posted to the queue.
+    uint32_t posted = 0;
+    /// Number of items dropped because the queue was full.
+    uint32_t dropped = 0;
+    /// Number of items whose handler has run.
+    uint32_t completed = 0;
+    /// Number of items in the queue right now.
+    uint32_t pending = 0;
+    /// Most items in the queue at once.
+    uint32_t maximum_pending = 0;
+    /// Longest time from Post() to the start of the handler.
+    std::chrono::microseconds maximum_latency = 0us;
+    /// Sum of the times from Post() to the start of the handler.
+    std::chrono::microseconds total_latency = 0us;
+
+    /// @return average time from Post() to the start of the handler.
+    std::chrono::microseconds AverageLatency() const
+    {
+      return (completed == 0) ? 0us : total_latency / completed;
+    }
+  };
+
+  /// A producer of deferred work, usually one per driver or interrupt. Must
+  /// outlive every item it posts.
+  class Source_t
+  {
+   public:
+    /// Called with the payload of each item, in the thread that runs Serve()
+    /// or in the interrupt given to AttachInterrupt(). Like an interrupt
+    /// handler, it can capture at most two pointers or references.
+    using Handler = BasicInterruptDelegate<uint32_t>;
+
+    /// @param queue - queue the items are posted to.
+    /// @param name - name of the source, for reporting statistics.
+    /// @param handler - runs the deferred work.
+    Source_t(DeferredWork & queue, const char * name, Handler handler)
+        : queue_(queue), name_(name), handler_(handler)
+    {
+    }
+
+    Source_t(const Source_t &) = delete;
+    Source_t & operator=(const Source_t &) = delete;
+
+    /// Queue the handler to run with the payload.
+    ///
+    /// @param payload - passed to the handler.
+    /// @return false if the queue was full and the item was dropped.
+    bool Post(uint32_t payload = 0)
+    {
+      return queue_.Post(*this, payload);
+    }
+
+    /// @return an interrupt handler that calls Post(). Lets drivers that take
+    ///         a callback, such as Gpio::AttachInterrupt() or Timer, run it
+    ///         outside of their interrupt.
+    InterruptHandler ToInterruptHandler()
+    {
+      return [this]() { Post(); };
+    }
+
+    /// @return name of the source.
+    const char * GetName() const
+    {
+      return name_;
+    }
+
+    /// @return a snapshot of the source's counters.
+    Statistics_t GetStatistics() const
+    {
+      return {
+        .posted          = posted_.load(std::memory_order_relaxed),
+        .dropped         = dropped_.load(std::memory_order_relaxed),
+        .completed       = completed_,
+        .pending         = pending_.load(std::memory_order_relaxed),
+        .maximum_pending = maximum_pending_.load(std::memory_order_relaxed),
+        .maximum_latency = maximum_latency_,
+        .total_latency   = total_latency_,
+      };
+    }
+
+    /// Clear the counters, except for the number of pending items.
+    void ResetStatistics()
+    {
+      posted_          = 0;
+      dropped_         = 0;
+      completed_       = 0;
+      maximum_pending_ = pending_.load(std::memory_order_relaxed);
+      maximum_latency_ = 0us;
+      total_latency_   = 0us;
+    }
+
+   private:
+    friend class DeferredWork;
+
+    DeferredWork & queue_;
+    const char * name_;
+    Handler handler_;
+
+    // Updated by the producers
+    std::atomic<uint32_t> posted_          = 0;
+    std::atomic<uint32_t> dropped_         = 0;
+    std::atomic<uint32_t> pending_         = 0;
+    std::atomic<uint32_t> maximum_pending_ = 0;
+
+    // Updated by the consumer
+    uint32_t completed_                        = 0;
+    std::chrono::microseconds maximum_latency_ = 0us;
+    std::chrono::microseconds total_latency_   = 0us;
+  };
+
+  /// Entry point for a FreeRTOS task that serves the queue, see Serve().
+  ///
+  /// @param deferred_work - pointer to the DeferredWork to serve.
+  [[noreturn]] static void Task(void * deferred_work)
+  {
+    static_cast<DeferredWork *>(deferred_work)->Serve();
+  }
+
+  DeferredWork() = default;
+  DeferredWork(const DeferredWork &) = delete;
+  DeferredWork & operator=(const DeferredWork &) = delete;
+
+  /// Queue a work item. Prefer Source_t::Post().
+  ///
+  /// @param source - source whose handler runs the item.
+  /// @param payload - passed to the handler.
+  /// @return false if the queue was full and the item was dropped.
+  bool Post(Source_t & source, uint32_t payload)
+  {
+    source.posted_.fetch_add(1, std::memory_order_relaxed);
+
+    // Counted before the item is published, so the consumer never takes it
+    // off the count first.
+    const uint32_t kPending =
+        source.pending_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!queue_.Push({
+            .source  = &source,
+            .payload = payload,
+            .posted  = Timestamp(),
+        }))
+    {
+      source.pending_.fetch_sub(1, std::memory_order_relaxed);
+      source.dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    uint32_t maximum = source.maximum_pending_.load(std::memory_order_relaxed);
+    while (kPending > maximum &&
+           !source.maximum_pending_.compare_exchange_weak(
+               maximum, kPending, std::memory_order_relaxed))
+    {
+      continue;
+    }
+
+    Wake();
+    return true;
+  }
+
+  /// Run the handlers of up to `limit` queued items, oldest first. Called by
+  /// Serve() and by the attached interrupt; call it directly to serve the
+  /// queue from a loop of your own. Must not be called from two places at
+  /// once.
+  ///
+  /// @param limit - most items to run.
+  /// @return number of items run.
+  size_t Drain(size_t limit = kDefaultBatchSize)
+  {
+    size_t count = 0;
+    Item_t item;
+    // Stops early if the queue is empty, or the next item is still being
+    // written by a producer that was interrupted.
+    for (; count < limit && queue_.Pop(item); count++)
+    {
+      Source_t & source = *item.source;
+      source.pending_.fetch_sub(1, std::memory_order_relaxed);
+
+      const std::chrono::microseconds kLatency(Timestamp() - item.posted);
+      source.maximum_latency_ = std::max(source.maximum_latency_, kLatency);
+      source.total_latency_ += kLatency;
+
+      source.handler_(item.payload);
+      source.completed_++;
+    }
+    return count;
+  }
+
+  /// Serve the queue from the calling thread forever, sleeping while it is
+  /// empty. The thread should have a high priority and should not use its
+  /// task notification for anything else. Without a running scheduler, this
+  /// polls the queue.
+  ///
+  /// @param batch_size - items to run between checks for higher priority
+  ///        threads.
+  [[noreturn]] void Serve(size_t batch_size = kDefaultBatchSize)
+  {
+    constexpr auto kIdleSleep = 1s;
+    thread_.store(SleepableThread(), std::memory_order_release);
+    while (true)
+    {
+      if (Drain(batch_size) == 0)
+      {
+        // Returns as soon as Post() signals the thread. A signal sent after
+        // the queue was found empty is kept, so it is never missed.
+        SleepThread(kIdleSleep, true);
+      }
+    }
+  }
+
+  /// Serve the queue from an interrupt triggered in software after each
+  /// Post(). Use the interrupt of a peripheral the application does not use,
+  /// at a priority below the interrupts that post work. The platform's
+  /// interrupt controller must support InterruptController::Trigger().
+  ///
+  /// @param interrupt_request_number - interrupt to serve the queue from.
+  /// @param priority - priority of the interrupt.
+  /// @param batch_size - items to run each time the interrupt fires. Anything
+  ///        left triggers the interrupt again, so pending interrupts of the
+  ///        same priority get to run in between.
+  void AttachInterrupt(int interrupt_request_number,
+                       int priority      = -1,
+                       size_t batch_size = kDefaultBatchSize)
+  {
+    batch_size_ = batch_size;
+    sjsu::InterruptController::GetPlatformController().Enable({
+        .interrupt_request_number = interrupt_request_number,
+        .interrupt_handler        = [this]() { ServeInterrupt(); },
+        .priority                 = priority,
+    });
+    interrupt_request_number_.store(interrupt_request_number,
+                                    std::memory_order_release);
+  }
+
+  /// @return number of items in the queue, including any being written.
+  size_t Size() const
+  {
+    return queue_.Size();
+  }
+
+ private:
+  static constexpr int kNoInterrupt = -1'000;
+
+  struct Item_t
+  {
+    Source_t * source;
+    uint32_t payload;
+    uint32_t posted;
+  };
+
+  /// @return uptime in microseconds, truncated to 32 bits. Differences are
+  ///         correct for latencies of up to an hour.
+  static uint32_t Timestamp()
+  {
+    return static_cast<uint32_t>(Uptime() / 1us);
+  }
+
+  void ServeInterrupt()
+  {
+    if (Drain(batch_size_) == batch_size_)
+    {
+      Wake();
+    }
+  }
+
+  void Wake()
+  {
+    void * thread = thread_.load(std::memory_order_acquire);
+    if (thread != nullptr)
+    {
+      SignalThread(thread);
+      return;
+    }
+
+    const int kIrq = interrupt_request_number_.load(std::memory_order_acquire);
+    if (kIrq != kNoInterrupt)
+    {
+      sjsu::InterruptController::GetPlatformController().Trigger(kIrq);
+    }
+  }
+
+  MpscQueue<Item_t, kCapacity> queue_;
+  std::atomic<void *> thread_                = nullptr;
+  std::atomic<int> interrupt_request_number_ = kNoInterrupt;
+  size_t batch_size_                         = kDefaultBatchSize;
+};
+}  // namespace sjsu
@@ -0,0 +1,462 @@
+// Usage:
+//
+//    // One interrupt feeds one task
+//    sjsu::SpscQueue<uint8_t, 256> received;
+//
+//    void UartInterrupt()
+//    {
+//      received.Push(uart_data_register);
+//    }
+//
+//    void ParserTask(void *)
+//    {
+//      std::array<uint8_t, 32> bytes;
+//      while (true)
+//      {
+//        // Sleeps until the interrupt pushes, then takes everything at once
+//        size_t count = received.Pop(bytes, std::chrono::nanoseconds::max());
+//        Parse(std::span(bytes).first(count));
+//      }
+//    }
+//
+//    // Any number of interrupts and tasks feed one task
+//    sjsu::MpscQueue<Event_t, 64> events;
+//    events.Push(event);       // From anywhere
+//    events.Pop(event, 10ms);  // From the one consumer
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+/// Lets the consumer of a lock-free queue sleep until a producer pushes, with
+/// the operating system's thread signal, which is a task notification on
+/// FreeRTOS (see SystemSignal()). Producers only signal while the consumer is
+/// waiting, so pushing to a queue that nobody waits on costs no system call.
+class QueueWaiter
+{
+ public:
+  /// Wake the consumer if it is waiting. Called by producers after publishing
+  /// items, including from interrupts.
+  void Notify()
+  {
+    // Without scheduler hooks, consumers spin and nobody needs waking.
+    if constexpr (kHasSchedulerHooks)
+    {
+      // Pairs with the fence in Wait(): either the consumer sees the items
+      // published before this, or this sees that the consumer is waiting.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      void * thread = waiting_.load(std::memory_order_relaxed);
+      if (thread != nullptr)
+      {
+        SignalThread(thread);
+      }
+    }
+  }
+
+  /// Block the calling thread until is_ready() returns true or the timeout
+  /// passes. Spins where threads cannot sleep: before the scheduler starts,
+  /// in interrupts, and on host and linux builds. Only one thread may wait at
+  /// a time.
+  ///
+  /// @param timeout - longest time to wait. nanoseconds::max() waits forever.
+  /// @param is_ready - checks whether there is anything to take.
+  /// @return the final result of is_ready().
+  template <typename Ready>
+  bool Wait(std::chrono::nanoseconds timeout, Ready is_ready)
+  {
+    if (is_ready())
+    {
+      return true;
+    }
+
+    void * thread = SleepableThread();
+    if (thread == nullptr)
+    {
+      return sjsu::Wait(timeout, is_ready);
+    }
+
+    const bool kForever  = (timeout == std::chrono::nanoseconds::max());
+    const auto kDeadline = kForever ? timeout : Uptime() + timeout;
+
+    waiting_.store(thread, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool ready = is_ready();
+    while (!ready)
+    {
+      const auto kNow = Uptime();
+      if (kNow >= kDeadline)
+      {
+        break;
+      }
+      // Returns as soon as Notify() signals the thread. A signal sent after
+      // is_ready() was checked is kept, so it is never missed. Sleeps are
+      // capped so the duration always fits in the scheduler's tick count.
+      SleepThread(std::min<std::chrono::nanoseconds>(kDeadline - kNow, 1s),
+                  true);
+      ready = is_ready();
+    }
+
+    waiting_.store(nullptr, std::memory_order_relaxed);
+    return ready;
+  }
+
+ private:
+  std::atomic<void *> waiting_ = nullptr;
+};
+
+/// Bounded lock-free queue with a single producer and a single consumer, such
+/// as an interrupt handler feeding a task. Neither side ever blocks the other
+/// or disables interrupts: each side only writes its own position, and
+/// publishes it with release ordering after copying the items.
+///
+/// Push() must only be called from one thread or interrupt at a time, and
+/// Pop() from one other. For more than one producer, see MpscQueue.
+///
+/// @tparam T - type of the items, copied in and out of the queue.
+/// @tparam kSize - number of items the queue holds. Must be a power of two.
+template <typename T, size_t kSize>
+class SpscQueue
+{
+ public:
+  /// Number of items the queue holds.
+  static constexpr size_t kCapacity = kSize;
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                "The size of a SpscQueue must be a power of two.");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                "SpscQueue needs lock-free 32-bit atomics.");
+
+  constexpr SpscQueue() = default;
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue & operator=(const SpscQueue &) = delete;
+
+  /// Add an item to the back of the queue.
+  ///
+  /// @param item - item to copy into the queue.
+  /// @return false if the queue was full and the item was not added.
+  bool Push(const T & item)
+  {
+    return Push(std::span<const T>(&item, 1)) == 1;
+  }
+
+  /// Add as many items as fit to the back of the queue, publishing them to
+  /// the consumer all at once.
+  ///
+  /// @param items - items to copy into the queue, in order.
+  /// @return number of items added, from the front of `items`.
+  size_t Push(std::span<const T> items)
+  {
+    const uint32_t kTail = tail_.load(std::memory_order_relaxed);
+    const uint32_t kHead = head_.load(std::memory_order_acquire);
+    const size_t kCount =
+        std::min<size_t>(items.size(), kCapacity - (kTail - kHead));
+    for (size_t i = 0; i < kCount; i++)
+    {
+      buffer_[(kTail + i) & (kCapacity - 1)] = items[i];
+    }
+    if (kCount != 0)
+    {
+      tail_.store(kTail + static_cast<uint32_t>(kCount),
+                  std::memory_order_release);
+      waiter_.Notify();
+    }
+    return kCount;
+  }
+
+  /// Take the item at the front of the queue.
+  ///
+  /// @param item - where to copy the item to.
+  /// @return false if the queue was empty.
+  bool Pop(T & item)
+  {
+    return Pop(std::span<T>(&item, 1)) == 1;
+  }
+
+  /// Take as many items as fit from the front of the queue.
+  ///
+  /// @param items - where to copy the items to, oldest first.
+  /// @return number of items taken.
+  size_t Pop(std::span<T> items)
+  {
+    const uint32_t kHead = head_.load(std::memory_order_relaxed);
+    const uint32_t kTail = tail_.load(std::memory_order_acquire);
+    const size_t kCount  = std::min<size_t>(items.size(), kTail - kHead);
+    for (size_t i = 0; i < kCount; i++)
+    {
+      items[i] = buffer_[(kHead + i) & (kCapacity - 1)];
+    }
+    head_.store(kHead + static_cast<uint32_t>(kCount),
+                std::memory_order_release);
+    return kCount;
+  }
+
+  /// Take the item at the front of the queue, sleeping until one is pushed if
+  /// it is empty, see QueueWaiter::Wait().
+  ///
+  /// @param item - where to copy the item to.
+  /// @param timeout - longest time to wait for an item.
+  /// @return false if the queue stayed empty.
+  bool Pop(T & item, std::chrono::nanoseconds timeout)
+  {
+    return Pop(std::span<T>(&item, 1), timeout) == 1;
+  }
+
+  /// Take as many items as fit from the front of the queue, sleeping until
+  /// at least one is pushed if it is empty, see QueueWaiter::Wait().
+  ///
+  /// @param items - where to copy the items to, oldest first.
+  /// @param timeout - longest time to wait for an item.
+  /// @return number of items taken.
+  size_t Pop(std::span<T> items, std::chrono::nanoseconds timeout)
+  {
+    waiter_.Wait(timeout, [this]() { return !IsEmpty(); });
+    return Pop(items);
+  }
+
+  /// @return number of items in the queue.
+  size_t Size() const
+  {
+    // Read head first, so a Pop() in between cannot make the count negative.
+    const uint32_t kHead = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - kHead;
+  }
+
+  /// @return true if the queue holds no items.
+  bool IsEmpty() const
+  {
+    return Size() == 0;
+  }
+
+ private:
+  std::array<T, kCapacity> buffer_ = {};
+  // Free running positions, wrapped with the mask on each access
+  std::atomic<uint32_t> head_ = 0;
+  std::atomic<uint32_t> tail_ = 0;
+  QueueWaiter waiter_;
+};
+
+/// Bounded lock-free queue with any number of producers and a single
+/// consumer, such as several interrupt handlers and tasks feeding one task.
+///
+/// Each cell carries a sequence number saying whether it is free or holds a
+/// published item. Producers claim a cell by advancing the tail with a
+/// compare and swap, which compiles to LDREX/STREX on Cortex-M3 and M4, so an
+/// interrupted producer retries rather than holding up the interrupt. A
+/// producer that is preempted between claiming and publishing its cell
+/// delays the consumer from seeing later items, but never loses them.
+///
+/// Push() can be called from any thread or interrupt, at any priority. Pop()
+/// must only be called from one thread or interrupt at a time.
+///
+/// @tparam T - type of the items, copied in and out of the queue.
+/// @tparam kSize - number of items the queue holds. Must be a power of two.
+template <typename T, size_t kSize>
+class MpscQueue
+{
+ public:
+  /// Number of items the queue holds.
+  static constexpr size_t kCapacity = kSize;
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                "The size of a MpscQueue must be a power of two.");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                "MpscQueue needs lock-free 32-bit atomics.");
+
+  MpscQueue()
+  {
+    for (size_t i = 0; i < kCapacity; i++)
+    {
+      cells_[i].sequence.store(static_cast<uint32_t>(i),
+                               std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue & operator=(const MpscQueue &) = delete;
+
+  /// Add an item to the back of the queue.
+  ///
+  /// @param item - item to copy into the queue.
+  /// @return false if the queue was full and the item was not added.
+  bool Push(const T & item)
+  {
+    return Push(std::span<const T>(&item, 1)) == 1;
+  }
+
+  /// Add as many items as fit to the back of the queue, claiming room for
+  /// them at once and waking the consumer once. Items pushed by other
+  /// producers at the same time come before or after them, never in between.
+  ///
+  /// @param items - items to copy into the queue, in order.
+  /// @return number of items added, from the front of `items`.
+  size_t Push(std::span<const T> items)
+  {
+    const size_t kCount = Publish(items);
+    if (kCount != 0)
+    {
+      waiter_.Notify();
+    }
+    return kCount;
+  }
+
+  /// Take the item at the front of the queue.
+  ///
+  /// @param item - where to copy the item to.
+  /// @return false if the queue was empty.
+  bool Pop(T & item)
+  {
+    return Pop(std::span<T>(&item, 1)) == 1;
+  }
+
+  /// Take as many items as fit from the front of the queue.
+  ///
+  /// @param items - where to copy the items to, oldest first.
+  /// @return number of items taken.
+  size_t Pop(std::span<T> items)
+  {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    size_t count  = 0;
+    for (; count < items.size(); count++)
+    {
+      Cell_t & cell            = cells_[head & (kCapacity - 1)];
+      const uint32_t kSequence = cell.sequence.load(std::memory_order_acquire);
+      // Empty, or the next item is still being written by a producer that was
+      // interrupted.
+      if (kSequence != head + 1)
+      {
+        break;
+      }
+      items[count] = cell.item;
+      cell.sequence.store(head + kCapacity, std::memory_order_release);
+      head++;
+    }
+    head_.store(head, std::memory_order_relaxed);
+    return count;
+  }
+
+  /// Take the item at the front of the queue, sleeping until one is pushed if
+  /// it is empty, see QueueWaiter::Wait().
+  ///
+  /// @param item - where to copy the item to.
+  /// @param timeout - longest time to wait for an item.
+  /// @return false if the queue stayed empty.
+  bool Pop(T & item, std::chrono::nanoseconds timeout)
+  {
+    return Pop(std::span<T>(&item, 1), timeout) == 1;
+  }
+
+  /// Take as many items as fit from the front of the queue, sleeping until
+  /// at least one is pushed if it is empty, see QueueWaiter::Wait().
+  ///
+  /// @param items - where to copy the items to, oldest first.
+  /// @param timeout - longest time to wait for an item.
+  /// @return number of items taken.
+  size_t Pop(std::span<T> items, std::chrono::nanoseconds timeout)
+  {
+    waiter_.Wait(timeout, [this]() { return IsReadable(); });
+    return Pop(items);
+  }
+
+  /// @return number of items in the queue, including any being written.
+  size_t Size() const
+  {
+    const uint32_t kHead = head_.load(std::memory_order_relaxed);
+    return tail_.load(std::memory_order_relaxed) - kHead;
+  }
+
+  /// @return true if the queue holds no items, including any being written.
+  bool IsEmpty() const
+  {
+    return Size() == 0;
+  }
+
+ private:
+  struct Cell_t
+  {
+    std::atomic<uint32_t> sequence;
+    T item;
+  };
+
+  /// Claim a run of free cells with a single compare and swap of the tail,
+  /// then fill and publish them. A cell is free once the consumer has moved
+  /// its sequence a whole lap ahead of its position.
+  ///
+  /// @return number of items published, from the front of `items`.
+  size_t Publish(std::span<const T> items)
+  {
+    // Nothing to claim, and the loop below would retry forever.
+    if (items.empty())
+    {
+      return 0;
+    }
+
+    uint32_t position = tail_.load(std::memory_order_relaxed);
+    uint32_t count    = 0;
+    while (true)
+    {
+      // Count the free cells from the tail onwards. The compare and swap
+      // fails if another producer claimed any of them in the meantime.
+      int32_t difference = 0;
+      for (count = 0; count < items.size(); count++)
+      {
+        const uint32_t kPosition = position + count;
+        const uint32_t kSequence =
+            cells_[kPosition & (kCapacity - 1)].sequence.load(
+                std::memory_order_acquire);
+        difference = static_cast<int32_t>(kSequence - kPosition);
+        if (difference != 0)
+        {
+          break;
+        }
+      }
+
+      if (count != 0)
+      {
+        if (tail_.compare_exchange_weak(
+                position, position + count, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (difference < 0)
+      {
+        return 0;
+      }
+      else
+      {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+      Cell_t & cell = cells_[(position + i) & (kCapacity - 1)];
+      cell.item     = items[i];
+      cell.sequence.store(position + i + 1, std::memory_order_release);
+    }
+    return count;
+  }
+
+  /// @return true if the item at the front has been published.
+  bool IsReadable() const
+  {
+    const uint32_t kHead = head_.load(std::memory_order_relaxed);
+    return cells_[kHead & (kCapacity - 1)].sequence.load(
+               std::memory_order_acquire) == kHead + 1;
+  }
+
+  std::array<Cell_t, kCapacity> cells_;
+  std::atomic<uint32_t> tail_ = 0;
+  // Only written by the consumer. Atomic so Size() can be read anywhere.
+  std::atomic<uint32_t> head_ = 0;
+  QueueWaiter waiter_;
+};
+}  // namespace sjsu
@@ -139,4 +139,23 @@ constexpr auto ToIntegerArray(std::endian endian,
   }
   return value;
 }
+
+/// Write an integer into a byte buffer in little-endian order, for building a
+/// binary record one field at a time.
+///
+/// @tparam T - integer type of the value, which sets how many bytes are
+/// written.
+/// @param buffer - buffer to write into.
+/// @param position - index in buffer of the first byte to write. Advanced past
+/// the bytes written.
+/// @param value - the value to write.
+template <typename T>
+constexpr void PutLittleEndian(std::span<uint8_t> buffer,
+                               size_t & position,
+                               T value)
+{
+  const auto kBytes = ToByteArray(std::endian::little, value);
+  std::copy(kBytes.begin(), kBytes.end(), buffer.begin() + position);
+  position += kBytes.size();
+}
 }  // namespace sjsu
@@ -1,3 +1,4 @@
+#include <array>
 #include <cstdint>
 
 #include "testing/testing_frameworks.hpp"
@@ -12,4 +13,21 @@ TEST_CASE("Testing ToByteArray")
     // constexpr uint32_t kTestValue = 0x01020304;
   }
 }
+
+TEST_CASE("Testing PutLittleEndian")
+{
+  // Setup
+  std::array<uint8_t, 8> buffer = {};
+  size_t position               = 1;
+
+  // Exercise
+  PutLittleEndian(buffer, position, uint8_t{ 0xAA });
+  PutLittleEndian(buffer, position, uint16_t{ 0x0102 });
+  PutLittleEndian(buffer, position, uint32_t{ 0x0304'0506 });
+
+  // Verify
+  CHECK(8 == position);
+  CHECK(std::array<uint8_t, 8>{ 0, 0xAA, 0x02, 0x01, 0x06, 0x05, 0x04, 0x03 } ==
+        buffer);
+}
 }  // namespace sjsu
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "utility/rtos/freertos/rtos.hpp"
+#include "utility/error_handling.hpp"
+#include "utility/log.hpp"
+#include "utility/time/time.hpp"
+
+namespace sjsu::rtos
+{
+/// Execution time and deadline statistics of a periodic callback.
+struct PeriodicStatistics_t
+{
+  /// Number of times the callback has been run.
+  uint32_t runs = 0;
+  /// Number of periods in which the callback finished after its deadline, or
+  /// did not get to run at all because an earlier period overran.
+  uint32_t missed_deadlines = 0;
+  /// Shortest execution time of the callback.
+  std::chrono::nanoseconds minimum_execution = std::chrono::nanoseconds::max();
+  /// Longest execution time of the callback.
+  std::chrono::nanoseconds maximum_execution = 0ns;
+  /// Sum of every execution time of the callback.
+  std::chrono::nanoseconds total_execution = 0ns;
+
+  /// @return the mean execution time of the callback, or 0ns if it has not
+  ///         run yet.
+  std::chrono::nanoseconds AverageExecution() const
+  {
+    return (runs == 0) ? 0ns : total_execution / runs;
+  }
+};
+
+/// Runs callbacks at arbitrary periods. Callbacks with the same period share a
+/// rate, which is a single FreeRTOS task acting as a cyclic executive: each
+/// period it runs its callbacks in order of their phase offsets. Rates are
+/// given rate monotonic priorities, meaning the shorter the period, the higher
+/// the priority of its task.
+///
+/// Usage:
+///
+/// ```
+///   sjsu::rtos::RateMonotonicScheduler<2> scheduler;
+///   sjsu::rtos::RateMonotonicScheduler<2>::Callback_t read_imu(
+///       "Imu", [](uint32_t) { ReadImu(); });
+///   sjsu::rtos::RateMonotonicScheduler<2>::Callback_t filter(
+///       "Filter", [](uint32_t) { UpdateFilter(); }, 2ms);
+///   sjsu::rtos::RateMonotonicScheduler<2>::Callback_t telemetry(
+///       "Telemetry", [](uint32_t) { SendTelemetry(); });
+///
+///   scheduler.Add(read_imu, 5ms);
+///   scheduler.Add(filter, 5ms);
+///   scheduler.Add(telemetry, 100ms);
+///   scheduler.Start();
+///   vTaskStartScheduler();
+/// ```
+///
+/// @tparam kMaxRates - maximum number of distinct periods.
+/// @tparam kStackSize - stack size in bytes of each rate's task.
+template <size_t kMaxRates, size_t kStackSize = 1024>
+class RateMonotonicScheduler
+{
+ public:
+  /// Function run each period.
+  ///
+  /// @warning The function should not contain any blocking code, as it delays
+  ///          every callback after it within the same rate.
+  ///
+  /// @param count Number of times the function has been run, including this
+  ///        time.
+  using CallbackFunction = std::function<void(uint32_t count)>;
+
+  /// A function scheduled to run periodically. Callbacks are linked into their
+  /// rate, so they must outlive the scheduler.
+  class Callback_t
+  {
+   public:
+    /// @param name - name used to identify this callback.
+    /// @param function - function to run each period.
+    /// @param phase - offset from the start of each period at which to run the
+    ///        function. Must be less than the period.
+    Callback_t(const char * name,
+               CallbackFunction function,
+               std::chrono::nanoseconds phase = 0ns)
+        : name_(name), function_(function), phase_(phase)
+    {
+    }
+
+    Callback_t(const Callback_t &) = delete;
+    Callback_t & operator=(const Callback_t &) = delete;
+
+    /// @return name used to identify this callback.
+    const char * GetName() const
+    {
+      return name_;
+    }
+
+    /// @return offset from the start of each period at which this runs.
+    std::chrono::nanoseconds GetPhase() const
+    {
+      return phase_;
+    }
+
+    /// @return period of this callback, or 0ns if it has not been added to a
+    ///         scheduler.
+    std::chrono::nanoseconds GetPeriod() const
+    {
+      return period_;
+    }
+
+    /// @return priority of the task running this callback. Only valid after
+    ///         the scheduler has been started.
+    Priority GetPriority() const
+    {
+      return priority_;
+    }
+
+    /// @return execution time and deadline statistics of this callback.
+    const PeriodicStatistics_t & GetStatistics() const
+    {
+      return statistics_;
+    }
+
+    /// Clear the statistics of this callback.
+    void ResetStatistics()
+    {
+      statistics_ = {};
+    }
+
+   private:
+    friend class RateMonotonicScheduler;
+
+    const char * name_;
+    CallbackFunction function_;
+    std::chrono::nanoseconds phase_;
+    std::chrono::nanoseconds period_ = 0ns;
+    Priority priority_               = Priority::kIdle;
+    Callback_t * next_               = nullptr;
+    PeriodicStatistics_t statistics_;
+  };
+
+  /// Schedule a callback to run every period. Must be called before Start().
+  ///
+  /// @param callback - callback to schedule. Must not already be scheduled.
+  /// @param period - time between the starts of consecutive runs. Must be at
+  ///        least one RTOS tick.
+  void Add(Callback_t & callback, std::chrono::nanoseconds period)
+  {
+    if (started_)
+    {
+      throw Exception(std::errc::operation_not_permitted,
+                      "Callbacks cannot be added after Start()");
+    }
+    if (period < kTickPeriod)
+    {
+      throw Exception(std::errc::invalid_argument,
+                      "Period must be at least one RTOS tick");
+    }
+    if (callback.phase_ < 0ns || callback.phase_ >= period)
+    {
+      throw Exception(std::errc::invalid_argument,
+                      "Phase must be within the period");
+    }
+    if (callback.period_ != 0ns)
+    {
+      throw Exception(std::errc::device_or_resource_busy,
+                      "Callback has already been scheduled");
+    }
+
+    Rate_t * rate = FindRate(period);
+    if (rate == nullptr)
+    {
+      if (rate_count_ >= kMaxRates)
+      {
+        throw Exception(std::errc::not_enough_memory,
+                        "Too many distinct periods for this scheduler");
+      }
+      rate         = &rates_[rate_count_++];
+      rate->period = period;
+    }
+
+    // Keep the callbacks of a rate sorted by phase, in the order they run.
+    Callback_t ** link = &rate->callbacks;
+    while (*link != nullptr && (*link)->phase_ <= callback.phase_)
+    {
+      link = &(*link)->next_;
+    }
+    callback.period_ = period;
+    callback.next_   = *link;
+    *link            = &callback;
+  }
+
+  /// Assign rate monotonic priorities to each rate and create their tasks.
+  /// The tasks begin running once the FreeRTOS scheduler is running.
+  ///
+  /// @param highest - priority given to the rate with the shortest period.
+  /// @param lowest - lowest priority to assign. Rates beyond the number of
+  ///        priorities between highest and lowest all share this priority.
+  void Start(Priority highest = Priority::kHigh,
+             Priority lowest  = Priority::kLow)
+  {
+    if (started_)
+    {
+      return;
+    }
+    started_ = true;
+
+    AssignPriorities(highest, lowest);
+
+    for (size_t i = 0; i < rate_count_; i++)
+    {
+      Rate_t & rate = rates_[i];
+      rate.handle   = xTaskCreateStatic(RunRate,
+                                      rate.callbacks->name_,
+                                      static_cast<uint16_t>(rate.stack.size()),
+                                      &rate,
+                                      rate.priority,
+                                      rate.stack.data(),
+                                      &rate.task_buffer);
+      SJ2_ASSERT_FATAL(rate.handle != nullptr,
+                       "Unable to create task for rate of: %s",
+                       rate.callbacks->name_);
+    }
+  }
+
+  /// Run one period of a rate: wait for the release of each of its callbacks,
+  /// run them, record their statistics, and advance to the next period. This
+  /// is what each rate's task does in a loop, and is exposed for unit testing.
+  ///
+  /// @param rate_index - index of the rate, in the order rates were added.
+  void RunPeriod(size_t rate_index)
+  {
+    RunPeriod(rates_[rate_index]);
+  }
+
+  /// @return number of distinct periods scheduled.
+  size_t GetRateCount() const
+  {
+    return rate_count_;
+  }
+
+ private:
+  /// Duration of one RTOS tick, the resolution of sleeping until a release.
+  static constexpr std::chrono::nanoseconds kTickPeriod =
+      std::chrono::nanoseconds(std::nano::den / configTICK_RATE_HZ);
+
+  /// All callbacks that share a period, and the task that runs them.
+  struct Rate_t
+  {
+    RateMonotonicScheduler * scheduler = nullptr;
+    std::chrono::nanoseconds period    = 0ns;
+    Callback_t * callbacks             = nullptr;
+    Priority priority                  = Priority::kIdle;
+    /// Start of the current period, relative to epoch_.
+    std::chrono::nanoseconds release = 0ns;
+    TaskHandle_t handle              = nullptr;
+    StaticTask_t task_buffer;
+    std::array<StackType_t, StackSize(kStackSize)> stack;
+  };
+
+  static void RunRate(void * parameter)
+  {
+    Rate_t * rate = reinterpret_cast<Rate_t *>(parameter);
+    while (true)
+    {
+      rate->scheduler->RunPeriod(*rate);
+    }
+  }
+
+  Rate_t * FindRate(std::chrono::nanoseconds period)
+  {
+    for (size_t i = 0; i < rate_count_; i++)
+    {
+      if (rates_[i].period == period)
+      {
+        return &rates_[i];
+      }
+    }
+    return nullptr;
+  }
+
+  void AssignPriorities(Priority highest, Priority lowest)
+  {
+    std::array<Rate_t *, kMaxRates> order;
+    for (size_t i = 0; i < rate_count_; i++)
+    {
+      rates_[i].scheduler = this;
+      order[i]            = &rates_[i];
+    }
+    std::stable_sort(order.begin(),
+                     order.begin() + rate_count_,
+                     [](const Rate_t * left, const Rate_t * right) {
+                       return left->period < right->period;
+                     });
+
+    for (size_t rank = 0; rank < rate_count_; rank++)
+    {
+      const int kPriority =
+          std::max(static_cast<int>(highest) - static_cast<int>(rank),
+                   static_cast<int>(lowest));
+      order[rank]->priority = static_cast<Priority>(kPriority);
+      for (Callback_t * callback = order[rank]->callbacks; callback != nullptr;
+           callback              = callback->next_)
+      {
+        callback->priority_ = order[rank]->priority;
+      }
+    }
+  }
+
+  /// @return time elapsed since the first period of any rate began.
+  std::chrono::nanoseconds Elapsed()
+  {
+    // Rates share one epoch so their phases line up. The first task to run is
+    // the one with the highest priority, and sets it before any other can.
+    if (!epoch_set_)
+    {
+      epoch_     = Uptime();
+      epoch_set_ = true;
+    }
+    return Uptime() - epoch_;
+  }
+
+  /// Block until the given time since the epoch. Releases are kept in Uptime()
+  /// rather than ticks, so periods that are not a whole number of ticks do not
+  /// drift, and neither do releases when the tick falls behind Uptime().
+  void SleepUntil(std::chrono::nanoseconds time)
+  {
+    std::chrono::nanoseconds remaining = time - Elapsed();
+    while (remaining > 0ns)
+    {
+      // The current tick has partly elapsed, so the delay can end up to a tick
+      // short of the time asked for, in which case this loops once more.
+      const auto kTicks = (remaining + kTickPeriod - 1ns) / kTickPeriod;
+      TickType_t now    = xTaskGetTickCount();
+      vTaskDelayUntil(&now, static_cast<TickType_t>(kTicks));
+      remaining = time - Elapsed();
+    }
+  }
+
+  void RunPeriod(Rate_t & rate)
+  {
+    const std::chrono::nanoseconds kDeadline = rate.release + rate.period;
+
+    for (Callback_t * callback = rate.callbacks; callback != nullptr;
+         callback              = callback->next_)
+    {
+      SleepUntil(rate.release + callback->phase_);
+
+      PeriodicStatistics_t & statistics     = callback->statistics_;
+      const std::chrono::nanoseconds kStart = Elapsed();
+      callback->function_(statistics.runs + 1);
+      const std::chrono::nanoseconds kEnd = Elapsed();
+
+      const std::chrono::nanoseconds kExecution = kEnd - kStart;
+      statistics.runs++;
+      statistics.total_execution += kExecution;
+      statistics.minimum_execution =
+          std::min(statistics.minimum_execution, kExecution);
+      statistics.maximum_execution =
+          std::max(statistics.maximum_execution, kExecution);
+      if (kEnd > kDeadline)
+      {
+        statistics.missed_deadlines++;
+      }
+    }
+
+    rate.release = kDeadline;
+
+    // Periods that have already ended by now are skipped rather than run late
+    // back to back, and each of their callbacks missed those deadlines.
+    const std::chrono::nanoseconds kLate = Elapsed() - rate.release;
+    if (kLate >= rate.period)
+    {
+      const auto kSkipped = static_cast<uint32_t>(kLate / rate.period);
+      rate.release += kSkipped * rate.period;
+      for (Callback_t * callback = rate.callbacks; callback != nullptr;
+           callback              = callback->next_)
+      {
+        callback->statistics_.missed_deadlines += kSkipped;
+      }
+    }
+  }
+
+  std::array<Rate_t, kMaxRates> rates_;
+  size_t rate_count_ = 0;
+  bool started_      = false;
+  bool epoch_set_    = false;
+  std::chrono::nanoseconds epoch_ = 0ns;
+};
+}  // namespace sjsu::rtos
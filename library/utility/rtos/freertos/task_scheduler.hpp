@@ -1,5 +1,11 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
 #include "config.hpp"
 #include "platforms/utility/ram.hpp"
 #include "utility/log.hpp"
@@ -26,7 +32,13 @@ class TaskInterface
 {
  protected:
   /// TaskScheduler responsible for scheduling this task.
-  TaskScheduler * task_scheduler_;
+  TaskScheduler * task_scheduler_ = nullptr;
+  /// Index of this task in the TaskScheduler, TaskScheduler::kNotFound until
+  /// the task is added.
+  size_t task_index_;
+
+  /// Defined after TaskScheduler, which it needs to initialize task_index_.
+  TaskInterface();
 
  public:
   /// @param task_scheduler Reference to the TaskScheduler responsible for
@@ -43,6 +55,19 @@ class TaskInterface
     return task_scheduler_;
   }
 
+  /// @param task_index Index given to this task by its TaskScheduler.
+  void SetTaskIndex(size_t task_index)
+  {
+    task_index_ = task_index;
+  }
+
+  /// @returns The index given to this task by its TaskScheduler, which stays
+  ///          the same until the task is removed.
+  size_t GetTaskIndex() const
+  {
+    return task_index_;
+  }
+
   /// Setup is performed before the task begins to execute.
   /// The function should be overridden with any initialization code that the
   /// task requires.
@@ -101,35 +126,82 @@ class TaskInterface
 // TaskScheduler class
 // =============================================================================
 
+/// Blocks each task that arrives at it until a set number of tasks have
+/// arrived. Unlike the bits of an event group, the count does not limit how
+/// many tasks can wait at once.
+class CountingBarrier
+{
+ public:
+  /// Set the number of tasks to wait for. Must be called before any task
+  /// arrives.
+  ///
+  /// @param count Number of tasks that must arrive to release the barrier.
+  void Initialize(size_t count)
+  {
+    remaining_.store(count, std::memory_order_relaxed);
+    release_ = xSemaphoreCreateBinaryStatic(&release_buffer_);
+    SJ2_ASSERT_FATAL(release_ != nullptr,
+                     "Failed to create the barrier's semaphore!");
+  }
+
+  /// Block the calling task until every task has arrived.
+  void ArriveAndWait()
+  {
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      xSemaphoreGive(release_);
+    }
+    // Each task that gets through lets the next one through.
+    xSemaphoreTake(release_, portMAX_DELAY);
+    xSemaphoreGive(release_);
+  }
+
+  /// @return Number of tasks that have yet to arrive.
+  size_t GetRemaining() const
+  {
+    return remaining_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<size_t> remaining_ = 0;
+  StaticSemaphore_t release_buffer_;
+  SemaphoreHandle_t release_ = nullptr;
+};
+
 /// A FreeRTOS task scheduler responsible for scheduling tasks that inherit the
 /// Task interface.Tasks inheriting Task interface are automatically added to
 /// the scheduler when constructed.
+///
+/// Each task is given an index when it is added, which stays the same until it
+/// is removed. Operations by index are O(1). Names are looked up through a
+/// hash table, so they do not depend on the number of tasks either.
 class TaskScheduler final
 {
  public:
-  TaskScheduler()
-      : task_list_{ nullptr },
-        task_count_(0),
-        pre_run_event_group_handle_(NULL),
-        pre_run_sync_bits_(0x0)
-  {
-  }
+  /// Returned by GetTaskIndex() for a task that is not scheduled.
+  static constexpr size_t kNotFound = config::kTaskSchedulerSize + 1;
 
-  /// @return The PreRun event group handler used to notify that PreRun of all
-  ///         tasks have completed successfully.
-  EventGroupHandle_t GetPreRunEventGroupHandle() const
+  TaskScheduler()
   {
-    return pre_run_event_group_handle_;
+    task_list_.fill(nullptr);
+    name_table_.fill(kEmptySlot);
+    // Hand out the lowest indices first.
+    for (size_t i = 0; i < config::kTaskSchedulerSize; i++)
+    {
+      free_indices_[i] =
+          static_cast<Index_t>(config::kTaskSchedulerSize - 1 - i);
+    }
   }
 
-  /// @return The sync bits of the PreRun event group.
-  EventBits_t GetPreRunSyncBits() const
+  /// @return The barrier that each task waits at after its PreRun() until all
+  ///         tasks have completed theirs.
+  const CountingBarrier & GetPreRunBarrier() const
   {
-    return pre_run_sync_bits_;
+    return pre_run_barrier_;
   }
 
   /// @return The current number of scheduled tasks.
-  uint8_t GetTaskCount() const
+  size_t GetTaskCount() const
   {
     return task_count_;
   }
@@ -144,19 +216,21 @@ class TaskScheduler final
   void AddTask(TaskInterface * task)
   {
     SJ2_ASSERT_FATAL(
-        task_count_ + 1 < config::kTaskSchedulerSize,
+        task_count_ < config::kTaskSchedulerSize,
         "The scheduler is currently full, the task will not be "
         "added. Consider increasing the scheduler size configuration.");
-    for (uint8_t i = 0; i < config::kTaskSchedulerSize; i++)
+    if (task_count_ >= config::kTaskSchedulerSize)
     {
-      if (task_list_[i] == nullptr)
-      {
-        task_list_[i] = task;
-        task_count_++;
-        task->SetTaskScheduler(this);
-        return;
-      }
+      return;
     }
+
+    const Index_t kIndex = free_indices_[config::kTaskSchedulerSize -
+                                         task_count_ - 1];
+    task_list_[kIndex] = task;
+    task_count_++;
+    task->SetTaskScheduler(this);
+    task->SetTaskIndex(kIndex);
+    InsertName(task->GetName(), kIndex);
   }
 
   /// Removes a specified task by its name and updates the task_list_ and
@@ -165,18 +239,29 @@ class TaskScheduler final
   /// @param task_name Name of the task to remove.
   void RemoveTask(const char * task_name)
   {
-    const uint8_t kTaskIndex = GetTaskIndex(task_name);
-    if (kTaskIndex > config::kTaskSchedulerSize)
+    RemoveTaskByIndex(GetTaskIndex(task_name));
+  }
+
+  /// Removes the task at an index, see TaskInterface::GetTaskIndex().
+  ///
+  /// @param index Index of the task to remove.
+  void RemoveTaskByIndex(size_t index)
+  {
+    TaskInterface * task = GetTaskByIndex(index);
+    if (task == nullptr)
     {
       return;
     }
-    TaskHandle_t handle = task_list_[kTaskIndex]->GetHandle();
+    TaskHandle_t handle = *task->GetHandle();
     if (handle != nullptr)
     {
       vTaskDelete(handle);
     }
-    task_list_[kTaskIndex] = nullptr;
+    RemoveName(task->GetName(), static_cast<Index_t>(index));
+    task_list_[index] = nullptr;
     task_count_--;
+    free_indices_[config::kTaskSchedulerSize - task_count_ - 1] =
+        static_cast<Index_t>(index);
   }
 
   /// Retreive a task by its task name.
@@ -186,40 +271,54 @@ class TaskScheduler final
   ///         reference to the retrieved task with the matching name.
   TaskInterface * GetTask(const char * task_name) const
   {
-    const uint32_t kTaskIndex = GetTaskIndex(task_name);
-    if (kTaskIndex > task_count_)
+    return GetTaskByIndex(GetTaskIndex(task_name));
+  }
+
+  /// Retreive a task by its index.
+  ///
+  /// @param index Index of the task, see TaskInterface::GetTaskIndex().
+  /// @return A nullptr if no task has the index.
+  TaskInterface * GetTaskByIndex(size_t index) const
+  {
+    if (index >= config::kTaskSchedulerSize)
     {
       return nullptr;
     }
-    return task_list_[kTaskIndex];
+    return task_list_[index];
   }
 
-  /// Used to get a task's index to determine the sync bit for the PreRun event
-  /// group.
+  /// Look up the index of a task by its name. Tasks already know their own
+  /// index, see TaskInterface::GetTaskIndex().
   ///
   /// @param task_name Name of the task.
   /// @return The index of the specified task. If the task is not scheduled,
-  ///         kTaskSchedulerSize + 1 will be returned.
-  uint8_t GetTaskIndex(const char * task_name) const
+  ///         kNotFound will be returned.
+  size_t GetTaskIndex(const char * task_name) const
   {
-    for (uint8_t i = 0; i < config::kTaskSchedulerSize; i++)
+    size_t slot = Hash(task_name);
+    for (size_t probe = 0; probe < kNameTableSize; probe++)
     {
-      if (task_list_[i] != nullptr)
+      const Index_t kIndex = name_table_[slot];
+      if (kIndex == kEmptySlot)
+      {
+        break;
+      }
+      if (kIndex != kRemovedSlot &&
+          !strcmp(task_list_[kIndex]->GetName(), task_name))
       {
-        if (!strcmp(task_list_[i]->GetName(), task_name))
-        {
-          return i;
-        }
+        return kIndex;
       }
+      slot = (slot + 1) & (kNameTableSize - 1);
     }
-    return static_cast<uint8_t>(config::kTaskSchedulerSize + 1);
+    return kNotFound;
   }
 
   /// @return A pointer reference to an immutable array of all currently
-  ///         scheduled tasks.
+  ///         scheduled tasks, indexed by their task index. Unused indices hold
+  ///         nullptr.
   TaskInterface * const * GetAllTasks() const
   {
-    return task_list_;
+    return task_list_.data();
   }
 
   /// Starts the scheduler and attempts to initialize all tasks.
@@ -237,6 +336,72 @@ class TaskScheduler final
   }
 
  private:
+  /// Type of a task index, sized for the configured number of tasks.
+  using Index_t = uint16_t;
+  static_assert(config::kTaskSchedulerSize < 0xFFFE,
+                "SJ2_TASK_SCHEDULER_SIZE must be below 65534.");
+
+  /// Marks a slot of the name table that has never held a task.
+  static constexpr Index_t kEmptySlot = 0xFFFF;
+  /// Marks a slot of the name table whose task has been removed. Lookups
+  /// continue past it, insertions reuse it.
+  static constexpr Index_t kRemovedSlot = 0xFFFE;
+
+  /// Number of bits used to index the name table, which has at least twice
+  /// as many slots as tasks to keep probe sequences short.
+  static constexpr uint32_t kNameTableBits = []() {
+    uint32_t bits = 1;
+    while ((size_t{ 1 } << bits) < config::kTaskSchedulerSize * 2)
+    {
+      bits++;
+    }
+    return bits;
+  }();
+
+  /// Number of slots in the name table.
+  static constexpr size_t kNameTableSize = size_t{ 1 } << kNameTableBits;
+
+  /// @param name Name of a task.
+  /// @return The slot of the name table where the search for the name starts.
+  static size_t Hash(const char * name)
+  {
+    // 32-bit FNV-1a
+    uint32_t hash = 0x811C'9DC5;
+    for (; *name != '\0'; name++)
+    {
+      hash = (hash ^ static_cast<uint8_t>(*name)) * 0x0100'0193;
+    }
+    return hash & (kNameTableSize - 1);
+  }
+
+  void InsertName(const char * name, Index_t index)
+  {
+    size_t slot = Hash(name);
+    while (name_table_[slot] != kEmptySlot && name_table_[slot] != kRemovedSlot)
+    {
+      slot = (slot + 1) & (kNameTableSize - 1);
+    }
+    name_table_[slot] = index;
+  }
+
+  void RemoveName(const char * name, Index_t index)
+  {
+    size_t slot = Hash(name);
+    for (size_t probe = 0; probe < kNameTableSize; probe++)
+    {
+      if (name_table_[slot] == index)
+      {
+        name_table_[slot] = kRemovedSlot;
+        return;
+      }
+      if (name_table_[slot] == kEmptySlot)
+      {
+        return;
+      }
+      slot = (slot + 1) & (kNameTableSize - 1);
+    }
+  }
+
   /// Function used during InitializeAllTasks() for xTaskCreate() for running
   /// scheduled tasks.
   ///
@@ -246,22 +411,11 @@ class TaskScheduler final
     TaskInterface & task = *(reinterpret_cast<TaskInterface *>(task_pointer));
     TaskScheduler & task_scheduler = *(task.GetTaskScheduler());
 
-    const uint8_t kTaskCount = task_scheduler.GetTaskCount();
-    const uint8_t kTaskIndex = task_scheduler.GetTaskIndex(task.GetName());
-    SJ2_ASSERT_FATAL(kTaskIndex < kTaskCount,
-                     "The task index should not exceed the task count.");
-    // Perform PreRun for the task and then set the event group sync bit to
-    // broadcast this task's PreRun has completed
-    EventGroupHandle_t pre_run_event_group_handle =
-        task_scheduler.GetPreRunEventGroupHandle();
-    const EventBits_t kPreRunSyncBits = task_scheduler.GetPreRunSyncBits();
-    const uint32_t kSyncBit           = (1 << kTaskIndex);
     SJ2_ASSERT_FATAL(task.PreRun(),
                      "PreRun() failed for task: %s, terminating scheduler!",
                      task.GetName());
     // wait for all other PreRun() of other tasks to finish
-    xEventGroupSync(pre_run_event_group_handle, kSyncBit, kPreRunSyncBits,
-                    portMAX_DELAY);
+    task_scheduler.pre_run_barrier_.ArriveAndWait();
     // All PreRun() complete, each Task's Run() can now start executing...
     TickType_t last_wake_time = xTaskGetTickCount();
 
@@ -288,9 +442,15 @@ class TaskScheduler final
   /// xTaskCreateStatic() or Setup() fails.
   void InitializeAllTasks()
   {
-    for (uint32_t i = 0; i < task_count_; i++)
+    // Set up before any task is created, so no task can reach it first.
+    pre_run_barrier_.Initialize(task_count_);
+
+    for (TaskInterface * task : task_list_)
     {
-      TaskInterface * task = task_list_[i];
+      if (task == nullptr)
+      {
+        continue;
+      }
       *(task->GetHandle()) = xTaskCreateStatic(
           RunTask,  // function to execute the task
           task->GetName(),
@@ -299,31 +459,30 @@ class TaskScheduler final
           task->GetPriority(),
           task->GetStack(),        // the task's statically allocated memory
           task->GetTaskBuffer());  // task TCB
-      SJ2_ASSERT_FATAL(task->GetHandle() != nullptr,
+      SJ2_ASSERT_FATAL(*(task->GetHandle()) != nullptr,
                        "Unable to create task: %s", task->GetName());
       SJ2_ASSERT_FATAL(task->Setup(), "Failed to complete Setup() for task: %s",
                        task->GetName());
-      pre_run_sync_bits_ |= (1 << i);
     }
-    pre_run_event_group_handle_ =
-        xEventGroupCreateStatic(&pre_run_event_group_buffer_);
-    SJ2_ASSERT_FATAL(pre_run_event_group_handle_ != nullptr,
-                     "Failed to create PreRun Event Group!");
   }
 
-  /// Array containing all scheduled tasks.
-  TaskInterface * task_list_[config::kTaskSchedulerSize];
+  /// Array containing all scheduled tasks, indexed by their task index.
+  std::array<TaskInterface *, config::kTaskSchedulerSize> task_list_;
+  /// Indices not used by any task. The last task_count_ entries are stale, the
+  /// entry just before them is the next index to hand out.
+  std::array<Index_t, config::kTaskSchedulerSize> free_indices_;
+  /// Open addressing hash table from task names to task indices.
+  std::array<Index_t, kNameTableSize> name_table_;
   /// Current number of scheduled tasks in task_list_.
-  uint8_t task_count_;
-  /// Buffer to hold the static allocation of the PreRun Event Group.
-  StaticEventGroup_t pre_run_event_group_buffer_;
-  /// Event Group handle to be used by tasks running their PreRun callback to
-  /// indicate that all of them have completed it.
-  EventGroupHandle_t pre_run_event_group_handle_;
-  /// All PreRun sync bits for PreRun Event Group.
-  EventBits_t pre_run_sync_bits_;
+  size_t task_count_ = 0;
+  /// Each task waits here after its PreRun() until all have completed.
+  CountingBarrier pre_run_barrier_;
 };
 
+inline TaskInterface::TaskInterface() : task_index_(TaskScheduler::kNotFound)
+{
+}
+
 // =============================================================================
 // Task interface class
 // =============================================================================
@@ -368,7 +527,7 @@ class Task : public TaskInterface
   void Delete() const override
   {
     vTaskSuspend(handle_);
-    task_scheduler_->RemoveTask(kName);
+    task_scheduler_->RemoveTaskByIndex(task_index_);
   }
 
   /// @return The name of this task.
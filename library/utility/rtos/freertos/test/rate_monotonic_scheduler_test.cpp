@@ -0,0 +1,235 @@
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "testing/testing_frameworks.hpp"
+#include "utility/rtos/freertos/rate_monotonic_scheduler.hpp"
+
+namespace  // private namespace for custom fakes
+{
+std::chrono::nanoseconds test_now = 0ns;
+
+TickType_t xTaskGetTickCount_custom_fake()  // NOLINT
+{
+  return static_cast<TickType_t>(test_now / 1ms);
+}
+
+void vTaskDelayUntil_custom_fake(TickType_t * previous,  // NOLINT
+                                 TickType_t ticks)
+{
+  test_now = std::chrono::milliseconds(*previous + ticks);
+}
+}  // namespace
+
+namespace sjsu::rtos
+{
+TEST_CASE("Testing RateMonotonicScheduler")
+{
+  using Scheduler_t = RateMonotonicScheduler<4, 512>;
+
+  RESET_FAKE(xTaskCreateStatic);
+  RESET_FAKE(xTaskGetTickCount);
+  RESET_FAKE(vTaskDelayUntil);
+
+  // Setup: A clock that only moves while sleeping or running callbacks
+  test_now                           = 0ns;
+  xTaskGetTickCount_fake.custom_fake = xTaskGetTickCount_custom_fake;
+  vTaskDelayUntil_fake.custom_fake   = vTaskDelayUntil_custom_fake;
+  xTaskCreateStatic_fake.return_val  = reinterpret_cast<TaskHandle_t>(1);
+  SetUptimeFunction([]() { return test_now; });
+
+  std::vector<std::chrono::nanoseconds> run_times;
+  auto record_run = [&run_times](std::chrono::nanoseconds execution) {
+    return [&run_times, execution](uint32_t) {
+      run_times.push_back(test_now);
+      test_now += execution;
+    };
+  };
+
+  Scheduler_t test_subject;
+
+  SECTION("Callbacks of a rate run at their phase each period")
+  {
+    // Setup
+    Scheduler_t::Callback_t first("First", record_run(1ms));
+    Scheduler_t::Callback_t second("Second", record_run(1ms), 4ms);
+    Scheduler_t::Callback_t third("Third", record_run(1ms), 2ms);
+    test_subject.Add(second, 10ms);
+    test_subject.Add(first, 10ms);
+    test_subject.Add(third, 10ms);
+
+    // Exercise
+    test_subject.RunPeriod(0);
+    test_subject.RunPeriod(0);
+
+    // Verify
+    CHECK(1 == test_subject.GetRateCount());
+    CHECK(std::vector<std::chrono::nanoseconds>{
+              0ms, 2ms, 4ms, 10ms, 12ms, 14ms } == run_times);
+    CHECK(2 == first.GetStatistics().runs);
+    CHECK(2 == second.GetStatistics().runs);
+    CHECK(0 == second.GetStatistics().missed_deadlines);
+    CHECK(10ms == second.GetPeriod());
+  }
+
+  SECTION("Periods that are not a multiple of the tick do not drift")
+  {
+    // Setup
+    Scheduler_t::Callback_t callback("Callback", record_run(0ns));
+    test_subject.Add(callback, 2500us);
+
+    // Exercise
+    for (int i = 0; i < 5; i++)
+    {
+      test_subject.RunPeriod(0);
+    }
+
+    // Verify: Each release is rounded up to the tick after it
+    CHECK(std::vector<std::chrono::nanoseconds>{
+              0ms, 3ms, 5ms, 8ms, 10ms } == run_times);
+  }
+
+  SECTION("Releases between ticks are never early")
+  {
+    // Setup: The first period starts part way through a tick
+    test_now = 700us;
+    Scheduler_t::Callback_t callback("Callback", record_run(0ns));
+    test_subject.Add(callback, 2500us);
+
+    // Exercise
+    test_subject.RunPeriod(0);
+    test_subject.RunPeriod(0);
+
+    // Verify: 3 ticks from 700us falls short of 3200us, so it waits another
+    CHECK(std::vector<std::chrono::nanoseconds>{ 700us, 4ms } == run_times);
+    CHECK(2 == vTaskDelayUntil_fake.call_count);
+  }
+
+  SECTION("Execution time statistics")
+  {
+    // Setup
+    std::chrono::nanoseconds execution = 100us;
+    Scheduler_t::Callback_t callback("Callback", [&execution](uint32_t) {
+      test_now += execution;
+      execution += 200us;
+    });
+    test_subject.Add(callback, 1ms);
+
+    // Exercise
+    for (int i = 0; i < 3; i++)
+    {
+      test_subject.RunPeriod(0);
+    }
+
+    // Verify
+    const PeriodicStatistics_t & statistics = callback.GetStatistics();
+    CHECK(3 == statistics.runs);
+    CHECK(0 == statistics.missed_deadlines);
+    CHECK(100us == statistics.minimum_execution);
+    CHECK(500us == statistics.maximum_execution);
+    CHECK(900us == statistics.total_execution);
+    CHECK(300us == statistics.AverageExecution());
+
+    // Exercise + Verify
+    callback.ResetStatistics();
+    CHECK(0 == callback.GetStatistics().runs);
+    CHECK(0us == callback.GetStatistics().AverageExecution());
+  }
+
+  SECTION("Overruns are counted as missed deadlines and skipped")
+  {
+    // Setup
+    std::vector<uint32_t> counts;
+    Scheduler_t::Callback_t slow("Slow", [&counts](uint32_t count) {
+      counts.push_back(count);
+      test_now += (count == 2) ? 25ms : 1ms;
+    });
+    Scheduler_t::Callback_t after("After", record_run(1ms), 5ms);
+    test_subject.Add(slow, 10ms);
+    test_subject.Add(after, 10ms);
+
+    // Exercise
+    for (int i = 0; i < 3; i++)
+    {
+      test_subject.RunPeriod(0);
+    }
+
+    // Verify: The period at 10ms ran until 36ms, so it finished late, the one
+    //         at 20ms was skipped, and the one at 30ms started late.
+    CHECK(std::vector<uint32_t>{ 1, 2, 3 } == counts);
+    CHECK(std::vector<std::chrono::nanoseconds>{ 5ms, 35ms, 37ms } ==
+          run_times);
+    CHECK(2 == slow.GetStatistics().missed_deadlines);
+    CHECK(2 == after.GetStatistics().missed_deadlines);
+  }
+
+  SECTION("Start assigns rate monotonic priorities")
+  {
+    // Setup
+    Scheduler_t::Callback_t slowest("Slowest", record_run(0ns));
+    Scheduler_t::Callback_t fastest("Fastest", record_run(0ns));
+    Scheduler_t::Callback_t fast("Fast", record_run(0ns));
+    Scheduler_t::Callback_t slow("Slow", record_run(0ns));
+    Scheduler_t::Callback_t also_fastest("AlsoFastest", record_run(0ns));
+    test_subject.Add(slowest, 1s);
+    test_subject.Add(fastest, 1ms);
+    test_subject.Add(fast, 20ms);
+    test_subject.Add(slow, 100ms);
+    test_subject.Add(also_fastest, 1ms);
+
+    // Exercise
+    test_subject.Start(Priority::kCritical, Priority::kMedium);
+
+    // Verify
+    CHECK(4 == xTaskCreateStatic_fake.call_count);
+    CHECK(Priority::kCritical == fastest.GetPriority());
+    CHECK(Priority::kCritical == also_fastest.GetPriority());
+    CHECK(Priority::kHigh == fast.GetPriority());
+    CHECK(Priority::kMedium == slow.GetPriority());
+    CHECK(Priority::kMedium == slowest.GetPriority());
+  }
+
+  SECTION("Invalid callbacks are rejected")
+  {
+    // Setup
+    Scheduler_t::Callback_t callback("Callback", record_run(0ns), 5ms);
+    Scheduler_t::Callback_t other("Other", record_run(0ns));
+
+    // Exercise + Verify
+    SJ2_CHECK_EXCEPTION(test_subject.Add(callback, 100us),
+                        std::errc::invalid_argument);
+    SJ2_CHECK_EXCEPTION(test_subject.Add(callback, 5ms),
+                        std::errc::invalid_argument);
+    test_subject.Add(callback, 10ms);
+    SJ2_CHECK_EXCEPTION(test_subject.Add(callback, 20ms),
+                        std::errc::device_or_resource_busy);
+
+    // Exercise + Verify
+    test_subject.Start();
+    SJ2_CHECK_EXCEPTION(test_subject.Add(other, 10ms),
+                        std::errc::operation_not_permitted);
+  }
+
+  SECTION("Too many rates")
+  {
+    // Setup
+    std::array<std::unique_ptr<Scheduler_t::Callback_t>, 5> callbacks;
+    for (auto & callback : callbacks)
+    {
+      callback =
+          std::make_unique<Scheduler_t::Callback_t>("", record_run(0ns));
+    }
+    test_subject.Add(*callbacks[0], 1ms);
+    test_subject.Add(*callbacks[1], 2ms);
+    test_subject.Add(*callbacks[2], 3ms);
+    test_subject.Add(*callbacks[3], 4ms);
+
+    // Exercise + Verify
+    SJ2_CHECK_EXCEPTION(test_subject.Add(*callbacks[4], 5ms),
+                        std::errc::not_enough_memory);
+  }
+
+  SetUptimeFunction(nullptr);
+}
+}  // namespace sjsu::rtos
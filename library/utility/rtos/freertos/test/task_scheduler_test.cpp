@@ -1,19 +1,10 @@
 // Tests for the TaskScheduler singleton class.
+#include <array>
 #include <iterator>
 
 #include "utility/rtos/freertos/task_scheduler.hpp"
 #include "testing/testing_frameworks.hpp"
 
-namespace  // private namespace for custom fakes
-{
-EventGroupHandle_t test_event_group_handle;
-EventGroupHandle_t xEventGroupCreateStatic_custom_fake(  // NOLINT
-    StaticEventGroup_t *)
-{
-  return test_event_group_handle;
-}
-}  // namespace
-
 namespace sjsu::rtos
 {
 TEST_CASE("Testing TaskScheduler")
@@ -24,6 +15,11 @@ TEST_CASE("Testing TaskScheduler")
     "Task 13", "Task 14", "Task 15", "Task 16", "Task 17",
   };
   std::array<TaskHandle_t, kTaskNames.size()> task_handles;
+  std::array<int, kTaskNames.size()> task_control_blocks;
+  for (size_t i = 0; i < task_handles.size(); i++)
+  {
+    task_handles[i] = reinterpret_cast<TaskHandle_t>(&task_control_blocks[i]);
+  }
   std::array<Mock<TaskInterface>, kTaskNames.size()> mock_tasks;
   for (size_t i = 0; i < kTaskNames.size(); i++)
   {
@@ -44,8 +40,8 @@ TEST_CASE("Testing TaskScheduler")
   SECTION("AddTask")
   {
     TaskInterface * const * task_list = scheduler.GetAllTasks();
-    constexpr uint8_t kMaxTaskCount   = config::kTaskSchedulerSize;
-    uint8_t task_count                = 0;
+    constexpr size_t kMaxTaskCount    = config::kTaskSchedulerSize;
+    size_t task_count                 = 0;
 
     // scheduler should be initially empty
     CHECK(scheduler.GetTaskCount() == 0);
@@ -63,6 +59,7 @@ TEST_CASE("Testing TaskScheduler")
       // Verify
       CHECK(scheduler.GetTaskCount() == task_count);
       CHECK(!strcmp(task_list[i]->GetName(), task.GetName()));
+      CHECK(i == task.GetTaskIndex());
     }
 
     // scheduler should now be full and new tasks should not be added
@@ -78,8 +75,8 @@ TEST_CASE("Testing TaskScheduler")
 
   SECTION("GetTask")
   {
-    constexpr uint8_t kMaxTaskCount = config::kTaskSchedulerSize;
-    uint8_t task_count              = 0;
+    constexpr size_t kMaxTaskCount = config::kTaskSchedulerSize;
+    size_t task_count              = 0;
     CHECK(scheduler.GetTaskCount() == 0);
 
     SECTION("Getting a task that has been scheduled")
@@ -116,8 +113,8 @@ TEST_CASE("Testing TaskScheduler")
 
   SECTION("GetTaskIndex")
   {
-    constexpr uint8_t kMaxTaskCount = config::kTaskSchedulerSize;
-    uint8_t task_count              = 0;
+    constexpr size_t kMaxTaskCount = config::kTaskSchedulerSize;
+    size_t task_count              = 0;
 
     SECTION("Getting the task indices of scheduled tasks")
     {
@@ -141,6 +138,7 @@ TEST_CASE("Testing TaskScheduler")
       // If retreiving the index of a task that is not scheduled, GetTaskIndex
       // should return kTaskSchedulerSize + 1
       CHECK(scheduler.GetTaskIndex("Does not exist") == (kMaxTaskCount + 1));
+      CHECK(TaskScheduler::kNotFound == (kMaxTaskCount + 1));
     }
   }
 
@@ -175,23 +173,80 @@ TEST_CASE("Testing TaskScheduler")
 
       // Verify
       CHECK(vTaskDelete_fake.call_count == 1);
+      CHECK(vTaskDelete_fake.arg0_val == task_handles[kTaskIndexToRemove]);
       CHECK(scheduler.GetTaskCount() == (kExpectedTaskCount - 1));
       CHECK(task_list[kTaskIndexToRemove] == nullptr);
+      CHECK(scheduler.GetTask(kTaskNames[kTaskIndexToRemove]) == nullptr);
+      CHECK(scheduler.GetTaskIndex(kTaskNames[3]) == 3);
+
+      // Exercise: The next task added takes the index that was freed
+      scheduler.AddTask(&(mock_tasks[kExpectedTaskCount].get()));
+
+      // Verify
+      CHECK(task_list[kTaskIndexToRemove] ==
+            &(mock_tasks[kExpectedTaskCount].get()));
+      CHECK(scheduler.GetTaskIndex(kTaskNames[kExpectedTaskCount]) ==
+            kTaskIndexToRemove);
+    }
+
+    SECTION("By index")
+    {
+      // Setup
+      for (size_t i = 0; i < 3; i++)
+      {
+        scheduler.AddTask(&(mock_tasks[i].get()));
+      }
+
+      // Exercise
+      scheduler.RemoveTaskByIndex(mock_tasks[1].get().GetTaskIndex());
+
+      // Verify
+      CHECK(vTaskDelete_fake.call_count == 1);
+      CHECK(scheduler.GetTaskCount() == 2);
+      CHECK(scheduler.GetTaskByIndex(1) == nullptr);
+      CHECK(scheduler.GetTaskByIndex(2) == &(mock_tasks[2].get()));
+    }
+  }
+
+  SECTION("Name lookup after many adds and removals")
+  {
+    // Exercise: Cycle every task through the scheduler a few times, so that
+    // the name table fills up with removed slots.
+    for (size_t round = 0; round < 4; round++)
+    {
+      for (size_t i = 0; i < config::kTaskSchedulerSize; i++)
+      {
+        scheduler.AddTask(&(mock_tasks[(i + round) % kTaskNames.size()].get()));
+      }
+      for (size_t i = 0; i < config::kTaskSchedulerSize; i += 2)
+      {
+        scheduler.RemoveTaskByIndex(i);
+      }
+      for (size_t i = 0; i < config::kTaskSchedulerSize; i++)
+      {
+        TaskInterface * task = scheduler.GetTaskByIndex(i);
+        if (task != nullptr)
+        {
+          INFO("Round " << round << ", index " << i);
+          CHECK(scheduler.GetTaskIndex(task->GetName()) == i);
+          scheduler.RemoveTask(task->GetName());
+        }
+      }
+
+      // Verify
+      CHECK(scheduler.GetTaskCount() == 0);
     }
   }
 
   SECTION("Start")
   {
     RESET_FAKE(xTaskCreateStatic);
-    RESET_FAKE(xEventGroupCreateStatic);
+    RESET_FAKE(xQueueGenericCreateStatic);
     RESET_FAKE(vTaskStartScheduler);
 
     // Setup
-    constexpr uint32_t kPreRunSyncBits = 0xFFFF;
-    xEventGroupCreateStatic_fake.custom_fake =
-        xEventGroupCreateStatic_custom_fake;
-    constexpr uint8_t kMaxTaskCount = config::kTaskSchedulerSize;
-    size_t task_count               = 0;
+    const size_t kMaxTaskCount = config::kTaskSchedulerSize;
+    size_t task_count          = 0;
     // Add tasks 1-16 to the scheduler
     for (size_t i = 0; i < kMaxTaskCount; i++)
     {
@@ -211,10 +266,41 @@ TEST_CASE("Testing TaskScheduler")
 
     // Verify
     CHECK(xTaskCreateStatic_fake.call_count == kMaxTaskCount);
-    CHECK(xEventGroupCreateStatic_fake.call_count == 1);
-    CHECK(scheduler.GetPreRunEventGroupHandle() == test_event_group_handle);
-    CHECK(scheduler.GetPreRunSyncBits() == kPreRunSyncBits);
+    // The barrier's semaphore
+    CHECK(xQueueGenericCreateStatic_fake.call_count == 1);
+    CHECK(scheduler.GetPreRunBarrier().GetRemaining() == kMaxTaskCount);
     CHECK(vTaskStartScheduler_fake.call_count == 1);
   }
 }
+
+TEST_CASE("Testing CountingBarrier")
+{
+  RESET_FAKE(xQueueGenericCreateStatic);
+  RESET_FAKE(xQueueGenericSend);
+  RESET_FAKE(xQueueSemaphoreTake);
+
+  // Setup
+  CountingBarrier barrier;
+  barrier.Initialize(40);
+  CHECK(xQueueGenericCreateStatic_fake.call_count == 1);
+
+  // Exercise
+  for (size_t i = 0; i < 39; i++)
+  {
+    barrier.ArriveAndWait();
+  }
+
+  // Verify: Every early arrival waits, then passes the release on
+  CHECK(barrier.GetRemaining() == 1);
+  CHECK(xQueueSemaphoreTake_fake.call_count == 39);
+  CHECK(xQueueGenericSend_fake.call_count == 39);
+
+  // Exercise
+  barrier.ArriveAndWait();
+
+  // Verify: The last arrival releases the barrier
+  CHECK(barrier.GetRemaining() == 0);
+  CHECK(xQueueSemaphoreTake_fake.call_count == 40);
+  CHECK(xQueueGenericSend_fake.call_count == 41);
+}
 }  // namespace sjsu::rtos
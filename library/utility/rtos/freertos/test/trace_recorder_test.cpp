@@ -0,0 +1,160 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "testing/testing_frameworks.hpp"
+#include "utility/rtos/freertos/trace_recorder.hpp"
+
+namespace sjsu::rtos
+{
+TEST_CASE("Testing TraceRecorder")
+{
+  // Setup: A clock that only moves when told to
+  std::chrono::nanoseconds now = 0ns;
+  SetUptimeFunction([&now]() { return now; });
+
+  std::array<TraceEvent_t, 4> events;
+  std::array<TraceTask_t, 2> tasks;
+  TraceRecorder test_subject(events, tasks);
+
+  SECTION("Events are only recorded while recording")
+  {
+    // Exercise
+    test_subject.Record(TraceEvent::kTaskSwitchIn, 1, 2);
+    test_subject.Start();
+    now = 5us;
+    test_subject.Record(TraceEvent::kQueueSend, 3, 70'000);
+    test_subject.Stop();
+    test_subject.Record(TraceEvent::kTaskSwitchIn, 1, 2);
+
+    // Verify
+    REQUIRE(1 == test_subject.Size());
+    const TraceEvent_t & event = test_subject.GetEvent(0);
+    CHECK(5 == event.timestamp);
+    CHECK(TraceEvent::kQueueSend == event.type);
+    CHECK(3 == event.id);
+    CHECK(UINT16_MAX == event.argument);
+    CHECK(!test_subject.IsRecording());
+  }
+
+  SECTION("The oldest events are overwritten")
+  {
+    // Exercise
+    test_subject.Start();
+    for (uint32_t i = 0; i < 6; i++)
+    {
+      now = std::chrono::microseconds(i);
+      test_subject.Record(TraceEvent::kIsrEnter, i);
+    }
+
+    // Verify
+    CHECK(4 == test_subject.Size());
+    CHECK(4 == test_subject.GetCapacity());
+    CHECK(2 == test_subject.GetOverwritten());
+    for (uint32_t i = 0; i < 4; i++)
+    {
+      CHECK(i + 2 == test_subject.GetEvent(i).id);
+    }
+
+    // Exercise + Verify: Starting again clears the buffer
+    test_subject.Start();
+    CHECK(0 == test_subject.Size());
+    CHECK(0 == test_subject.GetOverwritten());
+  }
+
+  SECTION("Ids above 255 are truncated and counted")
+  {
+    // Exercise
+    test_subject.Start();
+    test_subject.Record(TraceEvent::kQueueCreate, 255);
+    test_subject.Record(TraceEvent::kQueueCreate, 256);
+    test_subject.Record(TraceEvent::kQueueCreate, 300);
+
+    // Verify
+    CHECK(255 == test_subject.GetEvent(0).id);
+    CHECK(0 == test_subject.GetEvent(1).id);
+    CHECK(44 == test_subject.GetEvent(2).id);
+    CHECK(2 == test_subject.GetTruncated());
+
+    // Exercise + Verify: Starting again clears the count
+    test_subject.Start();
+    CHECK(0 == test_subject.GetTruncated());
+  }
+
+  SECTION("Task names are kept whether recording or not")
+  {
+    // Exercise
+    test_subject.RegisterTask(1, 2, "Short");
+    test_subject.RegisterTask(7, 3, "AVeryLongTaskNameIndeed");
+    test_subject.RegisterTask(9, 1, "NoRoom");
+    test_subject.RegisterTask(1, 4, "Renamed");
+
+    // Verify
+    CHECK(0 == test_subject.Size());
+    CHECK(1 == tasks[0].number);
+    CHECK(4 == tasks[0].priority);
+    CHECK(std::string("Renamed") == tasks[0].name.data());
+    CHECK(7 == tasks[1].number);
+    CHECK(std::string("AVeryLongTaskNa") == tasks[1].name.data());
+  }
+
+  SECTION("Dump")
+  {
+    // Setup
+    test_subject.RegisterTask(3, 2, "Idle");
+    test_subject.Start();
+    now = 0x1234us;
+    test_subject.Record(TraceEvent::kTaskSwitchOut, 3, 0x150);
+
+    // Exercise
+    std::vector<uint8_t> dump;
+    test_subject.Dump([&dump](std::span<const uint8_t> bytes) {
+      dump.insert(dump.end(), bytes.begin(), bytes.end());
+    });
+
+    // Verify
+    constexpr size_t kHeader = TraceRecorder::kDumpHeaderSize;
+    constexpr size_t kTask   = TraceRecorder::kDumpTaskSize;
+    REQUIRE(kHeader + kTask + TraceRecorder::kDumpEventSize == dump.size());
+
+    const std::vector<uint8_t> kExpectedHeader = {
+      'R', 'T', 'T', 'R',  // magic
+      1,   0,              // version
+      1,   0,              // tasks
+      1,   0,   0,   0,    // events
+      0,   0,   0,   0,    // overwritten
+      0x40, 0x42, 0x0F, 0,  // timestamp frequency
+    };
+    CHECK(kExpectedHeader ==
+          std::vector<uint8_t>(dump.begin(), dump.begin() + kHeader));
+
+    const std::vector<uint8_t> kExpectedTask = {
+      3,   2,   0,   0,    // number, priority, reserved
+      'I', 'd', 'l', 'e', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+    const auto kTaskRecord = dump.begin() + kHeader;
+    CHECK(kExpectedTask ==
+          std::vector<uint8_t>(kTaskRecord, kTaskRecord + kTask));
+
+    const std::vector<uint8_t> kExpectedEvent = {
+      0x34, 0x12, 0, 0,  // timestamp
+      2,    3,           // type, id
+      0x50, 0x01,        // argument
+    };
+    CHECK(kExpectedEvent ==
+          std::vector<uint8_t>(kTaskRecord + kTask, dump.end()));
+  }
+
+  SECTION("Platform recorder")
+  {
+    // Exercise + Verify
+    CHECK(nullptr == TraceRecorder::GetPlatformRecorder());
+    TraceRecorder::SetPlatformRecorder(&test_subject);
+    CHECK(&test_subject == TraceRecorder::GetPlatformRecorder());
+    TraceRecorder::SetPlatformRecorder(nullptr);
+  }
+
+  SetUptimeFunction(nullptr);
+}
+}  // namespace sjsu::rtos
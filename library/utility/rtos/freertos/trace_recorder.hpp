@@ -0,0 +1,355 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "utility/math/byte.hpp"
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+namespace rtos
+{
+/// Kinds of events recorded by the TraceRecorder. The values are part of the
+/// binary dump format, and the FreeRTOS hooks in trace_hooks.h use the same
+/// numbers.
+enum class TraceEvent : uint8_t
+{
+  /// A task starts running. id: task number, argument: its priority.
+  kTaskSwitchIn = 1,
+  /// A task stops running. id: task number, argument: words of stack left.
+  kTaskSwitchOut = 2,
+  /// A task was created. id: task number, argument: its priority.
+  kTaskCreate = 3,
+  /// A task was deleted. id: task number.
+  kTaskDelete = 4,
+  /// A task inherited the priority of a task waiting on its mutex.
+  /// id: task number, argument: its new priority.
+  kPriorityInherit = 5,
+  /// A task returned to its base priority after giving back a mutex.
+  /// id: task number, argument: its new priority.
+  kPriorityDisinherit = 6,
+  /// A queue, semaphore or mutex was created. id: queue number, argument:
+  /// FreeRTOS queue type (queueQUEUE_TYPE_*).
+  kQueueCreate = 7,
+  /// An item was sent, or a semaphore or mutex given. id: queue number,
+  /// argument: items in the queue before the call.
+  kQueueSend = 8,
+  /// A send failed because the queue stayed full. Arguments as kQueueSend.
+  kQueueSendFailed = 9,
+  /// An item was received, or a semaphore or mutex taken. id: queue number,
+  /// argument: items in the queue before the call.
+  kQueueReceive = 10,
+  /// A receive failed because the queue stayed empty. Arguments as
+  /// kQueueReceive.
+  kQueueReceiveFailed = 11,
+  /// The running task blocks until it can send. Arguments as kQueueSend.
+  kQueueBlockOnSend = 12,
+  /// The running task blocks until it can receive. Arguments as
+  /// kQueueReceive.
+  kQueueBlockOnReceive = 13,
+  /// An interrupt handler starts. id: interrupt vector table index.
+  kIsrEnter = 14,
+  /// An interrupt handler returns. id: interrupt vector table index.
+  kIsrExit = 15,
+};
+
+/// One recorded event. 8 bytes, so a few kilobytes of RAM hold thousands.
+struct TraceEvent_t
+{
+  /// Uptime() in microseconds, wrapping after 71 minutes.
+  uint32_t timestamp;
+  /// What happened.
+  TraceEvent type;
+  /// Task number, queue number or vector index, depending on the type. Only
+  /// the low 8 bits are kept, see TraceRecorder::GetTruncated().
+  uint8_t id;
+  /// Depends on the type, see TraceEvent.
+  uint16_t argument;
+};
+
+/// Name and priority of a task, kept apart from the events so a task's name is
+/// known even if its creation was overwritten in the ring buffer.
+struct TraceTask_t
+{
+  /// Longest name kept, including the null terminator.
+  static constexpr size_t kNameLength = 16;
+
+  /// Task number, or 0 if this entry is unused.
+  uint8_t number = 0;
+  /// Priority given when the task was created.
+  uint8_t priority = 0;
+  /// Null terminated name of the task.
+  std::array<char, kNameLength> name = {};
+};
+
+/// Records scheduling, queue and interrupt events into a RAM ring buffer, to
+/// be exported and viewed as a timeline on a computer, see Dump().
+///
+/// The FreeRTOS kernel reports its events through trace hooks, compiled in by
+/// defining SJ2_ENABLE_RTOS_TRACE on the compiler command line, and the Cortex
+/// interrupt controller reports each interrupt it dispatches. Events are
+/// recorded into the platform recorder:
+///
+/// ```
+///   std::array<sjsu::rtos::TraceEvent_t, 1024> events;
+///   std::array<sjsu::rtos::TraceTask_t, 16> tasks;
+///   sjsu::rtos::TraceRecorder recorder(events, tasks);
+///   sjsu::rtos::TraceRecorder::SetPlatformRecorder(&recorder);
+///   recorder.Start();
+/// ```
+///
+/// Once the buffer is full, the oldest events are overwritten, so it always
+/// holds the most recent history.
+class TraceRecorder
+{
+ public:
+  /// Identifies the start of a binary dump.
+  static constexpr uint32_t kDumpMagic = 0x5254'5452;  // "RTTR"
+  /// Version of the binary dump format.
+  static constexpr uint16_t kDumpVersion = 1;
+  /// Size of the dump header: magic (u32), version (u16), number of task
+  /// records (u16), number of event records (u32), events overwritten before
+  /// the oldest record (u32), timestamp ticks per second (u32).
+  static constexpr size_t kDumpHeaderSize = 20;
+  /// Size of each task record: number (u8), priority (u8), reserved (u16),
+  /// null padded name (16 bytes).
+  static constexpr size_t kDumpTaskSize = 4 + TraceTask_t::kNameLength;
+  /// Size of each event record, oldest first: timestamp (u32), type (u8),
+  /// id (u8), argument (u16). Every field is little-endian.
+  static constexpr size_t kDumpEventSize = 8;
+  /// Timestamps count microseconds.
+  static constexpr uint32_t kTimestampFrequency = 1'000'000;
+
+  /// @return the recorder that the RTOS and interrupt hooks record into, or
+  ///         nullptr if none has been set.
+  static TraceRecorder * GetPlatformRecorder()
+  {
+    return platform_recorder;
+  }
+
+  /// @param recorder - recorder to return from GetPlatformRecorder().
+  static void SetPlatformRecorder(TraceRecorder * recorder)
+  {
+    platform_recorder = recorder;
+  }
+
+  /// @param events - ring buffer to record events into.
+  /// @param tasks - table of the names of tasks created while this recorder
+  ///        is the platform recorder.
+  constexpr TraceRecorder(std::span<TraceEvent_t> events,
+                          std::span<TraceTask_t> tasks)
+      : events_(events), tasks_(tasks)
+  {
+  }
+
+  /// Clear the buffer and begin recording events.
+  void Start()
+  {
+    Clear();
+    recording_ = true;
+  }
+
+  /// Stop recording events, so the buffer can be exported unchanged.
+  void Stop()
+  {
+    recording_ = false;
+  }
+
+  /// @return true if events are being recorded.
+  bool IsRecording() const
+  {
+    return recording_;
+  }
+
+  /// Forget every recorded event. Task names are kept.
+  void Clear()
+  {
+    count_     = 0;
+    truncated_ = 0;
+  }
+
+  /// Record an event, if recording. Safe to call from interrupts, including
+  /// ones that preempt another call.
+  ///
+  /// @param type - what happened.
+  /// @param id - task number, queue number or vector index. Only the low 8
+  ///        bits are recorded, so ids above 255 alias lower ones, and are
+  ///        counted by GetTruncated().
+  /// @param argument - depends on the type, see TraceEvent. Saturates at
+  ///        UINT16_MAX.
+  void Record(TraceEvent type, uint32_t id, uint32_t argument = 0)
+  {
+    if (!recording_ || events_.empty())
+    {
+      return;
+    }
+    const uint32_t kArgument = std::min<uint32_t>(argument, UINT16_MAX);
+    if (id > UINT8_MAX)
+    {
+      truncated_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Claiming the slot first means a nested call gets the next one, rather
+    // than both writing into the same event.
+    const uint32_t kIndex = count_.fetch_add(1, std::memory_order_relaxed);
+    events_[kIndex % events_.size()] = {
+      .timestamp = Timestamp(),
+      .type      = type,
+      .id        = static_cast<uint8_t>(id),
+      .argument  = static_cast<uint16_t>(kArgument),
+    };
+  }
+
+  /// Remember the name of a task, whether recording or not, and record its
+  /// creation.
+  ///
+  /// @param number - unique number of the task.
+  /// @param priority - priority of the task.
+  /// @param name - name of the task. Truncated to fit TraceTask_t.
+  void RegisterTask(uint32_t number, uint32_t priority, const char * name)
+  {
+    TraceTask_t * entry = FindTask(static_cast<uint8_t>(number));
+    if (entry == nullptr)
+    {
+      entry = FindTask(0);
+    }
+    if (entry != nullptr)
+    {
+      entry->number   = static_cast<uint8_t>(number);
+      entry->priority = static_cast<uint8_t>(priority);
+      entry->name     = {};
+      for (size_t i = 0; i < entry->name.size() - 1 && name[i] != '\0'; i++)
+      {
+        entry->name[i] = name[i];
+      }
+    }
+    Record(TraceEvent::kTaskCreate, number, priority);
+  }
+
+  /// @return the number of events in the buffer.
+  size_t Size() const
+  {
+    return std::min<size_t>(count_, events_.size());
+  }
+
+  /// @return the most events the buffer holds.
+  size_t GetCapacity() const
+  {
+    return events_.size();
+  }
+
+  /// @return the number of events overwritten since recording began.
+  uint32_t GetOverwritten() const
+  {
+    return count_ - static_cast<uint32_t>(Size());
+  }
+
+  /// @return the number of events recorded since recording began whose id
+  ///         did not fit in TraceEvent_t::id. Queue numbers only ever grow, so
+  ///         this becomes non-zero once more than 255 queues, semaphores or
+  ///         mutexes have been created.
+  uint32_t GetTruncated() const
+  {
+    return truncated_;
+  }
+
+  /// @param index - 0 for the oldest event in the buffer, up to Size() - 1.
+  /// @return the event at that position.
+  const TraceEvent_t & GetEvent(size_t index) const
+  {
+    return events_[(GetOverwritten() + index) % events_.size()];
+  }
+
+  /// @return table of the tasks' names.
+  std::span<const TraceTask_t> GetTasks() const
+  {
+    return tasks_;
+  }
+
+  /// Write the task names and every event in the buffer in a binary format,
+  /// see kDumpHeaderSize, kDumpTaskSize and kDumpEventSize. Stop() recording
+  /// first, otherwise new events may overwrite the ones being written.
+  ///
+  /// @param write - called with the header, then each task record, then each
+  ///        event record.
+  void Dump(const std::function<void(std::span<const uint8_t>)> & write) const
+  {
+    const auto kTasks =
+        std::count_if(tasks_.begin(), tasks_.end(), [](const auto & task) {
+          return task.number != 0;
+        });
+
+    std::array<uint8_t, kDumpHeaderSize> header;
+    size_t position = 0;
+    PutLittleEndian(header, position, kDumpMagic);
+    PutLittleEndian(header, position, kDumpVersion);
+    PutLittleEndian(header, position, static_cast<uint16_t>(kTasks));
+    PutLittleEndian(header, position, static_cast<uint32_t>(Size()));
+    PutLittleEndian(header, position, GetOverwritten());
+    PutLittleEndian(header, position, kTimestampFrequency);
+    write(header);
+
+    for (const TraceTask_t & task : tasks_)
+    {
+      if (task.number == 0)
+      {
+        continue;
+      }
+      std::array<uint8_t, kDumpTaskSize> record;
+      position = 0;
+      PutLittleEndian(record, position, task.number);
+      PutLittleEndian(record, position, task.priority);
+      PutLittleEndian(record, position, uint16_t{ 0 });
+      for (char character : task.name)
+      {
+        PutLittleEndian(record, position, static_cast<uint8_t>(character));
+      }
+      write(record);
+    }
+
+    for (size_t i = 0; i < Size(); i++)
+    {
+      const TraceEvent_t & event = GetEvent(i);
+      std::array<uint8_t, kDumpEventSize> record;
+      position = 0;
+      PutLittleEndian(record, position, event.timestamp);
+      PutLittleEndian(record, position, static_cast<uint8_t>(event.type));
+      PutLittleEndian(record, position, event.id);
+      PutLittleEndian(record, position, event.argument);
+      write(record);
+    }
+  }
+
+ private:
+  static uint32_t Timestamp()
+  {
+    return static_cast<uint32_t>(Uptime() / 1us);
+  }
+
+  TraceTask_t * FindTask(uint8_t number)
+  {
+    for (TraceTask_t & task : tasks_)
+    {
+      if (task.number == number)
+      {
+        return &task;
+      }
+    }
+    return nullptr;
+  }
+
+  static inline TraceRecorder * platform_recorder = nullptr;
+
+  std::span<TraceEvent_t> events_;
+  std::span<TraceTask_t> tasks_;
+  std::atomic<uint32_t> count_     = 0;
+  std::atomic<uint32_t> truncated_ = 0;
+  std::atomic<bool> recording_     = false;
+};
+}  // namespace rtos
+}  // namespace sjsu
@@ -0,0 +1,170 @@
+#include <cstdint>
+#include <vector>
+
+#include "testing/testing_frameworks.hpp"
+#include "utility/deferred_work.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing DeferredWork")
+{
+  // Setup: A clock that only moves when told to
+  std::chrono::nanoseconds now = 0ns;
+  SetUptimeFunction([&now]() { return now; });
+
+  DeferredWork test_subject;
+  std::vector<uint32_t> payloads;
+  DeferredWork::Source_t source(
+      test_subject, "source", [&payloads](uint32_t payload) {
+        payloads.push_back(payload);
+      });
+
+  SECTION("Handlers run in order when drained")
+  {
+    // Exercise
+    CHECK(source.Post(1));
+    CHECK(source.Post(2));
+    CHECK(source.Post(3));
+
+    // Verify
+    CHECK(payloads.empty());
+    CHECK(3 == test_subject.Size());
+    CHECK(3 == test_subject.Drain());
+    CHECK(std::vector<uint32_t>{ 1, 2, 3 } == payloads);
+    CHECK(0 == test_subject.Size());
+    CHECK(0 == test_subject.Drain());
+  }
+
+  SECTION("Drain runs at most a batch")
+  {
+    // Setup
+    for (uint32_t i = 0; i < 5; i++)
+    {
+      source.Post(i);
+    }
+
+    // Exercise + Verify
+    CHECK(2 == test_subject.Drain(2));
+    CHECK(2 == test_subject.Drain(2));
+    CHECK(1 == test_subject.Drain(2));
+    CHECK(std::vector<uint32_t>{ 0, 1, 2, 3, 4 } == payloads);
+  }
+
+  SECTION("Full queue drops items")
+  {
+    // Setup
+    for (size_t i = 0; i < DeferredWork::kCapacity; i++)
+    {
+      CHECK(source.Post());
+    }
+
+    // Exercise + Verify
+    CHECK(!source.Post());
+    CHECK(1 == source.GetStatistics().dropped);
+
+    // Exercise + Verify: Space is reused once drained, around the ring
+    CHECK(DeferredWork::kCapacity == test_subject.Drain(SIZE_MAX));
+    for (size_t i = 0; i < DeferredWork::kCapacity; i++)
+    {
+      CHECK(source.Post());
+    }
+    CHECK(DeferredWork::kCapacity == test_subject.Drain(SIZE_MAX));
+  }
+
+  SECTION("Statistics")
+  {
+    // Setup
+    std::vector<uint32_t> other_payloads;
+    DeferredWork::Source_t other(
+        test_subject, "other", [&other_payloads](uint32_t payload) {
+          other_payloads.push_back(payload);
+        });
+
+    // Exercise
+    source.Post(1);
+    now += 100us;
+    other.Post(2);
+    source.Post(3);
+    now += 50us;
+    test_subject.Drain();
+
+    // Verify
+    const auto kSource = source.GetStatistics();
+    CHECK(2 == kSource.posted);
+    CHECK(2 == kSource.completed);
+    CHECK(0 == kSource.pending);
+    CHECK(2 == kSource.maximum_pending);
+    CHECK(150us == kSource.maximum_latency);
+    CHECK(200us == kSource.total_latency);
+    CHECK(100us == kSource.AverageLatency());
+
+    const auto kOther = other.GetStatistics();
+    CHECK(1 == kOther.completed);
+    CHECK(1 == kOther.maximum_pending);
+    CHECK(50us == kOther.maximum_latency);
+    CHECK(std::vector<uint32_t>{ 2 } == other_payloads);
+
+    CHECK(std::string("source") == source.GetName());
+
+    // Exercise + Verify
+    source.ResetStatistics();
+    CHECK(0 == source.GetStatistics().completed);
+    CHECK(0us == source.GetStatistics().maximum_latency);
+  }
+
+  SECTION("Interrupt handler posts")
+  {
+    // Setup
+    InterruptHandler handler = source.ToInterruptHandler();
+
+    // Exercise
+    handler();
+    test_subject.Drain();
+
+    // Verify
+    CHECK(std::vector<uint32_t>{ 0 } == payloads);
+  }
+
+  SECTION("Served from a software triggered interrupt")
+  {
+    // Setup
+    constexpr int kIrq     = 12;
+    InterruptHandler serve = nullptr;
+    Mock<sjsu::InterruptController> mock_interrupt_controller;
+    When(Method(mock_interrupt_controller, Enable))
+        .AlwaysDo(
+            [&serve](sjsu::InterruptController::RegistrationInfo_t info) {
+              serve = info.interrupt_handler;
+            });
+    Fake(Method(mock_interrupt_controller, Trigger));
+    sjsu::InterruptController::SetPlatformController(
+        &mock_interrupt_controller.get());
+
+    // Exercise
+    test_subject.AttachInterrupt(kIrq, 7, 2);
+    source.Post(1);
+    source.Post(2);
+    source.Post(3);
+
+    // Verify
+    using RegistrationInfo_t = sjsu::InterruptController::RegistrationInfo_t;
+    Verify(Method(mock_interrupt_controller, Enable)
+               .Matching([](RegistrationInfo_t info) {
+                 return info.interrupt_request_number == kIrq &&
+                        info.priority == 7;
+               }))
+        .Once();
+    Verify(Method(mock_interrupt_controller, Trigger).Using(kIrq)).Exactly(3);
+
+    // Exercise + Verify: A full batch triggers the interrupt again
+    serve();
+    CHECK(std::vector<uint32_t>{ 1, 2 } == payloads);
+    Verify(Method(mock_interrupt_controller, Trigger).Using(kIrq)).Exactly(4);
+    serve();
+    CHECK(std::vector<uint32_t>{ 1, 2, 3 } == payloads);
+    Verify(Method(mock_interrupt_controller, Trigger).Using(kIrq)).Exactly(4);
+  }
+
+  SetUptimeFunction(nullptr);
+}
+}  // namespace sjsu
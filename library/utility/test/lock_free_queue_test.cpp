@@ -0,0 +1,205 @@
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "testing/testing_frameworks.hpp"
+#include "utility/lock_free_queue.hpp"
+
+namespace sjsu
+{
+namespace
+{
+using TestSpscQueue = SpscQueue<uint32_t, 8>;
+using TestMpscQueue = MpscQueue<uint32_t, 8>;
+}  // namespace
+
+TEST_CASE_TEMPLATE("Testing lock-free queues",
+                   Queue,
+                   TestSpscQueue,
+                   TestMpscQueue)
+{
+  Queue test_subject;
+
+  SECTION("Items come out in the order they went in")
+  {
+    // Exercise
+    CHECK(test_subject.Push(1));
+    CHECK(test_subject.Push(2));
+    CHECK(test_subject.Push(3));
+
+    // Verify
+    uint32_t item = 0;
+    CHECK(3 == test_subject.Size());
+    CHECK(test_subject.Pop(item));
+    CHECK(1 == item);
+    CHECK(test_subject.Pop(item));
+    CHECK(2 == item);
+    CHECK(test_subject.Pop(item));
+    CHECK(3 == item);
+    CHECK(!test_subject.Pop(item));
+    CHECK(test_subject.IsEmpty());
+  }
+
+  SECTION("Pushing to a full queue fails")
+  {
+    // Exercise
+    for (uint32_t i = 0; i < Queue::kCapacity; i++)
+    {
+      CHECK(test_subject.Push(i));
+    }
+
+    // Verify
+    CHECK(!test_subject.Push(100));
+    CHECK(Queue::kCapacity == test_subject.Size());
+
+    uint32_t item = 0;
+    CHECK(test_subject.Pop(item));
+    CHECK(0 == item);
+    CHECK(test_subject.Push(100));
+  }
+
+  SECTION("Bulk push and pop take as many items as fit")
+  {
+    // Setup
+    const std::array<uint32_t, 6> kItems = { 1, 2, 3, 4, 5, 6 };
+    std::array<uint32_t, 4> popped       = {};
+
+    // Exercise + Verify
+    CHECK(6 == test_subject.Push(kItems));
+    CHECK(2 == test_subject.Push(kItems));
+    CHECK(4 == test_subject.Pop(popped));
+    CHECK(std::array<uint32_t, 4>{ 1, 2, 3, 4 } == popped);
+    CHECK(4 == test_subject.Pop(popped));
+    CHECK(std::array<uint32_t, 4>{ 5, 6, 1, 2 } == popped);
+    CHECK(0 == test_subject.Pop(popped));
+  }
+
+  SECTION("Pushing nothing adds nothing")
+  {
+    // Exercise + Verify
+    CHECK(0 == test_subject.Push(std::span<const uint32_t>()));
+    CHECK(test_subject.IsEmpty());
+    for (uint32_t i = 0; i < Queue::kCapacity; i++)
+    {
+      CHECK(test_subject.Push(i));
+    }
+    CHECK(0 == test_subject.Push(std::span<const uint32_t>()));
+    CHECK(Queue::kCapacity == test_subject.Size());
+  }
+
+  SECTION("Positions wrap around the buffer")
+  {
+    // Exercise + Verify
+    uint32_t item = 0;
+    for (uint32_t i = 0; i < 10 * Queue::kCapacity + 3; i++)
+    {
+      CHECK(test_subject.Push(i));
+      CHECK(test_subject.Pop(item));
+      CHECK(i == item);
+    }
+    CHECK(test_subject.IsEmpty());
+  }
+
+  SECTION("Waiting pops")
+  {
+    // Exercise + Verify
+    uint32_t item = 0;
+    CHECK(!test_subject.Pop(item, 0ns));
+    CHECK(test_subject.Push(7));
+    CHECK(test_subject.Pop(item, 0ns));
+    CHECK(7 == item);
+  }
+
+  SECTION("A producer thread and a consumer thread")
+  {
+    // Setup
+    constexpr uint32_t kCount = 100'000;
+    uint32_t expected         = 0;
+    bool in_order             = true;
+
+    // Exercise
+    std::thread producer([&test_subject]() {
+      for (uint32_t i = 0; i < kCount; i++)
+      {
+        while (!test_subject.Push(i))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+    while (expected < kCount)
+    {
+      uint32_t item = 0;
+      if (test_subject.Pop(item, std::chrono::nanoseconds::max()))
+      {
+        in_order = in_order && (item == expected);
+        expected++;
+      }
+    }
+    producer.join();
+
+    // Verify
+    CHECK(in_order);
+    CHECK(test_subject.IsEmpty());
+  }
+}
+
+TEST_CASE("Testing MpscQueue with many producers")
+{
+  // Setup
+  constexpr uint32_t kProducers = 4;
+  constexpr uint32_t kCount     = 50'000;
+  MpscQueue<uint32_t, 64> test_subject;
+  std::array<uint32_t, kProducers> next = {};
+  bool in_order                         = true;
+
+  // Exercise: Each producer pushes its own increasing sequence, in bulk
+  std::vector<std::thread> producers;
+  for (uint32_t producer = 0; producer < kProducers; producer++)
+  {
+    producers.emplace_back([&test_subject, producer]() {
+      std::array<uint32_t, 3> items;
+      uint32_t sent = 0;
+      while (sent < kCount)
+      {
+        uint32_t length = 0;
+        for (; length < items.size() && sent + length < kCount; length++)
+        {
+          items[length] = (producer << 24) | (sent + length);
+        }
+        sent += static_cast<uint32_t>(test_subject.Push(
+            std::span<const uint32_t>(items.data(), length)));
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  uint32_t received = 0;
+  while (received < kProducers * kCount)
+  {
+    std::array<uint32_t, 8> items;
+    const size_t kPopped =
+        test_subject.Pop(items, std::chrono::nanoseconds::max());
+    for (size_t i = 0; i < kPopped; i++)
+    {
+      const uint32_t kProducer = items[i] >> 24;
+      in_order = in_order && ((items[i] & 0xFF'FFFF) == next[kProducer]);
+      next[kProducer]++;
+    }
+    received += static_cast<uint32_t>(kPopped);
+  }
+  for (std::thread & producer : producers)
+  {
+    producer.join();
+  }
+
+  // Verify: Items of one producer stay in order, and none are lost
+  CHECK(in_order);
+  for (uint32_t count : next)
+  {
+    CHECK(kCount == count);
+  }
+  CHECK(test_subject.IsEmpty());
+}
+}  // namespace sjsu
@@ -6,9 +6,11 @@
 #include "utility/test/config_test.cpp"               // NOLINT
 #include "utility/test/constexpr_test.cpp"            // NOLINT
 #include "utility/test/debug_test.cpp"                // NOLINT
+#include "utility/test/deferred_work_test.cpp"        // NOLINT
 #include "utility/test/enum_test.cpp"                 // NOLINT
 #include "utility/test/error_handling_test.cpp"       // NOLINT
 #include "utility/test/infrared_algorithms_test.cpp"  // NOLINT
+#include "utility/test/lock_free_queue_test.cpp"     // NOLINT
 #include "utility/test/log_levels_test.cpp"           // NOLINT
 #include "utility/test/memory_resource_test.cpp"      // NOLINT
 
@@ -18,6 +20,7 @@
 
 #include "utility/math/test/average_test.cpp"  // NOLINT
 #include "utility/math/test/bit_test.cpp"      // NOLINT
+#include "utility/math/test/byte_test.cpp"     // NOLINT
 #include "utility/math/test/crc_test.cpp"      // NOLINT
 #include "utility/math/test/limits_test.cpp"   // NOLINT
 #include "utility/math/test/map_test.cpp"      // NOLINT
@@ -26,9 +29,11 @@
 // RTOS
 // =============================================================================
 
-#include "utility/rtos/freertos/test/periodic_scheduler_test.cpp"  // NOLINT
-#include "utility/rtos/freertos/test/rtos_test.cpp"                // NOLINT
-#include "utility/rtos/freertos/test/task_scheduler_test.cpp"      // NOLINT
+#include "utility/rtos/freertos/test/periodic_scheduler_test.cpp"        // NOLINT
+#include "utility/rtos/freertos/test/rate_monotonic_scheduler_test.cpp"  // NOLINT
+#include "utility/rtos/freertos/test/rtos_test.cpp"                      // NOLINT
+#include "utility/rtos/freertos/test/task_scheduler_test.cpp"            // NOLINT
+#include "utility/rtos/freertos/test/trace_recorder_test.cpp"            // NOLINT
 
 // =============================================================================
 // FILE I/O
@@ -42,9 +47,12 @@
 // =============================================================================
 
 #include "utility/console/commands/test/arm_system_command_test.cpp"  // NOLINT
+#include "utility/console/commands/test/can_command_test.cpp"         // NOLINT
 #include "utility/console/commands/test/common_test.cpp"              // NOLINT
 #include "utility/console/commands/test/i2c_command_test.cpp"         // NOLINT
+#include "utility/console/commands/test/interrupt_command_test.cpp"   // NOLINT
 #include "utility/console/commands/test/rtos_command_test.cpp"        // NOLINT
+#include "utility/console/commands/test/trace_command_test.cpp"       // NOLINT
 #include "utility/console/test/console_test.cpp"                      // NOLINT
 
 // =============================================================================
@@ -54,3 +62,5 @@
 #include "utility/time/test/stopwatch_test.cpp"      // NOLINT
 #include "utility/time/test/time_test.cpp"           // NOLINT
 #include "utility/time/test/timeout_timer_test.cpp"  // NOLINT
+#include "utility/time/test/timer_wheel_test.cpp"    // NOLINT
+#include "utility/time/test/wait_signal_test.cpp"    // NOLINT
@@ -40,6 +40,20 @@ TEST_CASE("Testing Time Utility")
     CHECK(uptime_was_set);
   }
 
+  SECTION("SetUptimeFunction(nullptr) returns to the platform clock")
+  {
+    // Setup
+    SetUptimeFunction([]() { return 1s; });
+
+    // Exercise
+    SetUptimeFunction(nullptr);
+
+    // Verify: On host builds, the platform clock is DefaultUptime()
+    auto first_uptime = Uptime();
+    CHECK(first_uptime + 1us == PlatformUptime());
+    CHECK(first_uptime + 2us == Uptime());
+  }
+
   SECTION("Delay()")
   {
     // Setup
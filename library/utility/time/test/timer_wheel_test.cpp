@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "testing/testing_frameworks.hpp"
+#include "utility/time/timer_wheel.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing TimerWheel")
+{
+  // Setup
+  std::chrono::nanoseconds now = 0ns;
+  SetUptimeFunction([&now]() { return now; });
+
+  TimerWheel wheel(100us);
+
+  int fired = 0;
+  TimerWheel::Timeout_t timeout([&fired]() { fired++; });
+
+  auto advance_to = [&](std::chrono::nanoseconds time) {
+    now = time;
+    wheel.Advance(now);
+  };
+
+  // Timeout callbacks capture at most two pointers, so the ones that record
+  // when they fired share this.
+  struct Recorder_t
+  {
+    std::chrono::nanoseconds & now;
+    std::vector<std::chrono::nanoseconds> fired_at;
+  };
+
+  SECTION("Expires on the first tick at or after the deadline")
+  {
+    // Exercise
+    wheel.Schedule(timeout, 250us);
+
+    // Verify
+    CHECK(timeout.IsScheduled());
+    CHECK(1 == wheel.Size());
+    advance_to(299us);
+    CHECK(0 == fired);
+    advance_to(300us);
+    CHECK(1 == fired);
+    CHECK(!timeout.IsScheduled());
+    CHECK(0 == wheel.Size());
+  }
+
+  SECTION("Scheduled part way through a tick, expires no earlier")
+  {
+    // Setup
+    now = 190us;
+
+    // Exercise
+    wheel.Schedule(timeout, 100us);
+
+    // Verify
+    advance_to(200us);
+    CHECK(0 == fired);
+    advance_to(299us);
+    CHECK(0 == fired);
+    advance_to(300us);
+    CHECK(1 == fired);
+  }
+
+  SECTION("Zero delay expires on the next tick")
+  {
+    // Exercise
+    wheel.Schedule(timeout, 0us);
+    advance_to(100us);
+
+    // Verify
+    CHECK(1 == fired);
+  }
+
+  SECTION("Cancel")
+  {
+    // Setup
+    wheel.Schedule(timeout, 1ms);
+
+    // Exercise + Verify
+    CHECK(wheel.Cancel(timeout));
+    CHECK(!wheel.Cancel(timeout));
+    advance_to(2ms);
+    CHECK(0 == fired);
+    CHECK(0 == wheel.Size());
+  }
+
+  SECTION("Rescheduling replaces the deadline")
+  {
+    // Exercise
+    wheel.Schedule(timeout, 1ms);
+    wheel.Schedule(timeout, 10ms);
+    advance_to(5ms);
+
+    // Verify
+    CHECK(0 == fired);
+    CHECK(1 == wheel.Size());
+    advance_to(10ms);
+    CHECK(1 == fired);
+  }
+
+  SECTION("Deadlines in every level and beyond the range")
+  {
+    // Setup
+    const std::array<std::chrono::nanoseconds, 6> kDelays = {
+      1ms, 7ms, 400ms, 25s, 30min, 1000h,
+    };
+    Recorder_t recorder = { now, std::vector(kDelays.size(), -1ns) };
+    std::vector<std::unique_ptr<TimerWheel::Timeout_t>> timeouts;
+    for (size_t i = 0; i < kDelays.size(); i++)
+    {
+      timeouts.push_back(std::make_unique<TimerWheel::Timeout_t>(
+          [&recorder, i]() { recorder.fired_at[i] = recorder.now; }));
+      wheel.Schedule(*timeouts.back(), kDelays[i]);
+    }
+
+    // Exercise: Advance in uneven steps, like a late interrupt would
+    for (auto time = 0ns; time <= 1001h; time += 37ms)
+    {
+      advance_to(time);
+    }
+
+    // Verify
+    for (size_t i = 0; i < kDelays.size(); i++)
+    {
+      INFO("delay #" << i);
+      CHECK(kDelays[i] <= recorder.fired_at[i]);
+      CHECK(recorder.fired_at[i] < kDelays[i] + 37ms);
+    }
+  }
+
+  SECTION("10,000 random timeouts expire on time")
+  {
+    // Setup
+    constexpr size_t kCount = 10'000;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int64_t> delay_us(0, 2'000'000);
+
+    std::vector<std::chrono::microseconds> delays(kCount);
+    Recorder_t recorder = { now, std::vector(kCount, -1ns) };
+    std::vector<std::unique_ptr<TimerWheel::Timeout_t>> timeouts;
+    for (size_t i = 0; i < kCount; i++)
+    {
+      delays[i] = std::chrono::microseconds(delay_us(random));
+      timeouts.push_back(std::make_unique<TimerWheel::Timeout_t>(
+          [&recorder, i]() { recorder.fired_at[i] = recorder.now; }));
+      wheel.Schedule(*timeouts.back(), delays[i]);
+    }
+
+    // Setup: Cancel every tenth timeout
+    for (size_t i = 0; i < kCount; i += 10)
+    {
+      CHECK(wheel.Cancel(*timeouts[i]));
+    }
+    CHECK(kCount - kCount / 10 == wheel.Size());
+
+    // Exercise
+    for (auto time = 0ns; time <= 2100ms; time += 100us)
+    {
+      advance_to(time);
+    }
+
+    // Verify
+    size_t mismatches = 0;
+    for (size_t i = 0; i < kCount; i++)
+    {
+      const auto kExpected =
+          (i % 10 == 0) ? -1ns
+                        : std::max(100us, (delays[i] + 99us) / 100us * 100us);
+      mismatches += (recorder.fired_at[i] != kExpected);
+    }
+    CHECK(0 == mismatches);
+    CHECK(0 == wheel.Size());
+  }
+
+  SECTION("Callback can reschedule its own timeout")
+  {
+    // Setup
+    TimerWheel::Timeout_t periodic;
+    periodic.callback = [&wheel, &periodic]() {
+      wheel.Schedule(periodic, 1ms);
+    };
+    wheel.Schedule(periodic, 1ms);
+
+    // Exercise
+    for (auto time = 0ns; time <= 10ms; time += 100us)
+    {
+      advance_to(time);
+    }
+
+    // Verify: Scheduled again from its tenth expiry
+    CHECK(periodic.IsScheduled());
+    CHECK(1 == wheel.Size());
+    advance_to(10900us);
+    CHECK(periodic.IsScheduled());
+    wheel.Cancel(periodic);
+    advance_to(11ms);
+    CHECK(!periodic.IsScheduled());
+  }
+
+  SECTION("Callback can cancel a timeout that expires on the same tick")
+  {
+    // Setup
+    TimerWheel::Timeout_t first;
+    TimerWheel::Timeout_t second;
+    first.callback  = [&wheel, &second]() { wheel.Cancel(second); };
+    second.callback = [&wheel, &first]() { wheel.Cancel(first); };
+    wheel.Schedule(first, 1ms);
+    wheel.Schedule(second, 1ms);
+
+    // Exercise
+    advance_to(1ms);
+
+    // Verify: Whichever ran first cancelled the other, so neither is left
+    CHECK(!first.IsScheduled());
+    CHECK(!second.IsScheduled());
+    CHECK(0 == wheel.Size());
+  }
+
+  SECTION("Deferred timeouts run in RunDeferred()")
+  {
+    // Setup
+    TimerWheel::Timeout_t deferred([&fired]() { fired++; },
+                                   TimerWheel::Context::kDeferred);
+    TimerWheel::Timeout_t cancelled([&fired]() { fired++; },
+                                    TimerWheel::Context::kDeferred);
+    wheel.Schedule(deferred, 1ms);
+    wheel.Schedule(cancelled, 1ms);
+
+    // Exercise
+    advance_to(1ms);
+
+    // Verify
+    CHECK(0 == fired);
+    CHECK(0 == wheel.Size());
+    CHECK(deferred.IsScheduled());
+    CHECK(wheel.Cancel(cancelled));
+    CHECK(1 == wheel.RunDeferred());
+    CHECK(1 == fired);
+    CHECK(!deferred.IsScheduled());
+    CHECK(0 == wheel.RunDeferred());
+  }
+
+  SECTION("Threads take turns modifying the wheel")
+  {
+    // Setup
+    constexpr int kRounds = 20'000;
+    TimerWheel::Timeout_t first([&fired]() { fired++; });
+    TimerWheel::Timeout_t second([&fired]() { fired++; });
+
+    // Exercise: Each thread schedules and cancels its own timeout, while the
+    //           other thread links and unlinks its timeout in the same slots
+    auto churn = [&wheel](TimerWheel::Timeout_t * own, int offset) {
+      for (int i = 0; i < kRounds; i++)
+      {
+        wheel.Schedule(*own, std::chrono::microseconds(100 * (i % 8 + offset)));
+        wheel.Cancel(*own);
+      }
+      wheel.Schedule(*own, 1ms);
+    };
+    std::thread other(churn, &second, 1);
+    churn(&first, 0);
+    other.join();
+
+    // Verify
+    CHECK(2 == wheel.Size());
+    advance_to(1ms);
+    CHECK(2 == fired);
+    CHECK(0 == wheel.Size());
+  }
+
+  SECTION("Attach drives the wheel from a timer's match interrupt")
+  {
+    // Setup
+    InterruptCallback isr;
+    Mock<Timer> mock_timer;
+    When(Method(mock_timer, Initialize))
+        .AlwaysDo([&isr](units::frequency::hertz_t, InterruptCallback callback,
+                         int32_t) { isr = callback; });
+    Fake(Method(mock_timer, SetMatchBehavior), Method(mock_timer, Start));
+
+    // Exercise
+    wheel.Attach(mock_timer.get(), 1);
+    wheel.Schedule(timeout, 150us);
+    now = 200us;
+    isr();
+
+    // Verify
+    Verify(Method(mock_timer, Initialize).Using(1_MHz, _, -1),
+           Method(mock_timer, SetMatchBehavior)
+               .Using(100, Timer::MatchAction::kInterruptRestart, 1),
+           Method(mock_timer, Start));
+    CHECK(1 == fired);
+  }
+
+  SetUptimeFunction(DefaultUptime);
+}
+}  // namespace sjsu
@@ -0,0 +1,48 @@
+#include <cstdint>
+
+#include "testing/testing_frameworks.hpp"
+#include "utility/time/wait_signal.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing WaitSignal")
+{
+  // Setup: Without a scheduler, WaitSignal polls like sjsu::Wait()
+  WaitSignal signal;
+  int polls = 0;
+
+  SECTION("Returns true once is_done returns true")
+  {
+    // Exercise
+    bool finished = signal.Wait(1ms, [&polls]() { return ++polls == 10; });
+
+    // Verify
+    CHECK(finished);
+    CHECK(10 == polls);
+  }
+
+  SECTION("Returns false on timeout")
+  {
+    // Setup
+    const auto kStart = Uptime();
+
+    // Exercise
+    bool finished = signal.Wait(100us, [&polls]() {
+      polls++;
+      return false;
+    });
+
+    // Verify
+    CHECK(!finished);
+    CHECK(0 < polls);
+    CHECK(100us <= Uptime() - kStart);
+  }
+
+  SECTION("Notify without a waiting thread does nothing")
+  {
+    // Exercise + Verify
+    signal.Notify();
+    CHECK(signal.Wait(1ms, []() { return true; }));
+  }
+}
+}  // namespace sjsu
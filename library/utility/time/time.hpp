@@ -2,6 +2,7 @@
 
 #include <time.h>
 
+#include <chrono>
 #include <cstdint>
 #include <cinttypes>
 #include <functional>
@@ -29,24 +30,123 @@ inline std::chrono::nanoseconds DefaultUptime()
   return default_uptime;
 }
 
-/// Global Uptime function, preset to DefaultUptime() for testing purposes.
-/// In general, this function is overwritten by
-inline UptimeFunction Uptime = DefaultUptime;  // NOLINT
+/// Reads the hardware clock of bare metal platforms. Defined once by the
+/// platform's startup code, which knows which timer keeps time.
+///
+/// @return the time since the system started.
+std::chrono::nanoseconds SystemUptime();
+
+/// The platform's own monotonic clock, selected at compile time.
+///
+/// @return the time since the system started. On host test builds, this is
+///         DefaultUptime().
+inline std::chrono::nanoseconds PlatformUptime()
+{
+  if constexpr (build::IsPlatform(build::Platform::host))
+  {
+    return DefaultUptime();
+  }
+  else if constexpr (build::IsPlatform(build::Platform::linux))
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+  }
+  else
+  {
+    // Like nanosleep() below, this is removed from every other platform's
+    // build, so only bare metal startup code needs to define SystemUptime().
+    return SystemUptime();
+  }
+}
 
-/// Global count of the time.
-inline std::chrono::nanoseconds global_time = 0ns;
+/// Optional replacement for the platform clock, installed by
+/// SetUptimeFunction(). Empty unless an application or test supplies its own
+/// clock, such as a simulated one.
+inline UptimeFunction uptime_override = nullptr;  // NOLINT
 
-/// Returns the system uptime in nanoseconds, do not use this function directly
+/// @return the system uptime. Reads the platform clock directly, unless a
+///         clock has been installed with SetUptimeFunction().
+inline std::chrono::nanoseconds Uptime()
+{
+  if (uptime_override)
+  {
+    return uptime_override();
+  }
+  return PlatformUptime();
+}
+
+/// Replace the clock returned by Uptime(). Only needed to run code on a clock
+/// other than the platform's own, such as a simulated one in tests.
 ///
 /// @param uptime_function - new system wide uptime function to override the
-///        previous one.
+///        previous one. nullptr returns Uptime() to the platform clock.
 inline void SetUptimeFunction(UptimeFunction uptime_function)
 {
-  Uptime = uptime_function;
+  uptime_override = uptime_function;
+}
+
+/// Hooks into the operating system's scheduler, defined by its support code
+/// (see freertos_common.cpp). Like SystemUptime(), they are only referenced on
+/// bare metal platforms.
+///
+/// @return a handle to the calling thread, or nullptr if it cannot block,
+///         because the scheduler is not running or the caller is an interrupt.
+void * SystemThread();
+
+/// Block the calling thread for up to `duration`, rounded down to whole ticks
+/// of the scheduler. Returns immediately if `duration` is shorter than a tick.
+///
+/// @param duration - longest time to block for.
+/// @param wake_on_signal - return as soon as SystemSignal() is called for this
+///        thread, or immediately if it was called since the last such sleep.
+void SystemSleep(std::chrono::nanoseconds duration, bool wake_on_signal);
+
+/// Wake a thread from SystemSleep(). Can be called from interrupts.
+///
+/// @param thread - handle returned by SystemThread() in the sleeping thread.
+void SystemSignal(void * thread);
+
+/// True on the bare metal platforms, which define the scheduler hooks. Host
+/// and linux builds never reference them.
+constexpr bool kHasSchedulerHooks = !build::IsPlatform(build::Platform::host) &&
+                                    !build::IsPlatform(build::Platform::linux);
+
+/// @return the calling thread if Wait() can put it to sleep, otherwise nullptr.
+inline void * SleepableThread()
+{
+  if constexpr (kHasSchedulerHooks)
+  {
+    return SystemThread();
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
+/// Calls SystemSleep() on platforms that have scheduler hooks.
+inline void SleepThread(std::chrono::nanoseconds duration, bool wake_on_signal)
+{
+  if constexpr (kHasSchedulerHooks)
+  {
+    SystemSleep(duration, wake_on_signal);
+  }
+}
+
+/// Calls SystemSignal() on platforms that have scheduler hooks.
+inline void SignalThread(void * thread)
+{
+  if constexpr (kHasSchedulerHooks)
+  {
+    SystemSignal(thread);
+  }
 }
 
 /// Wait will until the is_done parameter returns true
 ///
+/// This always spins, since nothing tells it when is_done could change. To let
+/// an interrupt wake the waiting thread instead, see WaitSignal.
+///
 /// @param timeout the maximum amount of time to wait for the is_done to
 ///        return true.
 /// @param is_done will be run in a tight loop until it returns true or the
@@ -85,26 +185,36 @@ inline bool Wait(std::chrono::nanoseconds timeout,
     }
   }
 
-  global_time = Uptime();
-  while (global_time <= timeout_time)
+  while (Uptime() <= timeout_time)
   {
     if (is_done())
     {
       return true;
     }
-    global_time = Uptime();
   }
 
   return false;
 }
 
-/// Overload of `Wait` that merely takes a timeout.
+/// Overload of `Wait` that merely takes a timeout. With the scheduler running,
+/// the calling thread sleeps for the whole ticks of the wait, letting other
+/// tasks run, and only spins for the remaining part of a tick or two.
 ///
 /// @param timeout - the amount of time to wait.
 /// @return always returns std::errc::timed_out
 inline bool Wait(std::chrono::nanoseconds timeout)
 {
-  return Wait(timeout, []() -> bool { return false; });
+  auto never = []() -> bool { return false; };
+
+  if (timeout != std::chrono::nanoseconds::max() &&
+      SleepableThread() != nullptr)
+  {
+    const auto kEnd = Uptime() + timeout;
+    SleepThread(timeout, false);
+    return Wait(kEnd - Uptime(), never);
+  }
+
+  return Wait(timeout, never);
 }
 
 /// Declare an external linkage to the linux nanosleep() function. This is
@@ -144,7 +254,8 @@ inline void Delay(std::chrono::nanoseconds delay_time)
   }
   else
   {
-    // For all other systems use the Wait function to loop until time is up.
+    // For all other systems use the Wait function, which sleeps if the
+    // scheduler is running and loops until time is up otherwise.
     Wait(delay_time);
   }
 }
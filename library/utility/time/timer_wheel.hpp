@@ -0,0 +1,436 @@
+// Usage:
+//
+//    sjsu::TimerWheel wheel(100us);
+//    wheel.Attach(timer0);
+//
+//    sjsu::TimerWheel::Timeout_t led_off([]() { led.SetLow(); });
+//    wheel.Schedule(led_off, 2500us);
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "peripherals/interrupt.hpp"
+#include "peripherals/timer.hpp"
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+/// Hierarchical timer wheel that keeps any number of software timeouts on a
+/// single hardware timer. Scheduling and cancelling a timeout are O(1), and an
+/// interrupt only does work for the timeouts that expire and for the one slot
+/// of a higher level that cascades down every 64 ticks. Ticks on which nothing
+/// can expire are skipped, so a late interrupt catches up quickly.
+///
+/// The wheel is advanced with Advance(), from the interrupt of an attached
+/// sjsu::Timer (see Attach()) or from an existing periodic callback such as the
+/// SystemTimer's.
+///
+/// Schedule(), Cancel() and RunDeferred() may be called from threads and from
+/// the callbacks of expired timeouts, but not from other interrupts. A thread
+/// that finds another thread modifying the wheel waits for it to finish. If the
+/// wheel's interrupt fires while a thread is modifying it, that tick is skipped
+/// and caught up on the next one.
+class TimerWheel
+{
+ public:
+  /// Number of bits of the tick count handled by each level.
+  static constexpr uint32_t kSlotBits = 6;
+  /// Number of slots in each level of the wheel.
+  static constexpr uint32_t kSlots = 1 << kSlotBits;
+  /// Number of levels of the wheel.
+  static constexpr uint32_t kLevels = 4;
+  /// Timeouts further than this many ticks away are parked in the last level
+  /// and cascaded again until they are within range.
+  static constexpr uint64_t kRange = uint64_t{ 1 } << (kSlotBits * kLevels);
+
+  /// Where the callback of a timeout runs.
+  enum class Context : uint8_t
+  {
+    /// In Advance(), usually the timer interrupt.
+    kInterrupt,
+    /// In RunDeferred(), called by a thread.
+    kDeferred,
+  };
+
+  /// A timeout is owned by the caller and linked into the wheel while it is
+  /// scheduled, so the wheel never allocates. It must not be destroyed or moved
+  /// while it is scheduled.
+  class Timeout_t
+  {
+   public:
+    Timeout_t() = default;
+
+    /// @param handler - called when the timeout expires.
+    /// @param run_in - where the handler is called.
+    explicit Timeout_t(InterruptDelegate handler,
+                       Context run_in = Context::kInterrupt)
+        : callback(handler), context(run_in)
+    {
+    }
+
+    Timeout_t(const Timeout_t &) = delete;
+    Timeout_t & operator=(const Timeout_t &) = delete;
+
+    /// @return true if the timeout is waiting to expire or, for deferred
+    ///         timeouts, waiting for RunDeferred().
+    bool IsScheduled() const
+    {
+      return link_ != nullptr;
+    }
+
+    /// Called when the timeout expires.
+    InterruptDelegate callback;
+    /// Where the callback is called.
+    Context context = Context::kInterrupt;
+
+   private:
+    friend class TimerWheel;
+
+    Timeout_t * next_  = nullptr;
+    Timeout_t ** link_ = nullptr;
+    uint64_t expiry_   = 0;
+    uint8_t level_     = 0;
+    bool expired_      = false;
+  };
+
+  /// @param resolution - duration of one tick of the wheel. Timeouts expire on
+  ///        the first tick at or after their deadline.
+  explicit TimerWheel(std::chrono::nanoseconds resolution = 1ms)
+      : resolution_(resolution)
+  {
+  }
+
+  TimerWheel(const TimerWheel &) = delete;
+  TimerWheel & operator=(const TimerWheel &) = delete;
+
+  /// Initialize the timer and advance the wheel from its interrupt once per
+  /// tick.
+  ///
+  /// @param timer - hardware timer dedicated to the wheel.
+  /// @param match_register - which of the timer's match registers to use.
+  /// @param priority - the timer interrupt's priority level.
+  void Attach(const sjsu::Timer & timer,
+              uint8_t match_register = 0,
+              int32_t priority       = -1)
+  {
+    constexpr auto kCountPeriod = 1us;
+    const auto kMatchCount = std::max(resolution_ / kCountPeriod, int64_t{ 1 });
+
+    timer.Initialize(1_MHz, [this]() { Advance(Uptime()); }, priority);
+    timer.SetMatchBehavior(static_cast<uint32_t>(kMatchCount),
+                           sjsu::Timer::MatchAction::kInterruptRestart,
+                           match_register);
+    timer.Start();
+  }
+
+  /// Schedule a timeout, replacing its deadline if it is already scheduled.
+  ///
+  /// @param timeout - timeout to schedule.
+  /// @param delay - time from now until the timeout expires. It expires on the
+  ///        next tick if this is zero.
+  void Schedule(Timeout_t & timeout, std::chrono::nanoseconds delay)
+  {
+    Lock_t lock(*this);
+
+    const auto kUptime  = Uptime();
+    const uint64_t kNow = std::max(ToTicks(kUptime), current_tick_);
+    // An empty wheel skips straight to the present, unless this is a callback
+    // in the middle of Advance().
+    if (scheduled_ == 0 && lock.IsAcquired())
+    {
+      current_tick_ = kNow;
+    }
+
+    // Round the deadline itself up to a tick, rather than adding the delay in
+    // ticks to the current tick, which starts part way through.
+    const auto kDeadline = kUptime + std::max(delay, 0ns);
+    const auto kExpiry =
+        static_cast<uint64_t>((kDeadline + resolution_ - 1ns) / resolution_);
+
+    Unlink(timeout);
+    timeout.expiry_ = std::max(kExpiry, kNow + 1);
+    Insert(timeout);
+  }
+
+  /// Cancel a timeout. Cancelling a deferred timeout that has expired but not
+  /// been run yet also keeps it from running.
+  ///
+  /// @param timeout - timeout to cancel.
+  /// @return true if the timeout was scheduled.
+  bool Cancel(Timeout_t & timeout)
+  {
+    Lock_t lock(*this);
+    return Unlink(timeout);
+  }
+
+  /// Expire every timeout whose deadline is at or before `now`. Callbacks of
+  /// kInterrupt timeouts run here, kDeferred timeouts are queued for
+  /// RunDeferred().
+  ///
+  /// @param now - the current uptime.
+  void Advance(std::chrono::nanoseconds now)
+  {
+    if (busy_.exchange(true, std::memory_order_acquire))
+    {
+      return;
+    }
+    in_advance_.store(true, std::memory_order_relaxed);
+
+    const uint64_t kTarget = ToTicks(now);
+    while (current_tick_ < kTarget)
+    {
+      if (scheduled_ == 0)
+      {
+        current_tick_ = kTarget;
+        break;
+      }
+
+      // While the lower levels are empty, nothing happens until the next
+      // cascade of the lowest level that holds a timeout.
+      uint32_t level = 0;
+      while (level < kLevels - 1 && occupancy_[level] == 0)
+      {
+        level++;
+      }
+      if (level > 0)
+      {
+        const uint64_t kBlock = uint64_t{ 1 } << (kSlotBits * level);
+        current_tick_ = std::min(current_tick_ | (kBlock - 1), kTarget);
+        if (current_tick_ == kTarget)
+        {
+          break;
+        }
+      }
+
+      current_tick_++;
+      Cascade();
+      Expire();
+    }
+
+    in_advance_.store(false, std::memory_order_relaxed);
+    busy_.store(false, std::memory_order_release);
+  }
+
+  /// Run the callbacks of deferred timeouts that have expired. Call this from
+  /// a thread.
+  ///
+  /// @return number of callbacks that were run.
+  size_t RunDeferred()
+  {
+    size_t count = 0;
+    while (true)
+    {
+      Timeout_t * timeout;
+      {
+        Lock_t lock(*this);
+        timeout = deferred_;
+        if (timeout == nullptr)
+        {
+          break;
+        }
+        Unlink(*timeout);
+      }
+      timeout->callback();
+      count++;
+    }
+    return count;
+  }
+
+  /// @return number of timeouts waiting to expire.
+  size_t Size() const
+  {
+    return scheduled_;
+  }
+
+  /// @return duration of one tick of the wheel.
+  std::chrono::nanoseconds GetResolution() const
+  {
+    return resolution_;
+  }
+
+ private:
+  /// Holds the wheel for a thread, waiting for any other thread holding it.
+  /// Does nothing when called from a callback of an expired timeout, as
+  /// Advance() already holds the wheel for it.
+  class Lock_t
+  {
+   public:
+    explicit Lock_t(TimerWheel & wheel) : wheel_(wheel), acquired_(false)
+    {
+      // Advance() runs in an interrupt, so while it is in progress the only
+      // code that can get here is one of the callbacks it calls.
+      if (wheel.in_advance_.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+
+      // Sleep a tick at a time rather than spin, as the holder may be a lower
+      // priority thread that this one preempted.
+      while (wheel.busy_.exchange(true, std::memory_order_acquire))
+      {
+        SleepThread(1ms, false);
+      }
+      acquired_ = true;
+    }
+
+    bool IsAcquired() const
+    {
+      return acquired_;
+    }
+
+    ~Lock_t()
+    {
+      if (acquired_)
+      {
+        wheel_.busy_.store(false, std::memory_order_release);
+      }
+    }
+
+   private:
+    TimerWheel & wheel_;
+    bool acquired_;
+  };
+
+  uint64_t ToTicks(std::chrono::nanoseconds time) const
+  {
+    return static_cast<uint64_t>(time / resolution_);
+  }
+
+  /// Link a timeout into the slot of the level that covers its deadline.
+  void Insert(Timeout_t & timeout)
+  {
+    const uint64_t kDelta = timeout.expiry_ - current_tick_;
+    // Deadlines past the range of the wheel are parked in the last slot they
+    // can reach and cascaded again when it comes around.
+    const uint64_t kSlotTick =
+        (kDelta < kRange) ? timeout.expiry_ : current_tick_ + kRange - 1;
+
+    uint32_t level = 0;
+    while (level < kLevels - 1 &&
+           kDelta >= (uint64_t{ 1 } << (kSlotBits * (level + 1))))
+    {
+      level++;
+    }
+
+    const size_t kSlot = (kSlotTick >> (kSlotBits * level)) & (kSlots - 1);
+    Link(timeout, wheel_[level][kSlot]);
+    timeout.level_ = static_cast<uint8_t>(level);
+    occupancy_[level]++;
+    scheduled_++;
+  }
+
+  /// Push a timeout onto the front of a list.
+  static void Link(Timeout_t & timeout, Timeout_t *& head)
+  {
+    timeout.next_ = head;
+    if (head != nullptr)
+    {
+      head->link_ = &timeout.next_;
+    }
+    head          = &timeout;
+    timeout.link_ = &head;
+  }
+
+  /// Remove a timeout from whichever list holds it.
+  ///
+  /// @return true if the timeout was in a list.
+  bool Unlink(Timeout_t & timeout)
+  {
+    if (timeout.link_ == nullptr)
+    {
+      return false;
+    }
+
+    if (!timeout.expired_)
+    {
+      occupancy_[timeout.level_]--;
+      scheduled_--;
+    }
+
+    *timeout.link_ = timeout.next_;
+    if (timeout.next_ != nullptr)
+    {
+      timeout.next_->link_ = timeout.link_;
+    }
+    timeout.next_    = nullptr;
+    timeout.link_    = nullptr;
+    timeout.expired_ = false;
+    return true;
+  }
+
+  /// Move every timeout of a slot into a list held by the caller. The timeouts
+  /// stay linked, so a callback can still cancel or reschedule any of them.
+  static void Detach(Timeout_t *& head, Timeout_t *& list)
+  {
+    list = head;
+    head = nullptr;
+    if (list != nullptr)
+    {
+      list->link_ = &list;
+    }
+  }
+
+  /// At the start of each block of a level's ticks, move the timeouts of that
+  /// block down into the lower levels.
+  void Cascade()
+  {
+    for (uint32_t level = 1; level < kLevels; level++)
+    {
+      const uint64_t kLowerBits = current_tick_ >> (kSlotBits * (level - 1));
+      if ((kLowerBits & (kSlots - 1)) != 0)
+      {
+        break;
+      }
+
+      const size_t kSlot =
+          (current_tick_ >> (kSlotBits * level)) & (kSlots - 1);
+      Timeout_t * list;
+      Detach(wheel_[level][kSlot], list);
+      while (list != nullptr)
+      {
+        Timeout_t & timeout = *list;
+        Unlink(timeout);
+        Insert(timeout);
+      }
+    }
+  }
+
+  /// Run or queue the timeouts of the current tick.
+  void Expire()
+  {
+    Timeout_t * list;
+    Detach(wheel_[0][current_tick_ & (kSlots - 1)], list);
+    while (list != nullptr)
+    {
+      Timeout_t & timeout = *list;
+      Unlink(timeout);
+
+      if (timeout.context == Context::kDeferred)
+      {
+        Link(timeout, deferred_);
+        timeout.expired_ = true;
+      }
+      else
+      {
+        // The timeout is unlinked first, so the callback can schedule it again.
+        timeout.callback();
+      }
+    }
+  }
+
+  std::chrono::nanoseconds resolution_;
+  std::array<std::array<Timeout_t *, kSlots>, kLevels> wheel_ = {};
+
+  std::array<size_t, kLevels> occupancy_ = {};
+  Timeout_t * deferred_                  = nullptr;
+  uint64_t current_tick_                 = 0;
+  size_t scheduled_                      = 0;
+  std::atomic<bool> busy_                = false;
+  std::atomic<bool> in_advance_          = false;
+};
+}  // namespace sjsu
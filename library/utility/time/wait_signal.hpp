@@ -0,0 +1,78 @@
+// Usage:
+//
+//    // In the driver
+//    sjsu::WaitSignal signal;
+//
+//    // In the thread
+//    bool finished = signal.Wait(10ms, [this]() { return !busy; });
+//
+//    // In the interrupt handler, once the work is done
+//    busy = false;
+//    signal.Notify();
+//
+#pragma once
+
+#include <chrono>
+#include <atomic>
+#include <functional>
+
+#include "utility/time/time.hpp"
+
+namespace sjsu
+{
+/// Lets an interrupt handler wake a thread that waits for it. With the
+/// scheduler running, the thread sleeps instead of polling, so lower priority
+/// tasks get the CPU until the interrupt handler calls Notify(). Without it,
+/// such as before the scheduler starts, Wait() spins like sjsu::Wait().
+///
+/// Sleeping uses the task notification of the waiting thread, so a thread
+/// should not use its task notification for anything else while it waits.
+class WaitSignal
+{
+ public:
+  /// Wait until is_done returns true. It is checked each time Notify() wakes
+  /// the thread, and in a loop during the last tick of the timeout.
+  ///
+  /// @param timeout - the maximum amount of time to wait for is_done to return
+  ///        true.
+  /// @param is_done - returns true once the interrupt has finished the work.
+  /// @return true if is_done returned true before the timeout elapsed.
+  bool Wait(std::chrono::nanoseconds timeout, std::function<bool()> is_done)
+  {
+    void * thread = SleepableThread();
+    if (thread == nullptr || timeout == std::chrono::nanoseconds::max())
+    {
+      return sjsu::Wait(timeout, is_done);
+    }
+
+    waiter_.store(thread, std::memory_order_release);
+
+    const auto kEnd = Uptime() + timeout;
+    bool done       = is_done();
+    for (auto now = Uptime(); !done && now <= kEnd; now = Uptime())
+    {
+      // Returns immediately if the remaining time is less than a tick, so the
+      // end of the wait spins.
+      SleepThread(kEnd - now, true);
+      done = is_done();
+    }
+
+    waiter_.store(nullptr, std::memory_order_release);
+    return done;
+  }
+
+  /// Wake the thread waiting on this signal, if there is one. Can be called
+  /// from an interrupt.
+  void Notify()
+  {
+    void * thread = waiter_.load(std::memory_order_acquire);
+    if (thread != nullptr)
+    {
+      SignalThread(thread);
+    }
+  }
+
+ private:
+  std::atomic<void *> waiter_ = nullptr;
+};
+}  // namespace sjsu
@@ -5,5 +5,7 @@
 
 #define SJ2_LOG_LEVEL SJ2_LOG_LEVEL_ERROR
 #define SJ2_AUTOMATICALLY_PRINT_ON_ERROR false
+// Larger than Can::kMaximumAcceptanceFilters to exercise filter overflow
+#define SJ2_CAN_NETWORK_CAPACITY 64
 
 #include "config.hpp"
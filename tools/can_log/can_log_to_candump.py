@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Convert a binary sjsu::CanRecorder log into a candump log file.
+
+The result holds one `candump -l` line per frame, which can be replayed with
+canplayer or loaded by most CAN analysis tools, such as SavvyCAN or
+cantools.
+
+Usage:
+
+    python3 can_log_to_candump.py CANLOG.BIN can.log
+
+Frame times start at zero, unless --start is given the time the log was
+recorded, in seconds since the epoch. The binary format is documented with
+CanLogFormat in can_log.hpp.
+"""
+
+import argparse
+import struct
+import sys
+
+SIGNATURE = b"SJ2CANLG"
+VERSION = 1
+HEADER = struct.Struct("<8sII")
+RECORD = struct.Struct("<IIB")
+
+REMOTE_REQUEST_FLAG = 1 << 30
+EXTENDED_FLAG = 1 << 31
+
+
+def parse(data):
+    """Return the frames of a log as a list of (time, id, extended, remote,
+    payload) tuples, with times in microseconds since the first frame.
+    """
+    if len(data) < HEADER.size:
+        raise ValueError("log is shorter than its header")
+
+    signature, version, _ = HEADER.unpack_from(data, 0)
+    if signature != SIGNATURE:
+        raise ValueError("not a CAN log")
+    if version != VERSION:
+        raise ValueError("unsupported log version {}".format(version))
+
+    frames = []
+    time = 0
+    position = HEADER.size
+    while position + RECORD.size <= len(data):
+        delta, identifier, length = RECORD.unpack_from(data, position)
+        # The end of log marker, a length of 0xFF, fills the rest of the last
+        # sector.
+        if length > 8:
+            break
+        position += RECORD.size
+        if position + length > len(data):
+            break
+        payload = data[position:position + length]
+        position += length
+
+        time += delta
+        frames.append((time,
+                       identifier & ~(REMOTE_REQUEST_FLAG | EXTENDED_FLAG),
+                       bool(identifier & EXTENDED_FLAG),
+                       bool(identifier & REMOTE_REQUEST_FLAG),
+                       payload))
+    return frames
+
+
+def format_candump(frame, interface, start):
+    """Return a frame as a candump log line, like FormatCandump() does."""
+    time, identifier, extended, remote, payload = frame
+    microseconds = time + start
+    data = "R" if remote else payload.hex().upper()
+    return "({:010d}.{:06d}) {} {:0{}X}#{}".format(
+        microseconds // 1_000_000, microseconds % 1_000_000, interface,
+        identifier, 8 if extended else 3, data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="file holding a binary CAN log")
+    parser.add_argument("output", nargs="?",
+                        help="candump log file to write, stdout if omitted")
+    parser.add_argument("--interface", default="can0",
+                        help="interface name put in each line (default can0)")
+    parser.add_argument("--start", type=float, default=0.0,
+                        help="seconds added to every frame's time")
+    arguments = parser.parse_args()
+
+    with open(arguments.log, "rb") as log:
+        data = log.read()
+
+    try:
+        frames = parse(data)
+    except ValueError as error:
+        sys.exit("{}: {}".format(arguments.log, error))
+
+    start = round(arguments.start * 1_000_000)
+    lines = [format_candump(frame, arguments.interface, start)
+             for frame in frames]
+
+    if arguments.output:
+        with open(arguments.output, "w") as output:
+            output.writelines(line + "\n" for line in lines)
+        print("Wrote {} frames to {}".format(len(frames), arguments.output))
+    else:
+        sys.stdout.writelines(line + "\n" for line in lines)
+
+
+if __name__ == "__main__":
+    main()
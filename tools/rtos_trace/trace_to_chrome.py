@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""Convert an sjsu::rtos::TraceRecorder dump into Chrome trace event JSON.
+
+The result can be opened in chrome://tracing or https://ui.perfetto.dev to see
+which task ran when, how much stack each had left, and when queues were used,
+priorities inherited, and interrupts serviced.
+
+Usage:
+
+    python3 trace_to_chrome.py rtos_trace.bin trace.json
+
+The input may hold other bytes before the dump, such as serial console output
+captured while running `trace dump`; everything before the magic number is
+skipped. The binary format is documented in trace_recorder.hpp.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"RTTR"
+VERSION = 1
+HEADER = struct.Struct("<4sHHIII")
+TASK = struct.Struct("<BBH16s")
+EVENT = struct.Struct("<IBBH")
+
+TASK_SWITCH_IN = 1
+TASK_SWITCH_OUT = 2
+TASK_CREATE = 3
+TASK_DELETE = 4
+PRIORITY_INHERIT = 5
+PRIORITY_DISINHERIT = 6
+QUEUE_CREATE = 7
+QUEUE_SEND = 8
+QUEUE_SEND_FAILED = 9
+QUEUE_RECEIVE = 10
+QUEUE_RECEIVE_FAILED = 11
+QUEUE_BLOCK_ON_SEND = 12
+QUEUE_BLOCK_ON_RECEIVE = 13
+ISR_ENTER = 14
+ISR_EXIT = 15
+
+QUEUE_EVENT_NAMES = {
+    QUEUE_SEND: "send",
+    QUEUE_SEND_FAILED: "send failed",
+    QUEUE_RECEIVE: "receive",
+    QUEUE_RECEIVE_FAILED: "receive failed",
+    QUEUE_BLOCK_ON_SEND: "block on send",
+    QUEUE_BLOCK_ON_RECEIVE: "block on receive",
+}
+
+# FreeRTOS queueQUEUE_TYPE_* values
+QUEUE_TYPE_NAMES = {
+    0: "queue",
+    1: "mutex",
+    2: "counting semaphore",
+    3: "binary semaphore",
+    4: "recursive mutex",
+}
+
+PROCESS_ID = 1
+TASKS_THREAD = 0
+QUEUES_THREAD = 1000
+INTERRUPTS_THREAD = 1001
+
+
+def parse(data):
+    """Return (header, tasks, events) from the bytes of a dump.
+
+    tasks maps task numbers to (name, priority). events is a list of
+    (timestamp, type, id, argument) tuples, oldest first, with timestamps in
+    microseconds since the oldest event.
+    """
+    start = data.find(MAGIC)
+    if start < 0:
+        raise ValueError("no trace dump found")
+
+    (_, version, task_count, event_count, overwritten,
+     frequency) = HEADER.unpack_from(data, start)
+    if version != VERSION:
+        raise ValueError("unsupported dump version {}".format(version))
+
+    position = start + HEADER.size
+    needed = position + task_count * TASK.size + event_count * EVENT.size
+    if len(data) < needed:
+        raise ValueError("dump is truncated, {} of {} bytes".format(
+            len(data) - start, needed - start))
+
+    tasks = {}
+    for _ in range(task_count):
+        number, priority, _, name = TASK.unpack_from(data, position)
+        position += TASK.size
+        tasks[number] = (name.split(b"\0")[0].decode("ascii", "replace"),
+                         priority)
+
+    events = []
+    wraps = 0
+    previous = None
+    for _ in range(event_count):
+        timestamp, kind, identifier, argument = EVENT.unpack_from(
+            data, position)
+        position += EVENT.size
+        # Events recorded by nested interrupts can be a few ticks out of order,
+        # so only a large backwards step is taken as the counter wrapping.
+        if previous is not None and previous - timestamp > 0x8000_0000:
+            wraps += 1
+        previous = timestamp
+        ticks = timestamp + (wraps << 32)
+        events.append((ticks * 1_000_000 / frequency, kind, identifier,
+                       argument))
+
+    events.sort(key=lambda event: event[0])
+    # Start the timeline at the oldest event, rather than at power on
+    if events:
+        origin = events[0][0]
+        events = [(timestamp - origin, kind, identifier, argument)
+                  for timestamp, kind, identifier, argument in events]
+    header = {"events": event_count, "overwritten": overwritten}
+    return header, tasks, events
+
+
+def convert(tasks, events):
+    """Return a list of Chrome trace events describing the recording."""
+    output = [
+        {"name": "process_name", "ph": "M", "pid": PROCESS_ID,
+         "args": {"name": "FreeRTOS"}},
+        {"name": "thread_name", "ph": "M", "pid": PROCESS_ID,
+         "tid": QUEUES_THREAD, "args": {"name": "Queues"}},
+        {"name": "thread_name", "ph": "M", "pid": PROCESS_ID,
+         "tid": INTERRUPTS_THREAD, "args": {"name": "Interrupts"}},
+    ]
+
+    def task_name(number):
+        return tasks.get(number, ("Task {}".format(number), 0))[0]
+
+    for number, (name, priority) in sorted(tasks.items()):
+        output.append({"name": "thread_name", "ph": "M", "pid": PROCESS_ID,
+                       "tid": TASKS_THREAD + number,
+                       "args": {"name": "{} ({})".format(name, priority)}})
+        output.append({"name": "thread_sort_index", "ph": "M",
+                       "pid": PROCESS_ID, "tid": TASKS_THREAD + number,
+                       "args": {"sort_index": -priority}})
+
+    queue_types = {}
+    running = {}
+    interrupts = {}
+    for timestamp, kind, identifier, argument in events:
+        tid = TASKS_THREAD + identifier
+        if kind == TASK_SWITCH_IN:
+            running[identifier] = (timestamp, argument)
+        elif kind == TASK_SWITCH_OUT:
+            if identifier in running:
+                start, priority = running.pop(identifier)
+                output.append({"name": task_name(identifier), "cat": "task",
+                               "ph": "X", "pid": PROCESS_ID, "tid": tid,
+                               "ts": start, "dur": timestamp - start,
+                               "args": {"priority": priority}})
+            output.append({"name": "Stack left", "ph": "C",
+                           "pid": PROCESS_ID, "ts": timestamp,
+                           "args": {task_name(identifier): argument}})
+        elif kind in (TASK_CREATE, TASK_DELETE):
+            output.append({"name": "create" if kind == TASK_CREATE
+                                   else "delete",
+                           "cat": "task", "ph": "i", "s": "t",
+                           "pid": PROCESS_ID, "tid": tid, "ts": timestamp})
+        elif kind in (PRIORITY_INHERIT, PRIORITY_DISINHERIT):
+            output.append({"name": "inherit priority"
+                                   if kind == PRIORITY_INHERIT
+                                   else "disinherit priority",
+                           "cat": "priority", "ph": "i", "s": "t",
+                           "pid": PROCESS_ID, "tid": tid, "ts": timestamp,
+                           "args": {"priority": argument}})
+        elif kind == QUEUE_CREATE:
+            queue_types[identifier] = QUEUE_TYPE_NAMES.get(argument, "queue")
+        elif kind in QUEUE_EVENT_NAMES:
+            queue = "{} {}".format(queue_types.get(identifier, "queue"),
+                                   identifier)
+            output.append({"name": "{} {}".format(
+                               queue, QUEUE_EVENT_NAMES[kind]),
+                           "cat": "queue", "ph": "i", "s": "t",
+                           "pid": PROCESS_ID, "tid": QUEUES_THREAD,
+                           "ts": timestamp,
+                           "args": {"items waiting": argument}})
+        elif kind == ISR_ENTER:
+            interrupts.setdefault(identifier, []).append(timestamp)
+        elif kind == ISR_EXIT:
+            if interrupts.get(identifier):
+                start = interrupts[identifier].pop()
+                output.append({"name": "IRQ {}".format(identifier),
+                               "cat": "interrupt", "ph": "X",
+                               "pid": PROCESS_ID, "tid": INTERRUPTS_THREAD,
+                               "ts": start, "dur": timestamp - start})
+
+    # Close the slices of tasks that were still running when recording stopped
+    if events:
+        end = events[-1][0]
+        for identifier, (start, priority) in running.items():
+            output.append({"name": task_name(identifier), "cat": "task",
+                           "ph": "X", "pid": PROCESS_ID,
+                           "tid": TASKS_THREAD + identifier, "ts": start,
+                           "dur": end - start,
+                           "args": {"priority": priority}})
+    return output
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump", help="file holding a TraceRecorder dump")
+    parser.add_argument("output", nargs="?",
+                        help="JSON file to write, stdout if omitted")
+    arguments = parser.parse_args()
+
+    with open(arguments.dump, "rb") as dump:
+        data = dump.read()
+
+    try:
+        header, tasks, events = parse(data)
+    except (ValueError, struct.error) as error:
+        sys.exit("{}: {}".format(arguments.dump, error))
+
+    if header["overwritten"]:
+        print("{} events were overwritten before the oldest one".format(
+            header["overwritten"]), file=sys.stderr)
+
+    trace = {"traceEvents": convert(tasks, events),
+             "displayTimeUnit": "ms"}
+    if arguments.output:
+        with open(arguments.output, "w") as output:
+            json.dump(trace, output)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()